@@ -107,9 +107,10 @@ targets.append(.target(name: "TestsUtils", path: "utils", sources: ["TestsUtils.
 //                                 "-enable-experimental-feature",
 //                                 "LayoutPrespecialization"])]))
 targets.append(.systemLibrary(name: "LibProc", path: "utils/LibProc"))
+targets.append(.systemLibrary(name: "LibPerf", path: "utils/LibPerf"))
 targets.append(
   .target(name: "DriverUtils",
-    dependencies: [.target(name: "TestsUtils"), "LibProc"],
+    dependencies: [.target(name: "TestsUtils"), "LibProc", "LibPerf"],
     path: "utils",
     sources: ["DriverUtils.swift", "ArgParse.swift"]))
 
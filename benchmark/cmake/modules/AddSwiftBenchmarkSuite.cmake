@@ -380,6 +380,9 @@ function (swift_benchmark_compile_archopts)
     if(NOT ${optflag} STREQUAL "Onone" AND "${bench_flags}" MATCHES "-whole-module.*")
       list(APPEND common_options "-save-optimization-record=bitstream")
     endif()
+  else()
+    list(APPEND common_options
+      "-I" "${srcdir}/utils/LibPerf")
   endif()
 
   set(opt_view_main_dir)
@@ -418,6 +421,9 @@ function (swift_benchmark_compile_archopts)
       "-F" "${sdk}/../../../Developer/Library/Frameworks"
       "-I" "${srcdir}/utils/LibProc"
       "-no-link-objc-runtime")
+  else()
+    list(APPEND common_options_driver
+      "-I" "${srcdir}/utils/LibPerf")
   endif()
   set(bench_library_objects)
   set(bench_library_sibfiles)
@@ -23,6 +23,10 @@ import LibProc
 
 import TestsUtils
 
+#if os(Linux) && canImport(LibPerf)
+import LibPerf
+#endif
+
 /// Sorry.
 private func ??<T>(_ x: T?, _ y: @autoclosure () async -> T) async -> T {
   if let x { return x }
@@ -39,15 +43,26 @@ struct MeasurementMetadata {
   let yields: Int /// Yield Count
 }
 
+/// Hardware performance counters measured over a sample, normalized to one
+/// iteration. Counters the platform could not provide read as zero.
+struct PerfCounterSample {
+  var instructions: UInt64 = 0
+  var branches: UInt64 = 0
+  var cacheMisses: UInt64 = 0
+}
+
 struct BenchResults {
   let samples: [Double]
   let meta: MeasurementMetadata?
   let iters: Int
+  let counters: PerfCounterSample?
 
-  init(_ samples: [Double], _ metadata: MeasurementMetadata?, _ iters: Int) {
+  init(_ samples: [Double], _ metadata: MeasurementMetadata?, _ iters: Int,
+       _ counters: PerfCounterSample?) {
     self.samples = samples
     self.meta = metadata
     self.iters = iters
+    self.counters = counters
   }
 }
 
@@ -96,6 +111,9 @@ struct TestConfig {
   // Should we log the measurement metadata?
   let logMeta: Bool
 
+  // Should we measure and log hardware performance counters?
+  let logCounters: Bool
+
   // Allow running with nondeterministic hashing?
   var allowNondeterministicHashing: Bool
 
@@ -126,6 +144,7 @@ struct TestConfig {
       var verbose: Bool?
       var logMemory: Bool?
       var logMeta: Bool?
+      var logCounters: Bool?
       var allowNondeterministicHashing: Bool?
       var jsonOutput: Bool?
       var action: TestAction?
@@ -168,6 +187,10 @@ struct TestConfig {
                   help: "log the change in maximum resident set size (MAX_RSS)")
     p.addArgument("--meta", \.logMeta, defaultValue: true,
                   help: "log the metadata (memory usage, context switches)")
+    p.addArgument("--counters", \.logCounters, defaultValue: true,
+                  help: "log hardware performance counters (instructions\n" +
+                        "retired; on Linux also branches and cache misses),\n" +
+                        "minimum over samples, normalized per iteration")
     p.addArgument("--tags", \PartialTestConfig.tags,
                   help: "run tests matching all the specified categories",
                   parser: tags)
@@ -200,6 +223,7 @@ struct TestConfig {
     verbose = c.verbose ?? false
     logMemory = c.logMemory ?? false
     logMeta = c.logMeta ?? false
+    logCounters = c.logCounters ?? false
     afterRunSleep = c.afterRunSleep
     action = c.action ?? .run
     allowNondeterministicHashing = c.allowNondeterministicHashing ?? false
@@ -240,6 +264,7 @@ struct TestConfig {
         Verbose: \(verbose)
         LogMemory: \(logMemory)
         LogMeta: \(logMeta)
+        LogCounters: \(logCounters)
         SampleTime: \(sampleTime)
         NumIters: \(numIters ?? 0)
         Tests Filter: \(c.tests ?? [])
@@ -362,6 +387,89 @@ extension UInt64 {
   var microseconds: Int { return Int(self / 1000) }
 }
 
+#if os(Linux) && canImport(LibPerf)
+/// Per-sample hardware counters read through perf_event_open(2).
+final class PerfCounters {
+  private let instructions: CInt
+  private let branches: CInt
+  private let cacheMisses: CInt
+
+  /// Fails when the kernel refuses access to the PMU (perf_event_paranoid,
+  /// containers without CAP_PERFMON); the driver then degrades to time-only
+  /// measurement. Individual counters may still be unavailable (e.g. no LLC
+  /// event in a VM) and read as zero.
+  init?() {
+    instructions = swift_perf_instructions_open()
+    branches = swift_perf_branches_open()
+    cacheMisses = swift_perf_cache_misses_open()
+    if instructions < 0 && branches < 0 && cacheMisses < 0 { return nil }
+  }
+
+  deinit {
+    for fd in [instructions, branches, cacheMisses] where fd >= 0 {
+      swift_perf_counter_close(fd)
+    }
+  }
+
+  func start() {
+    for fd in [instructions, branches, cacheMisses] where fd >= 0 {
+      swift_perf_counter_start(fd)
+    }
+  }
+
+  func stop() -> PerfCounterSample {
+    func value(_ fd: CInt) -> UInt64 {
+      return fd >= 0 ? swift_perf_counter_stop(fd) : 0
+    }
+    return PerfCounterSample(
+      instructions: value(instructions),
+      branches: value(branches),
+      cacheMisses: value(cacheMisses))
+  }
+}
+#elseif canImport(Darwin)
+/// Instructions-retired from the process-wide resource usage info; branch
+/// and cache-miss counters would need the private kperf interface, so they
+/// always read as zero here.
+final class PerfCounters {
+  private var startInstructions: UInt64 = 0
+
+  init?() {
+    guard PerfCounters.executedInstructions() > 0 else { return nil }
+  }
+
+  private static func executedInstructions() -> UInt64 {
+    if #available(OSX 10.9, iOS 7.0, *) {
+      var u = rusage_info_v4()
+      withUnsafeMutablePointer(to: &u) { p in
+        p.withMemoryRebound(to: Optional<rusage_info_t>.self, capacity: 1) { up in
+          let _ = proc_pid_rusage(getpid(), RUSAGE_INFO_V4, up)
+        }
+      }
+      return u.ri_instructions
+    } else {
+      return 0
+    }
+  }
+
+  func start() {
+    startInstructions = PerfCounters.executedInstructions()
+  }
+
+  func stop() -> PerfCounterSample {
+    return PerfCounterSample(
+      instructions: PerfCounters.executedInstructions() - startInstructions)
+  }
+}
+#else
+/// No counter source on this platform.
+final class PerfCounters {
+  init?() { return nil }
+  func start() {}
+  func stop() -> PerfCounterSample { return PerfCounterSample() }
+}
+#endif
+
 /// Performance test runner that measures benchmarks and reports the results.
 final class TestRunner {
   let c: TestConfig
@@ -370,9 +478,14 @@ final class TestRunner {
   let baseline = TestRunner.getResourceUtilization()
   let schedulerQuantum = UInt64(10_000_000) // nanoseconds (== 10ms, macos)
   var yieldCount = 0
+  let counters: PerfCounters?
+  /// Minimum per-iteration counter values over the samples of the current
+  /// test; the minimum is the least noisy summary of a hardware counter.
+  var minCounters: PerfCounterSample?
 
   init(_ config: TestConfig) {
     self.c = config
+    self.counters = config.logCounters ? PerfCounters() : nil
     let now = timer.getTime()
     (start, end, lastYield) = (now, now, now)
   }
@@ -384,28 +497,6 @@ final class TestRunner {
     return timer.getTime()
   }
 
-#if os(Linux)
-  private static func getExecutedInstructions() -> UInt64 {
-    // FIXME: there is a Linux PMC API you can use to get this, but it's
-    // not quite so straightforward.
-    return 0
-  }
-#else
-  private static func getExecutedInstructions() -> UInt64 {
-    if #available(OSX 10.9, iOS 7.0, *) {
-      var u = rusage_info_v4()
-      withUnsafeMutablePointer(to: &u) { p in
-        p.withMemoryRebound(to: Optional<rusage_info_t>.self, capacity: 1) { up in
-          let _ = proc_pid_rusage(getpid(), RUSAGE_INFO_V4, up)
-        }
-      }
-      return u.ri_instructions
-    } else {
-      return 0
-    }
-  }
-#endif
-
   private static func getResourceUtilization() -> rusage {
 #if canImport(Darwin)
    let rusageSelf = RUSAGE_SELF
@@ -492,15 +583,37 @@ final class TestRunner {
     return timer.diffTimeInNanoSeconds(from: start, to: end)
   }
 
+  /// Fold one sample's counters into the per-test minimum, normalized to a
+  /// single iteration.
+  private func mergeCounters(_ sample: PerfCounterSample, numIters: Int) {
+    let n = UInt64(numIters)
+    let perIter = PerfCounterSample(
+      instructions: sample.instructions / n,
+      branches: sample.branches / n,
+      cacheMisses: sample.cacheMisses / n)
+    guard let m = minCounters else { minCounters = perIter; return }
+    minCounters = PerfCounterSample(
+      instructions: min(m.instructions, perIter.instructions),
+      branches: min(m.branches, perIter.branches),
+      cacheMisses: min(m.cacheMisses, perIter.cacheMisses))
+  }
+
   /// Measure the `fn` and return the average sample time per iteration (μs).
   func measure(_ name: String, fn: (Int) async -> Void, numIters: Int) async -> Double {
 #if SWIFT_RUNTIME_ENABLE_LEAK_CHECKER
     name.withCString { p in startTrackingObjects(p) }
 #endif
 
+    // Counters start before and stop after the timed region, so the counter
+    // syscalls never pollute the time measurement and the timer reads
+    // contribute only a few instructions to the counted region.
+    counters?.start()
     startMeasurement()
     await fn(numIters)
     stopMeasurement()
+    if let sample = counters?.stop() {
+      mergeCounters(sample, numIters: numIters)
+    }
 
 #if SWIFT_RUNTIME_ENABLE_LEAK_CHECKER
     name.withCString { p in stopTrackingObjects(p) }
@@ -525,6 +638,7 @@ final class TestRunner {
     logVerbose("Running \(test.name)")
 
     var samples: [Double] = []
+    minCounters = nil
 
     func addSample(_ time: Double) {
       logVerbose("    Sample \(samples.count),\(time)")
@@ -582,7 +696,7 @@ final class TestRunner {
       samples = samples.map { $0 * Double(lf) }
     }
 
-    return BenchResults(samples, collectMetadata(), numIters)
+    return BenchResults(samples, collectMetadata(), numIters, minCounters)
   }
 
   func printJSON(index: Int, info: BenchmarkInfo, results: BenchResults?) {
@@ -602,6 +716,11 @@ final class TestRunner {
       let samples = results.samples.sorted().map({$0.description}).joined(separator: ",")
       out.append("\"samples\":[\(samples)]")
       out.append("\"iters\":\(results.iters)")
+      if let pc = results.counters {
+        if pc.instructions > 0 { out.append("\"instructions\":\(pc.instructions)") }
+        if pc.branches > 0 { out.append("\"branches\":\(pc.branches)") }
+        if pc.cacheMisses > 0 { out.append("\"cache_misses\":\(pc.cacheMisses)") }
+      }
       if let meta = results.meta {
 	if c.logMemory {
 	  out += [
@@ -0,0 +1,76 @@
+//===--- LibPerf.h --------------------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2026 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// This file wraps the raw perf_event_open(2) interface in a few static
+// inline helpers the benchmark driver can call from Swift without having to
+// spell out the perf_event_attr struct layout. On platforms without the
+// perf interface the module is intentionally empty; the Swift side guards
+// its use with `os(Linux)`.
+
+#ifndef SWIFT_BENCHMARK_LIBPERF_H
+#define SWIFT_BENCHMARK_LIBPERF_H
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static inline int _swift_perf_counter_open(unsigned type,
+                                           unsigned long long config) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type = type;
+  attr.size = sizeof(attr);
+  attr.config = config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return (int)syscall(__NR_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1,
+                      /*group_fd=*/-1, /*flags=*/0);
+}
+
+static inline int swift_perf_instructions_open(void) {
+  return _swift_perf_counter_open(PERF_TYPE_HARDWARE,
+                                  PERF_COUNT_HW_INSTRUCTIONS);
+}
+
+static inline int swift_perf_branches_open(void) {
+  return _swift_perf_counter_open(PERF_TYPE_HARDWARE,
+                                  PERF_COUNT_HW_BRANCH_INSTRUCTIONS);
+}
+
+static inline int swift_perf_cache_misses_open(void) {
+  return _swift_perf_counter_open(PERF_TYPE_HARDWARE,
+                                  PERF_COUNT_HW_CACHE_MISSES);
+}
+
+static inline void swift_perf_counter_start(int fd) {
+  ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+  ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+static inline unsigned long long swift_perf_counter_stop(int fd) {
+  ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+  unsigned long long value = 0;
+  if (read(fd, &value, sizeof(value)) != (ssize_t)sizeof(value))
+    return 0;
+  return value;
+}
+
+static inline void swift_perf_counter_close(int fd) { close(fd); }
+
+#endif // defined(__linux__) && __has_include(<linux/perf_event.h>)
+
+#endif // SWIFT_BENCHMARK_LIBPERF_H
@@ -25,7 +25,7 @@
 /// SWIFTSCAN_VERSION_MINOR should increase when there are API additions.
 /// SWIFTSCAN_VERSION_MAJOR is intended for "major" source/ABI breaking changes.
 #define SWIFTSCAN_VERSION_MAJOR 2
-#define SWIFTSCAN_VERSION_MINOR 2
+#define SWIFTSCAN_VERSION_MINOR 3
 
 SWIFTSCAN_BEGIN_DECLS
 
@@ -531,6 +531,54 @@ swiftscan_scanner_cache_reset(swiftscan_scanner_t scanner);
 /// An entry point to invoke the compiler via a library call.
 SWIFTSCAN_PUBLIC int invoke_swift_compiler(int argc, const char **argv);
 
+//=== Scanner Daemon Operations -------------------------------------------===//
+// A scanner daemon is a long-lived process holding a scanner's in-memory
+// dependency cache across build-system invocations. It serves scan requests
+// over a Unix-domain socket, and invalidates its cache when files the cached
+// dependencies were computed from change on disk.
+
+/// Opaque container of a client connection to a running scanner daemon.
+typedef void *swiftscan_scan_daemon_t;
+
+/// Run a scanner daemon serving scan requests on the Unix-domain socket at
+/// \c socket_path. Blocks until a client requests a shutdown. Returns
+/// non-zero on failure; if an error occurs, the error message is returned via
+/// the `error` parameter, and the caller needs to free it using
+/// `swiftscan_string_dispose`.
+SWIFTSCAN_PUBLIC int
+swiftscan_scanner_daemon_run(const char *socket_path,
+                             swiftscan_string_ref_t *error);
+
+/// Connect to the scanner daemon serving the Unix-domain socket at
+/// \c socket_path. Returns NULL on failure; if an error occurs, the error
+/// message is returned via the `error` parameter, and the caller needs to
+/// free it using `swiftscan_string_dispose`. The returned connection must be
+/// disposed of using `swiftscan_scan_daemon_dispose`.
+SWIFTSCAN_PUBLIC swiftscan_scan_daemon_t
+swiftscan_scan_daemon_connect(const char *socket_path,
+                              swiftscan_string_ref_t *error);
+
+/// Perform a dependency scan on the daemon, using arguments specified in the
+/// \c swiftscan_scan_invocation_t argument. The result is the same JSON
+/// dependency graph document 'swift-frontend -scan-dependencies' emits, and
+/// must be disposed of using `swiftscan_string_dispose`. Returns a null
+/// string on failure; if an error occurs, the error message is returned via
+/// the `error` parameter, and the caller needs to free it using
+/// `swiftscan_string_dispose`.
+SWIFTSCAN_PUBLIC swiftscan_string_ref_t
+swiftscan_scan_daemon_scan_json(swiftscan_scan_daemon_t daemon,
+                                swiftscan_scan_invocation_t invocation,
+                                swiftscan_string_ref_t *error);
+
+/// Reset the daemon's dependency cache, ensuring subsequent scan requests
+/// are serviced "from-scratch".
+SWIFTSCAN_PUBLIC void
+swiftscan_scan_daemon_cache_reset(swiftscan_scan_daemon_t daemon);
+
+/// Dispose of a scanner daemon connection. The daemon itself keeps running.
+SWIFTSCAN_PUBLIC void
+swiftscan_scan_daemon_dispose(swiftscan_scan_daemon_t daemon);
+
 //=== Scanner CAS Operations ----------------------------------------------===//
 
 /// Opaque container for a CASOptions that describe how CAS should be created.
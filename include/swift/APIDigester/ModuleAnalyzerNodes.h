@@ -155,6 +155,11 @@ struct CheckerOptions {
   bool SkipRemoveDeprecatedCheck;
   bool CompilerStyle;
   bool Migrator;
+  /// Emit baselines without indentation. Most of a pretty-printed baseline is
+  /// whitespace, so this makes them both smaller to write and faster to
+  /// re-tokenize during comparison; '-deserialize-sdk' re-expands a compact
+  /// baseline to the indented form for human diffing.
+  bool CompactJSON;
   StringRef LocationFilter;
   std::vector<std::string> ToolArgs;
   llvm::StringSet<> SPIGroupNamesToIgnore;
@@ -405,6 +405,13 @@ public:
   /// Cache of remapped types (useful for diagnostics).
   llvm::StringMap<Type> RemappedTypes;
 
+  /// Cache of types resolved from mangled names by the AST demangler
+  /// (\c Demangle::getTypeForMangling), which debugger workloads hit with
+  /// the same manglings over and over. Only successful lookups performed
+  /// without a generic signature are stored; successes never go stale
+  /// because modules are only ever added to a context, never unloaded.
+  llvm::StringMap<Type> DemangledTypeCache;
+
   /// The # of times we have performed typo correction.
   unsigned NumTypoCorrections = 0;
 
@@ -484,6 +491,16 @@ private:
   mutable PreModuleImportCallbackPtr PreModuleImportCallback;
 
 public:
+  /// Take a slab allocator for a constraint system, reusing the slabs of a
+  /// previously destroyed constraint system when one is pooled. Returns a
+  /// fresh allocator otherwise.
+  llvm::BumpPtrAllocator takeConstraintSolverMemory();
+
+  /// Bulk-reset a constraint system's slab allocator and return it to the
+  /// pool consulted by \c takeConstraintSolverMemory. All memory allocated
+  /// from \p allocator becomes invalid.
+  void recycleConstraintSolverMemory(llvm::BumpPtrAllocator &&allocator);
+
   /// Allocate - Allocate memory from the ASTContext bump pointer.
   void *Allocate(unsigned long bytes, unsigned alignment,
                  AllocationArena arena = AllocationArena::Permanent) const {
@@ -19,6 +19,8 @@
 
 #include "swift/AST/ASTContext.h"
 #include "swift/AST/ActorIsolation.h"
+#include "swift/Markup/Markup.h"
+#include "llvm/ADT/StringMap.h"
 #include <variant>
 
 namespace swift {
@@ -84,6 +86,15 @@ struct ASTContext::GlobalCache {
     const NormalProtocolConformance *,
     std::vector<ConformanceIsolationError>
   > conformanceIsolationErrors;
+
+  /// Arena owning the parsed doc comments cached in \c parsedDocComments.
+  markup::MarkupContext docCommentMarkup;
+
+  /// Parsed doc comments, keyed by their raw comment text together with the
+  /// comment kinds and column indents that affect line splitting. IDE clients
+  /// request documentation for the same few declarations many times per
+  /// session, so repeated requests become a table lookup.
+  llvm::StringMap<DocComment *> parsedDocComments;
 };
 
 } // end namespace 
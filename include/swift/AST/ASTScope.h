@@ -280,6 +280,11 @@ public:
 
 protected:
   void setWasExpanded() { parentAndWasExpanded.setInt(1); }
+
+  /// Discard the children of this scope and mark it unexpanded, so that it
+  /// is expanded again from the current AST on the next query. Only valid
+  /// for scopes that support deferred expansion.
+  void unexpand();
   virtual ASTScopeImpl *expandSpecifically(ScopeCreator &) = 0;
 
 public:
@@ -449,6 +454,13 @@ public:
 
   void expandFunctionBody(AbstractFunctionDecl *AFD);
 
+  /// Discard the scopes for the given function body, so that they are
+  /// rebuilt from the (reparsed) body on the next query.
+  ///
+  /// \returns false if the body's scopes could not be isolated, in which
+  /// case the caller must drop the entire scope tree.
+  bool unexpandFunctionBody(AbstractFunctionDecl *AFD);
+
   NullablePtr<const void> addressForPrinting() const override { return SF; }
 
   bool ignoreInDebugInfo() const override { return true; }
@@ -34,6 +34,12 @@ public:
   static DocComment *create(const Decl *D, swift::markup::MarkupContext &MC,
                             RawComment RC);
 
+  /// Create a copy of this doc comment for \p D that shares the underlying
+  /// parsed markup. Comments cached in the ASTContext are handed out through
+  /// copies so that callers may retarget or annotate them without mutating
+  /// the shared parse.
+  DocComment *copyForDecl(const Decl *D, swift::markup::MarkupContext &MC) const;
+
   void addInheritanceNote(swift::markup::MarkupContext &MC, TypeDecl *base);
 
   const Decl *getDecl() const { return D; }
@@ -300,6 +300,12 @@ public:
   /// caching.
   void clearCache() { cache.clear(); }
 
+  /// The total heap memory used by the result caches, in bytes.
+  ///
+  /// Note that this does not include the caches of requests that use
+  /// external caching.
+  size_t getTotalMemory() const { return cache.getTotalMemory(); }
+
   /// Is the given request, or an equivalent, currently being evaluated?
   template <typename Request>
   bool hasActiveRequest(const Request &request) const {
@@ -390,12 +396,10 @@ private:
   typename Request::OutputType
   getResultCached(const Request &request, Fn defaultValueFn) {
     // If we already have an entry for this request in the cache, return it.
-    auto known = cache.find_as<Request>(request);
-    if (known != cache.end<Request>()) {
-      auto result = known->second;
+    if (auto known = cache.lookup<Request>(request)) {
       recorder.replayCachedRequest(request);
-      handleDependencySinkRequest<Request>(request, result);
-      return result;
+      handleDependencySinkRequest<Request>(request, *known);
+      return *known;
     }
 
     // Compute the result.
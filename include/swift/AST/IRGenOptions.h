@@ -491,6 +491,11 @@ public:
 
   unsigned ConditionalRuntimeRecords : 1;
 
+  /// Emit type metadata of public types only if it is actually requested
+  /// within the module, under the assumption that no external client can
+  /// request it.
+  unsigned PruneUnusedMetadata : 1;
+
   unsigned AnnotateCondFailMessage : 1;
 
   unsigned InternalizeAtLink : 1;
@@ -641,7 +646,7 @@ public:
         DisableStandardSubstitutionsInReflectionMangling(false),
         EnableGlobalISel(false), VirtualFunctionElimination(false),
         WitnessMethodElimination(false), ConditionalRuntimeRecords(false),
-        AnnotateCondFailMessage(false),
+        PruneUnusedMetadata(false), AnnotateCondFailMessage(false),
         InternalizeAtLink(false), InternalizeSymbols(false),
         EmitGenericRODatas(true),
         NoPreallocatedInstantiationCaches(false),
@@ -21,6 +21,7 @@
 #include "swift/AST/Module.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/FoldingSet.h"
+#include <optional>
 
 namespace swift {
 class DeclContext;
@@ -47,9 +48,13 @@ namespace namelookup {
 ///
 /// The Swift standard library module is not included in either set unless
 /// it was explicitly imported (or re-exported).
+///
+/// In addition to the arrays, the set stores membership bitsets over the
+/// dense module indices handed out by the ImportCache, so that visibility
+/// checks are a single bit test instead of a walk over the arrays.
 class ImportSet final :
     public llvm::FoldingSetNode,
-    private llvm::TrailingObjects<ImportSet, ImportedModule> {
+    private llvm::TrailingObjects<ImportSet, ImportedModule, uint64_t> {
   friend TrailingObjects;
   friend class ImportCache;
 
@@ -57,11 +62,15 @@ class ImportSet final :
   unsigned NumTopLevelImports : 31;
   unsigned NumTransitiveImports;
   unsigned NumTransitiveSwiftOnlyImports;
+  unsigned NumImportBitWords;
+  unsigned NumSwiftOnlyImportBitWords;
 
   ImportSet(bool hasHeaderImportModule,
             ArrayRef<ImportedModule> topLevelImports,
             ArrayRef<ImportedModule> transitiveImports,
-            ArrayRef<ImportedModule> transitiveSwiftOnlyImports);
+            ArrayRef<ImportedModule> transitiveSwiftOnlyImports,
+            ArrayRef<uint64_t> importBits,
+            ArrayRef<uint64_t> swiftOnlyImportBits);
 
   ImportSet(const ImportSet &) = delete;
   void operator=(const ImportSet &) = delete;
@@ -79,6 +88,10 @@ public:
            NumTransitiveSwiftOnlyImports;
   }
 
+  size_t numTrailingObjects(OverloadToken<uint64_t>) const {
+    return NumImportBitWords + NumSwiftOnlyImportBitWords;
+  }
+
   /// This is a bit of a hack to make module name lookup work properly.
   /// If our import set includes the ClangImporter's special header import
   /// module, we have to check it first, before any other imported module.
@@ -108,6 +121,29 @@ public:
               NumTopLevelImports + NumTransitiveImports};
   }
 
+  /// Whether the module with the given dense index appears in the top-level
+  /// or transitive imports.
+  ///
+  /// An index beyond the stored bits belongs to a module that did not exist
+  /// when this set was built, and so cannot be a member.
+  bool containsImport(unsigned index) const {
+    unsigned word = index / 64;
+    if (word >= NumImportBitWords)
+      return false;
+    return getTrailingObjects<uint64_t>()[word] &
+           (uint64_t(1) << (index % 64));
+  }
+
+  /// Whether the module with the given dense index appears in the transitive
+  /// Swift-only imports.
+  bool containsSwiftOnlyImport(unsigned index) const {
+    unsigned word = index / 64;
+    if (word >= NumSwiftOnlyImportBitWords)
+      return false;
+    return getTrailingObjects<uint64_t>()[NumImportBitWords + word] &
+           (uint64_t(1) << (index % 64));
+  }
+
   SWIFT_DEBUG_DUMP;
 };
 
@@ -124,13 +160,31 @@ class alignas(ImportedModule) ImportCache {
                             const ModuleDecl *,
                             const DeclContext *>,
                  ArrayRef<ImportPath::Access>> ShadowCache;
-  llvm::DenseMap<std::tuple<const ModuleDecl *,
-                            const DeclContext *>,
-                 bool> SwiftOnlyCache;
   llvm::DenseMap<const ModuleDecl *, ArrayRef<ModuleDecl *>> WeakCache;
 
+  /// Dense indices for modules, assigned in the order the modules are first
+  /// encountered while building import sets. The indices key the membership
+  /// bitsets stored in each ImportSet.
+  llvm::DenseMap<const ModuleDecl *, unsigned> ModuleIndices;
+
   ImportPath::Access EmptyAccessPath;
 
+  /// Retrieve the dense index for the given module, assigning one if the
+  /// module has not been seen before.
+  unsigned getModuleIndex(const ModuleDecl *mod) {
+    return ModuleIndices.try_emplace(mod, ModuleIndices.size()).first->second;
+  }
+
+  /// Retrieve the dense index for the given module, if one has been
+  /// assigned. A module without an index cannot appear in any import set
+  /// built so far.
+  std::optional<unsigned> lookupModuleIndex(const ModuleDecl *mod) const {
+    auto found = ModuleIndices.find(mod);
+    if (found == ModuleIndices.end())
+      return std::nullopt;
+    return found->second;
+  }
+
   ArrayRef<ImportPath::Access> allocateArray(
       ASTContext &ctx,
       SmallVectorImpl<ImportPath::Access> &results);
@@ -155,9 +209,7 @@ public:
   getAllVisibleAccessPaths(const ModuleDecl *mod, const DeclContext *dc);
 
   bool isImportedBy(const ModuleDecl *mod,
-                    const DeclContext *dc) {
-    return !getAllVisibleAccessPaths(mod, dc).empty();
-  }
+                    const DeclContext *dc);
 
   /// Is `mod` imported from `dc` via a purely Swift access path?
   /// Always returns false if `dc` is a non-Swift module and only takes
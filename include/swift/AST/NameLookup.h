@@ -753,6 +753,15 @@ public:
 
   static void expandFunctionBody(AbstractFunctionDecl *);
 
+  /// Discard the scopes for the given function body, so that they are
+  /// rebuilt from the (reparsed) body on the next lookup. This allows an
+  /// edit confined to one function body to splice just that subtree rather
+  /// than dropping the whole scope tree.
+  ///
+  /// \returns false if the body's scopes could not be isolated, in which
+  /// case the caller must clear the source file's entire scope tree.
+  static bool unexpandFunctionBody(AbstractFunctionDecl *);
+
   /// Flesh out the tree for dumping
   void buildFullyExpandedTree();
 
@@ -859,6 +868,8 @@ private:
   static ast_scope::ASTSourceFileScope *createScopeTree(SourceFile *);
 
   void expandFunctionBodyImpl(AbstractFunctionDecl *);
+
+  bool unexpandFunctionBodyImpl(AbstractFunctionDecl *);
 };
 
 } // end namespace swift
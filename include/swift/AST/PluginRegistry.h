@@ -203,6 +203,44 @@ public:
   llvm::sys::process_t getProcess() { return Process->process.Process; }
 };
 
+/// Represents a connection to an already-running plugin server over a Unix
+/// domain socket.
+///
+/// Unlike 'LoadedExecutablePlugin', the server process is not managed by the
+/// compiler. An external coordinator (typically the build system) launches
+/// 'swift-plugin-server --socket <path>' once and keeps it warm, so plugin
+/// libraries stay loaded across frontend invocations instead of being
+/// re-spawned and re-handshaked by every job. The message framing is
+/// identical to the pipe transport. Note that the compiler cannot sandbox a
+/// server it didn't launch; sandboxing the server process is the
+/// coordinator's responsibility.
+class LoadedSocketPlugin : public CompilerPlugin {
+  /// Connected socket, or -1 before the first connection and after an I/O
+  /// failure.
+  int fd = -1;
+
+  ssize_t write(const void *buf, size_t nbyte) const;
+  ssize_t read(void *buf, size_t nbyte) const;
+
+  /// Drop the current connection so 'spawnIfNeeded()' reconnects.
+  void setStale();
+
+public:
+  LoadedSocketPlugin(llvm::StringRef socketPath)
+      : CompilerPlugin(socketPath) {}
+  ~LoadedSocketPlugin();
+
+  /// Connect to the socket if there is no usable connection. Return an error
+  /// if the server is not listening.
+  llvm::Error spawnIfNeeded() override;
+
+  /// Send a message to the plugin.
+  llvm::Error sendMessage(llvm::StringRef message) override;
+
+  /// Wait for a message from plugin and returns it.
+  llvm::Expected<std::string> waitForNextMessage() override;
+};
+
 class PluginRegistry {
   /// The in-process plugin server.
   std::unique_ptr<InProcessPlugins> inProcessPlugins;
@@ -211,6 +249,9 @@ class PluginRegistry {
   llvm::StringMap<std::unique_ptr<LoadedExecutablePlugin>>
       LoadedPluginExecutables;
 
+  /// Record of plugin server connections, keyed by socket path.
+  llvm::StringMap<std::unique_ptr<LoadedSocketPlugin>> SocketPlugins;
+
   /// Flag to dump plugin messagings.
   bool dumpMessaging = false;
 
@@ -230,6 +271,13 @@ public:
   /// If \p path plugin is already loaded, this returns the cached object.
   llvm::Expected<CompilerPlugin *> loadExecutablePlugin(llvm::StringRef path,
                                                         bool disableSandbox);
+
+  /// Connect to an already-running plugin server listening on the Unix
+  /// domain socket at \p socketPath .
+  /// If a connection to \p socketPath is already open, this returns the
+  /// cached object.
+  llvm::Expected<CompilerPlugin *>
+  connectToPluginServer(llvm::StringRef socketPath);
 };
 
 } // namespace swift
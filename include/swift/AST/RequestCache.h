@@ -19,6 +19,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/raw_ostream.h"
+#include <optional>
 
 #ifndef SWIFT_AST_REQUEST_CACHE_H
 #define SWIFT_AST_REQUEST_CACHE_H
@@ -162,23 +163,27 @@ public:
 /// Type-erased wrapper for caching results of a single type of request.
 class PerRequestCache {
   void *Storage;
-  std::function<void(void *)> Deleter;
-  std::function<void(llvm::raw_ostream &out, void *)> Dumper;
+  void (*Deleter)(void *);
+  void (*Dumper)(llvm::raw_ostream &out, void *);
+  size_t (*Sizer)(void *);
 
   PerRequestCache(void *storage,
-                  std::function<void(void *)> deleter,
-                  std::function<void(llvm::raw_ostream &out, void *)> dumper)
-      : Storage(storage), Deleter(deleter), Dumper(dumper) {}
+                  void (*deleter)(void *),
+                  void (*dumper)(llvm::raw_ostream &out, void *),
+                  size_t (*sizer)(void *))
+      : Storage(storage), Deleter(deleter), Dumper(dumper), Sizer(sizer) {}
 
 public:
   PerRequestCache()
     : Storage(nullptr),
       Deleter([](void *) {}),
-      Dumper([](llvm::raw_ostream &, void *) {}) {}
+      Dumper([](llvm::raw_ostream &, void *) {}),
+      Sizer([](void *) -> size_t { return 0; }) {}
   PerRequestCache(PerRequestCache &&other)
       : Storage(other.Storage),
-        Deleter(std::move(other.Deleter)),
-        Dumper(std::move(other.Dumper)) {
+        Deleter(other.Deleter),
+        Dumper(other.Dumper),
+        Sizer(other.Sizer) {
     other.Storage = nullptr;
   }
 
@@ -209,9 +214,19 @@ public:
                                out << "0\t0";
                              }
                              out << "\n";
+                           },
+                           [](void *storage) -> size_t {
+                             if (auto *map = static_cast<Map *>(storage))
+                               return llvm::capacity_in_bytes(*map);
+                             return 0;
                            });
   }
 
+  /// The heap memory used by the underlying map, in bytes.
+  size_t getMemorySize() const {
+    return Storage ? Sizer(Storage) : 0;
+  }
+
   template <typename Request>
   llvm::DenseMap<RequestKey<Request>,
                  typename Request::OutputType> *
@@ -278,6 +293,19 @@ class RequestCache {
 #undef SWIFT_TYPEID_ZONE
 
 public:
+  /// Look up the cached result for the given request, if present.
+  ///
+  /// Performs a single per-kind cache resolution, unlike pairing find_as()
+  /// with end().
+  template <typename Request>
+  std::optional<typename Request::OutputType> lookup(const Request &req) {
+    auto *cache = getCache<Request>();
+    auto known = cache->find_as(req);
+    if (known == cache->end())
+      return std::nullopt;
+    return known->second;
+  }
+
   template <typename Request>
   typename llvm::DenseMap<RequestKey<Request>,
                           typename Request::OutputType>::const_iterator
@@ -314,6 +342,18 @@ public:
 #undef SWIFT_TYPEID_ZONE
   }
 
+  /// The total heap memory used by the underlying caches, in bytes.
+  size_t getTotalMemory() const {
+    size_t size = 0;
+#define SWIFT_TYPEID_ZONE(Name, Id)                                            \
+    for (const auto &entry : Name##ZoneCache) {                                \
+      size += entry.getMemorySize();                                           \
+    }
+#include "swift/Basic/TypeIDZones.def"
+#undef SWIFT_TYPEID_ZONE
+    return size;
+  }
+
   void dump(llvm::raw_ostream &out) {
 #define SWIFT_TYPEID_ZONE(Name, Id)                                            \
     for (auto &entry : Name##ZoneCache) {                                      \
@@ -327,9 +367,9 @@ public:
 /// Type-erased wrapper for caching dependencies from a single type of request.
 class PerRequestReferences {
   void *Storage;
-  std::function<void(void *)> Deleter;
+  void (*Deleter)(void *);
 
-  PerRequestReferences(void *storage, std::function<void(void *)> deleter)
+  PerRequestReferences(void *storage, void (*deleter)(void *))
       : Storage(storage), Deleter(deleter) {}
 
 public:
@@ -492,6 +492,10 @@ public:
   /// Path to in-process plugin server shared library.
   std::string InProcessPluginServerPath;
 
+  /// Directory used to cache and replay external macro expansion results.
+  /// If empty, no caching is performed.
+  std::string MacroExpansionCachePath;
+
   /// Don't automatically add any import paths.
   bool SkipAllImplicitImportPaths = false;
 
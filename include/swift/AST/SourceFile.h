@@ -672,6 +672,11 @@ public:
   /// Retrieve the scope that describes this source file.
   ASTScope &getScope();
 
+  /// Whether the scope tree for this source file has been built.
+  bool hasScope() const {
+    return Scope.isNonNull();
+  }
+
   void clearScope() {
     Scope = nullptr;
   }
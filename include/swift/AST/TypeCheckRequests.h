@@ -3089,6 +3089,30 @@ public:
   bool isCached() const { return true; }
 };
 
+/// Compute the value requirements of a protocol that are structurally able
+/// to drive associated type inference: non-operator, non-accessor
+/// requirements that reference at least one of the protocol's associated
+/// types. Memoized per protocol, so every conformance to the same protocol
+/// shares the filtering instead of re-deriving it.
+class InferenceCandidateRequirementsRequest
+    : public SimpleRequest<InferenceCandidateRequirementsRequest,
+                           TinyPtrVector<ValueDecl *>(ProtocolDecl *),
+                           RequestFlags::Cached> {
+public:
+  using SimpleRequest::SimpleRequest;
+
+private:
+  friend SimpleRequest;
+
+  // Evaluation.
+  TinyPtrVector<ValueDecl *> evaluate(Evaluator &evaluator,
+                                      ProtocolDecl *proto) const;
+
+public:
+  // Caching.
+  bool isCached() const { return true; }
+};
+
 class ResolveTypeWitnessesRequest
     : public SimpleRequest<ResolveTypeWitnessesRequest,
                            evaluator::SideEffect(NormalProtocolConformance *),
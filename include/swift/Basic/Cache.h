@@ -130,6 +130,17 @@ protected:
 
   /// Destroys cache.
   void destroy();
+
+public:
+  /// Evicts least-recently-used entries from every cache created through
+  /// this mechanism until each cache's total maintained cost (the sum of the
+  /// costs passed to \c setAndRetain) is at most \p MaxResidualCost.
+  /// Long-lived host processes (e.g. sourcekitd) can call this when they
+  /// come under memory pressure.
+  ///
+  /// On Darwin this is a no-op: the system cache library already evicts in
+  /// response to memory pressure on its own.
+  static void trimAllCaches(size_t MaxResidualCost = 0);
 };
 
 /// Caching mechanism, that is thread-safe and can evict its entries when there
@@ -156,6 +156,11 @@ public:
     appendSetBits(newSize - size());
   }
 
+  /// Append a number of constant bits to this vector.
+  void appendConstantBits(size_t numBits, bool value) {
+    value ? appendSetBits(numBits) : appendClearBits(numBits);
+  }
+
   /// Test whether a particular bit is set.
   bool operator[](size_t i) const {
     assert(i < size());
@@ -217,6 +222,22 @@ public:
     return Bits ? Bits.value().popcount() : 0;
   }
 
+  /// A sentinel index returned by the find operations when no bit matches.
+  static constexpr size_t npos = ~size_t(0);
+
+  /// Find the index of the first set bit at or after \p fromIndex,
+  /// scanning a word at a time.  Returns npos if there is none.
+  size_t findNextSetBit(size_t fromIndex = 0) const;
+
+  /// Find the index of the first clear bit at or after \p fromIndex,
+  /// scanning a word at a time.  Returns npos if there is none.
+  size_t findNextClearBit(size_t fromIndex = 0) const;
+
+  /// Find the index of the last set bit strictly below \p fromIndex,
+  /// scanning a word at a time.  Returns npos if there is none.
+  /// Pass size() to search the entire vector from the top.
+  size_t findPreviousSetBit(size_t fromIndex) const;
+
   /// Determine if there are any bits set in this vector.
   bool any() const {
     return Bits && Bits.value() != 0;
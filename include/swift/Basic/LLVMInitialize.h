@@ -40,4 +40,22 @@
     llvm::InitializeAllTargetInfos(); \
   } while (0)
 
+namespace swift {
+
+/// Initialize the LLVM target machinery on first use rather than at program
+/// start. Registering every target, MC layer, asm printer/parser and
+/// disassembler is a fixed startup cost that frontend jobs which never reach
+/// IRGen (typechecking, module emission, dependency scanning) do not need to
+/// pay; call this from the paths that actually consult the target registry.
+/// Thread-safe, and repeated calls are no-ops.
+inline void initializeLLVMTargetsOnce() {
+  static const bool initialized = [] {
+    INITIALIZE_LLVM();
+    return true;
+  }();
+  (void)initialized;
+}
+
+} // end namespace swift
+
 #endif // SWIFT_BASIC_LLVMINITIALIZE_H
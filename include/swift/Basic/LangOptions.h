@@ -993,6 +993,11 @@ namespace swift {
     /// Should be stored sorted.
     llvm::SmallVector<unsigned, 4> DebugConstraintSolverOnLines;
 
+    /// If non-empty, append one Chrome trace event per constraint system
+    /// solved (source range, scopes explored, trail steps, time, memory)
+    /// to the file at this path.
+    std::string SolverTracePath;
+
     /// Triggers llvm fatal error if the typechecker tries to typecheck a decl
     /// or an identifier reference with any of the provided prefix names. This
     /// is for testing purposes.
@@ -52,7 +52,10 @@ protected:
   llvm::SmallVector<WordReplacement, 8> SubstWordsInIdent;
 
   /// Substitutions, except identifier substitutions.
-  llvm::DenseMap<const void *, unsigned> Substitutions;
+  ///
+  /// The inline buckets cover the substitution count of typical manglings,
+  /// so most mangling operations never allocate for this table.
+  llvm::SmallDenseMap<const void *, unsigned, 16> Substitutions;
 
   /// Identifier substitutions.
   llvm::StringMap<unsigned> StringSubstitutions;
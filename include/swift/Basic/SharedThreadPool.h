@@ -0,0 +1,46 @@
+//===--- SharedThreadPool.h - Process-wide thread pool ----------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2026 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_BASIC_SHAREDTHREADPOOL_H
+#define SWIFT_BASIC_SHAREDTHREADPOOL_H
+
+#include "llvm/Support/ThreadPool.h"
+
+namespace swift {
+
+/// Return the process-wide thread pool.
+///
+/// Parallel features should run their tasks on this pool rather than
+/// creating their own so that the process as a whole never runs more
+/// compute threads than the machine has cores, no matter how many
+/// features go parallel at once.  Threads are spawned lazily as tasks
+/// demand them, so merely touching the pool costs nothing on serial
+/// paths.
+///
+/// Callers that need to wait for their own tasks (rather than for the
+/// whole pool to drain) should scope them with an
+/// \c llvm::ThreadPoolTaskGroup:
+///
+/// \code
+///   llvm::ThreadPoolTaskGroup group(getSharedThreadPool());
+///   group.async(...);
+///   group.wait();
+/// \endcode
+///
+/// Waiting on a task group from inside a pool thread is allowed (the
+/// waiting thread runs the group's remaining tasks itself), so nested
+/// parallelism does not deadlock.
+llvm::ThreadPoolInterface &getSharedThreadPool();
+
+} // end namespace swift
+
+#endif // SWIFT_BASIC_SHAREDTHREADPOOL_H
@@ -203,6 +203,15 @@ private:
   /// buffer ID.
   mutable BufferLocCache LocCache;
 
+  /// Per-buffer tables of line start offsets, built lazily on the first
+  /// line-oriented query for a buffer.
+  mutable llvm::DenseMap<unsigned, std::vector<unsigned>> LineStartOffsetCache;
+
+  /// Per-buffer UTF-8 well-formedness, computed by a single whole-buffer
+  /// validation pass on the first query so that clients such as the Lexer
+  /// can skip per-scalar validation on the hot path.
+  mutable llvm::DenseMap<unsigned, bool> WellFormedUTF8Cache;
+
   std::optional<unsigned> findBufferContainingLocInternal(SourceLoc Loc) const;
 
 public:
@@ -485,7 +494,7 @@ public:
     assert(Loc.isValid());
     int LineOffset = getLineOffset(Loc);
     int l, c;
-    std::tie(l, c) = LLVMSourceMgr.getLineAndColumn(Loc, BufferID);
+    std::tie(l, c) = getLineAndColumnInBuffer(Loc, BufferID);
     assert(LineOffset+l > 0 && "bogus line offset");
     return { LineOffset + l, c };
   }
@@ -496,10 +505,16 @@ public:
   ///
   /// This does not respect \c #sourceLocation directives.
   std::pair<unsigned, unsigned>
-  getLineAndColumnInBuffer(SourceLoc Loc, unsigned BufferID = 0) const {
-    assert(Loc.isValid());
-    return LLVMSourceMgr.getLineAndColumn(Loc, BufferID);
-  }
+  getLineAndColumnInBuffer(SourceLoc Loc, unsigned BufferID = 0) const;
+
+  /// Returns the byte offsets at which each line of the given buffer starts,
+  /// computing them on first use with a word-at-a-time newline scan. The
+  /// result always has at least one entry, for offset zero.
+  ArrayRef<unsigned> getLineStartOffsets(unsigned BufferID) const;
+
+  /// Whether the buffer's contents are entirely well-formed UTF-8. The whole
+  /// buffer is validated once, on the first query.
+  bool isBufferWellFormedUTF8(unsigned BufferID) const;
 
   /// Returns the column for the given source location in the given buffer.
   unsigned getColumnInBuffer(SourceLoc Loc, unsigned BufferID) const;
@@ -16,7 +16,9 @@
 #include "swift/Basic/LLVM.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Timer.h"
+#include <functional>
 #include <optional>
 
 #include <thread>
@@ -128,6 +130,21 @@ public:
     const TraceFormatter *Formatter;
   };
 
+  // A phase-level event recorded by the sampled low-overhead mode
+  // (-sample-stats-events): one entry per frontier (depth-zero, non-nested)
+  // FrontendStatsTracer, together with a snapshot of cheap process-wide
+  // counters taken at exit. Unlike FrontendStatsEvent there is no
+  // per-counter delta loop on the hot path, so this is inexpensive enough
+  // to leave enabled on every build.
+  struct SampledStatsEvent
+  {
+    uint64_t BeginUSec;
+    uint64_t DurationUSec;
+    StringRef EventName;
+    int64_t MallocUsageBytes;
+    uint64_t InstructionsExecuted;
+  };
+
   // We only write fine-grained trace entries when the user passed
   // -trace-stats-events, but we recycle the same FrontendStatsTracers to give
   // us some free recursion-save phase timings whenever -trace-stats-dir is
@@ -148,6 +165,7 @@ private:
   long maxChildRSS = 0;
   SmallString<128> StatsFilename;
   SmallString<128> TraceFilename;
+  SmallString<128> SampledEventsFilename;
   SmallString<128> ProfileDirname;
   llvm::TimeRecord StartedTime;
   std::thread::id MainThreadID;
@@ -161,6 +179,35 @@ private:
   std::optional<AlwaysOnFrontendCounters> FrontendCounters;
   std::optional<AlwaysOnFrontendCounters> LastTracedFrontendCounters;
   std::optional<std::vector<FrontendStatsEvent>> FrontendStatsEvents;
+  std::optional<std::vector<SampledStatsEvent>> SampledStatsEvents;
+
+  /// Nesting depth of currently-active tracers; the sampled mode records an
+  /// event only when the depth returns to zero, i.e. for frontier events
+  /// that correspond to top-level compiler phases.
+  unsigned ActiveTracerDepth = 0;
+
+  /// When -emit-timing is active, the path of the per-file timing record
+  /// and the wall time accumulated per frontier event name. Collection is
+  /// restricted to depth-zero tracer exits, so it costs a hash lookup per
+  /// top-level phase rather than per event.
+  SmallString<128> TimingRecordPath;
+  llvm::StringMap<uint64_t> FrontierEventWallUSec;
+
+  /// Writes the compact JSON timing record for -emit-timing.
+  void writeTimingRecord(llvm::TimeRecord ElapsedTime);
+
+  /// Cheap callbacks polled at tracer boundaries, each returning the bytes
+  /// currently retained by one of the compiler's bump-pointer arenas. The
+  /// owners of the arenas (the ASTContext and the SILModule) install these
+  /// when they attach to the reporter, and must clear them again before
+  /// they are destroyed; see the setters below.
+  std::function<int64_t()> ASTArenaBytes;
+  std::function<int64_t()> SolverArenaBytes;
+  std::function<int64_t()> SILArenaBytes;
+
+  /// Poll the registered arena callbacks, updating the retained-bytes
+  /// counters and their high-water marks in \p C.
+  void updateArenaCounters(AlwaysOnFrontendCounters &C);
 
   // These are unique_ptr so we can use incomplete types here.
   std::unique_ptr<RecursionSafeTimers> RecursiveTimers;
@@ -171,6 +218,10 @@ private:
   /// evaluator requests. This will have a runtime performance impact.
   bool FineGrainedTimers;
 
+  /// Whether a -stats-output-dir was provided. When the reporter exists
+  /// only to serve -emit-timing, no stats files are written on shutdown.
+  bool HaveStatsOutputDir;
+
   /// Whether we are currently flushing statistics and should not therefore
   /// record any additional stats until we've finished.
   bool IsFlushingTracesAndProfiles;
@@ -188,6 +239,7 @@ private:
                        clang::SourceManager *CSM,
                        bool FineGrainedTimers,
                        bool TraceEvents,
+                       bool SampleEvents,
                        bool ProfileEvents,
                        bool ProfileEntities,
                        bool PrintZeroStats);
@@ -203,6 +255,7 @@ public:
                        clang::SourceManager *CSM,
                        bool FineGrainedTimers,
                        bool TraceEvents,
+                       bool SampleEvents,
                        bool ProfileEvents,
                        bool ProfileEntities,
                        bool PrintZeroStats);
@@ -210,6 +263,22 @@ public:
 
   bool fineGrainedTimers() const { return FineGrainedTimers; }
 
+  /// Install (or, passing nullptr, remove) the callbacks that attribute
+  /// arena memory to compiler phases. The callbacks run at every tracer
+  /// boundary, so they must be no more than a load from the allocator.
+  void setASTArenaBytesCallback(std::function<int64_t()> cb) {
+    ASTArenaBytes = std::move(cb);
+  }
+  void setSolverArenaBytesCallback(std::function<int64_t()> cb) {
+    SolverArenaBytes = std::move(cb);
+  }
+  void setSILArenaBytesCallback(std::function<int64_t()> cb) {
+    SILArenaBytes = std::move(cb);
+  }
+
+  /// Enable the -emit-timing record, to be written to \p Path on shutdown.
+  void setTimingRecordPath(StringRef Path) { TimingRecordPath = Path; }
+
   AlwaysOnDriverCounters &getDriverCounters();
   AlwaysOnFrontendCounters &getFrontendCounters();
   void flushTracesAndProfiles();
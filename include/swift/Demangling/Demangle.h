@@ -739,6 +739,22 @@ ManglingErrorOr<llvm::StringRef>
 mangleNode(NodePointer root, SymbolicResolver resolver, NodeFactory &Factory,
            Mangle::ManglingFlavor Flavor = Mangle::ManglingFlavor::Default);
 
+/// Remangle a batch of demangled parse trees, reusing a single remangler and
+/// its substitution and output-buffer storage across the whole batch. All of
+/// \p roots must stay alive until this function returns.
+///
+/// For each root, \p consume is called with the root's index and its mangled
+/// string. The string lives in scratch memory that is rewritten by the next
+/// root, so it is only valid until \p consume returns; callers that need to
+/// keep it must copy it out. Mangling stops at the first failure and returns
+/// its error.
+ManglingError
+mangleNodes(const NodePointer *roots, size_t numRoots,
+            SymbolicResolver resolver, NodeFactory &Factory,
+            llvm::function_ref<void(size_t index, llvm::StringRef mangling)>
+                consume,
+            Mangle::ManglingFlavor Flavor = Mangle::ManglingFlavor::Default);
+
 /// Remangle in the old mangling scheme.
 ///
 /// This is only used for objc-runtime names.
@@ -279,9 +279,19 @@ private:
       ArrayRef<ModuleDependencyID> swiftModules, ModuleDependenciesCache &cache,
       ModuleDependencyIDSetVector &discoveredDependencies);
 
-  /// Resolve all of a given module's imports to a Swift module, if one exists.
-  void resolveSwiftImportsForModule(
+  /// Query the filesystem for Swift modules matching the not-yet-resolved
+  /// imports of all of \p moduleIDs, as a single batch of parallel scanning
+  /// tasks, collecting the results into \p moduleLookupResult.
+  void scanSwiftImportsOfModules(
+      ArrayRef<ModuleDependencyID> moduleIDs, ModuleDependenciesCache &cache,
+      llvm::StringMap<SwiftModuleScannerQueryResult> &moduleLookupResult);
+
+  /// Resolve all of a given module's imports to a Swift module, if one
+  /// exists, using the query results collected by
+  /// \c scanSwiftImportsOfModules.
+  void recordSwiftImportsOfModule(
       const ModuleDependencyID &moduleID, ModuleDependenciesCache &cache,
+      llvm::StringMap<SwiftModuleScannerQueryResult> &moduleLookupResult,
       ModuleDependencyIDSetVector &importedSwiftDependencies);
 
   /// If a module has a bridging header or other header inputs, execute a
@@ -267,6 +267,15 @@ public:
   /// Trace changes to stats to files in StatsOutputDir.
   bool TraceStats = false;
 
+  /// Record phase-level (frontier) events only and write them to
+  /// StatsOutputDir as chrome://tracing JSON. Much cheaper than TraceStats.
+  bool SampleEvents = false;
+
+  /// Write a compact per-file record of phase wall times and peak memory
+  /// next to the main output. Derived from the same phase-level events as
+  /// SampleEvents, but independent of StatsOutputDir.
+  bool EmitTiming = false;
+
   /// Profile changes to stats to files in StatsOutputDir.
   bool ProfileEvents = false;
 
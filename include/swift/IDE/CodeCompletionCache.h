@@ -20,6 +20,7 @@
 #include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/Support/Chrono.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include <system_error>
 
 namespace swift {
@@ -73,6 +74,11 @@ public:
 
     std::vector<const ContextFreeCodeCompletionResult *> Results;
 
+    /// The (typically memory-mapped) cache file these results were
+    /// deserialized from, if any. The strings in \c Results point directly
+    /// into it, so it must stay alive as long as they do.
+    std::unique_ptr<llvm::MemoryBuffer> SourceBuffer;
+
     /// The arena that contains the \c USRBasedTypes of the
     /// \c ContextFreeCodeCompletionResult in this cache value.
     USRBasedTypeArena USRTypeArena;
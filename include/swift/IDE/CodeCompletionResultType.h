@@ -15,8 +15,10 @@
 
 #include "swift/AST/Types.h"
 #include "swift/Basic/LLVM.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/PointerUnion.h"
 #include "llvm/ADT/StringMap.h"
+#include <optional>
 
 namespace swift {
 namespace ide {
@@ -38,6 +40,8 @@ enum class CustomAttributeKind : uint8_t {
   FunctionMacro = 1 << 6,
 };
 
+enum class CodeCompletionResultTypeRelation : uint8_t;
+
 /// The expected contextual type(s) for code-completion.
 class ExpectedTypeContext {
   /// Possible types of the code completion expression.
@@ -59,6 +63,14 @@ class ExpectedTypeContext {
   /// 'Convertible'. All other types are related as 'Invalid'.
   OptionSet<CustomAttributeKind> ExpectedCustomAttributeKinds;
 
+  /// Relations already calculated against this type context, keyed by the
+  /// result's canonical type. Many results in a completion session share a
+  /// type, so this avoids re-running the conversion checks per item. Cleared
+  /// whenever the context is mutated in a way that affects relations. This is
+  /// the AST-typed counterpart of \c USRBasedTypeContext::CachedTypeRelations.
+  mutable llvm::DenseMap<TypeBase *, CodeCompletionResultTypeRelation>
+      CachedTypeRelations;
+
 public:
   ExpectedTypeContext() = default;
 
@@ -68,6 +80,7 @@ public:
 
   void setPossibleTypes(ArrayRef<Type> Types) {
     PossibleTypes.clear();
+    CachedTypeRelations.clear();
     PossibleTypes.reserve(Types.size());
     for (auto T : Types) {
       if (T) {
@@ -76,12 +89,29 @@ public:
     }
   }
 
+  /// Return the cached relation of \p Ty to this type context, if it has
+  /// already been calculated.
+  std::optional<CodeCompletionResultTypeRelation>
+  getCachedTypeRelation(Type Ty) const {
+    auto Known = CachedTypeRelations.find(Ty->getCanonicalType().getPointer());
+    if (Known == CachedTypeRelations.end())
+      return std::nullopt;
+    return Known->second;
+  }
+
+  /// Record the relation of \p Ty to this type context for later lookups.
+  void cacheTypeRelation(Type Ty,
+                         CodeCompletionResultTypeRelation Relation) const {
+    CachedTypeRelations[Ty->getCanonicalType().getPointer()] = Relation;
+  }
+
   /// Form a union of this expected type context with \p Other.
   ///
   /// Any possible type from either type context will be considered a possible
   /// type in the merged type context.
   void merge(const ExpectedTypeContext &Other) {
     PossibleTypes.append(Other.PossibleTypes);
+    CachedTypeRelations.clear();
 
     // We can't merge ideal types. If they are different, setting to a null type
     // is the best thing we can do.
@@ -113,12 +143,14 @@ public:
 
   void setIsImpliedResult(bool IsImpliedResult) {
     this->IsImpliedResult = IsImpliedResult;
+    CachedTypeRelations.clear();
   }
 
   bool getPreferNonVoid() const { return PreferNonVoid; }
 
   void setPreferNonVoid(bool PreferNonVoid) {
     this->PreferNonVoid = PreferNonVoid;
+    CachedTypeRelations.clear();
   }
 
   OptionSet<CustomAttributeKind> getExpectedCustomAttributeKinds() const {
@@ -128,6 +160,7 @@ public:
   void setExpectedCustomAttributeKinds(
       OptionSet<CustomAttributeKind> ExpectedAttributeKinds) {
     this->ExpectedCustomAttributeKinds = ExpectedAttributeKinds;
+    CachedTypeRelations.clear();
   }
 };
 
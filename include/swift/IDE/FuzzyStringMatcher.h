@@ -33,6 +33,10 @@ class FuzzyStringMatcher {
   double maxScore; ///< The maximum possible raw score for this pattern.
   /// If (and only if) c is in pattern, charactersInPattern[c] == 1
   llvm::BitVector charactersInPattern;
+  /// One bit per case-folded character class occurring in the pattern, used
+  /// to cheaply reject candidates that lack some pattern character entirely
+  /// before running the per-character match loop.
+  uint64_t patternCharMask = 0;
 
 public:
   bool normalize = false; ///< Whether to normalize scores to [0, 1].
@@ -48,6 +52,15 @@ public:
 
   /// Calculates the numerical score for \p candidate.
   double scoreCandidate(StringRef candidate) const;
+
+  /// Scores every element of \p candidates, writing one entry per candidate
+  /// to \p scores. Candidates that do not match the pattern score 0.
+  ///
+  /// Equivalent to calling \c matchesCandidate followed by \c scoreCandidate
+  /// per element; candidates rejected by the cheap character prefilter never
+  /// reach the exact scorer.
+  void scoreCandidates(ArrayRef<StringRef> candidates,
+                       MutableArrayRef<double> scores) const;
 };
 
 } // namespace ide
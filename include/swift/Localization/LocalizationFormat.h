@@ -218,6 +218,7 @@ class SerializedLocalizationProducer final : public LocalizationProducer {
   using SerializedLocalizationTable =
       llvm::OnDiskIterableChainedHashTable<LocalizationReaderInfo>;
   using offset_type = LocalizationReaderInfo::offset_type;
+  std::string filePath;
   std::unique_ptr<llvm::MemoryBuffer> Buffer;
   std::unique_ptr<SerializedLocalizationTable> SerializedTable;
 
@@ -225,6 +226,11 @@ public:
   explicit SerializedLocalizationProducer(
       std::unique_ptr<llvm::MemoryBuffer> buffer);
 
+  /// Create a producer that memory-maps the serialized diagnostics file at
+  /// \p filePath on first use, so enabling localization costs nothing in
+  /// processes that never format a localized diagnostic.
+  explicit SerializedLocalizationProducer(llvm::StringRef filePath);
+
 protected:
   bool initializeImpl() override;
   llvm::StringRef getMessage(swift::DiagID id) const override;
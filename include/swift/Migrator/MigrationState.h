@@ -57,13 +57,17 @@ struct MigrationState : public llvm::ThreadSafeRefCountedBase<MigrationState> {
     return Kind;
   }
 
-  std::string getInputText() const;
+  /// Returns the text of the input buffer. The text is owned by the
+  /// SourceManager, so there is no need to copy it per state.
+  StringRef getInputText() const;
 
   unsigned getInputBufferID() const {
     return InputBufferID;
   }
 
-  std::string getOutputText() const;
+  /// Returns the text of the output buffer. The text is owned by the
+  /// SourceManager, so there is no need to copy it per state.
+  StringRef getOutputText() const;
 
   unsigned getOutputBufferID() const {
     return OutputBufferID;
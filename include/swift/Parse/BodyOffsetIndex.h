@@ -0,0 +1,93 @@
+//===--- BodyOffsetIndex.h - Function body offset side table ----*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2026 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// A compact, serializable side table mapping declarations to the extents of
+// their function bodies, so that invocations that delay or skip body parsing
+// can seek straight to a body without re-scanning the file.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_PARSE_BODYOFFSETINDEX_H
+#define SWIFT_PARSE_BODYOFFSETINDEX_H
+
+#include "swift/Basic/Fingerprint.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <optional>
+#include <vector>
+
+namespace llvm {
+class raw_ostream;
+}
+
+namespace swift {
+
+class SourceFile;
+
+/// A side table of function-body extents for one source buffer.
+///
+/// Each entry records where a declaration starts, where its body begins and
+/// ends, and a fingerprint of the body's tokens. A consumer holding an index
+/// from a previous invocation can validate an entry against the fingerprint
+/// and, on a match, materialize the delayed body without re-discovering its
+/// range.
+class BodyOffsetIndex {
+public:
+  struct Entry {
+    /// Offset of the owning declaration's start within the buffer.
+    unsigned DeclStartOffset;
+    /// Offsets of the body's braces (inclusive start, exclusive end).
+    unsigned BodyStartOffset;
+    unsigned BodyEndOffset;
+    /// Fingerprint of the body's tokens, or \c Fingerprint::ZERO() when the
+    /// parse did not compute one.
+    Fingerprint BodyHash;
+
+    bool operator==(const Entry &other) const {
+      return DeclStartOffset == other.DeclStartOffset &&
+             BodyStartOffset == other.BodyStartOffset &&
+             BodyEndOffset == other.BodyEndOffset && BodyHash == other.BodyHash;
+    }
+  };
+
+private:
+  /// Entries sorted by \c DeclStartOffset.
+  std::vector<Entry> Entries;
+
+public:
+  /// Collect body extents for every function-like declaration in \p SF.
+  static BodyOffsetIndex harvest(SourceFile &SF);
+
+  /// Append an entry. Entries must be added in increasing declaration
+  /// offset order.
+  void addEntry(const Entry &entry);
+
+  /// Find the entry for the declaration starting at \p DeclStartOffset, or
+  /// \c nullptr if none was recorded.
+  const Entry *lookup(unsigned DeclStartOffset) const;
+
+  llvm::ArrayRef<Entry> getEntries() const { return Entries; }
+
+  bool empty() const { return Entries.empty(); }
+
+  /// Write the index in its compact binary form.
+  void serialize(llvm::raw_ostream &OS) const;
+
+  /// Reconstruct an index from data produced by \c serialize. Returns
+  /// \c std::nullopt if the data is malformed or has an unsupported version.
+  static std::optional<BodyOffsetIndex> deserialize(llvm::StringRef Data);
+};
+
+} // end namespace swift
+
+#endif // SWIFT_PARSE_BODYOFFSETINDEX_H
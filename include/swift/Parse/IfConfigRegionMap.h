@@ -0,0 +1,77 @@
+//===--- IfConfigRegionMap.h - Cached #if region maps -----------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2026 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// An offset-based snapshot of a buffer's conditional-compilation regions,
+// together with a process-wide cache of such snapshots. Computing the
+// active/inactive #if clause ranges of a file requires parsing it; IDE
+// clients issue many syntactic requests against unchanged buffers, so the
+// snapshots are keyed by buffer contents and the conditional-compilation
+// configuration and shared across ASTContexts.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_PARSE_IFCONFIGREGIONMAP_H
+#define SWIFT_PARSE_IFCONFIGREGIONMAP_H
+
+#include "swift/AST/IfConfigClauseRangeInfo.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <memory>
+#include <vector>
+
+namespace swift {
+
+class LangOptions;
+class SourceManager;
+
+/// The #if clause regions of one buffer, stored as byte offsets so a
+/// snapshot remains valid for any identical buffer text regardless of which
+/// SourceManager it is loaded into.
+class IfConfigRegionMap {
+public:
+  struct Region {
+    /// Offset of the '#if', '#elseif', '#else', or '#endif' directive.
+    unsigned DirectiveOffset;
+    /// Offset at which the clause body starts.
+    unsigned BodyOffset;
+    /// Offset of the end of the clause body.
+    unsigned EndOffset;
+    IfConfigClauseRangeInfo::ClauseKind Kind;
+  };
+
+  /// Regions in source order.
+  std::vector<Region> Regions;
+
+  /// Rebind the offset-based regions to source locations within \p BufferID
+  /// of \p SM, appending the results to \p Ranges.
+  void materialize(const SourceManager &SM, unsigned BufferID,
+                   std::vector<IfConfigClauseRangeInfo> &Ranges) const;
+};
+
+/// A bounded, thread-safe, process-wide cache of \c IfConfigRegionMap
+/// snapshots keyed by buffer contents and conditional-compilation
+/// configuration.
+class IfConfigRegionCache {
+public:
+  /// Look up the snapshot for the given buffer text and configuration, or
+  /// nullptr if none is cached.
+  static std::shared_ptr<const IfConfigRegionMap>
+  lookup(llvm::StringRef bufferText, const LangOptions &langOpts);
+
+  /// Cache a snapshot for the given buffer text and configuration.
+  static void insert(llvm::StringRef bufferText, const LangOptions &langOpts,
+                     std::shared_ptr<const IfConfigRegionMap> map);
+};
+
+} // end namespace swift
+
+#endif // SWIFT_PARSE_IFCONFIGREGIONMAP_H
@@ -65,6 +65,48 @@ enum class LexerForwardSlashRegexMode {
   Always
 };
 
+/// Compact per-buffer storage for comment trivia skipped by the lexer.
+///
+/// When a consumer installs an arena via \c Lexer::setCommentTriviaArena, the
+/// lexer appends an (offset, length) record for every comment it skips in
+/// \c lexTrivia. Nothing is copied and no source ranges are formed at lex
+/// time; records are materialized into ranges or text only when a consumer
+/// asks. When no arena is installed — the normal compile path with
+/// \c CommentRetentionMode::None — the lexer does no trivia bookkeeping at
+/// all.
+class TriviaArena {
+public:
+  struct CommentRecord {
+    /// Byte offset of the comment's first character within the buffer.
+    unsigned Offset;
+    /// Length of the comment in bytes, including the terminating "*/" for
+    /// block comments but not the newline ending a "//" comment.
+    unsigned Length;
+  };
+
+private:
+  SmallVector<CommentRecord, 16> Records;
+
+public:
+  void record(unsigned Offset, unsigned Length) {
+    Records.push_back({Offset, Length});
+  }
+
+  ArrayRef<CommentRecord> getRecords() const { return Records; }
+  bool empty() const { return Records.empty(); }
+  size_t size() const { return Records.size(); }
+  void clear() { Records.clear(); }
+
+  /// Materialize the \p Index-th record as a source range in \p BufferID.
+  CharSourceRange materializeRange(const SourceManager &SM, unsigned BufferID,
+                                   size_t Index) const;
+
+  /// Materialize the \p Index-th record as the comment's text. The returned
+  /// string points into the source buffer owned by \p SM.
+  StringRef materializeText(const SourceManager &SM, unsigned BufferID,
+                            size_t Index) const;
+};
+
 /// Kinds of conflict marker which the lexer might encounter.
 enum class ConflictMarkerKind {
   /// A normal or diff3 conflict marker, initiated by at least 7 "<"s,
@@ -129,6 +171,15 @@ class Lexer {
   /// in a SIL file.  This enables some context-sensitive lexing.
   bool InSILBody = false;
 
+  /// True if the whole buffer was validated as well-formed UTF-8 up front,
+  /// which lets comment skipping avoid re-validating every non-ASCII scalar.
+  bool BufferIsKnownWellFormedUTF8 = false;
+
+  /// If non-null, every comment skipped as trivia is recorded here as an
+  /// (offset, length) pair. Null in the normal compile path, where trivia is
+  /// discarded without any bookkeeping.
+  TriviaArena *CommentTriviaArena = nullptr;
+
   /// The location at which the comment of the next token starts. \c nullptr if
   /// the next token doesn't have a comment.
   const char *CommentStart;
@@ -261,6 +312,11 @@ public:
     return RetainComments == CommentRetentionMode::ReturnAsTokens;
   }
 
+  /// Install an arena that records an (offset, length) pair for every comment
+  /// skipped as trivia, or pass null to stop recording. The arena must outlive
+  /// the lexer's use of it.
+  void setCommentTriviaArena(TriviaArena *Arena) { CommentTriviaArena = Arena; }
+
   unsigned getBufferID() const { return BufferID; }
 
   /// peekNextToken - Return the next token to be returned by Lex without
@@ -18,6 +18,10 @@
 #define SWIFT_PARSE_PERSISTENTPARSERSTATE_H
 
 #include "swift/Basic/SourceLoc.h"
+#include "llvm/ADT/ArrayRef.h"
+
+#include <optional>
+#include <vector>
 
 namespace swift {
 
@@ -47,10 +51,26 @@ public:
         EndOffset(EndOffset), PrevOffset(PrevOffset) {}
 };
 
+/// A single textual edit applied to a source buffer, described in byte
+/// offsets of the pre-edit buffer.
+struct SourceFileEdit {
+  /// The offset at which the replaced region starts.
+  unsigned Offset;
+  /// The length of the replaced region in the pre-edit buffer.
+  unsigned OldLength;
+  /// The length of the replacement text.
+  unsigned NewLength;
+};
+
 /// Parser state persistent across multiple parses.
 class PersistentParserState {
   std::unique_ptr<IDEInspectionDelayedDeclState> IDEInspectionDelayedDeclStat;
 
+  /// Byte ranges (begin/end offsets) of the top-level items produced by the
+  /// previous parse, in source order. Used to bound re-parsing to the items
+  /// overlapping an edited region.
+  std::vector<std::pair<unsigned, unsigned>> TopLevelItemRanges;
+
 public:
   PersistentParserState();
   PersistentParserState(ASTContext &ctx) : PersistentParserState() { }
@@ -81,6 +101,35 @@ public:
     assert(hasIDEInspectionDelayedDeclState());
     return std::move(IDEInspectionDelayedDeclStat);
   }
+
+  /// Record the byte range of a top-level item from the most recent parse.
+  /// Ranges must be recorded in source order.
+  void recordTopLevelItemRange(unsigned StartOffset, unsigned EndOffset);
+
+  /// Drop all recorded top-level item ranges, e.g. when the previous parse
+  /// is no longer representative of the buffer.
+  void clearTopLevelItemRanges() { TopLevelItemRanges.clear(); }
+
+  bool hasTopLevelItemRanges() const { return !TopLevelItemRanges.empty(); }
+
+  llvm::ArrayRef<std::pair<unsigned, unsigned>> getTopLevelItemRanges() const {
+    return TopLevelItemRanges;
+  }
+
+  /// Compute the pre-edit byte range that must be re-parsed for \p Edit,
+  /// extended outward to the boundaries of the recorded top-level items it
+  /// overlaps. Items entirely outside the returned range can be reused after
+  /// shifting by the edit's length delta.
+  ///
+  /// Returns \c std::nullopt if no ranges have been recorded, in which case
+  /// the caller must re-parse the whole buffer.
+  std::optional<std::pair<unsigned, unsigned>>
+  computeDamagedRegion(const SourceFileEdit &Edit) const;
+
+  /// Update the recorded item ranges for \p Edit: ranges overlapping the
+  /// damaged region are dropped (their replacements are re-recorded by the
+  /// next partial parse) and later ranges are shifted by the length delta.
+  void applyEdit(const SourceFileEdit &Edit);
 };
 
 } // end namespace swift
@@ -21,6 +21,10 @@
 #include "swift/SwiftRemoteMirror/MemoryReaderInterface.h"
 #include "swift/Remote/MemoryReader.h"
 
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
 struct MemoryReaderImpl {
   uint8_t PointerSize;
 
@@ -42,6 +46,19 @@ namespace remote {
 class CMemoryReader final : public MemoryReader {
   MemoryReaderImpl Impl;
 
+  // Read-through cache of remote memory, keyed by page-aligned address.
+  // Metadata walks touch the same pages over and over, and each readBytes
+  // callback is potentially a syscall round trip into the remote process;
+  // serving repeat reads from cached pages is what keeps a heap walk of a
+  // large process from being dominated by those round trips. The reflection
+  // stack already assumes the target is quiescent while it is inspected (the
+  // surrounding caches in ReflectionContext are never invalidated either), so
+  // cached pages are not invalidated. The cache stops growing at
+  // MaxCachedPages rather than evicting.
+  static constexpr uint64_t CachePageSize = 4096;
+  static constexpr size_t MaxCachedPages = 4096; // 16MB
+  std::unordered_map<uint64_t, std::unique_ptr<uint8_t[]>> PageCache;
+
   // Check to see if an address has bits outside the ptrauth mask. This suggests
   // that we're likely failing to strip a signed pointer when reading from it.
   bool hasSignatureBits(RemoteAddress address) {
@@ -50,6 +67,44 @@ class CMemoryReader final : public MemoryReader {
     return addressData != (addressData & mask);
   }
 
+  /// Read a range through the callback, bypassing the page cache.
+  ReadBytesResult readBytesUncached(RemoteAddress address, uint64_t size) {
+    void *FreeContext;
+    auto Ptr = Impl.readBytes(Impl.reader_context, address.getRawAddress(),
+                              size, &FreeContext);
+
+    auto Free = Impl.free;
+    if (Free == nullptr)
+      return ReadBytesResult(Ptr, [](const void *) {});
+
+    auto ReaderContext = Impl.reader_context;
+    auto freeLambda = [=](const void *Ptr) {
+      Free(ReaderContext, Ptr, FreeContext);
+    };
+    return ReadBytesResult(Ptr, freeLambda);
+  }
+
+  /// Returns the cached page starting at the page-aligned address \p pageAddr,
+  /// filling it through the callback on a miss. Returns NULL if the page
+  /// cannot be read or the cache has reached its size cap.
+  const uint8_t *getCachedPage(uint64_t pageAddr) {
+    auto It = PageCache.find(pageAddr);
+    if (It != PageCache.end())
+      return It->second.get();
+    if (PageCache.size() >= MaxCachedPages)
+      return nullptr;
+
+    auto Buf = readBytesUncached(
+        RemoteAddress(pageAddr, RemoteAddress::DefaultAddressSpace),
+        CachePageSize);
+    if (!Buf)
+      return nullptr;
+
+    auto Page = std::make_unique<uint8_t[]>(CachePageSize);
+    memcpy(Page.get(), Buf.get(), CachePageSize);
+    return PageCache.emplace(pageAddr, std::move(Page)).first->second.get();
+  }
+
 public:
   CMemoryReader(MemoryReaderImpl Impl) : Impl(Impl) {
     assert(this->Impl.queryDataLayout && "No queryDataLayout implementation");
@@ -95,19 +150,38 @@ public:
 
   ReadBytesResult readBytes(RemoteAddress address, uint64_t size) override {
     assert(!hasSignatureBits(address));
-    void *FreeContext;
-    auto Ptr = Impl.readBytes(Impl.reader_context, address.getRawAddress(),
-                              size, &FreeContext);
+    // Only small reads go through the page cache; bulk reads (e.g. whole
+    // reflection sections) would churn it without ever being re-read.
+    if (size == 0 || size > CachePageSize ||
+        address.getAddressSpace() != RemoteAddress::DefaultAddressSpace)
+      return readBytesUncached(address, size);
 
-    auto Free = Impl.free;
-    if (Free == nullptr)
-      return ReadBytesResult(Ptr, [](const void *) {});
+    auto *Buf = static_cast<uint8_t *>(malloc(size));
+    if (!Buf)
+      return ReadBytesResult();
+
+    uint64_t addr = address.getRawAddress();
+    uint64_t copied = 0;
+    while (copied < size) {
+      uint64_t pageAddr = (addr + copied) & ~(CachePageSize - 1);
+      const uint8_t *Page = getCachedPage(pageAddr);
+      if (!Page)
+        break;
+      uint64_t offset = (addr + copied) - pageAddr;
+      uint64_t chunk = std::min(size - copied, CachePageSize - offset);
+      memcpy(Buf + copied, Page + offset, chunk);
+      copied += chunk;
+    }
+    if (copied < size) {
+      // A page-granular fill can fail where the exact range would succeed,
+      // e.g. against a reader backed by byte-granular captured ranges, so
+      // retry uncached before reporting failure.
+      free(Buf);
+      return readBytesUncached(address, size);
+    }
 
-    auto ReaderContext = Impl.reader_context;
-    auto freeLambda = [=](const void *Ptr) {
-      Free(ReaderContext, Ptr, FreeContext);
-    };
-    return ReadBytesResult(Ptr, freeLambda);
+    return ReadBytesResult(
+        Buf, [](const void *ptr) { free(const_cast<void *>(ptr)); });
   }
 };
 } // namespace remote
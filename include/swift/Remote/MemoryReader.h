@@ -230,6 +230,28 @@ public:
     return true;
   }
   
+  /// A single range in a scatter-gather read. On return from
+  /// readBytesScattered, \c success records whether this range was read.
+  struct ReadRangeRequest {
+    RemoteAddress address;
+    uint8_t *dest;
+    uint64_t size;
+    bool success;
+  };
+
+  /// Attempts to read each of the given ranges from the remote process,
+  /// recording success or failure per range.
+  ///
+  /// The default implementation issues one readBytes per range. Readers that
+  /// reach the remote process over a transport with per-request round-trip
+  /// costs should override this to flush all the ranges in one batched
+  /// request.
+  virtual void readBytesScattered(ReadRangeRequest *requests, size_t count) {
+    for (size_t i = 0; i < count; ++i)
+      requests[i].success =
+          readBytes(requests[i].address, requests[i].dest, requests[i].size);
+  }
+
   /// Attempts to resolve a pointer value read from the given remote address.
   virtual RemoteAbsolutePointer resolvePointer(RemoteAddress address,
                                                uint64_t readValue) {
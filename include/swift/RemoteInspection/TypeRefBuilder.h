@@ -473,6 +473,16 @@ public:
     }
   };
 
+  /// The reflection section groups dumpAllSections emits, in output order.
+  enum class DumpSection {
+    FieldDescriptors,
+    AssociatedTypes,
+    BuiltinTypes,
+    CaptureDescriptors,
+    Conformances,
+    MultiPayloadEnums,
+  };
+
   /// The default descriptor finder implementation that find descriptors from
   /// reflection metadata.
   struct ReflectionTypeDescriptorFinder
@@ -830,32 +840,51 @@ public:
 
     template <template <typename Runtime> class ObjCInteropKind,
               unsigned PointerSize>
-    void dumpAllSections(std::ostream &stream) {
-      stream << "FIELDS:\n";
-      stream << "=======\n";
-      dumpFieldSection(stream);
-      stream << "\n";
-      stream << "ASSOCIATED TYPES:\n";
-      stream << "=================\n";
-      dumpAssociatedTypeSection<ObjCInteropKind, PointerSize>(stream);
-      stream << "\n";
-      stream << "BUILTIN TYPES:\n";
-      stream << "==============\n";
-      dumpBuiltinTypeSection(stream);
-      stream << "\n";
-      stream << "CAPTURE DESCRIPTORS:\n";
-      stream << "====================\n";
-      dumpCaptureSection(stream);
-      stream << "\n";
-      stream << "CONFORMANCES:\n";
-      stream << "=============\n";
-      dumpConformanceSection<ObjCInteropKind, PointerSize>(stream);
-      stream << "\n";
-      stream << "MULTI-PAYLOAD ENUM DESCRIPTORS:\n";
-      stream << "===============================\n";
-      dumpMultiPayloadEnumSection(stream);
+    void dumpSection(DumpSection section, std::ostream &stream) {
+      switch (section) {
+      case DumpSection::FieldDescriptors:
+        stream << "FIELDS:\n";
+        stream << "=======\n";
+        dumpFieldSection(stream);
+        break;
+      case DumpSection::AssociatedTypes:
+        stream << "ASSOCIATED TYPES:\n";
+        stream << "=================\n";
+        dumpAssociatedTypeSection<ObjCInteropKind, PointerSize>(stream);
+        break;
+      case DumpSection::BuiltinTypes:
+        stream << "BUILTIN TYPES:\n";
+        stream << "==============\n";
+        dumpBuiltinTypeSection(stream);
+        break;
+      case DumpSection::CaptureDescriptors:
+        stream << "CAPTURE DESCRIPTORS:\n";
+        stream << "====================\n";
+        dumpCaptureSection(stream);
+        break;
+      case DumpSection::Conformances:
+        stream << "CONFORMANCES:\n";
+        stream << "=============\n";
+        dumpConformanceSection<ObjCInteropKind, PointerSize>(stream);
+        break;
+      case DumpSection::MultiPayloadEnums:
+        stream << "MULTI-PAYLOAD ENUM DESCRIPTORS:\n";
+        stream << "===============================\n";
+        dumpMultiPayloadEnumSection(stream);
+        break;
+      }
       stream << "\n";
     }
+
+    template <template <typename Runtime> class ObjCInteropKind,
+              unsigned PointerSize>
+    void dumpAllSections(std::ostream &stream) {
+      for (auto section :
+           {DumpSection::FieldDescriptors, DumpSection::AssociatedTypes,
+            DumpSection::BuiltinTypes, DumpSection::CaptureDescriptors,
+            DumpSection::Conformances, DumpSection::MultiPayloadEnums})
+        dumpSection<ObjCInteropKind, PointerSize>(section, stream);
+    }
   };
   friend struct ReflectionTypeDescriptorFinder;
 
@@ -2434,6 +2463,11 @@ public:
   ConformanceCollectionResult collectAllConformances() {
     return RDF.collectAllConformances<ObjCInteropKind, PointerSize>();
   }
+  template <template <typename Runtime> class ObjCInteropKind,
+            unsigned PointerSize>
+  void dumpSection(DumpSection section, std::ostream &stream) {
+    RDF.dumpSection<ObjCInteropKind, PointerSize>(section, stream);
+  }
   template <template <typename Runtime> class ObjCInteropKind,
             unsigned PointerSize>
   void dumpAllSections(std::ostream &stream) {
@@ -77,8 +77,7 @@ public:
 };
 
 class SILBasicBlock :
-public llvm::ilist_node<SILBasicBlock>, public SILAllocated<SILBasicBlock>,
-public SwiftObjectHeader {
+public llvm::ilist_node<SILBasicBlock>, public SwiftObjectHeader {
   friend class SILSuccessor;
   friend class SILFunction;
   friend class SILGlobalVariable;
@@ -145,6 +144,11 @@ private:
   void operator=(const SILBasicBlock &) = delete;
   void operator delete(void *Ptr, size_t) = delete;
 
+  /// Blocks are malloc'ed through the module (and not placed into the
+  /// module's bump allocator) so that erasing a block - or deleting a whole
+  /// function - returns its memory; see SILModule::flushDeletedInsts().
+  void *operator new(size_t Bytes, SILModule &M);
+
 public:
   static void registerBridgedMetatype(SwiftMetatype metatype) {
     registeredMetatype = metatype;
@@ -152,6 +156,13 @@ public:
 
   ~SILBasicBlock();
 
+  /// Destroys \p BB and schedules its memory for being freed in
+  /// SILModule::flushDeletedInsts().
+  ///
+  /// This is called by the ilist traits when the block is removed from its
+  /// function's block list and must not be called directly.
+  static void deleteBlock(SILBasicBlock *BB);
+
   enum { numCustomBits = std::numeric_limits<CustomBitsType>::digits };
 
   constexpr static const uint64_t maxBitfieldID =
@@ -624,7 +635,9 @@ private:
   using block_iterator = simple_ilist<SILBasicBlock>::iterator;
 
 public:
-  static void deleteNode(SILBasicBlock *BB) { BB->~SILBasicBlock(); }
+  static void deleteNode(SILBasicBlock *BB) {
+    SILBasicBlock::deleteBlock(BB);
+  }
 
   void transferNodesFromList(ilist_traits<SILBasicBlock> &SrcTraits,
                              block_iterator First, block_iterator Last);
@@ -220,6 +220,12 @@ private:
   /// that analysis caches are invalidated before flushDeletedInsts().
   std::vector<SILInstruction*> scheduledForDeletion;
 
+  /// The memory of basic blocks which are removed from their function's block
+  /// list. Like deleted instructions (see scheduledForDeletion), the memory is
+  /// freed for real in flushDeletedInsts(), because block pointers can still
+  /// be stored in analysis caches until then.
+  std::vector<void *> scheduledBlockMemory;
+
   /// The swift Module associated with this SILModule.
   ModuleDecl *TheSwiftModule;
 
@@ -1095,6 +1101,13 @@ public:
   /// Allocate memory for an instruction using the module's internal allocator.
   void *allocateInst(unsigned Size, unsigned Align) const;
 
+  /// Allocate memory for a basic block using the module's internal allocator.
+  void *allocateBlock(unsigned Size, unsigned Align) const;
+
+  /// Schedules the memory of the (already destructed) basic block \p BB for
+  /// being freed in flushDeletedInsts().
+  void deallocateBlock(SILBasicBlock *BB);
+
   /// Called before \p I is removed from its basic block and scheduled for
   /// deletion.
   void willDeleteInstruction(SILInstruction *I);
@@ -1108,7 +1121,9 @@ public:
   void flushDeletedInsts();
 
   bool hasInstructionsScheduledForDeletion() const {
-    return !scheduledForDeletion.empty();
+    // Removed blocks are flushed together with deleted instructions and also
+    // indicate that the SIL of a function has changed.
+    return !scheduledForDeletion.empty() || !scheduledBlockMemory.empty();
   }
 
   /// Looks up the llvm intrinsic ID and type for the builtin function.
@@ -19,6 +19,8 @@
 #include "swift/SILOptimizer/PassManager/PassPipeline.h"
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/Chrono.h"
@@ -198,6 +200,21 @@ class SILPassManager {
   /// A completed-passes mask for each function.
   llvm::DenseMap<SILFunction *, CompletedPasses> CompletedPassesMap;
 
+  /// The flattened bottom-up function order used to seed the function pass
+  /// worklist, cached across pipeline segments. Computing the order walks
+  /// the entire call graph, so it is only recomputed after a change that
+  /// can affect the set of functions or the call graph structure.
+  std::vector<SILFunction *> CachedBottomUpFunctionOrder;
+
+  /// Whether \c CachedBottomUpFunctionOrder is up to date.
+  bool BottomUpFunctionOrderIsValid = false;
+
+  /// Drops the cached bottom-up function order.
+  void invalidateBottomUpFunctionOrder() {
+    CachedBottomUpFunctionOrder.clear();
+    BottomUpFunctionOrderIsValid = false;
+  }
+
   /// Stores for each function the number of levels of specializations it is
   /// derived from an original function. E.g. if a function is a signature
   /// optimized specialization of a generic specialization, it has level 2.
@@ -208,6 +225,19 @@ class SILPassManager {
   /// Set to true when a pass invalidates an analysis.
   bool CurrentPassHasInvalidated = false;
 
+  /// The functions for which the current pass reported an invalidation.
+  ///
+  /// This lets runModulePass verify only the functions a module pass
+  /// actually changed instead of re-verifying the whole module. Cleared
+  /// when a module pass starts.
+  llvm::SmallPtrSet<SILFunction *, 16> FunctionsInvalidatedByCurrentPass;
+
+  /// Set to true when the current pass reported a module-wide invalidation,
+  /// e.g. a change of witness- or vtables. Per-function invalidation
+  /// tracking is insufficient in this case and the whole module is
+  /// verified.
+  bool CurrentPassInvalidatedWholeModule = false;
+
   bool currentPassDependsOnCalleeBodies = false;
 
   /// True if we need to stop running passes and restart again on the
@@ -228,6 +258,19 @@ class SILPassManager {
 
   std::chrono::nanoseconds totalPassRuntime = std::chrono::nanoseconds(0);
 
+  /// Accumulated runtime and number of runs per pass tag, collected when
+  /// -sil-pass-times-json is given and appended to the file in the
+  /// destructor.
+  llvm::StringMap<std::pair<std::chrono::nanoseconds, unsigned>> passRuntimes;
+
+  /// The tag of the most recently executed pass, for -sil-pass-times-json.
+  /// Together with -sil-opt-pass-count this identifies the pass at a
+  /// pipeline prefix boundary.
+  StringRef lastRunPassTag;
+
+  /// Appends the contents of \p passRuntimes to -sil-pass-times-json.
+  void appendPassTimesJSON();
+
 public:
   /// C'tor. It creates and registers all analysis passes, which are defined
   /// in Analysis.def.
@@ -280,9 +323,11 @@ public:
         AP->invalidate();
 
     CurrentPassHasInvalidated = true;
+    CurrentPassInvalidatedWholeModule = true;
 
     // Assume that all functions have changed. Clear all masks of all functions.
     CompletedPassesMap.clear();
+    invalidateBottomUpFunctionOrder();
   }
 
   /// Notify the pass manager of a newly create function for tracing.
@@ -303,6 +348,8 @@ public:
     for (auto AP : Analyses) {
       AP->notifyAddedOrModifiedFunction(F);
     }
+    FunctionsInvalidatedByCurrentPass.insert(F);
+    invalidateBottomUpFunctionOrder();
   }
 
   /// Broadcast the invalidation of the function to all analysis.
@@ -312,10 +359,16 @@ public:
     for (auto AP : Analyses)
       if (!AP->isLocked())
         AP->invalidate(F, K);
-    
+
     CurrentPassHasInvalidated = true;
+    FunctionsInvalidatedByCurrentPass.insert(F);
     // Any change let all passes run again.
     CompletedPassesMap[F].reset();
+
+    // Only a change to the call graph structure affects the bottom-up
+    // function order.
+    if (K & SILAnalysis::InvalidationKind::Calls)
+      invalidateBottomUpFunctionOrder();
   }
 
   /// Iterate over all analysis and notify them of a change in witness-
@@ -327,9 +380,11 @@ public:
         AP->invalidateFunctionTables();
 
     CurrentPassHasInvalidated = true;
+    CurrentPassInvalidatedWholeModule = true;
 
     // Assume that all functions have changed. Clear all masks of all functions.
     CompletedPassesMap.clear();
+    invalidateBottomUpFunctionOrder();
   }
 
   /// Iterate over all analysis and notify them of a deleted function.
@@ -340,8 +395,13 @@ public:
         AP->notifyWillDeleteFunction(F);
 
     CurrentPassHasInvalidated = true;
+    // The function is about to go away and must not be verified anymore.
+    FunctionsInvalidatedByCurrentPass.erase(F);
     // Any change let all passes run again.
     CompletedPassesMap[F].reset();
+
+    // The cached order would be left holding a dangling function pointer.
+    invalidateBottomUpFunctionOrder();
   }
 
   void setDependingOnCalleeBodies() {
@@ -21,7 +21,10 @@
 #include "swift/AST/Type.h"
 #include "swift/AST/Types.h"
 #include "swift/Sema/Constraint.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/ilist.h"
+#include <memory>
+#include <utility>
 #include <vector>
 
 namespace llvm {
@@ -267,6 +270,23 @@ public:
     void dump(llvm::raw_ostream &out, ConstraintSystem &cs,
               unsigned indent = 0) const;
 
+    /// The maximum number of bytes a single encoded change record can
+    /// occupy, including its tag and trailing length byte.
+    static constexpr unsigned MaxEncodedSize = 40;
+
+    /// Encode this change into \p buffer as a variable-length tagged
+    /// record, returning the number of bytes written. \p buffer must have
+    /// room for at least \c MaxEncodedSize bytes.
+    unsigned encode(char *buffer) const;
+
+    /// Decode the record that begins at \p bytes, advancing \p bytes past
+    /// the end of the record.
+    static Change decode(const char *&bytes);
+
+    /// Decode the record that ends just before \p end, returning the
+    /// change together with the total number of bytes it occupies.
+    static std::pair<Change, unsigned> decodeLast(const char *end);
+
   private:
     SyntacticElementTargetKey getSyntacticElementTargetKey() const;
   };
@@ -287,7 +307,7 @@ public:
                               unsigned indent = 0) const;
 
   unsigned size() const {
-    return Changes.size();
+    return NumChanges;
   }
 
   void undo(unsigned toIndex);
@@ -299,8 +319,28 @@ public:
 private:
   ConstraintSystem &CS;
 
-  /// The list of changes made to this constraint system.
-  std::vector<Change> Changes;
+  /// A fixed-size slab of encoded change records.
+  struct Slab {
+    std::unique_ptr<char[]> Bytes;
+    unsigned Used = 0;
+  };
+
+  /// The number of bytes in each slab.
+  static const unsigned SlabSize = 256 * 1024;
+
+  /// The changes made to this constraint system, encoded as variable-length
+  /// tagged records in a sequence of fixed-size slabs. Records never
+  /// straddle a slab boundary; a new slab is started once fewer than
+  /// \c Change::MaxEncodedSize bytes remain in the current one.
+  std::vector<Slab> Slabs;
+
+  /// The number of changes currently recorded.
+  unsigned NumChanges = 0;
+
+  /// Visit every change at index \p fromIndex or later, in the order the
+  /// changes were recorded.
+  void forEachChangeFrom(unsigned fromIndex,
+                         llvm::function_ref<void(const Change &)> body) const;
 
   uint64_t Profile[unsigned(ChangeKind::Last) + 1];
 
@@ -665,10 +665,14 @@ public:
     while (rep != rep->getImpl().Component.getPointer())
       rep = rep->getImpl().Component.getPointer();
 
-    // Path compression
-    if (rep != getTypeVariable()) {
-      const_cast<TypeVariableType::Implementation *>(this)
-          ->Component.setPointer(rep);
+    // Path compression: repoint every variable on the walk directly at the
+    // root, so subsequent queries anywhere along the chain are O(1) rather
+    // than re-walking the tail of it.
+    auto *typeVar = getTypeVariable();
+    while (typeVar != rep) {
+      auto *parent = typeVar->getImpl().Component.getPointer();
+      typeVar->getImpl().Component.setPointer(rep);
+      typeVar = parent;
     }
 
     return rep;
@@ -2205,8 +2209,24 @@ private:
 
   llvm::DenseMap<Expr *, std::pair<unsigned, Expr *>> ExprWeights;
 
+  /// Owns the slab allocator used for all of the related constraint systems.
+  /// On destruction — after the constraint graph and arena members, which may
+  /// still touch solver-allocated memory, have been torn down — the slabs are
+  /// bulk-reset and returned to the ASTContext's recycling pool instead of
+  /// going back to malloc.
+  class RecyclingAllocator {
+    ASTContext &Context;
+    llvm::BumpPtrAllocator Allocator;
+
+  public:
+    explicit RecyclingAllocator(ASTContext &ctx);
+    ~RecyclingAllocator();
+
+    operator llvm::BumpPtrAllocator &() { return Allocator; }
+  };
+
   /// Allocator used for all of the related constraint systems.
-  llvm::BumpPtrAllocator Allocator;
+  RecyclingAllocator Allocator;
 
   /// Arena used for memory management of constraint-checker-related
   /// allocations.
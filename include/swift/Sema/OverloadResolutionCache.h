@@ -0,0 +1,100 @@
+//===--- OverloadResolutionCache.h - Solver outcome memoization -*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2025 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// A cross-compilation memo of constraint-solver outcomes, keyed by a
+// fingerprint of the expression's source text, its position, the contextual
+// type it was solved against, and the configuration it was solved under.
+//
+// A full Solution cannot be persisted across compilations: its overload
+// choices and type bindings are ASTContext pointers that die with the
+// invocation. What can be reused safely is the solver's *verdict* for an
+// expression whose text and configuration have not changed. Today that is
+// the "too complex" verdict — an expression that exceeded the solver's
+// scope, memory, or time limits will do so again on every rebuild, and
+// re-proving that is the single most expensive way to rediscover yesterday's
+// answer. The cache stores those verdicts and lets the type checker fail
+// fast on re-encounter; callers that persist the cache to disk must fold an
+// imported-interface fingerprint into the expression fingerprint so that
+// verdicts are invalidated when dependencies change.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_SEMA_OVERLOADRESOLUTIONCACHE_H
+#define SWIFT_SEMA_OVERLOADRESOLUTIONCACHE_H
+
+#include "swift/Basic/Fingerprint.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/raw_ostream.h"
+#include <optional>
+#include <set>
+
+namespace swift {
+
+class LangOptions;
+
+namespace constraints {
+
+class OverloadResolutionCache {
+  /// Fingerprints of expressions known to exceed the solver's limits.
+  std::set<Fingerprint> TooComplexExprs;
+
+public:
+  /// Compute the fingerprint under which an expression's solver outcome is
+  /// cached. The key includes where the expression appears
+  /// (\p BufferIdentifier and \p Offset) and the contextual type it is
+  /// solved against (\p ContextualTypeText, empty when there is none):
+  /// textually identical expressions in different scopes or against
+  /// different contextual types can have entirely different solver
+  /// outcomes, so a verdict may only be replayed for a verbatim
+  /// re-type-check of the same expression in the same position.
+  /// \p ExtraDependencies should carry whatever the caller needs to
+  /// invalidate on — for an on-disk cache, the interface fingerprints of the
+  /// imported modules.
+  static Fingerprint
+  fingerprintExpression(llvm::StringRef ExprText, llvm::StringRef ModuleName,
+                        const LangOptions &LangOpts,
+                        llvm::StringRef BufferIdentifier, unsigned Offset,
+                        llvm::StringRef ContextualTypeText,
+                        llvm::StringRef ExtraDependencies = "");
+
+  bool isKnownTooComplex(const Fingerprint &FP) const {
+    return TooComplexExprs.count(FP) != 0;
+  }
+
+  void recordTooComplex(const Fingerprint &FP) { TooComplexExprs.insert(FP); }
+
+  size_t size() const { return TooComplexExprs.size(); }
+
+  /// Whether the process-wide shared cache has recorded \p FP as too
+  /// complex. Thread-safe.
+  static bool lookupSharedTooComplex(const Fingerprint &FP);
+
+  /// Record \p FP in the process-wide shared cache. Thread-safe.
+  static void recordSharedTooComplex(const Fingerprint &FP);
+
+  /// Whether the process-wide shared cache has any entries; cheap enough to
+  /// gate fingerprint computation on the common path.
+  static bool sharedCacheIsEmpty();
+
+  /// Serialize the cache into \p OS in a stable binary format.
+  void writeToStream(llvm::raw_ostream &OS) const;
+
+  /// Deserialize a cache previously written by \c writeToStream. Returns
+  /// \c std::nullopt if \p Buffer is malformed or has the wrong version.
+  static std::optional<OverloadResolutionCache>
+  readFromBuffer(llvm::StringRef Buffer);
+};
+
+} // namespace constraints
+} // namespace swift
+
+#endif // SWIFT_SEMA_OVERLOADRESOLUTIONCACHE_H
@@ -27,6 +27,8 @@ class MachOObjectFile;
 namespace swift {
 namespace static_mirror {
 
+class OnDiskTypeRefCache;
+
 using ReadBytesResult = swift::remote::MemoryReader::ReadBytesResult;
 
 class Image {
@@ -154,7 +156,7 @@ T unwrap(llvm::Expected<T> value) {
 
 std::unique_ptr<ReflectionContextHolder> makeReflectionContextForObjectFiles(
     const std::vector<const llvm::object::ObjectFile *> &objectFiles,
-    bool objcInterOp);
+    bool objcInterOp, OnDiskTypeRefCache *typeRefCache = nullptr);
 
 std::unique_ptr<ReflectionContextHolder> makeReflectionContextForMetadataReader(
     std::shared_ptr<ObjectMemoryReader> reader,
@@ -0,0 +1,99 @@
+//===--- OnDiskTypeRefCache.h - Persistent typeref cache --------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2025 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares an on-disk implementation of ExternalTypeRefCache for
+// tools that repeatedly inspect the same binaries.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_STATICMIRROR_ONDISKTYPEREFCACHE_H
+#define SWIFT_STATICMIRROR_ONDISKTYPEREFCACHE_H
+
+#include "swift/Remote/ExternalTypeRefCache.h"
+#include "llvm/ADT/StringMap.h"
+
+#include <string>
+#include <vector>
+
+namespace llvm {
+namespace object {
+class ObjectFile;
+} // namespace object
+} // namespace llvm
+
+namespace swift {
+namespace static_mirror {
+
+/// A persistent ExternalTypeRefCache backed by one file per image in a cache
+/// directory, keyed by the image's build UUID.
+///
+/// Scanning a field section means demangling every descriptor's mangled name,
+/// which dominates repeated runs of swift-reflection-dump against the same
+/// binaries. For images whose UUID already has a cache file, the decoded
+/// name-to-descriptor-offset table is mapped in and the section scan is
+/// skipped entirely; TypeRefBuilder re-validates each descriptor it pulls
+/// through a cached locator, so a stale file degrades to a miss rather than a
+/// wrong answer. Images scanned for the first time have their tables written
+/// back to the directory when the cache is destroyed.
+///
+/// The cache files are host-endian and are only meant to be read on the
+/// machine that wrote them.
+class OnDiskTypeRefCache final : public remote::ExternalTypeRefCache {
+  struct ImageEntry {
+    /// Lower-case hex build UUID; empty if the image has none, in which case
+    /// it is not cached.
+    std::string UUID;
+
+    /// Normalized mangled name to offset in the image's field section.
+    llvm::StringMap<uint64_t> Locators;
+
+    bool LoadedFromDisk = false;
+    bool NeedsWrite = false;
+  };
+
+  std::string CacheDir;
+
+  /// Indexed by reflection info ID.
+  std::vector<ImageEntry> Images;
+
+  ImageEntry *getImage(uint64_t InfoID) {
+    return InfoID < Images.size() ? &Images[InfoID] : nullptr;
+  }
+
+  bool loadImage(ImageEntry &Entry);
+  void writeImage(const ImageEntry &Entry);
+
+public:
+  explicit OnDiskTypeRefCache(llvm::StringRef cacheDir)
+      : CacheDir(cacheDir) {}
+
+  /// Writes back the tables of any images scanned this session.
+  ~OnDiskTypeRefCache() override;
+
+  /// Associate the reflection info \p InfoID with \p O, loading the cached
+  /// table for its build UUID if one exists.
+  void registerImage(uint64_t InfoID, const llvm::object::ObjectFile *O);
+
+  void cacheFieldDescriptors(uint64_t InfoID,
+                             const reflection::FieldSection &FieldDescriptors,
+                             llvm::ArrayRef<std::string> MangledNames) override;
+
+  std::optional<remote::FieldDescriptorLocator>
+  getFieldDescriptorLocator(const std::string &Name) override;
+
+  bool isReflectionInfoCached(uint64_t InfoID) override;
+};
+
+} // end namespace static_mirror
+} // end namespace swift
+
+#endif // SWIFT_STATICMIRROR_ONDISKTYPEREFCACHE_H
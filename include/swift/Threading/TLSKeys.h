@@ -22,6 +22,7 @@ enum class tls_key {
   concurrency_task,
   concurrency_executor_tracking_info,
   concurrency_fallback,
+  concurrency_slab_cache,
   observation_transaction
 };
 
@@ -2515,7 +2515,8 @@ void SwiftDeclCollector::deSerialize(StringRef Filename) {
 void SwiftDeclCollector::serialize(llvm::raw_ostream &os, SDKNode *Root,
                                    PayLoad OtherInfo) {
   std::error_code EC;
-  json::Output yout(os);
+  json::Output yout(os, /*UserInfo=*/{},
+                    /*PrettyPrint=*/!Root->getSDKContext().getOpts().CompactJSON);
   assert(Root->getKind() == SDKNodeKind::Root);
   SDKNodeRoot &root = *static_cast<SDKNodeRoot*>(Root);
   yout.beginObject();
@@ -679,6 +679,11 @@ struct ASTContext::Implementation {
   /// The current constraint solver arena, if any.
   std::unique_ptr<ConstraintSolverArena> CurrentConstraintSolverArena;
 
+  /// Slab allocators recycled from destroyed constraint systems, kept warm
+  /// so that the next expression's constraint system doesn't start by going
+  /// back to malloc.
+  llvm::SmallVector<llvm::BumpPtrAllocator, 2> RecycledSolverAllocators;
+
   Arena &getArena(AllocationArena arena) {
     switch (arena) {
     case AllocationArena::Permanent:
@@ -730,6 +735,30 @@ ASTContext::Implementation::~Implementation() {
     cleanup();
 }
 
+llvm::BumpPtrAllocator ASTContext::takeConstraintSolverMemory() {
+  auto &pool = getImpl().RecycledSolverAllocators;
+  if (pool.empty())
+    return llvm::BumpPtrAllocator();
+  auto allocator = std::move(pool.back());
+  pool.pop_back();
+  return allocator;
+}
+
+void ASTContext::recycleConstraintSolverMemory(
+    llvm::BumpPtrAllocator &&allocator) {
+  // Keep the pool small; nested constraint systems mean more than one
+  // allocator can be retired before the next one is taken, but deep nesting
+  // is rare and pooling every slab would just hoard memory.
+  const unsigned MaxPooledAllocators = 4;
+
+  // Reset frees all but the first slab, so a pooled allocator holds on to a
+  // bounded amount of memory while keeping its warm slab.
+  allocator.Reset();
+  auto &pool = getImpl().RecycledSolverAllocators;
+  if (pool.size() < MaxPooledAllocators)
+    pool.push_back(std::move(allocator));
+}
+
 ConstraintCheckerArenaRAII::
 ConstraintCheckerArenaRAII(ASTContext &self, llvm::BumpPtrAllocator &allocator)
   : Self(self), Data(self.getImpl().CurrentConstraintSolverArena.release())
@@ -913,6 +942,11 @@ void ASTContext::Implementation::dump(llvm::raw_ostream &os) const {
 }
 
 ASTContext::~ASTContext() {
+  if (Stats) {
+    Stats->setASTArenaBytesCallback(nullptr);
+    Stats->setSolverArenaBytesCallback(nullptr);
+  }
+
   if (LangOpts.AnalyzeRequestEvaluator) {
     evaluator.dump(llvm::dbgs());
     getImpl().dump(llvm::dbgs());
@@ -971,6 +1005,14 @@ void ASTContext::setStatsReporter(UnifiedStatsReporter *stats) {
   stats->getFrontendCounters().NumASTBytesAllocated =
       getAllocator().getBytesAllocated();
 
+  // Attribute arena memory to phases: these run at every tracer boundary,
+  // so they only read the allocators' bookkeeping rather than walking
+  // anything. Cleared again in ~ASTContext, since the reporter outlives us.
+  stats->setASTArenaBytesCallback(
+      [this] { return (int64_t)getImpl().Allocator.getBytesAllocated(); });
+  stats->setSolverArenaBytesCallback(
+      [this] { return (int64_t)getSolverMemory(); });
+
   if (stats->fineGrainedTimers())
     evaluator.setStatsReporter(stats);
 }
@@ -3306,6 +3348,7 @@ size_t ASTContext::getTotalMemory() const {
     // getImpl().NormalConformances ?
     // getImpl().SelfConformances ?
     // getImpl().AvailabilityContexts
+    evaluator.getTotalMemory() +
     getImpl().Permanent.getTotalMemory();
 
     Size += getSolverMemory();
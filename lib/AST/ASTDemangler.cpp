@@ -73,13 +73,27 @@ Decl *swift::Demangle::getDeclForUSR(ASTContext &ctx, StringRef usr,
 Type swift::Demangle::getTypeForMangling(ASTContext &ctx,
                                          StringRef mangling,
                                          GenericSignature genericSig) {
+  // Generic parameters resolve against the given signature, so only
+  // signature-free lookups can be served from the context-scoped cache.
+  bool canCache = genericSig.isNull();
+  if (canCache) {
+    auto known = ctx.DemangledTypeCache.find(mangling);
+    if (known != ctx.DemangledTypeCache.end())
+      return known->second;
+  }
+
   Demangle::Context Dem;
   auto node = Dem.demangleSymbolAsNode(mangling);
   if (!node)
     return Type();
 
   ASTBuilder builder(ctx, genericSig);
-  return builder.decodeMangledType(node);
+  auto type = builder.decodeMangledType(node);
+  // Don't cache failures: a mangling that doesn't resolve now may start
+  // resolving once further modules are loaded into this context.
+  if (canCache && type)
+    ctx.DemangledTypeCache[mangling] = type;
+  return type;
 }
 
 TypeDecl *swift::Demangle::getTypeDeclForMangling(ASTContext &ctx,
@@ -260,6 +260,24 @@ void ASTScope::expandFunctionBodyImpl(AbstractFunctionDecl *AFD) {
   impl->expandFunctionBody(AFD);
 }
 
+bool ASTScope::unexpandFunctionBody(AbstractFunctionDecl *AFD) {
+  if (!AFD)
+    return false;
+  auto *const SF = AFD->getParentSourceFile();
+  if (!SF)
+    return false;
+
+  // If the scope tree has not been built, there is nothing stale to drop.
+  if (!SF->hasScope())
+    return true;
+
+  return SF->getScope().unexpandFunctionBodyImpl(AFD);
+}
+
+bool ASTScope::unexpandFunctionBodyImpl(AbstractFunctionDecl *AFD) {
+  return impl->unexpandFunctionBody(AFD);
+}
+
 ASTSourceFileScope *ASTScope::createScopeTree(SourceFile *SF) {
   ScopeCreator *scopeCreator = new (SF->getASTContext()) ScopeCreator(SF);
   return scopeCreator->sourceFileScope;
@@ -292,6 +310,37 @@ void ASTSourceFileScope::expandFunctionBody(AbstractFunctionDecl *AFD) {
     bodyScope->expandAndBeCurrent(*scopeCreator);
 }
 
+bool ASTSourceFileScope::unexpandFunctionBody(AbstractFunctionDecl *AFD) {
+  auto sr = AFD->getOriginalBodySourceRange();
+  if (sr.isInvalid())
+    return false;
+
+  // Walk down to the function body scope by containment, without expanding
+  // anything along the way. The body scope's own source range is the
+  // original body range, which is stable across body replacement.
+  auto *module = AFD->getParentModule();
+  auto &sourceMgr = getSourceManager();
+  ASTScopeImpl *scope = this;
+  while (true) {
+    if (auto *bodyScope = dyn_cast<FunctionBodyScope>(scope)) {
+      if (bodyScope->decl == AFD) {
+        bodyScope->unexpand();
+        return true;
+      }
+    }
+
+    // If a scope on the way down has not been expanded yet, the body scope
+    // does not exist, so there is nothing stale to drop.
+    if (!scope->getWasExpanded())
+      return true;
+
+    auto child = scope->findChildContaining(module, sr.Start, sourceMgr);
+    if (!child)
+      return false;
+    scope = child.get();
+  }
+}
+
 ASTSourceFileScope::ASTSourceFileScope(SourceFile *SF,
                                        ScopeCreator *scopeCreator)
     : ASTScopeImpl(ScopeKind::ASTSourceFile), SF(SF),
@@ -778,6 +827,15 @@ ASTScopeImpl *ASTScopeImpl::expandAndBeCurrent(ScopeCreator &scopeCreator) {
   return insertionPoint;
 }
 
+void ASTScopeImpl::unexpand() {
+  ASTScopeAssert(insertionPointForDeferredExpansion().isNonNull(),
+                 "Can only unexpand a scope that supports deferred "
+                 "expansion; other scopes cannot be expanded again");
+  storedChildren.clear();
+  cachedCharSourceRange = std::nullopt;
+  parentAndWasExpanded.setInt(0);
+}
+
   // Do this whole bit so it's easy to see which type of scope is which
 
 #define CREATES_NEW_INSERTION_POINT(Scope)                                     \
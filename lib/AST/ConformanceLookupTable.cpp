@@ -512,6 +512,9 @@ bool ConformanceLookupTable::addProtocol(ProtocolDecl *protocol, SourceLoc loc,
   // context.
   AllConformances[dc].push_back(entry);
 
+  // The new entry invalidates any memoized lookup result for this protocol.
+  LookupCache.erase(protocol);
+
   return true;
 }
 
@@ -1055,6 +1058,7 @@ void ConformanceLookupTable::registerProtocolConformance(
              entry->getConformance() == conformance &&
              "Mismatched conformances");
       entry->Conformance = conformance;
+      LookupCache.erase(protocol);
       return;
     }
   }
@@ -1079,6 +1083,9 @@ void ConformanceLookupTable::registerProtocolConformance(
   // Record this as a conformance within the given declaration
   // context.
   dcConformances.push_back(entry);
+
+  // The new entry invalidates any memoized lookup result for this protocol.
+  LookupCache.erase(protocol);
 }
 
 bool ConformanceLookupTable::lookupConformance(
@@ -1088,6 +1095,15 @@ bool ConformanceLookupTable::lookupConformance(
   // Update to record all explicit and inherited conformances.
   updateLookupTable(nominal, ConformanceStage::Inherited);
 
+  // If we have a memoized result for this protocol, use it. The stage
+  // update above has already recorded (and thereby invalidated the cache
+  // for) any conformances from newly-visible extensions.
+  auto cached = LookupCache.find(protocol);
+  if (cached != LookupCache.end()) {
+    conformances.append(cached->second.begin(), cached->second.end());
+    return !cached->second.empty();
+  }
+
   // Look for conformances to this protocol.
   auto known = Conformances.find(protocol);
   if (known == Conformances.end()) {
@@ -1102,12 +1118,21 @@ bool ConformanceLookupTable::lookupConformance(
 
   // Resolve the conformances for this protocol.
   resolveConformances(protocol);
+  llvm::TinyPtrVector<ProtocolConformance *> result;
   for (auto entry : Conformances[protocol]) {
     if (auto conformance = getConformance(nominal, entry)) {
-      conformances.push_back(conformance);
+      result.push_back(conformance);
     }
   }
-  return !conformances.empty();
+
+  conformances.append(result.begin(), result.end());
+  if (result.empty())
+    return false;
+
+  // Memoize the resolved result. Negative results are not cached, since a
+  // later stage expansion could still introduce a conformance.
+  LookupCache[protocol] = std::move(result);
+  return true;
 }
 
 void ConformanceLookupTable::lookupConformances(
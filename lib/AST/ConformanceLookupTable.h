@@ -393,6 +393,19 @@ class ConformanceLookupTable : public ASTAllocated<ConformanceLookupTable> {
   /// The conformance table.
   ConformanceTable Conformances;
 
+  /// Memoized results of lookupConformance(), keyed by protocol.
+  ///
+  /// Hot queries from global conformance lookup hit the same protocol
+  /// repeatedly (e.g. once per specialization of this nominal type during
+  /// constraint solving); the cache answers them without re-running
+  /// conformance resolution. An entry is erased whenever a new conformance
+  /// entry is recorded for its protocol, which covers conformances
+  /// introduced by newly-visible extensions: those pass through
+  /// addProtocol() or registerProtocolConformance() during the stage
+  /// update performed before the cache is consulted.
+  llvm::DenseMap<ProtocolDecl *, llvm::TinyPtrVector<ProtocolConformance *>>
+    LookupCache;
+
   typedef llvm::SmallVector<ProtocolDecl *, 2> ProtocolList;
 
   /// List of all of the protocols to which a given context declares
@@ -1603,6 +1603,16 @@ DiagnosticEngine::getGeneratedSourceBufferNotes(SourceLoc loc) {
 }
 
 void DiagnosticEngine::emitDiagnostic(const Diagnostic &diagnostic) {
+  // Without any attached consumer (e.g. while diagnostics are suppressed
+  // during code completion), the only lasting effect of emission is the state
+  // transition tracking errors and fatality. Don't compute the source
+  // locations, macro-expansion notes, and documentation URLs nobody will see.
+  if (Consumers.empty()) {
+    state.updateFor(state.determineBehavior(diagnostic));
+    for (auto &childNote : diagnostic.getChildNotes())
+      state.updateFor(state.determineBehavior(childNote));
+    return;
+  }
 
   ArrayRef<Diagnostic> childNotes = diagnostic.getChildNotes();
   std::vector<Diagnostic> extendedChildNotes;
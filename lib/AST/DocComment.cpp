@@ -17,6 +17,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "swift/AST/ASTContext.h"
+#include "swift/AST/ASTContextGlobalCache.h"
 #include "swift/AST/Comment.h"
 #include "swift/AST/Decl.h"
 #include "swift/AST/FileUnit.h"
@@ -364,6 +365,11 @@ DocComment *DocComment::create(const Decl *D, markup::MarkupContext &MC,
   return new (MC) DocComment(D, Doc, Parts);
 }
 
+DocComment *DocComment::copyForDecl(const Decl *D,
+                                    swift::markup::MarkupContext &MC) const {
+  return new (MC) DocComment(D, Doc, Parts);
+}
+
 void DocComment::addInheritanceNote(swift::markup::MarkupContext &MC,
                                     TypeDecl *base) {
   auto text = MC.allocateCopy("This documentation comment was inherited from ");
@@ -382,6 +388,18 @@ void DocComment::addInheritanceNote(swift::markup::MarkupContext &MC,
   Parts.BodyNodes = MC.allocateCopy(llvm::ArrayRef(BodyNodes));
 }
 
+/// Append a key uniquely identifying the parse of \p RC to \p OS.
+///
+/// Identical raw text does not guarantee an identical parse: the comment kind
+/// and column indent of each piece affect how the text is split into lines,
+/// so they are part of the key along with the text itself.
+static void printDocCommentCacheKey(RawComment RC, llvm::raw_ostream &OS) {
+  for (const auto &SRC : RC.Comments) {
+    OS << SRC.Kind << ':' << SRC.ColumnIndent << ':' << SRC.RawText.size()
+       << ':' << SRC.RawText;
+  }
+}
+
 DocComment *swift::getSingleDocComment(swift::markup::MarkupContext &MC,
                                        const Decl *D) {
   PrettyStackTraceDecl StackTrace("parsing comment for", D);
@@ -389,7 +407,24 @@ DocComment *swift::getSingleDocComment(swift::markup::MarkupContext &MC,
   auto RC = D->getRawComment();
   if (RC.isEmpty())
     return nullptr;
-  return DocComment::create(D, MC, RC);
+
+  // IDE clients request documentation for the same few declarations many
+  // times per session, and inherited declarations repeat the same raw text.
+  // Cache the parsed markup in the ASTContext keyed by the raw comment text;
+  // only the DocComment wrapper is allocated per request, so callers remain
+  // free to retarget or annotate their copy (see getCascadingDocComment)
+  // without mutating the shared parse.
+  auto &cache = D->getASTContext().getGlobalCache();
+  llvm::SmallString<256> Key;
+  {
+    llvm::raw_svector_ostream OS(Key);
+    printDocCommentCacheKey(RC, OS);
+  }
+
+  auto &Entry = cache.parsedDocComments[Key];
+  if (!Entry)
+    Entry = DocComment::create(D, cache.docCommentMarkup, RC);
+  return Entry->copyForDecl(D, MC);
 }
 
 const Decl *Decl::getDocCommentProvidingDecl() const {
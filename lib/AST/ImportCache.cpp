@@ -30,11 +30,15 @@ using namespace namelookup;
 ImportSet::ImportSet(bool hasHeaderImportModule,
                      ArrayRef<ImportedModule> topLevelImports,
                      ArrayRef<ImportedModule> transitiveImports,
-                     ArrayRef<ImportedModule> transitiveSwiftOnlyImports)
+                     ArrayRef<ImportedModule> transitiveSwiftOnlyImports,
+                     ArrayRef<uint64_t> importBits,
+                     ArrayRef<uint64_t> swiftOnlyImportBits)
   : HasHeaderImportModule(hasHeaderImportModule),
     NumTopLevelImports(topLevelImports.size()),
     NumTransitiveImports(transitiveImports.size()),
-    NumTransitiveSwiftOnlyImports(transitiveSwiftOnlyImports.size()) {
+    NumTransitiveSwiftOnlyImports(transitiveSwiftOnlyImports.size()),
+    NumImportBitWords(importBits.size()),
+    NumSwiftOnlyImportBitWords(swiftOnlyImportBits.size()) {
   auto buffer = getTrailingObjects<ImportedModule>();
   std::uninitialized_copy(topLevelImports.begin(), topLevelImports.end(),
                           buffer);
@@ -45,6 +49,12 @@ ImportSet::ImportSet(bool hasHeaderImportModule,
                           buffer + topLevelImports.size() +
                           transitiveImports.size());
 
+  auto words = getTrailingObjects<uint64_t>();
+  std::uninitialized_copy(importBits.begin(), importBits.end(), words);
+  std::uninitialized_copy(swiftOnlyImportBits.begin(),
+                          swiftOnlyImportBits.end(),
+                          words + importBits.size());
+
 #ifndef NDEBUG
   llvm::SmallDenseSet<ImportedModule, 8> unique;
   for (auto import : topLevelImports) {
@@ -191,21 +201,41 @@ ImportCache::getImportSet(ASTContext &ctx,
     collectExports(next, stack, /*onlySwiftExports*/true);
   }
 
+  // Build membership bitsets over the dense module indices, so that
+  // visibility checks are a single bit test.
+  SmallVector<uint64_t, 4> importBits;
+  SmallVector<uint64_t, 4> swiftOnlyImportBits;
+  auto addBit = [](SmallVectorImpl<uint64_t> &bits, unsigned index) {
+    unsigned word = index / 64;
+    if (word >= bits.size())
+      bits.resize(word + 1, 0);
+    bits[word] |= (uint64_t(1) << (index % 64));
+  };
+  for (auto next : topLevelImports)
+    addBit(importBits, getModuleIndex(next.importedModule));
+  for (auto next : transitiveImports)
+    addBit(importBits, getModuleIndex(next.importedModule));
+  for (auto next : transitiveSwiftOnlyImports)
+    addBit(swiftOnlyImportBits, getModuleIndex(next.importedModule));
+
   // Find the insert position again, in case the above traversal invalidated
   // the folding set via re-entrant calls to getImportSet() from
   // getImportedModulesForLookup().
   if (ImportSet *result = ImportSets.FindNodeOrInsertPos(ID, InsertPos))
     return *result;
-  
-  size_t bytes = ImportSet::totalSizeToAlloc<ImportedModule>(
+
+  size_t bytes = ImportSet::totalSizeToAlloc<ImportedModule, uint64_t>(
                             topLevelImports.size() + transitiveImports.size() +
-                            transitiveSwiftOnlyImports.size());
+                            transitiveSwiftOnlyImports.size(),
+                            importBits.size() + swiftOnlyImportBits.size());
   void *mem = ctx.Allocate(bytes, alignof(ImportSet), AllocationArena::Permanent);
 
   auto *result = new (mem) ImportSet(hasHeaderImportModule,
                                      topLevelImports,
                                      transitiveImports,
-                                     transitiveSwiftOnlyImports);
+                                     transitiveSwiftOnlyImports,
+                                     importBits,
+                                     swiftOnlyImportBits);
   ImportSets.InsertNode(result, InsertPos);
 
   return *result;
@@ -260,12 +290,28 @@ ArrayRef<ImportPath::Access> ImportCache::allocateArray(
     return ctx.AllocateCopy(results);
 }
 
+bool ImportCache::isImportedBy(const ModuleDecl *mod,
+                               const DeclContext *dc) {
+  auto &importSet = getImportSet(dc);
+  auto index = lookupModuleIndex(mod);
+  if (!index)
+    return false;
+  return importSet.containsImport(*index);
+}
+
 ArrayRef<ImportPath::Access>
 ImportCache::getAllVisibleAccessPaths(const ModuleDecl *mod,
                                       const DeclContext *dc) {
   dc = dc->getModuleScopeContext();
   auto &ctx = mod->getASTContext();
 
+  // If 'mod' is not in the import set at all, don't bother walking it or
+  // caching the result.
+  auto &importSet = getImportSet(dc);
+  auto index = lookupModuleIndex(mod);
+  if (!index || !importSet.containsImport(*index))
+    return {};
+
   auto key = std::make_pair(mod, dc);
   auto found = VisibilityCache.find(key);
   if (found != VisibilityCache.end()) {
@@ -278,7 +324,7 @@ ImportCache::getAllVisibleAccessPaths(const ModuleDecl *mod,
     ++ctx.Stats->getFrontendCounters().ModuleVisibilityCacheMiss;
 
   SmallVector<ImportPath::Access, 1> accessPaths;
-  for (auto next : getImportSet(dc).getAllImports()) {
+  for (auto next : importSet.getAllImports()) {
     // If we found 'mod', record the access path.
     if (next.importedModule == mod) {
       // Make sure the list of access paths is unique.
@@ -298,28 +344,11 @@ bool ImportCache::isImportedByViaSwiftOnly(const ModuleDecl *mod,
   if (dc->getParentModule()->isNonSwiftModule())
     return false;
 
-  auto &ctx = mod->getASTContext();
-  auto key = std::make_pair(mod, dc);
-  auto found = SwiftOnlyCache.find(key);
-  if (found != SwiftOnlyCache.end()) {
-    if (ctx.Stats)
-      ++ctx.Stats->getFrontendCounters().ModuleVisibilityCacheHit;
-    return found->second;
-  }
-
-  if (ctx.Stats)
-    ++ctx.Stats->getFrontendCounters().ModuleVisibilityCacheMiss;
-
-  bool result = false;
-  for (auto next : getImportSet(dc).getTransitiveSwiftOnlyImports()) {
-    if (next.importedModule == mod) {
-      result = true;
-      break;
-    }
-  }
-
-  SwiftOnlyCache[key] = result;
-  return result;
+  auto &importSet = getImportSet(dc);
+  auto index = lookupModuleIndex(mod);
+  if (!index)
+    return false;
+  return importSet.containsSwiftOnlyImport(*index);
 }
 
 ArrayRef<ImportPath::Access>
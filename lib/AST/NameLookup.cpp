@@ -1326,10 +1326,13 @@ class swift::MemberLookupTable : public ASTAllocated<swift::MemberLookupTable> {
   /// List of containers that have lazily-loaded members
   llvm::SmallVector<ExtensionDecl *, 2> ExtensionsWithLazyMembers;
 
-  /// The set of names of lazily-loaded members that the lookup table has a
-  /// complete accounting of with respect to all known extensions of its
-  /// parent nominal type.
-  llvm::DenseSet<DeclBaseName> LazilyCompleteNames;
+  /// For each name of a lazily-loaded member that has been looked up, the
+  /// number of extensions with lazy members that had been registered when the
+  /// lookup results for that name were gathered. A name is only completely
+  /// accounted for once every registered extension has been consulted; if new
+  /// extensions have been registered since, only those extensions need to be
+  /// consulted to bring the name up to date.
+  llvm::DenseMap<DeclBaseName, unsigned> LazilyCompleteNames;
 
   struct {
     /// Whether we have computed the `containersWithMacroExpansions`.
@@ -1367,21 +1370,32 @@ public:
   }
 
   /// Returns \c true if the lookup table has a complete accounting of the
-  /// given name.
+  /// given name with respect to every registered extension.
   bool isLazilyComplete(DeclBaseName name) const {
+    auto known = LazilyCompleteNames.find(name);
+    return known != LazilyCompleteNames.end() &&
+           known->second == ExtensionsWithLazyMembers.size();
+  }
+
+  /// Returns \c true if the parent nominal type's own lazy member loader has
+  /// already been consulted for the given name, even if extensions registered
+  /// since then have not been.
+  bool isLazilyCompleteExcludingNewExtensions(DeclBaseName name) const {
     return LazilyCompleteNames.contains(name);
   }
 
-  /// Mark a given lazily-loaded name as being complete.
-  void markLazilyComplete(DeclBaseName name) {
-    LazilyCompleteNames.insert(name);
+  /// The number of extensions with lazy members that have already been
+  /// consulted for the given name. Extensions are only ever appended to the
+  /// registered list, so the remaining ones form a suffix of
+  /// \c getExtensionsWithLazyMembers().
+  unsigned numLazyExtensionsConsulted(DeclBaseName name) const {
+    return LazilyCompleteNames.lookup(name);
   }
 
-  /// Clears the cache of lazily-complete names.  This _must_ be called when
-  /// new extensions with lazy members are added to the type, or direct lookup
-  /// will return inconsistent or stale results.
-  void clearLazilyCompleteCache() {
-    LazilyCompleteNames.clear();
+  /// Mark a given lazily-loaded name as being complete with respect to every
+  /// extension registered so far.
+  void markLazilyComplete(DeclBaseName name) {
+    LazilyCompleteNames[name] = ExtensionsWithLazyMembers.size();
   }
 
   /// Retrieve an array containing the set of containers for this type (
@@ -1569,10 +1583,11 @@ static bool shouldLoadMembersImmediately(ExtensionDecl *ext) {
 
 void MemberLookupTable::addExtension(ExtensionDecl *ext) {
   // If we can lazy-load this extension, only take the members we've loaded
-  // so far.
+  // so far. Registering the extension bumps the count that lazily-complete
+  // names are checked against, so names completed before this point will
+  // consult the new extension (and only it) on their next lookup.
   if (ext->hasLazyMembers() && !shouldLoadMembersImmediately(ext)) {
     addMembers(ext->getCurrentMembersWithoutLoading());
-    clearLazilyCompleteCache();
     clearLazilyCompleteForMacroExpansionCache();
     addExtensionWithLazyMembers(ext);
   } else {
@@ -1702,7 +1717,12 @@ populateLookupTableEntryFromExtensions(ASTContext &ctx,
   assert(!table.isLazilyComplete(name) &&
          "Should not be searching extensions for complete name!");
 
-  for (auto e : table.getExtensionsWithLazyMembers()) {
+  // Skip extensions that were already consulted for this name; only the
+  // ones registered since the name was last completed can contribute
+  // anything new.
+  auto extensions = table.getExtensionsWithLazyMembers().drop_front(
+      table.numLazyExtensionsConsulted(name));
+  for (auto e : extensions) {
     // If there's no lazy members to look at, all the members of this extension
     // are present in the lookup table.
     if (!e->hasLazyMembers()) {
@@ -2206,8 +2226,11 @@ DirectLookupRequest::evaluate(Evaluator &evaluator,
       // The lookup table believes it doesn't have a complete accounting of this
       // name - either because we're never seen it before, or another extension
       // was registered since the last time we searched. Ask the loaders to give
-      // us a hand.
-      populateLookupTableEntryFromLazyIDCLoader(ctx, Table, baseName, decl);
+      // us a hand. The nominal's own loader only needs to be consulted the
+      // first time around; after that, only newly-registered extensions can
+      // contribute members for the name.
+      if (!Table.isLazilyCompleteExcludingNewExtensions(baseName))
+        populateLookupTableEntryFromLazyIDCLoader(ctx, Table, baseName, decl);
       populateLookupTableEntryFromExtensions(ctx, Table, baseName, decl);
     }
 
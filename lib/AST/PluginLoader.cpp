@@ -246,6 +246,15 @@ llvm::Expected<CompilerPlugin *> PluginLoader::getInProcessPlugins() {
 
 llvm::Expected<CompilerPlugin *>
 PluginLoader::loadExecutablePlugin(StringRef path) {
+  // A server path of the form 'unix://<socket path>' connects to an
+  // already-running plugin server (e.g. 'swift-plugin-server --socket')
+  // instead of spawning one per frontend invocation.
+  constexpr StringRef socketScheme = "unix://";
+  if (path.starts_with(socketScheme)) {
+    return getRegistry()->connectToPluginServer(
+        path.drop_front(socketScheme.size()));
+  }
+
   auto fs = getPluginLoadingFS(Ctx);
   SmallString<128> resolvedPath;
   if (auto err = fs->getRealPath(path, resolvedPath)) {
@@ -32,6 +32,11 @@
 #include <io.h>
 #endif
 
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
 using namespace swift;
 
 PluginRegistry::PluginRegistry() {
@@ -368,3 +373,213 @@ llvm::Expected<std::string> LoadedExecutablePlugin::waitForNextMessage() {
 
   return message;
 }
+
+llvm::Expected<CompilerPlugin *>
+PluginRegistry::connectToPluginServer(StringRef socketPath) {
+#if defined(_WIN32)
+  return llvm::createStringError(
+      llvm::inconvertibleErrorCode(),
+      "socket plugin servers are not supported on this platform");
+#else
+  std::lock_guard<std::mutex> lock(mtx);
+
+  auto &storage = SocketPlugins[socketPath];
+  if (!storage) {
+    auto plugin = std::make_unique<LoadedSocketPlugin>(socketPath);
+    plugin->setDumpMessaging(dumpMessaging);
+
+    // Connect here to diagnose a missing or dead server up front.
+    if (auto error = plugin->spawnIfNeeded()) {
+      SocketPlugins.erase(socketPath);
+      return std::move(error);
+    }
+
+    storage = std::move(plugin);
+  }
+  return storage.get();
+#endif
+}
+
+LoadedSocketPlugin::~LoadedSocketPlugin() { setStale(); }
+
+void LoadedSocketPlugin::setStale() {
+#if !defined(_WIN32)
+  if (fd >= 0) {
+    close(fd);
+    fd = -1;
+  }
+#endif
+}
+
+llvm::Error LoadedSocketPlugin::spawnIfNeeded() {
+#if defined(_WIN32)
+  return llvm::createStringError(
+      llvm::inconvertibleErrorCode(),
+      "socket plugin servers are not supported on this platform");
+#else
+  if (fd >= 0) {
+    // The current connection is usable.
+    return llvm::Error::success();
+  }
+
+  StringRef socketPath = getPath();
+
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (socketPath.size() >= sizeof(addr.sun_path)) {
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "plugin server socket path is too long: %s",
+                                   socketPath.data());
+  }
+  memcpy(addr.sun_path, socketPath.data(), socketPath.size());
+
+  int sock = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (sock < 0) {
+    return llvm::errorCodeToError(
+        std::error_code(errno, std::generic_category()));
+  }
+  if (::connect(sock, reinterpret_cast<struct sockaddr *>(&addr),
+                sizeof(addr)) < 0) {
+    std::error_code ec(errno, std::generic_category());
+    close(sock);
+    return llvm::createStringError(
+        ec, "failed to connect to plugin server socket '%s'",
+        socketPath.data());
+  }
+  fd = sock;
+
+  // Call "on reconnect" callbacks so clients redo the capability handshake
+  // on the new connection.
+  for (auto *callback : getOnReconnectCallbacks()) {
+    (*callback)();
+  }
+
+  return llvm::Error::success();
+#endif
+}
+
+ssize_t LoadedSocketPlugin::read(void *buf, size_t nbyte) const {
+#if defined(_WIN32)
+  return 0;
+#else
+  ssize_t bytesToRead = nbyte;
+  void *ptr = buf;
+
+#if defined(SIGPIPE)
+  /// Ignore SIGPIPE while reading.
+  auto *old_handler = signal(SIGPIPE, SIG_IGN);
+  SWIFT_DEFER { signal(SIGPIPE, old_handler); };
+#endif
+
+  while (bytesToRead > 0) {
+    ssize_t readingSize = std::min(ssize_t(INT32_MAX), bytesToRead);
+    ssize_t readSize = ::read(fd, ptr, readingSize);
+    if (readSize <= 0) {
+      // 0: EOF (the server exited?), -1: error (e.g. connection reset.)
+      break;
+    }
+    ptr = static_cast<char *>(ptr) + readSize;
+    bytesToRead -= readSize;
+  }
+
+  return nbyte - bytesToRead;
+#endif
+}
+
+ssize_t LoadedSocketPlugin::write(const void *buf, size_t nbyte) const {
+#if defined(_WIN32)
+  return 0;
+#else
+  ssize_t bytesToWrite = nbyte;
+  const void *ptr = buf;
+
+#if defined(SIGPIPE)
+  /// Ignore SIGPIPE while writing.
+  auto *old_handler = signal(SIGPIPE, SIG_IGN);
+  SWIFT_DEFER { signal(SIGPIPE, old_handler); };
+#endif
+
+  while (bytesToWrite > 0) {
+    ssize_t writingSize = std::min(ssize_t(INT32_MAX), bytesToWrite);
+    ssize_t writtenSize = ::write(fd, ptr, writingSize);
+    if (writtenSize <= 0) {
+      // -1: error (e.g. connection reset.)
+      break;
+    }
+    ptr = static_cast<const char *>(ptr) + writtenSize;
+    bytesToWrite -= writtenSize;
+  }
+  return nbyte - bytesToWrite;
+#endif
+}
+
+llvm::Error LoadedSocketPlugin::sendMessage(llvm::StringRef message) {
+  ssize_t writtenSize = 0;
+
+  if (shouldDumpMessaging()) {
+    llvm::dbgs() << "->(server:" << getPath() << ") " << message << '\n';
+  }
+
+  const char *data = message.data();
+  size_t size = message.size();
+
+  // Write header (message size).
+  uint64_t header = llvm::support::endian::byte_swap(uint64_t(size),
+                                                     llvm::endianness::little);
+  writtenSize = write(&header, sizeof(header));
+  if (writtenSize != sizeof(header)) {
+    setStale();
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "failed to write plugin message header");
+  }
+
+  // Write message.
+  writtenSize = write(data, size);
+  if (writtenSize != ssize_t(size)) {
+    setStale();
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "failed to write plugin message data");
+  }
+
+  return llvm::Error::success();
+}
+
+llvm::Expected<std::string> LoadedSocketPlugin::waitForNextMessage() {
+  ssize_t readSize = 0;
+
+  // Read header (message size).
+  uint64_t header;
+  readSize = read(&header, sizeof(header));
+
+  if (readSize != sizeof(header)) {
+    setStale();
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "failed to read plugin message header");
+  }
+
+  size_t size =
+      llvm::support::endian::read<uint64_t>(&header, llvm::endianness::little);
+
+  // Read message.
+  std::string message;
+  message.reserve(size);
+  auto sizeToRead = size;
+  while (sizeToRead > 0) {
+    char buffer[4096];
+    readSize = read(buffer, std::min(sizeof(buffer), sizeToRead));
+    if (readSize == 0) {
+      setStale();
+      return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                     "failed to read plugin message data");
+    }
+    sizeToRead -= readSize;
+    message.append(buffer, readSize);
+  }
+
+  if (shouldDumpMessaging()) {
+    llvm::dbgs() << "<-(server:" << getPath() << ") " << message << "\n";
+  }
+
+  return message;
+}
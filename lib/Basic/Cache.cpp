@@ -14,12 +14,27 @@
 #include "Darwin/Cache-Mac.inc"
 #else
 
-//  This file implements a default caching implementation that never evicts
-//  its entries.
+//  This file implements a default caching implementation: a cost-accounted
+//  LRU map. Entries are evicted least-recently-used first, either when an
+//  insertion pushes the cache's total cost over its (optional) budget, or
+//  when the host process asks all caches to shrink via
+//  CacheImpl::trimAllCaches() because it is under memory pressure.
+//
+//  A per-cache cost budget can be set process-wide with the
+//  SWIFT_CACHE_COST_LIMIT environment variable (in cost units, i.e. bytes
+//  for callers that report byte costs); when unset, caches only shrink when
+//  trimAllCaches() is called. Setting SWIFT_CACHE_STATS reports hit, miss
+//  and eviction counts for each cache as it is destroyed.
 
 #include "swift/Basic/Cache.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/Mutex.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <cstdlib>
+#include <list>
+#include <string>
+#include <vector>
 
 using namespace swift::sys;
 using llvm::StringRef;
@@ -36,7 +51,36 @@ struct DefaultCacheKey {
 struct DefaultCache {
   llvm::sys::Mutex Mux;
   CacheImpl::CallBacks CBs;
-  llvm::DenseMap<DefaultCacheKey, void *> Entries;
+  std::string Name;
+
+  /// Total cost the cache may maintain before insertions start evicting
+  /// least-recently-used entries; 0 means unbounded.
+  size_t CostLimit = 0;
+  /// The sum of the costs of all current entries.
+  size_t TotalCost = 0;
+
+  uint64_t Hits = 0;
+  uint64_t Misses = 0;
+  uint64_t Evictions = 0;
+
+  struct EntryTy {
+    void *Value;
+    size_t Cost;
+    std::list<DefaultCacheKey>::iterator LRUPos;
+  };
+
+  llvm::DenseMap<DefaultCacheKey, EntryTy> Entries;
+  /// Keys in least-recently-used order; the front is the next eviction
+  /// victim.
+  std::list<DefaultCacheKey> LRUOrder;
+  /// Number of outstanding references per value handed out by
+  /// \c setAndRetain and \c getAndRetain and not yet returned through
+  /// \c releaseValue.
+  llvm::DenseMap<void *, unsigned> ExternalRefs;
+  /// Number of value releases deferred because the value was evicted or
+  /// replaced while callers still held references to it; applied once the
+  /// last external reference is released.
+  llvm::DenseMap<void *, unsigned> PendingReleases;
 
   explicit DefaultCache(CacheImpl::CallBacks CBs) : CBs(std::move(CBs)) { }
 };
@@ -67,21 +111,85 @@ template<> struct DenseMapInfo<DefaultCacheKey> {
 };
 } // namespace llvm
 
+static llvm::sys::Mutex &getCacheRegistryMutex() {
+  static llvm::sys::Mutex Mux;
+  return Mux;
+}
+
+static std::vector<DefaultCache *> &getCacheRegistry() {
+  static std::vector<DefaultCache *> Registry;
+  return Registry;
+}
+
+static size_t getEnvironmentCacheCostLimit() {
+  static size_t Limit = []() -> size_t {
+    if (const char *S = ::getenv("SWIFT_CACHE_COST_LIMIT"))
+      return strtoull(S, nullptr, 10);
+    return 0;
+  }();
+  return Limit;
+}
+
+/// Release \p Value, or defer the release if callers still hold references
+/// to it. Must be invoked with the cache's mutex held.
+static void releaseOrDeferValue(DefaultCache &DCache, void *Value) {
+  auto It = DCache.ExternalRefs.find(Value);
+  if (It != DCache.ExternalRefs.end() && It->second != 0) {
+    ++DCache.PendingReleases[Value];
+    return;
+  }
+  DCache.CBs.valueReleaseCB(Value, nullptr);
+}
+
+/// Evict least-recently-used entries until the cache's total cost is at most
+/// \p CostLimit. Must be invoked with the cache's mutex held.
+static void evictEntriesOverCost(DefaultCache &DCache, size_t CostLimit) {
+  while (DCache.TotalCost > CostLimit && !DCache.LRUOrder.empty()) {
+    DefaultCacheKey Victim = DCache.LRUOrder.front();
+    auto Entry = DCache.Entries.find(Victim);
+    assert(Entry != DCache.Entries.end() &&
+           "LRU list out of sync with the entries map");
+    DCache.TotalCost -= Entry->second.Cost;
+    releaseOrDeferValue(DCache, Entry->second.Value);
+    DCache.CBs.keyDestroyCB(Entry->first.Key, nullptr);
+    DCache.Entries.erase(Entry);
+    DCache.LRUOrder.pop_front();
+    ++DCache.Evictions;
+  }
+}
+
 CacheImpl::ImplTy CacheImpl::create(StringRef Name, const CallBacks &CBs) {
-  return new DefaultCache(CBs);
+  DefaultCache *DCache = new DefaultCache(CBs);
+  DCache->Name = Name.str();
+  DCache->CostLimit = getEnvironmentCacheCostLimit();
+  {
+    llvm::sys::ScopedLock R(getCacheRegistryMutex());
+    getCacheRegistry().push_back(DCache);
+  }
+  return DCache;
 }
 
 void CacheImpl::setAndRetain(void *Key, void *Value, size_t Cost) {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
   llvm::sys::ScopedLock L(DCache.Mux);
 
+  // Account entries with no reported cost as cost 1; otherwise they could
+  // never be evicted by the cost-driven loops below.
+  Cost = std::max(Cost, size_t(1));
+
   DefaultCacheKey CKey(Key, &DCache.CBs);
   auto Entry = DCache.Entries.find(CKey);
 
   // If there is no existing entry, retain the value and insert the entry.
   if (Entry == DCache.Entries.end()) {
     DCache.CBs.valueRetainCB(Value, nullptr);
-    DCache.Entries[CKey] = Value;
+    DCache.LRUOrder.push_back(CKey);
+    DCache.Entries[CKey] = {Value, Cost, std::prev(DCache.LRUOrder.end())};
+    DCache.TotalCost += Cost;
+    // The caller holds a reference too; see releaseValue().
+    ++DCache.ExternalRefs[Value];
+    if (DCache.CostLimit)
+      evictEntriesOverCost(DCache, DCache.CostLimit);
     return;
   }
 
@@ -90,15 +198,24 @@ void CacheImpl::setAndRetain(void *Key, void *Value, size_t Cost) {
   std::swap(Entry->first.Key, Key);
   DCache.CBs.keyDestroyCB(Key, nullptr);
 
+  // The entry was just used; move it to the most-recently-used position and
+  // keep the key stored in the LRU list in sync with the swapped map key.
+  *Entry->second.LRUPos = Entry->first;
+  DCache.LRUOrder.splice(DCache.LRUOrder.end(), DCache.LRUOrder,
+                         Entry->second.LRUPos);
+
+  DCache.TotalCost += Cost - Entry->second.Cost;
+  Entry->second.Cost = Cost;
+
   // Replace the value, if necessary.
-  if (Entry->second != Value) {
+  if (Entry->second.Value != Value) {
     DCache.CBs.valueRetainCB(Value, nullptr);
-    std::swap(Entry->second, Value);
-    DCache.CBs.valueReleaseCB(Value, nullptr);
+    std::swap(Entry->second.Value, Value);
+    releaseOrDeferValue(DCache, Value);
   }
-
-  // FIXME: Not thread-safe! It should avoid deleting the value until
-  // 'releaseValue is called on it.
+  ++DCache.ExternalRefs[Entry->second.Value];
+  if (DCache.CostLimit)
+    evictEntriesOverCost(DCache, DCache.CostLimit);
 }
 
 bool CacheImpl::getAndRetain(const void *Key, void **Value_out) {
@@ -108,16 +225,38 @@ bool CacheImpl::getAndRetain(const void *Key, void **Value_out) {
   DefaultCacheKey CKey(const_cast<void*>(Key), &DCache.CBs);
   auto Entry = DCache.Entries.find(CKey);
   if (Entry != DCache.Entries.end()) {
-    // FIXME: Not thread-safe! It should avoid deleting the value until
-    // 'releaseValue is called on it.
-    *Value_out = Entry->second;
+    DCache.LRUOrder.splice(DCache.LRUOrder.end(), DCache.LRUOrder,
+                           Entry->second.LRUPos);
+    // Keep the value alive until the caller calls releaseValue(), even if
+    // the entry gets evicted in the meantime.
+    ++DCache.ExternalRefs[Entry->second.Value];
+    ++DCache.Hits;
+    *Value_out = Entry->second.Value;
     return true;
   }
+  ++DCache.Misses;
   return false;
 }
 
 void CacheImpl::releaseValue(void *Value) {
-  // FIXME: Implementation.
+  DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
+  llvm::sys::ScopedLock L(DCache.Mux);
+
+  auto It = DCache.ExternalRefs.find(Value);
+  assert(It != DCache.ExternalRefs.end() && It->second != 0 &&
+         "releasing a value that was never retained");
+  if (--It->second != 0)
+    return;
+  DCache.ExternalRefs.erase(It);
+
+  // Apply any releases that were deferred while the caller held the value.
+  auto Pending = DCache.PendingReleases.find(Value);
+  if (Pending != DCache.PendingReleases.end()) {
+    unsigned Count = Pending->second;
+    DCache.PendingReleases.erase(Pending);
+    while (Count--)
+      DCache.CBs.valueReleaseCB(Value, nullptr);
+  }
 }
 
 bool CacheImpl::remove(const void *Key) {
@@ -127,8 +266,10 @@ bool CacheImpl::remove(const void *Key) {
   DefaultCacheKey CKey(const_cast<void*>(Key), &DCache.CBs);
   auto Entry = DCache.Entries.find(CKey);
   if (Entry != DCache.Entries.end()) {
+    DCache.TotalCost -= Entry->second.Cost;
+    DCache.LRUOrder.erase(Entry->second.LRUPos);
     DCache.CBs.keyDestroyCB(Entry->first.Key, nullptr);
-    DCache.CBs.valueReleaseCB(Entry->second, nullptr);
+    releaseOrDeferValue(DCache, Entry->second.Value);
     DCache.Entries.erase(Entry);
     return true;
   }
@@ -141,14 +282,35 @@ void CacheImpl::removeAll() {
 
   for (auto Entry : DCache.Entries) {
     DCache.CBs.keyDestroyCB(Entry.first.Key, nullptr);
-    DCache.CBs.valueReleaseCB(Entry.second, nullptr);
+    releaseOrDeferValue(DCache, Entry.second.Value);
   }
   DCache.Entries.clear();
+  DCache.LRUOrder.clear();
+  DCache.TotalCost = 0;
 }
 
 void CacheImpl::destroy() {
+  DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
+  {
+    llvm::sys::ScopedLock R(getCacheRegistryMutex());
+    auto &Registry = getCacheRegistry();
+    Registry.erase(std::find(Registry.begin(), Registry.end(), &DCache));
+  }
+  if (::getenv("SWIFT_CACHE_STATS")) {
+    llvm::errs() << "swift::sys::Cache '" << DCache.Name << "': "
+                 << DCache.Hits << " hits, " << DCache.Misses << " misses, "
+                 << DCache.Evictions << " evictions\n";
+  }
   removeAll();
-  delete static_cast<DefaultCache*>(Impl);
+  delete &DCache;
+}
+
+void CacheImpl::trimAllCaches(size_t MaxResidualCost) {
+  llvm::sys::ScopedLock R(getCacheRegistryMutex());
+  for (DefaultCache *DCache : getCacheRegistry()) {
+    llvm::sys::ScopedLock L(DCache->Mux);
+    evictEntriesOverCost(*DCache, MaxResidualCost);
+  }
 }
 
 #endif // finish default implementation
@@ -16,10 +16,84 @@
 
 #include "swift/Basic/ClusteredBitVector.h"
 
+#include "llvm/ADT/bit.h"
 #include "llvm/Support/raw_ostream.h"
 
 using namespace swift;
 
+using APInt = llvm::APInt;
+
+size_t ClusteredBitVector::findNextSetBit(size_t fromIndex) const {
+  assert(fromIndex <= size());
+  if (!Bits || fromIndex == size())
+    return npos;
+
+  const uint64_t *words = Bits.value().getRawData();
+  size_t numWords = Bits.value().getNumWords();
+  size_t wordIndex = fromIndex / APInt::APINT_BITS_PER_WORD;
+
+  // Mask off the bits below fromIndex in the first word.  Any set bit we
+  // find from here on is in range: APInt keeps the unused high bits of
+  // the last word clear.
+  uint64_t word = words[wordIndex] &
+      (~uint64_t(0) << (fromIndex % APInt::APINT_BITS_PER_WORD));
+  while (true) {
+    if (word != 0)
+      return wordIndex * APInt::APINT_BITS_PER_WORD + llvm::countr_zero(word);
+    if (++wordIndex == numWords)
+      return npos;
+    word = words[wordIndex];
+  }
+}
+
+size_t ClusteredBitVector::findNextClearBit(size_t fromIndex) const {
+  assert(fromIndex <= size());
+  if (!Bits || fromIndex == size())
+    return npos;
+
+  const uint64_t *words = Bits.value().getRawData();
+  size_t numWords = Bits.value().getNumWords();
+  size_t wordIndex = fromIndex / APInt::APINT_BITS_PER_WORD;
+
+  uint64_t word = ~words[wordIndex] &
+      (~uint64_t(0) << (fromIndex % APInt::APINT_BITS_PER_WORD));
+  while (true) {
+    if (word != 0) {
+      // The unused high bits of the last word read as clear, so check
+      // that the index we found is actually within the vector.
+      size_t result =
+          wordIndex * APInt::APINT_BITS_PER_WORD + llvm::countr_zero(word);
+      return result < size() ? result : npos;
+    }
+    if (++wordIndex == numWords)
+      return npos;
+    word = ~words[wordIndex];
+  }
+}
+
+size_t ClusteredBitVector::findPreviousSetBit(size_t fromIndex) const {
+  assert(fromIndex <= size());
+  if (!Bits || fromIndex == 0)
+    return npos;
+
+  const uint64_t *words = Bits.value().getRawData();
+  size_t wordIndex = (fromIndex - 1) / APInt::APINT_BITS_PER_WORD;
+  unsigned highBit = (fromIndex - 1) % APInt::APINT_BITS_PER_WORD;
+
+  // Mask off the bits above fromIndex-1 in the first word.
+  uint64_t word = words[wordIndex];
+  if (highBit != APInt::APINT_BITS_PER_WORD - 1)
+    word &= (uint64_t(1) << (highBit + 1)) - 1;
+  while (true) {
+    if (word != 0)
+      return wordIndex * APInt::APINT_BITS_PER_WORD +
+             (APInt::APINT_BITS_PER_WORD - 1 - llvm::countl_zero(word));
+    if (wordIndex == 0)
+      return npos;
+    word = words[--wordIndex];
+  }
+}
+
 void ClusteredBitVector::dump() const {
   print(llvm::errs());
 }
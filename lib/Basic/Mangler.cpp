@@ -160,8 +160,24 @@ std::string Mangler::finalize() {
 /// Finish the mangling of the symbol and write the mangled name into
 /// \p stream.
 void Mangler::finalize(llvm::raw_ostream &stream) {
-  std::string result = finalize();
+  assert(Storage.size() && "Mangling an empty name");
+  StringRef result = Storage.str();
+
+#ifndef NDEBUG
+  switch (Flavor) {
+  case ManglingFlavor::Default:
+    if (result.starts_with(MANGLING_PREFIX_STR))
+      verify(result, Flavor);
+    break;
+  case ManglingFlavor::Embedded:
+    if (result.starts_with(MANGLING_PREFIX_EMBEDDED_STR))
+      verify(result, Flavor);
+    break;
+  }
+#endif
+
   stream.write(result.data(), result.size());
+  Storage.clear();
 }
 
 LLVM_ATTRIBUTE_UNUSED
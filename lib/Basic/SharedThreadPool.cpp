@@ -0,0 +1,23 @@
+//===--- SharedThreadPool.cpp - Process-wide thread pool ------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2026 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/SharedThreadPool.h"
+
+#include "llvm/Support/Threading.h"
+
+llvm::ThreadPoolInterface &swift::getSharedThreadPool() {
+  // Sized to the physical core count: the tasks run on this pool are
+  // compute-bound, and hyperthread oversubscription only adds scheduling
+  // noise for them.
+  static llvm::DefaultThreadPool pool(llvm::heavyweight_hardware_concurrency());
+  return pool;
+}
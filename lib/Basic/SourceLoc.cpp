@@ -15,6 +15,7 @@
 #include "swift/Basic/Range.h"
 #include "swift/Basic/SourceLoc.h"
 #include "swift/Basic/SourceManager.h"
+#include "swift/Basic/Unicode.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/PrettyStackTrace.h"
@@ -357,6 +358,71 @@ unsigned SourceManager::getByteDistance(SourceLoc Start, SourceLoc End) const {
   return End.getPointer() - Start.getPointer();
 }
 
+/// Append the start offset of every line in \p Buffer to \p LineStarts,
+/// detecting newlines eight bytes at a time. Only '\n' terminates a line,
+/// matching llvm::SourceMgr; a "\r\n" sequence therefore counts once.
+static void computeLineStartOffsets(StringRef Buffer,
+                                    std::vector<unsigned> &LineStarts) {
+  LineStarts.push_back(0);
+  const char *Begin = Buffer.begin();
+  const char *Ptr = Begin;
+  const char *End = Buffer.end();
+
+  while (End - Ptr >= 8) {
+    uint64_t Word;
+    memcpy(&Word, Ptr, 8);
+    // SWAR: a byte of `Hit` has its high bit set iff the corresponding input
+    // byte is '\n'.
+    uint64_t X = Word ^ UINT64_C(0x0A0A0A0A0A0A0A0A);
+    uint64_t Hit =
+        (X - UINT64_C(0x0101010101010101)) & ~X & UINT64_C(0x8080808080808080);
+    if (Hit == 0) {
+      Ptr += 8;
+      continue;
+    }
+    // Rare: resolve this word's newlines one byte at a time, which avoids
+    // caring about host endianness.
+    for (const char *WordEnd = Ptr + 8; Ptr != WordEnd; ++Ptr)
+      if (*Ptr == '\n')
+        LineStarts.push_back(Ptr + 1 - Begin);
+  }
+  for (; Ptr != End; ++Ptr)
+    if (*Ptr == '\n')
+      LineStarts.push_back(Ptr + 1 - Begin);
+}
+
+bool SourceManager::isBufferWellFormedUTF8(unsigned BufferID) const {
+  auto it = WellFormedUTF8Cache.find(BufferID);
+  if (it != WellFormedUTF8Cache.end())
+    return it->second;
+
+  bool wellFormed = unicode::isWellFormedUTF8(getEntireTextForBuffer(BufferID));
+  WellFormedUTF8Cache[BufferID] = wellFormed;
+  return wellFormed;
+}
+
+ArrayRef<unsigned> SourceManager::getLineStartOffsets(unsigned BufferID) const {
+  auto &LineStarts = LineStartOffsetCache[BufferID];
+  if (LineStarts.empty())
+    computeLineStartOffsets(getEntireTextForBuffer(BufferID), LineStarts);
+  return LineStarts;
+}
+
+std::pair<unsigned, unsigned>
+SourceManager::getLineAndColumnInBuffer(SourceLoc Loc,
+                                        unsigned BufferID) const {
+  assert(Loc.isValid());
+  if (BufferID == 0)
+    BufferID = findBufferContainingLoc(Loc);
+
+  auto LineStarts = getLineStartOffsets(BufferID);
+  unsigned Offset = getLocOffsetInBuffer(Loc, BufferID);
+  auto It = std::upper_bound(LineStarts.begin(), LineStarts.end(), Offset);
+  assert(It != LineStarts.begin() && "no line contains the offset?");
+  unsigned Line = It - LineStarts.begin();
+  return {Line, Offset - *(It - 1) + 1};
+}
+
 unsigned SourceManager::getColumnInBuffer(SourceLoc Loc,
                                           unsigned BufferID) const {
   assert(Loc.isValid());
@@ -684,25 +750,21 @@ std::optional<unsigned> SourceManager::resolveFromLineCol(unsigned BufferId,
     return std::nullopt;
   }
   const bool LineEnd = (Col == ~0u);
-  if (LineEnd)
-    Col = 0;
 
-  auto loc = const_cast<SourceManager *>(this)
-                 ->getLLVMSourceMgr()
-                 .FindLocForLineAndColumn(BufferId, Line, Col);
-  if (!loc.isValid())
+  auto LineStarts = getLineStartOffsets(BufferId);
+  if (Line > LineStarts.size())
     return std::nullopt;
 
-  auto InputBuf = getLLVMSourceMgr().getMemoryBuffer(BufferId);
-  const char *Ptr = loc.getPointer();
-  if (LineEnd) {
-    const char *End = InputBuf->getBufferEnd();
-    for (;; ++Ptr) {
-      if (Ptr == End || *Ptr == '\n')
-        break;
-    }
-  }
-  return Ptr - InputBuf->getBufferStart();
+  unsigned LineStart = LineStarts[Line - 1];
+  // The line runs up to (but does not include) the next line's terminating
+  // '\n', or to the end of the buffer.
+  unsigned LineEndOffset =
+      Line < LineStarts.size()
+          ? LineStarts[Line] - 1
+          : (unsigned)getEntireTextForBuffer(BufferId).size();
+  if (LineEnd)
+    return LineEndOffset;
+  return std::min(LineStart + (Col ? Col - 1 : 0), LineEndOffset);
 }
 
 unsigned SourceManager::getExternalSourceBufferID(StringRef Path) {
@@ -18,6 +18,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/Config/config.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/SaveAndRestore.h"
@@ -99,6 +100,12 @@ makeTraceFileName(StringRef ProgramName,
   return makeFileName("trace", ProgramName, AuxName, "csv");
 }
 
+static std::string
+makeSampledEventsFileName(StringRef ProgramName,
+                          StringRef AuxName) {
+  return makeFileName("trace", ProgramName, AuxName, "json");
+}
+
 static std::string
 makeProfileDirName(StringRef ProgramName,
                    StringRef AuxName) {
@@ -321,6 +328,7 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
                                            clang::SourceManager *CSM,
                                            bool FineGrainedTimers,
                                            bool TraceEvents,
+                                           bool SampleEvents,
                                            bool ProfileEvents,
                                            bool ProfileEntities,
                                            bool PrintZeroStats)
@@ -332,8 +340,8 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
                                  OptType),
                          Directory,
                          SM, CSM, FineGrainedTimers,
-                         TraceEvents, ProfileEvents, ProfileEntities,
-                         PrintZeroStats)
+                         TraceEvents, SampleEvents, ProfileEvents,
+                         ProfileEntities, PrintZeroStats)
 {
 }
 
@@ -344,6 +352,7 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
                                            clang::SourceManager *CSM,
                                            bool FineGrainedTimers,
                                            bool TraceEvents,
+                                           bool SampleEvents,
                                            bool ProfileEvents,
                                            bool ProfileEntities,
                                            bool PrintZeroStats)
@@ -351,6 +360,7 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
     currentProcessExitStatus(EXIT_FAILURE),
     StatsFilename(Directory),
     TraceFilename(Directory),
+    SampledEventsFilename(Directory),
     ProfileDirname(Directory),
     StartedTime(llvm::TimeRecord::getCurrentTime()),
     MainThreadID(std::this_thread::get_id()),
@@ -361,17 +371,22 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
     ClangSourceMgr(CSM),
     RecursiveTimers(std::make_unique<RecursionSafeTimers>()),
     FineGrainedTimers(FineGrainedTimers),
+    HaveStatsOutputDir(!Directory.empty()),
     IsFlushingTracesAndProfiles(false),
     IsPrintingZeroStats(PrintZeroStats)
 {
   path::append(StatsFilename, makeStatsFileName(ProgramName, AuxName));
   path::append(TraceFilename, makeTraceFileName(ProgramName, AuxName));
+  path::append(SampledEventsFilename,
+               makeSampledEventsFileName(ProgramName, AuxName));
   path::append(ProfileDirname, makeProfileDirName(ProgramName, AuxName));
   EnableStatistics(/*PrintOnExit=*/false);
   if (TraceEvents || ProfileEvents || ProfileEntities)
     LastTracedFrontendCounters.emplace();
   if (TraceEvents)
     FrontendStatsEvents.emplace();
+  if (SampleEvents)
+    SampledStatsEvents.emplace();
   if (ProfileEvents)
     EventProfilers =std::make_unique<StatsProfilers>();
   if (ProfileEntities)
@@ -382,6 +397,25 @@ void UnifiedStatsReporter::recordJobMaxRSS(long rss) {
   maxChildRSS = std::max(maxChildRSS, rss);
 }
 
+/// Returns the peak resident set size of this process in bytes, or zero if
+/// the platform cannot report it.
+static int64_t getSelfMaxResidentSetSize() {
+#if HAVE_GETRUSAGE && !defined(__HAIKU__)
+  struct rusage RU;
+  ::getrusage(RUSAGE_SELF, &RU);
+  int64_t M = static_cast<int64_t>(RU.ru_maxrss);
+  if (M < 0)
+    return 0;
+#ifndef __APPLE__
+  // Apple systems report bytes; everything else appears to report KB.
+  M <<= 10;
+#endif
+  return M;
+#else
+  return 0;
+#endif
+}
+
 int64_t UnifiedStatsReporter::getChildrenMaxResidentSetSize() {
 #if HAVE_GETRUSAGE && !defined(__HAIKU__)
   struct rusage RU;
@@ -557,6 +591,28 @@ void updateProcessWideFrontendCounters(
 #endif
 }
 
+// Poll the registered arena callbacks. Like MaxMallocUsage above, the
+// high-water marks are only as good as the polling frequency; they get
+// refreshed at every tracer boundary, which in practice brackets the
+// allocation bursts we care about during OOM triage.
+void UnifiedStatsReporter::updateArenaCounters(AlwaysOnFrontendCounters &C) {
+  if (ASTArenaBytes) {
+    C.NumASTContextArenaBytes = ASTArenaBytes();
+    C.MaxASTContextArenaUsage =
+        std::max(C.MaxASTContextArenaUsage, C.NumASTContextArenaBytes);
+  }
+  if (SolverArenaBytes) {
+    C.NumSolverArenaBytes = SolverArenaBytes();
+    C.MaxSolverArenaUsage =
+        std::max(C.MaxSolverArenaUsage, C.NumSolverArenaBytes);
+  }
+  if (SILArenaBytes) {
+    C.NumSILModuleArenaBytes = SILArenaBytes();
+    C.MaxSILModuleArenaUsage =
+        std::max(C.MaxSILModuleArenaUsage, C.NumSILModuleArenaBytes);
+  }
+}
+
 static inline void
 saveEvent(StringRef StatName,
           int64_t Curr, int64_t Last,
@@ -593,6 +649,35 @@ UnifiedStatsReporter::saveAnyFrontendStatsEvents(
     RecursiveTimers->endTimer(T.EventName);
   }
 
+  // The sampled mode and the -emit-timing record only look at frontier
+  // events: one entry per depth-zero tracer as it exits, with a snapshot of
+  // the cheap process-wide counters, skipping the per-counter delta loops
+  // below entirely.
+  if (SampledStatsEvents || !TimingRecordPath.empty()) {
+    if (IsEntry) {
+      ++ActiveTracerDepth;
+    } else {
+      assert(ActiveTracerDepth != 0);
+      --ActiveTracerDepth;
+      if (ActiveTracerDepth == 0) {
+        // Refresh the arena high-water marks even when full tracing is off,
+        // so the aggregate stats file still reports them.
+        if (FrontendCounters)
+          updateArenaCounters(getFrontendCounters());
+        auto Now = llvm::TimeRecord::getCurrentTime();
+        auto BeginUSec = uint64_t(1000000.0 * T.SavedTime.getWallTime());
+        auto NowUSec = uint64_t(1000000.0 * Now.getWallTime());
+        if (!TimingRecordPath.empty())
+          FrontierEventWallUSec[T.EventName] += NowUSec - BeginUSec;
+        if (SampledStatsEvents)
+          SampledStatsEvents->push_back(
+              {BeginUSec, NowUSec - BeginUSec, T.EventName,
+               (int64_t)llvm::sys::Process::GetMallocUsage(),
+               getInstructionsExecuted()});
+      }
+    }
+  }
+
   // If we don't have a saved entry to form deltas against in the trace buffer
   // or profilers, we're not tracing or profiling: return early.
   if (!LastTracedFrontendCounters)
@@ -601,6 +686,7 @@ UnifiedStatsReporter::saveAnyFrontendStatsEvents(
   auto &Curr = getFrontendCounters();
   auto &Last = *LastTracedFrontendCounters;
   updateProcessWideFrontendCounters(Curr);
+  updateArenaCounters(Curr);
   if (EventProfilers) {
     auto TimeDelta = Now;
     TimeDelta -= EventProfilers->LastUpdated;
@@ -678,8 +764,10 @@ UnifiedStatsReporter::~UnifiedStatsReporter()
     }
   }
 
-  if (FrontendCounters)
+  if (FrontendCounters) {
     updateProcessWideFrontendCounters(getFrontendCounters());
+    updateArenaCounters(getFrontendCounters());
+  }
 
   // NB: Timer needs to be Optional<> because it needs to be destructed early;
   // LLVM will complain about double-stopping a timer if you tear down a
@@ -706,6 +794,14 @@ UnifiedStatsReporter::~UnifiedStatsReporter()
                                              ElapsedTime.getProcessTime());
   }
 
+  if (!TimingRecordPath.empty())
+    writeTimingRecord(ElapsedTime);
+
+  // When the reporter exists only to serve -emit-timing, there is no
+  // -stats-output-dir to write stats files to.
+  if (!HaveStatsOutputDir)
+    return;
+
   std::error_code EC;
   raw_fd_ostream ostream(StatsFilename, EC, fs::OF_Append | fs::OF_Text);
   if (EC) {
@@ -737,6 +833,29 @@ UnifiedStatsReporter::~UnifiedStatsReporter()
   flushTracesAndProfiles();
 }
 
+// Writes the compact per-file record for -emit-timing: the total wall and
+// process time of the job, its peak resident set size, and the wall time
+// accumulated in each top-level phase. One small JSON object per file, next
+// to the main output, cheap enough to leave enabled on every build.
+void UnifiedStatsReporter::writeTimingRecord(llvm::TimeRecord ElapsedTime) {
+  std::error_code EC;
+  raw_fd_ostream ostream(TimingRecordPath, EC, fs::OF_Text);
+  if (EC) {
+    llvm::errs() << "Error opening -emit-timing file '" << TimingRecordPath
+                 << "' for writing\n";
+    return;
+  }
+  llvm::json::Object Phases;
+  for (const auto &Entry : FrontierEventWallUSec)
+    Phases[Entry.getKey()] = int64_t(Entry.getValue());
+  llvm::json::Object Record{
+      {"wall_usec", int64_t(1000000.0 * ElapsedTime.getWallTime())},
+      {"process_usec", int64_t(1000000.0 * ElapsedTime.getProcessTime())},
+      {"max_rss_bytes", getSelfMaxResidentSetSize()},
+      {"phase_wall_usec", std::move(Phases)}};
+  ostream << llvm::json::Value(std::move(Record)) << '\n';
+}
+
 void
 UnifiedStatsReporter::flushTracesAndProfiles() {
   // Note that we're currently flushing statistics and shouldn't record any
@@ -772,6 +891,36 @@ UnifiedStatsReporter::flushTracesAndProfiles() {
     }
   }
 
+  if (SampledStatsEvents) {
+    std::error_code EC;
+    raw_fd_ostream jstream(SampledEventsFilename, EC,
+                           fs::OF_Append | fs::OF_Text);
+    if (EC) {
+      llvm::errs() << "Error opening -sample-stats-events file '"
+                   << SampledEventsFilename << "' for writing\n";
+      return;
+    }
+    // chrome://tracing JSON: one "complete" event per frontier phase, so the
+    // trace files of all jobs in a build can be concatenated by a merging
+    // tool and viewed on a shared timeline.
+    auto Pid = llvm::sys::Process::getProcessId();
+    jstream << "{\"traceEvents\":[";
+    const char *delim = "\n";
+    for (auto const &E : *SampledStatsEvents) {
+      jstream << delim
+              << "{\"name\":\"" << E.EventName << "\","
+              << "\"cat\":\"swift\",\"ph\":\"X\","
+              << "\"ts\":" << E.BeginUSec << ','
+              << "\"dur\":" << E.DurationUSec << ','
+              << "\"pid\":" << Pid << ",\"tid\":1,"
+              << "\"args\":{\"MallocUsage\":" << E.MallocUsageBytes
+              << ",\"InstructionsExecuted\":" << E.InstructionsExecuted
+              << "}}";
+      delim = ",\n";
+    }
+    jstream << "\n]}\n";
+  }
+
   if (EventProfilers || EntityProfilers) {
     std::error_code EC = llvm::sys::fs::create_directories(ProfileDirname);
     if (EC) {
@@ -806,6 +955,7 @@ UnifiedStatsReporter::flushTracesAndProfiles() {
   }
   LastTracedFrontendCounters.reset();
   FrontendStatsEvents.reset();
+  SampledStatsEvents.reset();
   EventProfilers.reset();
   EntityProfilers.reset();
 }
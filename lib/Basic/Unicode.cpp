@@ -16,6 +16,7 @@
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/ConvertUTF.h"
+#include <cstring>
 
 using namespace swift;
 
@@ -128,8 +129,31 @@ unsigned swift::unicode::extractFirstUnicodeScalar(StringRef S) {
 }
 
 bool swift::unicode::isWellFormedUTF8(StringRef S) {
-  const llvm::UTF8 *begin = S.bytes_begin();
-  return llvm::isLegalUTF8String(&begin, S.bytes_end());
+  const char *Ptr = S.begin();
+  const char *End = S.end();
+  while (Ptr < End) {
+    // Skip runs of ASCII eight bytes at a time; source text is mostly ASCII
+    // even in files that contain non-ASCII identifiers.
+    while (End - Ptr >= 8) {
+      uint64_t Word;
+      memcpy(&Word, Ptr, 8);
+      if (Word & UINT64_C(0x8080808080808080))
+        break;
+      Ptr += 8;
+    }
+    if (Ptr == End)
+      break;
+    if (!(*Ptr & 0x80)) {
+      ++Ptr;
+      continue;
+    }
+    const llvm::UTF8 *Scalar = reinterpret_cast<const llvm::UTF8 *>(Ptr);
+    if (!llvm::isLegalUTF8Sequence(Scalar,
+                                   reinterpret_cast<const llvm::UTF8 *>(End)))
+      return false;
+    Ptr += llvm::getNumBytesForUTF8(*Scalar);
+  }
+  return true;
 }
 
 std::string swift::unicode::sanitizeUTF8(StringRef Text) {
@@ -118,6 +118,15 @@ class SwiftLookupTableReader : public clang::ModuleFileExtensionReader {
   std::unique_ptr<SerializedGlobalsAsMembersTable> GlobalsAsMembersTable;
   std::unique_ptr<SerializedGlobalsAsMembersIndex> GlobalsAsMembersIndex;
 
+  /// Cached key enumerations for the on-disk hash tables above. Enumerating
+  /// keys decodes every key in the table, and clients such as
+  /// code-completion's lookupVisibleDecls ask for them repeatedly.
+  std::optional<SmallVector<SerializedSwiftName, 4>> CachedBaseNames;
+  std::optional<SmallVector<SwiftLookupTable::StoredContext, 4>>
+      CachedGlobalsAsMembersContexts;
+  std::optional<SmallVector<SerializedSwiftName, 4>>
+      CachedGlobalsAsMembersBaseNames;
+
   SwiftLookupTableReader(clang::ModuleFileExtension *extension,
                          clang::ASTReader &reader,
                          clang::serialization::ModuleFile &moduleFile,
@@ -1809,11 +1818,13 @@ SwiftLookupTableReader::create(clang::ModuleFileExtension *extension,
 }
 
 SmallVector<SerializedSwiftName, 4> SwiftLookupTableReader::getBaseNames() {
-  SmallVector<SerializedSwiftName, 4> results;
-  for (auto key : SerializedTable->keys()) {
-    results.push_back(key);
+  if (!CachedBaseNames) {
+    CachedBaseNames.emplace();
+    for (auto key : SerializedTable->keys()) {
+      CachedBaseNames->push_back(key);
+    }
   }
-  return results;
+  return *CachedBaseNames;
 }
 
 bool SwiftLookupTableReader::lookup(
@@ -1830,13 +1841,15 @@ bool SwiftLookupTableReader::lookup(
 
 SmallVector<SwiftLookupTable::StoredContext, 4>
 SwiftLookupTableReader::getGlobalsAsMembersContexts() {
-  SmallVector<SwiftLookupTable::StoredContext, 4> results;
-  if (!GlobalsAsMembersIndex) return results;
-
-  for (auto key : GlobalsAsMembersIndex->keys()) {
-    results.push_back(key);
+  if (!CachedGlobalsAsMembersContexts) {
+    CachedGlobalsAsMembersContexts.emplace();
+    if (GlobalsAsMembersIndex) {
+      for (auto key : GlobalsAsMembersIndex->keys()) {
+        CachedGlobalsAsMembersContexts->push_back(key);
+      }
+    }
   }
-  return results;
+  return *CachedGlobalsAsMembersContexts;
 }
 
 bool SwiftLookupTableReader::lookupGlobalsAsMembersInContext(
@@ -1855,13 +1868,15 @@ bool SwiftLookupTableReader::lookupGlobalsAsMembersInContext(
 
 SmallVector<SerializedSwiftName, 4>
 SwiftLookupTableReader::getGlobalsAsMembersBaseNames() {
-  SmallVector<SerializedSwiftName, 4> results;
-  if (!GlobalsAsMembersTable) return {};
-
-  for (auto key : GlobalsAsMembersTable->keys()) {
-    results.push_back(key);
+  if (!CachedGlobalsAsMembersBaseNames) {
+    CachedGlobalsAsMembersBaseNames.emplace();
+    if (GlobalsAsMembersTable) {
+      for (auto key : GlobalsAsMembersTable->keys()) {
+        CachedGlobalsAsMembersBaseNames->push_back(key);
+      }
+    }
   }
-  return results;
+  return *CachedGlobalsAsMembersBaseNames;
 }
 
 bool SwiftLookupTableReader::lookupGlobalsAsMembers(
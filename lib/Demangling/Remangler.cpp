@@ -392,6 +392,16 @@ public:
             ManglingFlavor Flavor)
       : RemanglerBase(Factory), Flavor(Flavor), Resolver(Resolver) {}
 
+  /// Prepare for mangling another tree, keeping the allocations. The word
+  /// substitutions and merging state refer to positions in the output buffer,
+  /// so they must be dropped together with it.
+  void reset() {
+    RemanglerBase::reset();
+    Words.clear();
+    SubstWordsInIdent.clear();
+    SubstMerging.clear();
+  }
+
   ManglingError mangle(Node *node, unsigned depth) {
     if (depth > Remangler::MaxDepth) {
       return MANGLING_ERROR(ManglingError::TooComplex, node);
@@ -4176,6 +4186,30 @@ ManglingErrorOr<llvm::StringRef> Demangle::mangleNode(NodePointer node,
   return remangler.getBufferStr();
 }
 
+ManglingError Demangle::mangleNodes(
+    const NodePointer *roots, size_t numRoots, SymbolicResolver resolver,
+    NodeFactory &Factory,
+    llvm::function_ref<void(size_t index, llvm::StringRef mangling)> consume,
+    ManglingFlavor Flavor) {
+  Remangler remangler(resolver, Factory, Flavor);
+  for (size_t i = 0; i < numRoots; ++i) {
+    if (i > 0)
+      remangler.reset();
+
+    if (!roots[i]) {
+      consume(i, StringRef());
+      continue;
+    }
+
+    ManglingError err = remangler.mangle(roots[i], 0);
+    if (!err.isSuccess())
+      return err;
+
+    consume(i, remangler.getBufferStr());
+  }
+  return ManglingError::Success;
+}
+
 bool Demangle::isSpecialized(Node *node) {
   // We shouldn't get here with node being NULL; if we do, assert in debug,
   // or return false at runtime (which should at least help diagnose things
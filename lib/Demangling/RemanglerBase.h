@@ -186,6 +186,19 @@ protected:
 
 public:
 
+  /// Prepare for mangling another tree: forget all substitutions and rewind
+  /// the output buffer, keeping the buffer and overflow-map allocations for
+  /// reuse. The node hash cache is kept as well; it stays valid as long as
+  /// the nodes it references are alive, which the batch entry points
+  /// guarantee.
+  void reset() {
+    for (size_t i = 0; i < NumInlineSubsts; ++i)
+      InlineSubstitutions[i] = SubstitutionEntry();
+    NumInlineSubsts = 0;
+    OverflowSubstitutions.clear();
+    Buffer.reset(0);
+  }
+
   /// Append a custom string to the output buffer.
   void append(StringRef str) { Buffer << str; }
 
@@ -23,17 +23,19 @@ using namespace swift::c_string_utils;
 using namespace llvm;
 
 namespace {
-std::string quote(StringRef unquoted) {
-  llvm::SmallString<128> buffer;
-  llvm::raw_svector_ostream os(buffer);
-  for (const auto ch : unquoted) {
-    if (ch == '\\')
-      os << '\\';
-    if (ch == '"')
-      os << '\\';
-    os << ch;
+/// Write \p unquoted to \p out with JSON escaping, without materializing an
+/// escaped copy. Almost none of the strings we emit contain a character that
+/// needs escaping, so scan for the next one and write unescaped runs in bulk.
+void writeQuoted(llvm::raw_ostream &out, StringRef unquoted) {
+  while (true) {
+    size_t pos = unquoted.find_first_of("\\\"");
+    if (pos == StringRef::npos) {
+      out << unquoted;
+      return;
+    }
+    out << unquoted.take_front(pos) << '\\' << unquoted[pos];
+    unquoted = unquoted.drop_front(pos + 1);
   }
-  return buffer.str().str();
 }
 } // namespace
 
@@ -42,15 +44,13 @@ std::string quote(StringRef unquoted) {
 void writeJSONValue(llvm::raw_ostream &out, StringRef value,
                     unsigned indentLevel) {
   out << "\"";
-  out << quote(value);
+  writeQuoted(out, value);
   out << "\"";
 }
 
 void writeJSONValue(llvm::raw_ostream &out, swiftscan_string_ref_t value,
                     unsigned indentLevel) {
-  out << "\"";
-  out << quote(get_C_string(value));
-  out << "\"";
+  writeJSONValue(out, StringRef(get_C_string(value)), indentLevel);
 }
 
 void writeJSONValue(llvm::raw_ostream &out, swiftscan_string_set_t *value_set,
@@ -77,9 +77,9 @@ void writeJSONValue(llvm::raw_ostream &out, bool value, unsigned indentLevel) {
   out.write_escaped(value ? "true" : "false");
 }
 
-/// Write a boolean value as JSON.
+/// Write an integer value as JSON.
 void writeJSONValue(llvm::raw_ostream &out, uint32_t value, unsigned indentLevel) {
-  out.write_escaped(std::to_string(value));
+  out << value;
 }
 
 /// Write a JSON array.
@@ -132,22 +132,16 @@ void writeEncodedModuleIdJSONValue(llvm::raw_ostream &out,
                                    swiftscan_string_ref_t value,
                                    unsigned indentLevel) {
   out << "{\n";
-  static const std::string textualPrefix("swiftTextual");
-  static const std::string binaryPrefix("swiftBinary");
-  static const std::string clangPrefix("clang");
-  std::string valueStr = get_C_string(value);
-  std::string moduleKind;
-  std::string moduleName;
-  if (!valueStr.compare(0, textualPrefix.size(), textualPrefix)) {
+  StringRef moduleKind;
+  StringRef moduleName = get_C_string(value);
+  if (moduleName.consume_front("swiftTextual:")) {
     moduleKind = "swift";
-    moduleName = valueStr.substr(textualPrefix.size() + 1);
-  } else if (!valueStr.compare(0, binaryPrefix.size(), binaryPrefix)) {
+  } else if (moduleName.consume_front("swiftBinary:")) {
     // FIXME: rename to be consistent in the clients (swift-driver)
     moduleKind = "swiftPrebuiltExternal";
-    moduleName = valueStr.substr(binaryPrefix.size() + 1);
   } else {
+    moduleName.consume_front("clang:");
     moduleKind = "clang";
-    moduleName = valueStr.substr(clangPrefix.size() + 1);
   }
   writeJSONSingleField(out, moduleKind, moduleName, indentLevel + 1,
                        /*trailingComma=*/false);
@@ -158,10 +152,10 @@ void writeEncodedModuleIdJSONValue(llvm::raw_ostream &out,
 
 static void writeDependencies(llvm::raw_ostream &out,
                               const swiftscan_string_set_t *dependencies,
-                              std::string dependenciesKind,
+                              StringRef dependenciesKind,
                               unsigned indentLevel, bool trailingComma) {
   out.indent(indentLevel * 2);
-  out << "\"" + dependenciesKind + "\": ";
+  out << "\"" << dependenciesKind << "\": ";
   out << "[\n";
 
   for (size_t i = 0; i < dependencies->count; ++i) {
@@ -417,17 +411,20 @@ void writeJSON(llvm::raw_ostream &out,
     // Module path.
     const char *modulePathSuffix = clangDeps ? ".pcm" : ".swiftmodule";
 
-    std::string modulePath;
-    std::string moduleKindAndName =
-        std::string(get_C_string(moduleInfo.module_name));
-    std::string moduleName =
+    StringRef moduleKindAndName = get_C_string(moduleInfo.module_name);
+    StringRef moduleName =
         moduleKindAndName.substr(moduleKindAndName.find(":") + 1);
+    SmallString<128> modulePathBuf;
+    StringRef modulePath;
     if (swiftBinaryDeps)
       modulePath = get_C_string(swiftBinaryDeps->compiled_module_path);
     else if (clangDeps || swiftTextualDeps)
       modulePath = get_C_string(moduleInfo.module_path);
-    else
-      modulePath = moduleName + modulePathSuffix;
+    else {
+      modulePathBuf = moduleName;
+      modulePathBuf += modulePathSuffix;
+      modulePath = modulePathBuf;
+    }
 
     writeJSONSingleField(out, "modulePath", modulePath, /*indentLevel=*/3,
                          /*trailingComma=*/true);
@@ -458,7 +455,7 @@ void writeJSON(llvm::raw_ostream &out,
       out << "\"swift\": {\n";
       /// Swift interface file, if there is one. The main module, for
       /// example, will not have an interface file.
-      std::string moduleInterfacePath =
+      StringRef moduleInterfacePath =
           swiftTextualDeps->module_interface_path.data
               ? get_C_string(swiftTextualDeps->module_interface_path)
               : "";
@@ -470,10 +467,10 @@ void writeJSON(llvm::raw_ostream &out,
         for (int i = 0,
                  count = swiftTextualDeps->compiled_module_candidates->count;
              i < count; ++i) {
-          const auto &candidate = get_C_string(
-              swiftTextualDeps->compiled_module_candidates->strings[i]);
           out.indent(6 * 2);
-          out << "\"" << quote(candidate) << "\"";
+          writeJSONValue(
+              out,
+              swiftTextualDeps->compiled_module_candidates->strings[i], 6);
           if (i != count - 1)
             out << ",";
           out << "\n";
@@ -485,10 +482,8 @@ void writeJSON(llvm::raw_ostream &out,
       out << "\"commandLine\": [\n";
       for (int i = 0, count = swiftTextualDeps->command_line->count; i < count;
            ++i) {
-        const auto &arg =
-            get_C_string(swiftTextualDeps->command_line->strings[i]);
         out.indent(6 * 2);
-        out << "\"" << quote(arg) << "\"";
+        writeJSONValue(out, swiftTextualDeps->command_line->strings[i], 6);
         if (i != count - 1)
           out << ",";
         out << "\n";
@@ -562,10 +557,9 @@ void writeJSON(llvm::raw_ostream &out,
         for (int i = 0,
                  count = swiftTextualDeps->bridging_pch_command_line->count;
              i < count; ++i) {
-          const auto &arg = get_C_string(
-              swiftTextualDeps->bridging_pch_command_line->strings[i]);
           out.indent(7 * 2);
-          out << "\"" << quote(arg) << "\"";
+          writeJSONValue(
+              out, swiftTextualDeps->bridging_pch_command_line->strings[i], 7);
           if (i != count - 1)
             out << ",";
           out << "\n";
@@ -1027,7 +1027,10 @@ bool swift::dependencies::module_dependency_cache_serialization::
                                      llvm::sys::TimePoint<> &serializedCacheTimeStamp) {
   PrettyStackTraceStringAction stackTrace(
       "loading inter-module dependency graph", path);
-  auto buffer = llvm::MemoryBuffer::getFile(path);
+  // Bitstream doesn't need a null terminator; not requiring one keeps large
+  // cache files mmap-able instead of being read into a private copy.
+  auto buffer = llvm::MemoryBuffer::getFile(path, /*IsText=*/false,
+                                            /*RequiresNullTerminator=*/false);
   if (!buffer)
     return true;
 
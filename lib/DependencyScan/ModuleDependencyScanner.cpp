@@ -939,24 +939,44 @@ void ModuleDependencyScanner::resolveSwiftModuleDependencies(
   if (!isSwiftDependencyKind(rootModuleID.Kind))
     return;
 
+  // Resolve the discovered modules level-by-level rather than one module at
+  // a time: the not-yet-resolved imports of the whole frontier are queried as
+  // one batch of parallel scanning tasks. This keeps the thread pool
+  // saturated when individual modules have few imports, so the serial depth
+  // of the scan is the depth of the dependency graph rather than the number
+  // of modules in it.
   allDiscoveredSwiftModules.insert(rootModuleID);
-  for (unsigned currentModuleIdx = 0;
-       currentModuleIdx < allDiscoveredSwiftModules.size();
-       ++currentModuleIdx) {
-    auto moduleID = allDiscoveredSwiftModules[currentModuleIdx];
-    auto moduleDependencyInfo = cache.findKnownDependency(moduleID);
+  unsigned currentModuleIdx = 0;
+  while (currentModuleIdx < allDiscoveredSwiftModules.size()) {
+    SmallVector<ModuleDependencyID, 8> unresolvedFrontier;
+    for (; currentModuleIdx < allDiscoveredSwiftModules.size();
+         ++currentModuleIdx) {
+      auto moduleID = allDiscoveredSwiftModules[currentModuleIdx];
+      if (!isSwiftDependencyKind(moduleID.Kind))
+        continue;
+      auto moduleDependencyInfo = cache.findKnownDependency(moduleID);
+
+      // If this dependency module's Swift imports are already resolved,
+      // we do not need to scan it.
+      if (!moduleDependencyInfo.getImportedSwiftDependencies().empty()) {
+        for (const auto &dep :
+             moduleDependencyInfo.getImportedSwiftDependencies())
+          allDiscoveredSwiftModules.insert(dep);
+      } else {
+        unresolvedFrontier.push_back(moduleID);
+      }
+    }
+    if (unresolvedFrontier.empty())
+      continue;
 
-    // If this dependency module's Swift imports are already resolved,
-    // we do not need to scan it.
-    if (!moduleDependencyInfo.getImportedSwiftDependencies().empty()) {
-      for (const auto &dep :
-           moduleDependencyInfo.getImportedSwiftDependencies())
-        allDiscoveredSwiftModules.insert(dep);
-    } else {
-      // Find the Swift dependencies of every module this module directly
-      // depends on.
+    // Find the Swift dependencies of every module in the frontier in one
+    // parallel batch, then record the results module-by-module.
+    llvm::StringMap<SwiftModuleScannerQueryResult> moduleLookupResult;
+    scanSwiftImportsOfModules(unresolvedFrontier, cache, moduleLookupResult);
+    for (const auto &moduleID : unresolvedFrontier) {
       ModuleDependencyIDSetVector importedSwiftDependencies;
-      resolveSwiftImportsForModule(moduleID, cache, importedSwiftDependencies);
+      recordSwiftImportsOfModule(moduleID, cache, moduleLookupResult,
+                                 importedSwiftDependencies);
       allDiscoveredSwiftModules.insert(importedSwiftDependencies.begin(),
                                        importedSwiftDependencies.end());
     }
@@ -1231,16 +1251,9 @@ void ModuleDependencyScanner::resolveSwiftOverlayDependencies(
                                    discoveredSwiftOverlays.end());
 }
 
-void ModuleDependencyScanner::resolveSwiftImportsForModule(
-    const ModuleDependencyID &moduleID, ModuleDependenciesCache &cache,
-    ModuleDependencyIDSetVector &importedSwiftDependencies) {
-  PrettyStackTraceStringAction trace("Resolving Swift imports of: ",
-                                     moduleID.ModuleName);
-  if (!isSwiftDependencyKind(moduleID.Kind))
-    return;
-
-  auto moduleDependencyInfo = cache.findKnownDependency(moduleID);
-  llvm::StringMap<SwiftModuleScannerQueryResult> moduleLookupResult;
+void ModuleDependencyScanner::scanSwiftImportsOfModules(
+    ArrayRef<ModuleDependencyID> moduleIDs, ModuleDependenciesCache &cache,
+    llvm::StringMap<SwiftModuleScannerQueryResult> &moduleLookupResult) {
   std::mutex lookupResultLock;
 
   // A scanning task to query a module by-name. If the module already exists
@@ -1268,27 +1281,47 @@ void ModuleDependencyScanner::resolveSwiftImportsForModule(
         }
       };
 
-  // Enque asynchronous lookup tasks
-  for (const auto &dependsOn : moduleDependencyInfo.getModuleImports()) {
-    // Avoid querying the underlying Clang module here
-    if (moduleID.ModuleName == dependsOn.importIdentifier)
-      continue;
-    ScanningThreadPool.async(
-        scanForSwiftModuleDependency,
-        getModuleImportIdentifier(dependsOn.importIdentifier),
-        moduleDependencyInfo.isTestableImport(dependsOn.importIdentifier));
-  }
-  for (const auto &dependsOn :
-       moduleDependencyInfo.getOptionalModuleImports()) {
-    // Avoid querying the underlying Clang module here
-    if (moduleID.ModuleName == dependsOn.importIdentifier)
-      continue;
-    ScanningThreadPool.async(
-        scanForSwiftModuleDependency,
-        getModuleImportIdentifier(dependsOn.importIdentifier),
-        moduleDependencyInfo.isTestableImport(dependsOn.importIdentifier));
+  // Enque asynchronous lookup tasks. Each import name is queried once per
+  // batch; the first module to import a given name decides whether the query
+  // is testable, matching the order in which modules used to be resolved
+  // one-by-one.
+  llvm::StringSet<> enqueuedModuleNames;
+  auto enqueueScanForImport =
+      [this, &enqueuedModuleNames,
+       &scanForSwiftModuleDependency](const ModuleDependencyID &moduleID,
+                                      const ScannerImportStatementInfo &import,
+                                      bool isTestable) {
+        // Avoid querying the underlying Clang module here
+        if (moduleID.ModuleName == import.importIdentifier)
+          return;
+        if (!enqueuedModuleNames.insert(import.importIdentifier).second)
+          return;
+        ScanningThreadPool.async(
+            scanForSwiftModuleDependency,
+            getModuleImportIdentifier(import.importIdentifier), isTestable);
+      };
+  for (const auto &moduleID : moduleIDs) {
+    auto moduleDependencyInfo = cache.findKnownDependency(moduleID);
+    for (const auto &dependsOn : moduleDependencyInfo.getModuleImports())
+      enqueueScanForImport(moduleID, dependsOn,
+                           moduleDependencyInfo.isTestableImport(
+                               dependsOn.importIdentifier));
+    for (const auto &dependsOn :
+         moduleDependencyInfo.getOptionalModuleImports())
+      enqueueScanForImport(moduleID, dependsOn,
+                           moduleDependencyInfo.isTestableImport(
+                               dependsOn.importIdentifier));
   }
   ScanningThreadPool.wait();
+}
+
+void ModuleDependencyScanner::recordSwiftImportsOfModule(
+    const ModuleDependencyID &moduleID, ModuleDependenciesCache &cache,
+    llvm::StringMap<SwiftModuleScannerQueryResult> &moduleLookupResult,
+    ModuleDependencyIDSetVector &importedSwiftDependencies) {
+  PrettyStackTraceStringAction trace("Resolving Swift imports of: ",
+                                     moduleID.ModuleName);
+  auto moduleDependencyInfo = cache.findKnownDependency(moduleID);
 
   auto recordResolvedModuleImport =
       [this, &cache, &moduleLookupResult, &importedSwiftDependencies,
@@ -553,9 +553,39 @@ namespace driver {
       Cmds.clear();
     }
 
+    /// An estimate of how long \p Cmd will run, for scheduling purposes: the
+    /// size of a compile job's single Swift input, or 0 for any other job.
+    uint64_t estimatedJobCost(const Job *Cmd) const {
+      const auto *CJA = dyn_cast<CompileJobAction>(&Cmd->getSource());
+      if (!CJA)
+        return 0;
+      const InputAction *IA = CJA->findSingleSwiftInput();
+      if (!IA)
+        return 0;
+      uint64_t size;
+      if (llvm::sys::fs::file_size(IA->getInputArg().getValue(), size))
+        return 0;
+      return size;
+    }
+
     void addPendingJobsToTaskQueue() {
-      transferJobsToTaskQueue(PendingExecution, "standard");
-      return;
+      // Start the predicted-longest jobs first. The task queue begins tasks
+      // in insertion order, so a big file handed over last runs alone after
+      // every other task has drained. Input size is a crude but serviceable
+      // proxy for compile time; the stable sort keeps the deterministic
+      // compilation-input order for ties and for non-compile jobs.
+      SmallVector<std::pair<uint64_t, const Job *>, 16> costedJobs;
+      for (const Job *Cmd : PendingExecution)
+        costedJobs.emplace_back(estimatedJobCost(Cmd), Cmd);
+      std::stable_sort(costedJobs.begin(), costedJobs.end(),
+                       [](const auto &LHS, const auto &RHS) {
+                         return LHS.first > RHS.first;
+                       });
+      SmallVector<const Job *, 16> orderedJobs;
+      for (const auto &costedJob : costedJobs)
+        orderedJobs.push_back(costedJob.second);
+      transferJobsToTaskQueue(orderedJobs, "standard");
+      PendingExecution.clear();
     }
 
     void runTaskQueueToCompletion() {
@@ -498,6 +498,7 @@ createStatsReporter(const llvm::opt::InputArgList *ArgList,
                                                  false,
                                                  false,
                                                  false,
+                                                 false,
                                                  false);
 }
 
@@ -2400,6 +2400,7 @@ public:
     }
     CheckerOpts.CompilerStyle =
         CompilerStyleDiags || !SerializedDiagPath.empty();
+    CheckerOpts.CompactJSON = ParsedArgs.hasArg(OPT_compact_json);
     for (auto Arg : Args)
       CheckerOpts.ToolArgs.push_back(Arg);
     for(auto spi: ParsedArgs.getAllArgValues(OPT_ignore_spi_groups))
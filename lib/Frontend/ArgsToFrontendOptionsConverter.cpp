@@ -487,6 +487,9 @@ void ArgsToFrontendOptionsConverter::computeDebugTimeOptions() {
     if (Args.getLastArg(OPT_trace_stats_events)) {
       Opts.TraceStats = true;
     }
+    if (Args.getLastArg(OPT_sample_stats_events)) {
+      Opts.SampleEvents = true;
+    }
     if (Args.getLastArg(OPT_profile_stats_events)) {
       Opts.ProfileEvents = true;
     }
@@ -494,6 +497,7 @@ void ArgsToFrontendOptionsConverter::computeDebugTimeOptions() {
       Opts.ProfileEntities = true;
     }
   }
+  Opts.EmitTiming |= Args.hasArg(OPT_emit_timing);
 }
 
 void ArgsToFrontendOptionsConverter::computeTBDOptions() {
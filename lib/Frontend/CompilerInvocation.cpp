@@ -2008,6 +2008,9 @@ static bool ParseTypeCheckerArgs(TypeCheckerOptions &Opts, ArgList &Args,
   if (Args.getLastArg(OPT_solver_disable_splitter))
     Opts.SolverDisableSplitter = true;
 
+  if (const Arg *A = Args.getLastArg(OPT_solver_trace_path_EQ))
+    Opts.SolverTracePath = A->getValue();
+
   if (Args.hasArg(OPT_solver_enable_prepared_overloads) ||
       Args.hasArg(OPT_solver_disable_prepared_overloads))
     Opts.SolverEnablePreparedOverloads = Args.hasArg(OPT_solver_enable_prepared_overloads);
@@ -2353,6 +2356,9 @@ static bool ParseSearchPathArgs(SearchPathOptions &Opts, ArgList &Args,
   if (const Arg *A = Args.getLastArg(OPT_in_process_plugin_server_path))
     Opts.InProcessPluginServerPath = A->getValue();
 
+  if (const Arg *A = Args.getLastArg(OPT_macro_expansion_cache_path))
+    Opts.MacroExpansionCachePath = A->getValue();
+
   // All plugin search options, i.e. '-load-plugin-library',
   // '-load-plugin-executable', '-plugin-path', and  '-external-plugin-path'
   // are grouped, and plugins are searched by the order of these options.
@@ -3830,6 +3836,10 @@ static bool ParseIRGenArgs(IRGenOptions &Opts, ArgList &Args,
     Opts.InternalizeAtLink = true;
   }
 
+  if (Args.hasArg(OPT_prune_unused_metadata)) {
+    Opts.PruneUnusedMetadata = true;
+  }
+
   Opts.InternalizeSymbols = FrontendOpts.Static;
 
   if (Args.hasArg(OPT_disable_preallocated_instantiation_caches)) {
@@ -379,7 +379,7 @@ void CompilerInstance::setupStatsReporter() {
   const auto &Invoke = getInvocation();
   const std::string &StatsOutputDir =
       Invoke.getFrontendOptions().StatsOutputDir;
-  if (StatsOutputDir.empty())
+  if (StatsOutputDir.empty() && !Invoke.getFrontendOptions().EmitTiming)
     return;
 
   auto silOptModeArgStr = [](OptimizationMode mode) -> StringRef {
@@ -418,9 +418,22 @@ void CompilerInstance::setupStatsReporter() {
       getClangSourceManager(getASTContext()),
       Invoke.getFrontendOptions().FineGrainedTimers,
       Invoke.getFrontendOptions().TraceStats,
+      Invoke.getFrontendOptions().SampleEvents,
       Invoke.getFrontendOptions().ProfileEvents,
       Invoke.getFrontendOptions().ProfileEntities,
       Invoke.getFrontendOptions().PrintZeroStats);
+  if (FEOpts.EmitTiming) {
+    // Put the timing record next to the main output; fall back to the
+    // module name for jobs writing to stdout.
+    SmallString<128> timingPath(OutFile);
+    if (timingPath.empty() || timingPath == "-") {
+      timingPath = FEOpts.ModuleName;
+      timingPath += ".timing.json";
+    } else {
+      llvm::sys::path::replace_extension(timingPath, "timing.json");
+    }
+    Reporter->setTimingRecordPath(timingPath);
+  }
   // Hand the stats reporter down to the ASTContext so the rest of the compiler
   // can use it.
   getASTContext().setStatsReporter(Reporter.get());
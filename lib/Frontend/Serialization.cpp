@@ -15,14 +15,52 @@
 #include "swift/AST/DiagnosticsFrontend.h"
 #include "swift/AST/FileSystem.h"
 #include "swift/Basic/Assertions.h"
+#include "swift/Basic/SharedThreadPool.h"
 #include "swift/Subsystems.h"
 #include "swift/SymbolGraphGen/SymbolGraphGen.h"
 #include "swift/SymbolGraphGen/SymbolGraphOptions.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/VirtualOutputBackend.h"
+#include "llvm/Support/VirtualOutputConfig.h"
 
 using namespace swift;
 
+namespace {
+/// An output that has been serialized to memory and is waiting to be
+/// written to disk.
+struct PendingOutput {
+  std::string Path;
+  llvm::SmallString<1024> Buffer;
+  /// Set by the writer if the write failed.
+  std::optional<std::string> ErrorMessage;
+  /// Whether a recorded failure happened while opening the output (as
+  /// opposed to while finalizing it).
+  bool FailedToOpen = false;
+};
+} // end anonymous namespace
+
+/// Write a serialized buffer to disk through the output backend.
+///
+/// This is safe to call from a thread other than the main thread: output
+/// backends are required to be thread-safe, and failures are recorded on
+/// \p output rather than diagnosed directly.
+static void writePendingOutput(llvm::vfs::OutputBackend &backend,
+                               PendingOutput &output) {
+  llvm::vfs::OutputConfig config;
+  config.setAtomicWrite().setOnlyIfDifferent();
+
+  auto outputFile = backend.createFile(output.Path, config);
+  if (!outputFile) {
+    output.ErrorMessage = toString(outputFile.takeError());
+    output.FailedToOpen = true;
+    return;
+  }
+  *outputFile << output.Buffer;
+  if (auto error = outputFile->keep())
+    output.ErrorMessage = toString(std::move(error));
+}
+
 static ModuleDecl *getModule(ModuleOrSourceFile DC) {
   if (auto M = DC.dyn_cast<ModuleDecl *>())
     return M;
@@ -144,46 +182,81 @@ void swift::serialize(
     return;
   }
 
-  bool hadError = withOutputPath(
-      getContext(DC).Diags, getContext(DC).getOutputBackend(),
-      options.OutputPath, [&](raw_ostream &out) {
-        FrontendStatsTracer tracer(getContext(DC).Stats,
-                                   "Serialization, swiftmodule");
-        serialization::writeToStream(out, DC, M, options, DG);
-        return false;
-      });
-  if (hadError)
-    return;
+  auto &context = getContext(DC);
+
+  // Serialize each output to memory first.  The AST is not thread-safe, so
+  // the serializers all run on this thread; the finished buffers can then
+  // be written out in parallel, which matters at the tail of a frontend job
+  // when the outputs land on a slow (e.g. network) filesystem.
+  llvm::SmallVector<PendingOutput, 3> pendingOutputs;
+  auto serializeTo = [&](StringRef path, StringRef statsEvent,
+                         llvm::function_ref<void(raw_ostream &)> write) {
+    FrontendStatsTracer tracer(context.Stats, statsEvent);
+    pendingOutputs.emplace_back();
+    pendingOutputs.back().Path = path.str();
+    llvm::raw_svector_ostream stream(pendingOutputs.back().Buffer);
+    write(stream);
+  };
+
+  serializeTo(options.OutputPath, "Serialization, swiftmodule",
+              [&](raw_ostream &out) {
+                serialization::writeToStream(out, DC, M, options, DG);
+              });
 
   if (!options.DocOutputPath.empty()) {
-    (void)withOutputPath(
-        getContext(DC).Diags, getContext(DC).getOutputBackend(),
-        options.DocOutputPath, [&](raw_ostream &out) {
-          FrontendStatsTracer tracer(getContext(DC).Stats,
-                                     "Serialization, swiftdoc");
-          serialization::writeDocToStream(out, DC, options.GroupInfoPath);
-          return false;
-        });
+    serializeTo(options.DocOutputPath, "Serialization, swiftdoc",
+                [&](raw_ostream &out) {
+                  serialization::writeDocToStream(out, DC,
+                                                  options.GroupInfoPath);
+                });
   }
 
   if (!options.SourceInfoOutputPath.empty()) {
-    (void)withOutputPath(
-        getContext(DC).Diags, getContext(DC).getOutputBackend(),
-        options.SourceInfoOutputPath, [&](raw_ostream &out) {
-          FrontendStatsTracer tracer(getContext(DC).Stats,
-                                     "Serialization, swiftsourceinfo");
-          serialization::writeSourceInfoToStream(out, DC);
-          return false;
-        });
+    serializeTo(options.SourceInfoOutputPath, "Serialization, swiftsourceinfo",
+                [&](raw_ostream &out) {
+                  serialization::writeSourceInfoToStream(out, DC);
+                });
   }
 
-  if (!symbolGraphOptions.OutputDir.empty()) {
-    if (isa<ModuleDecl *>(DC)) {
-      auto *M = cast<ModuleDecl *>(DC);
-      FrontendStatsTracer tracer(getContext(DC).Stats,
-                                 "Serialization, symbolgraph");
-      symbolgraphgen::emitSymbolGraphForModule(M, symbolGraphOptions);
+  auto emitSymbolGraph = [&] {
+    if (!symbolGraphOptions.OutputDir.empty()) {
+      if (isa<ModuleDecl *>(DC)) {
+        auto *M = cast<ModuleDecl *>(DC);
+        FrontendStatsTracer tracer(context.Stats, "Serialization, symbolgraph");
+        symbolgraphgen::emitSymbolGraphForModule(M, symbolGraphOptions);
+      }
     }
+  };
+
+  auto &backend = context.getOutputBackend();
+  if (pendingOutputs.size() > 1) {
+    // Overlap the writes with each other and with symbol graph emission.
+    llvm::ThreadPoolTaskGroup group(getSharedThreadPool());
+    for (auto &output : pendingOutputs)
+      group.async(
+          [&backend, &output] { writePendingOutput(backend, output); });
+    emitSymbolGraph();
+    group.wait();
+  } else {
+    for (auto &output : pendingOutputs)
+      writePendingOutput(backend, output);
+    emitSymbolGraph();
+  }
+
+  // The diagnostic engine is not thread-safe, so write failures are only
+  // reported now that the writers have finished.
+  bool hadError = false;
+  for (auto &output : pendingOutputs) {
+    if (!output.ErrorMessage)
+      continue;
+    hadError = true;
+    context.Diags.diagnose(SourceLoc(),
+                           output.FailedToOpen ? diag::error_opening_output
+                                               : diag::error_closing_output,
+                           output.Path, *output.ErrorMessage);
   }
+  if (hadError)
+    return;
+
   emitABIDescriptor(DC, options);
 }
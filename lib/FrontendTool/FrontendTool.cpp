@@ -2258,7 +2258,9 @@ public:
 int swift::performFrontend(ArrayRef<const char *> Args,
                            const char *Argv0, void *MainAddr,
                            FrontendObserver *observer) {
-  INITIALIZE_LLVM();
+  // The LLVM target machinery is initialized lazily, via
+  // initializeLLVMTargetsOnce() on the paths that create a TargetMachine;
+  // jobs that never reach IRGen skip the registration cost entirely.
   llvm::EnablePrettyStackTraceOnSigInfoForThisThread();
 
   std::unique_ptr<CompilerInstance> Instance =
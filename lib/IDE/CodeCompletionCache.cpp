@@ -105,11 +105,14 @@ CodeCompletionCache::~CodeCompletionCache() {}
 /// This should be incremented any time we commit a change to the format of the
 /// cached results. This isn't expected to change very often.
 static constexpr uint32_t onDiskCompletionCacheVersion =
-    12; // Removed 'IsAsync'.
+    13; // NUL-terminated entries in the STRINGS section.
 
 /// Deserializes CodeCompletionResults from \p in and stores them in \p V.
+///
+/// On success, takes ownership of \p in: the deserialized results reference
+/// strings in the buffer directly instead of copying them.
 /// \see writeCacheModule.
-static bool readCachedModule(llvm::MemoryBuffer *in,
+static bool readCachedModule(std::unique_ptr<llvm::MemoryBuffer> in,
                              const CodeCompletionCache::Key &K,
                              CodeCompletionCache::Value &V,
                              bool allowOutOfDate = false) {
@@ -160,20 +163,15 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
   (void)typesSize; // so it is not seen as "unused" in release builds.
 
   // STRINGS
-  llvm::DenseMap<uint32_t, NullTerminatedStringRef> knownStrings;
+  // Each entry is NUL-terminated in the file, so the results can reference
+  // the (memory-mapped) buffer directly instead of copying the string.
   auto getString = [&](uint32_t index) -> NullTerminatedStringRef {
     if (index == ~0u)
       return "";
-    auto found = knownStrings.find(index);
-    if (found != knownStrings.end()) {
-      return found->second;
-    }
 
     const char *p = strings + index;
     size_t size = read32le(p);
-    auto str = NullTerminatedStringRef(StringRef(p, size), *V.Allocator);
-    knownStrings[index] = str;
-    return str;
+    return NullTerminatedStringRef(p, size);
   };
 
   // TYPES
@@ -278,6 +276,8 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
     V.Results.push_back(result);
   }
 
+  // The results hold StringRefs into the buffer; keep it alive with them.
+  V.SourceBuffer = std::move(in);
   return true;
 }
 
@@ -302,7 +302,9 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
 ///       CodeCompletionString::Chunks.
 ///
 ///   STRINGS
-///     * A blob of length-prefixed strings referred to in CHUNKS or RESULTS.
+///     * A blob of length-prefixed, NUL-terminated strings referred to in
+///       CHUNKS or RESULTS. The terminators let readers reference the strings
+///       in the memory-mapped file instead of copying them.
 static void writeCachedModule(llvm::raw_ostream &out,
                               const CodeCompletionCache::Key &K,
                               CodeCompletionCache::Value &V) {
@@ -360,6 +362,8 @@ static void writeCachedModule(llvm::raw_ostream &out,
     llvm::support::endian::Writer LE(strings, llvm::endianness::little);
     LE.write(static_cast<uint32_t>(str.size()));
     strings << str;
+    // NUL-terminate so readers can reference the string in place.
+    strings << '\0';
     knownStrings[str] = size;
     return static_cast<uint32_t>(size);
   };
@@ -509,14 +513,17 @@ static std::string getName(StringRef cacheDirectory,
 
 std::optional<CodeCompletionCache::ValueRefCntPtr>
 OnDiskCodeCompletionCache::get(const Key &K) {
-  // Try to find the cached file.
-  auto bufferOrErr = llvm::MemoryBuffer::getFile(getName(cacheDirectory, K));
+  // Try to find the cached file. The strings inside carry their own NUL
+  // terminators, so the buffer doesn't need one and can always be mmap'ed.
+  auto bufferOrErr =
+      llvm::MemoryBuffer::getFile(getName(cacheDirectory, K), /*IsText=*/false,
+                                  /*RequiresNullTerminator=*/false);
   if (!bufferOrErr)
     return std::nullopt;
 
   // Read the cached results, failing if they are out of date.
   auto V = CodeCompletionCache::createValue();
-  if (!readCachedModule(bufferOrErr.get().get(), K, *V))
+  if (!readCachedModule(std::move(*bufferOrErr), K, *V))
     return std::nullopt;
 
   return V;
@@ -552,7 +559,8 @@ std::error_code OnDiskCodeCompletionCache::set(const Key &K, ValueRefCntPtr V) {
 std::optional<CodeCompletionCache::ValueRefCntPtr>
 OnDiskCodeCompletionCache::getFromFile(StringRef filename) {
   // Try to find the cached file.
-  auto bufferOrErr = llvm::MemoryBuffer::getFile(filename);
+  auto bufferOrErr = llvm::MemoryBuffer::getFile(filename, /*IsText=*/false,
+                                                 /*RequiresNullTerminator=*/false);
   if (!bufferOrErr)
     return std::nullopt;
 
@@ -570,7 +578,7 @@ OnDiskCodeCompletionCache::getFromFile(StringRef filename) {
 
   // Read the cached results.
   auto V = CodeCompletionCache::createValue();
-  if (!readCachedModule(bufferOrErr.get().get(), K, *V,
+  if (!readCachedModule(std::move(*bufferOrErr), K, *V,
                         /*allowOutOfDate*/ true))
     return std::nullopt;
 
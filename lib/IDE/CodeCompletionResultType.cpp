@@ -433,6 +433,13 @@ calculateMaxTypeRelation(Type Ty, const ExpectedTypeContext &typeContext,
   if (typeContext.empty())
     return TypeRelation::Unknown;
 
+  // Completion results frequently share a type (e.g. every 'Int' property in
+  // a large member list), so relations are memoized on the type context by
+  // canonical type.
+  if (auto Cached = typeContext.getCachedTypeRelation(Ty))
+    return *Cached;
+  const Type OriginalTy = Ty;
+
   if (auto funcTy = Ty->getAs<AnyFunctionType>())
     Ty = funcTy->removeArgumentLabels(1);
 
@@ -459,6 +466,7 @@ calculateMaxTypeRelation(Type Ty, const ExpectedTypeContext &typeContext,
   if (typeContext.isImpliedResult() && Result == TypeRelation::Invalid)
     Result = TypeRelation::Unrelated;
 
+  typeContext.cacheTypeRelation(OriginalTy, Result);
   return Result;
 }
 
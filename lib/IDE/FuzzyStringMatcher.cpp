@@ -23,6 +23,13 @@ using clang::toLowercase;
 using clang::isUppercase;
 using clang::isLowercase;
 
+/// Map a byte to one of 64 character classes for the match prefilter.
+/// ASCII letters fold case so 'A' and 'a' land on the same bit; collisions
+/// between other bytes only ever make the filter more conservative.
+static inline uint64_t charClassBit(char c) {
+  return 1ULL << ((static_cast<unsigned char>(c) | 0x20) & 63);
+}
+
 FuzzyStringMatcher::FuzzyStringMatcher(StringRef pattern_)
     : pattern(pattern_), charactersInPattern(1 << (sizeof(char) * 8)) {
   lowercasePattern.reserve(pattern.size());
@@ -33,6 +40,7 @@ FuzzyStringMatcher::FuzzyStringMatcher(StringRef pattern_)
     lowercasePattern.push_back(lower);
     charactersInPattern.set(static_cast<unsigned char>(lower));
     charactersInPattern.set(static_cast<unsigned char>(toUppercase(c)));
+    patternCharMask |= charClassBit(c);
   }
   assert(pattern.size() == lowercasePattern.size());
 
@@ -58,6 +66,17 @@ bool FuzzyStringMatcher::matchesCandidate(StringRef candidate) const {
   if (patternLength > candidateLength)
     return false;
 
+  // OR together the character classes present in the candidate -- a
+  // branchless loop the compiler can vectorize -- and reject the candidate
+  // outright if some pattern character never occurs in it. When filtering a
+  // large index with a selective pattern this prunes most candidates without
+  // entering the per-character loop below.
+  uint64_t candidateMask = 0;
+  for (char c : candidate)
+    candidateMask |= charClassBit(c);
+  if (patternCharMask & ~candidateMask)
+    return false;
+
   // Do all of the pattern characters match the candidate in order?
   unsigned pidx = 0, cidx = 0;
   while (pidx < patternLength && cidx < candidateLength) {
@@ -535,3 +554,11 @@ CandidateSpecificMatcher::scoreCandidateTrial(unsigned firstPatternPos) {
 
   return trialScore;
 }
+
+void FuzzyStringMatcher::scoreCandidates(ArrayRef<StringRef> candidates,
+                                         MutableArrayRef<double> scores) const {
+  assert(candidates.size() == scores.size());
+  for (unsigned i = 0, e = candidates.size(); i != e; ++i)
+    scores[i] =
+        matchesCandidate(candidates[i]) ? scoreCandidate(candidates[i]) : 0.0;
+}
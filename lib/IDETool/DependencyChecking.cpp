@@ -74,16 +74,15 @@ static void cacheDependencyHashIfNeeded(CompilerInstance &CI,
     if (Map.count(filename))
       return false;
 
-    auto stat = FS.status(filename);
-    if (!stat)
-      return false;
-
-    // We will check the hash only if the modification time of the dependecy
-    // is zero. See 'areAnyDependentFilesInvalidated() below'.
-    if (stat->getLastModificationTime() != llvm::sys::TimePoint<>())
+    auto buf = FS.getBufferForFile(filename);
+    if (!buf)
       return false;
 
-    auto buf = FS.getBufferForFile(filename);
+    // Hash every dependency, not just virtual files with a zero modification
+    // time: a dependency whose timestamp is newer but whose content is
+    // unchanged (e.g. a sibling file saved with only comment or body edits,
+    // or a module rebuilt to identical output) can then still be considered
+    // up-to-date in 'areAnyDependentFilesInvalidated()' below.
     Map[filename] = llvm::hash_value(buf.get()->getBuffer());
     return false;
   });
@@ -104,32 +103,30 @@ areAnyDependentFilesInvalidated(CompilerInstance &CI, llvm::vfs::FileSystem &FS,
           return true;
 
         auto lastModTime = stat->getLastModificationTime();
-        if (lastModTime > timestamp)
-          // Modified.
+        if (lastModTime <= timestamp && lastModTime != llvm::sys::TimePoint<>())
+          // Not modified since the last check. A zero modification time means
+          // the file is probably from a virtual file system, where timestamps
+          // are meaningless; fall through to the content check.
+          return false;
+
+        // The timestamp is newer (or meaningless), but the content may still
+        // be unchanged. Get the hash code of the last content.
+        auto oldHashEntry = Map.find(filePath);
+        if (oldHashEntry == Map.end())
+          // The dependency couldn't be read when the hashes were cached.
           return true;
+        auto oldHash = oldHashEntry->second;
 
-        // If the last modification time is zero, this file is probably from a
-        // virtual file system. We need to check the content.
-        if (lastModTime == llvm::sys::TimePoint<>()) {
-          // Get the hash code of the last content.
-          auto oldHashEntry = Map.find(filePath);
-          if (oldHashEntry == Map.end())
-            // Unreachable? Not virtual in old filesystem, but virtual in new
-            // one.
-            return true;
-          auto oldHash = oldHashEntry->second;
-
-          // Calculate the hash code of the current content.
-          auto newContent = FS.getBufferForFile(filePath);
-          if (!newContent)
-            // Unreachable? stat succeeded, but couldn't get the content.
-            return true;
-
-          auto newHash = llvm::hash_value(newContent.get()->getBuffer());
-
-          if (oldHash != newHash)
-            return true;
-        }
+        // Calculate the hash code of the current content.
+        auto newContent = FS.getBufferForFile(filePath);
+        if (!newContent)
+          // Unreachable? stat succeeded, but couldn't get the content.
+          return true;
+
+        auto newHash = llvm::hash_value(newContent.get()->getBuffer());
+
+        if (oldHash != newHash)
+          return true;
 
         return false;
       });
@@ -27,7 +27,9 @@ void cacheDependencyHashIfNeeded(CompilerInstance &CI,
                                  std::optional<unsigned> excludeBufferID,
                                  llvm::StringMap<llvm::hash_code> &Map);
 
-/// Check if any dependent files are modified since \p timestamp. If
+/// Check if any dependent files are modified since \p timestamp. A file whose
+/// timestamp is newer but whose content still matches the hash cached in
+/// \p Map is not considered modified. If
 /// \p excludeBufferID is specified, other source files are considered
 /// "dependencies", otherwise all source files are considered "current".
 /// \p Map should be the map populated by \c cacheDependencyHashIfNeeded at the
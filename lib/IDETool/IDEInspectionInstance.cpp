@@ -17,6 +17,7 @@
 #include "swift/AST/DiagnosticEngine.h"
 #include "swift/AST/DiagnosticsFrontend.h"
 #include "swift/AST/Module.h"
+#include "swift/AST/NameLookup.h"
 #include "swift/AST/PluginLoader.h"
 #include "swift/AST/PrettyStackTrace.h"
 #include "swift/AST/SourceFile.h"
@@ -384,7 +385,11 @@ bool IDEInspectionInstance::performCachedOperationIfPossible(
     SM.recordSourceFile(newBufferID, oldSF);
 
     AFD->setBodyToBeReparsed(newBodyRange);
-    oldSF->clearScope();
+
+    // Only the body's scopes are stale; splice that subtree out and keep
+    // the rest of the scope tree.
+    if (!ASTScope::unexpandFunctionBody(AFD))
+      oldSF->clearScope();
 
     traceDC = AFD;
     break;
@@ -1603,8 +1603,9 @@ bool IRGenerator::hasLazyMetadata(TypeDecl *type) {
       case AccessLevel::Open:
       case AccessLevel::Public:
       case AccessLevel::Package:
-        // We can't remove metadata for externally visible types.
-        return false;
+        // We can't remove metadata for externally visible types, unless the
+        // user promised that no external client requests it.
+        return Opts.PruneUnusedMetadata && SIL.isWholeModule();
       case AccessLevel::Internal:
         // In non-whole-module mode, internal types are also visible externally.
         return SIL.isWholeModule();
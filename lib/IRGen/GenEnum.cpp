@@ -7283,13 +7283,13 @@ MultiPayloadEnumImplStrategy::completeFixedLayout(TypeConverter &TC,
     spareBits = CommonSpareBits;
 
     // Mark the bits we'll use as occupied in both bitsets.
-    // We take bits starting from the most significant.
+    // We take bits starting from the most significant, skipping over the
+    // occupied bits a word at a time.
     unsigned remainingTagBits = numTagBits;
-    for (unsigned bit = CommonSpareBits.size() - 1; true; --bit) {
-      if (!CommonSpareBits[bit]) {
-        assert(bit > 0 && "ran out of spare bits?!");
-        continue;
-      }
+    for (size_t bit =
+             CommonSpareBits.findPreviousSetBit(CommonSpareBits.size());
+         true; bit = CommonSpareBits.findPreviousSetBit(bit)) {
+      assert(bit != ClusteredBitVector::npos && "ran out of spare bits?!");
 
       // Use this bit as a payload tag bit.
       PayloadTagBits.setBit(bit);
@@ -7298,7 +7298,6 @@ MultiPayloadEnumImplStrategy::completeFixedLayout(TypeConverter &TC,
       spareBits.clearBit(bit);
 
       if (--remainingTagBits == 0) break;
-      assert(bit > 0 && "ran out of spare bits?!");
     }
     assert(PayloadTagBits.count() == numTagBits);
   }
@@ -131,6 +131,11 @@ namespace {
     mutable Signature TheSignature;
     mutable Signature TheCXXConstructorSignature;
 
+    /// Signatures for special function-pointer kinds. The same SIL type
+    /// lowers differently per kind, so they cannot share TheSignature.
+    mutable llvm::SmallVector<std::pair<unsigned, Signature>, 1>
+        SpecialSignatures;
+
   public:
     FuncSignatureInfo(CanSILFunctionType formalType)
       : FormalType(formalType) {}
@@ -139,6 +144,8 @@ namespace {
     getCXXConstructorSignature(const clang::CXXConstructorDecl *cxxCtorDecl,
                                IRGenModule &IGM) const;
     Signature getSignature(IRGenModule &IGM) const;
+    Signature getSpecialSignature(FunctionPointerKind kind,
+                                  IRGenModule &IGM) const;
   };
 
   class ObjCFuncSignatureInfo : public FuncSignatureInfo {
@@ -682,6 +689,19 @@ Signature FuncSignatureInfo::getSignature(IRGenModule &IGM) const {
   return TheSignature;
 }
 
+Signature FuncSignatureInfo::getSpecialSignature(FunctionPointerKind kind,
+                                                 IRGenModule &IGM) const {
+  assert(kind.isSpecial());
+  auto key = unsigned(kind.getSpecialKind());
+  for (auto &entry : SpecialSignatures)
+    if (entry.first == key)
+      return entry.second;
+
+  auto signature = Signature::getUncached(IGM, FormalType, kind);
+  SpecialSignatures.push_back({key, signature});
+  return signature;
+}
+
 Signature FuncSignatureInfo::getCXXConstructorSignature(
     const clang::CXXConstructorDecl *cxxCtorDecl, IRGenModule &IGM) const {
   // If it's already been filled in, we're done.
@@ -745,12 +765,14 @@ Signature
 IRGenModule::getSignature(CanSILFunctionType type, FunctionPointerKind kind,
                           bool forStaticCall,
                           const clang::CXXConstructorDecl *cxxCtorDecl) {
-  // Don't bother caching if we're working with a special kind.
-  if (kind.isSpecial())
-    return Signature::getUncached(*this, type, kind);
-
   auto &sigInfo = getFuncSignatureInfoForLowered(*this, type);
 
+  // Special kinds are looked up for every await and task call, so they are
+  // worth caching too; they get their own per-kind cache on the signature
+  // info because they lower the same SIL type differently.
+  if (kind.isSpecial())
+    return sigInfo.getSpecialSignature(kind, *this);
+
   if (forStaticCall &&
       type->getRepresentation() == SILFunctionType::Representation::ObjCMethod) {
     auto &objcSigInfo = static_cast<const ObjCFuncSignatureInfo &>(sigInfo);
@@ -553,7 +553,16 @@ std::pair<llvm::Constant *, unsigned>
 IRGenModule::getTypeRef(CanType type, CanGenericSignature sig,
                         MangledTypeRefRole role) {
   type = substOpaqueTypesWithUnderlyingTypes(type);
-  return getTypeRefImpl(*this, type, sig, role);
+
+  auto key = std::make_pair(std::make_pair(type, sig.getPointer()),
+                            unsigned(role));
+  auto known = TypeRefs.find(key);
+  if (known != TypeRefs.end())
+    return known->second;
+
+  auto result = getTypeRefImpl(*this, type, sig, role);
+  TypeRefs.insert({key, result});
+  return result;
 }
 
 std::pair<llvm::Constant *, unsigned>
@@ -570,7 +579,16 @@ IRGenModule::getLoweredTypeRef(SILType loweredType,
   auto substTy =
     substOpaqueTypesWithUnderlyingTypes(loweredType, genericSig);
   auto type = substTy.getASTType();
-  return getTypeRefImpl(*this, type, genericSig, role);
+
+  auto key = std::make_pair(std::make_pair(type, genericSig.getPointer()),
+                            unsigned(role));
+  auto known = TypeRefs.find(key);
+  if (known != TypeRefs.end())
+    return known->second;
+
+  auto result = getTypeRefImpl(*this, type, genericSig, role);
+  TypeRefs.insert({key, result});
+  return result;
 }
 
 /// Emit a mangled string referencing a specific protocol conformance, so that
@@ -1686,6 +1704,15 @@ llvm::Constant *IRGenModule::getAddrOfFieldName(StringRef Name) {
   }
   entry = createStringConstant(ReflName, /*willBeRelativelyAddressed*/ true,
                                getReflectionStringsSectionName());
+
+  // The same field names occur in many translation units. Give the string a
+  // content-derived symbol name and ODR linkage so that the static linker
+  // coalesces the copies, like it already does for typeref strings.
+  llvm::SmallString<256> symbolName("field name ");
+  symbolName += ReflName;
+  entry.first->setName(symbolName);
+  ApplyIRLinkage(IRLinkage::InternalLinkOnceODR).to(entry.first);
+
   disableAddressSanitizer(*this, entry.first);
   return entry.second;
 }
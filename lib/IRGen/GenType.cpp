@@ -1453,11 +1453,34 @@ TypeConverter::createOpaqueImmovable(llvm::Type *type, Alignment align) {
 
 static TypeInfo *invalidTypeInfo() { return (TypeInfo*) 1; }
 
-bool TypeConverter::readLegacyTypeInfo(llvm::vfs::FileSystem &fs,
-                                       StringRef path) {
+namespace {
+/// A parsed legacy type info file.
+struct LegacyTypeInfoFile {
+  llvm::StringMap<YAMLTypeInfoNode> Infos;
+  bool Error = false;
+};
+} // end anonymous namespace
+
+/// Parsed legacy type info files, keyed by path and shared by all
+/// TypeConverters of the process: the files are immutable for the duration
+/// of a build, and in multi-threaded compilation every IGM would otherwise
+/// re-parse the same file. IGMs - and with them TypeConverters - are
+/// constructed serially, so no locking is needed.
+static llvm::StringMap<LegacyTypeInfoFile> ParsedLegacyTypeInfoFiles;
+
+static LegacyTypeInfoFile &parseLegacyTypeInfo(llvm::vfs::FileSystem &fs,
+                                               StringRef path) {
+  auto known = ParsedLegacyTypeInfoFiles.find(path);
+  if (known != ParsedLegacyTypeInfoFiles.end())
+    return known->second;
+
+  auto &parsed = ParsedLegacyTypeInfoFiles[path];
+
   auto fileOrErr = fs.getBufferForFile(path);
-  if (!fileOrErr)
-    return true;
+  if (!fileOrErr) {
+    parsed.Error = true;
+    return parsed;
+  }
 
   auto file = std::move(fileOrErr.get());
 
@@ -1467,19 +1490,31 @@ bool TypeConverter::readLegacyTypeInfo(llvm::vfs::FileSystem &fs,
   std::vector<YAMLModuleNode> modules;
   yin >> modules;
 
-  if (yin.error())
-    return true;
+  if (yin.error()) {
+    parsed.Error = true;
+    return parsed;
+  }
 
   for (auto &module : modules) {
     for (auto &decl : module.Decls) {
-      auto result = LegacyTypeInfos.insert(std::make_pair(
-                                             decl.Name,
-                                             decl));
+      auto result = parsed.Infos.insert(std::make_pair(
+                                          decl.Name,
+                                          decl));
       assert(result.second);
       (void) result;
     }
   }
 
+  return parsed;
+}
+
+bool TypeConverter::readLegacyTypeInfo(llvm::vfs::FileSystem &fs,
+                                       StringRef path) {
+  auto &parsed = parseLegacyTypeInfo(fs, path);
+  if (parsed.Error)
+    return true;
+
+  LegacyTypeInfos = &parsed.Infos;
   return false;
 }
 
@@ -1490,13 +1525,16 @@ static std::string mangleTypeAsContext(const NominalTypeDecl *decl) {
 
 std::optional<YAMLTypeInfoNode>
 TypeConverter::getLegacyTypeInfo(NominalTypeDecl *decl) const {
+  if (!LegacyTypeInfos)
+    return std::nullopt;
+
   auto &mangledName = const_cast<TypeConverter *>(this)->DeclMangledNames[decl];
   if (mangledName.empty())
     mangledName = mangleTypeAsContext(decl);
   assert(!mangledName.empty());
 
-  auto found = LegacyTypeInfos.find(mangledName);
-  if (found == LegacyTypeInfos.end())
+  auto found = LegacyTypeInfos->find(mangledName);
+  if (found == LegacyTypeInfos->end())
     return std::nullopt;
 
   return found->second;
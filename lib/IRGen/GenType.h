@@ -136,7 +136,10 @@ private:
   const LoadableTypeInfo *SwiftRetainablePointerBoxTI = nullptr,
                          *UnknownObjectRetainablePointerBoxTI = nullptr;
 
-  llvm::StringMap<YAMLTypeInfoNode> LegacyTypeInfos;
+  /// The contents of the legacy type info file, if one was read. The parsed
+  /// file is owned by a process-wide cache shared by all TypeConverters, so
+  /// that in multi-threaded compilation only the first IGM parses it.
+  const llvm::StringMap<YAMLTypeInfoNode> *LegacyTypeInfos = nullptr;
   llvm::DenseMap<NominalTypeDecl *, std::string> DeclMangledNames;
 
   /// The key is the number of witness tables.
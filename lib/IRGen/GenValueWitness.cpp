@@ -34,6 +34,7 @@
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/GlobalVariable.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "ConstantBuilder.h"
@@ -930,6 +931,35 @@ static bool isRuntimeInstatiatedLayoutString(IRGenModule &IGM,
   return false;
 }
 
+static llvm::cl::opt<unsigned> LayoutStringWitnessMinSize(
+    "layout-string-witness-min-size", llvm::cl::init(0),
+    llvm::cl::desc("Only use layout string value witnesses for types whose "
+                   "fixed size is at least this many bytes; smaller types "
+                   "keep specialized witness code"));
+
+/// Whether a value witness should dispatch through the type's layout string
+/// instead of specialized emitted code.
+///
+/// The code-size win of the layout string grows with the number of fields,
+/// and the interpretation overhead is amortized over the copied bytes, so
+/// large types benefit the most. If a minimum size is configured, small
+/// fixed-size types keep their specialized witness code.
+static bool shouldUseLayoutStringWitness(IRGenModule &IGM,
+                                         const TypeLayoutEntry *typeLayoutEntry,
+                                         GenericSignature genericSig) {
+  if (!typeLayoutEntry->layoutString(IGM, genericSig) &&
+      !isRuntimeInstatiatedLayoutString(IGM, typeLayoutEntry))
+    return false;
+
+  if (LayoutStringWitnessMinSize == 0)
+    return true;
+
+  // Types without a fixed size are assumed to be large enough.
+  if (auto fixedSize = typeLayoutEntry->fixedSize(IGM))
+    return fixedSize->getValue() >= LayoutStringWitnessMinSize;
+  return true;
+}
+
 static bool
 useMultiPayloadEnumFNSpecialization(IRGenModule &IGM,
                                     const TypeLayoutEntry *typeLayoutEntry,
@@ -1059,8 +1089,7 @@ static void addValueWitness(IRGenModule &IGM, ConstantStructBuilder &B,
             typeInfo.buildTypeLayoutEntry(IGM, ty, /*useStructLayouts*/true)) {
         auto genericSig = concreteType.getNominalOrBoundGenericNominal()
                               ->getGenericSignature();
-        if (typeLayoutEntry->layoutString(IGM, genericSig) ||
-            isRuntimeInstatiatedLayoutString(IGM, typeLayoutEntry)) {
+        if (shouldUseLayoutStringWitness(IGM, typeLayoutEntry, genericSig)) {
           if (useMultiPayloadEnumFNSpecialization(IGM, typeLayoutEntry,
                                                   genericSig)) {
             return addFunction(IGM.getGenericDestroyMultiPayloadEnumFNFn());
@@ -1093,8 +1122,7 @@ static void addValueWitness(IRGenModule &IGM, ConstantStructBuilder &B,
               IGM, ty, /*useStructLayouts*/ true)) {
         auto genericSig = concreteType.getNominalOrBoundGenericNominal()
                               ->getGenericSignature();
-        if (typeLayoutEntry->layoutString(IGM, genericSig) ||
-            isRuntimeInstatiatedLayoutString(IGM, typeLayoutEntry)) {
+        if (shouldUseLayoutStringWitness(IGM, typeLayoutEntry, genericSig)) {
           if (useMultiPayloadEnumFNSpecialization(IGM, typeLayoutEntry,
                                                   genericSig)) {
             return addFunction(
@@ -1119,8 +1147,7 @@ static void addValueWitness(IRGenModule &IGM, ConstantStructBuilder &B,
             typeInfo.buildTypeLayoutEntry(IGM, ty, /*useStructLayouts*/true)) {
         auto genericSig = concreteType.getNominalOrBoundGenericNominal()
                               ->getGenericSignature();
-        if (typeLayoutEntry->layoutString(IGM, genericSig) ||
-            isRuntimeInstatiatedLayoutString(IGM, typeLayoutEntry)) {
+        if (shouldUseLayoutStringWitness(IGM, typeLayoutEntry, genericSig)) {
           if (useMultiPayloadEnumFNSpecialization(IGM, typeLayoutEntry,
                                                   genericSig)) {
             return addFunction(
@@ -1146,8 +1173,7 @@ static void addValueWitness(IRGenModule &IGM, ConstantStructBuilder &B,
             typeInfo.buildTypeLayoutEntry(IGM, ty, /*useStructLayouts*/true)) {
         auto genericSig = concreteType.getNominalOrBoundGenericNominal()
                               ->getGenericSignature();
-        if (typeLayoutEntry->layoutString(IGM, genericSig) ||
-            isRuntimeInstatiatedLayoutString(IGM, typeLayoutEntry)) {
+        if (shouldUseLayoutStringWitness(IGM, typeLayoutEntry, genericSig)) {
           if (useMultiPayloadEnumFNSpecialization(IGM, typeLayoutEntry,
                                                   genericSig)) {
             return addFunction(
@@ -1173,8 +1199,7 @@ static void addValueWitness(IRGenModule &IGM, ConstantStructBuilder &B,
             typeInfo.buildTypeLayoutEntry(IGM, ty, /*useStructLayouts*/true)) {
         auto genericSig = concreteType.getNominalOrBoundGenericNominal()
                               ->getGenericSignature();
-        if (typeLayoutEntry->layoutString(IGM, genericSig) ||
-            isRuntimeInstatiatedLayoutString(IGM, typeLayoutEntry)) {
+        if (shouldUseLayoutStringWitness(IGM, typeLayoutEntry, genericSig)) {
           if (useMultiPayloadEnumFNSpecialization(IGM, typeLayoutEntry,
                                                   genericSig)) {
             return addFunction(
@@ -1200,8 +1225,7 @@ static void addValueWitness(IRGenModule &IGM, ConstantStructBuilder &B,
             typeInfo.buildTypeLayoutEntry(IGM, ty, /*useStructLayouts*/true)) {
         auto genericSig = concreteType.getNominalOrBoundGenericNominal()
                               ->getGenericSignature();
-        if (typeLayoutEntry->layoutString(IGM, genericSig) ||
-            isRuntimeInstatiatedLayoutString(IGM, typeLayoutEntry)) {
+        if (shouldUseLayoutStringWitness(IGM, typeLayoutEntry, genericSig)) {
           if (useMultiPayloadEnumFNSpecialization(IGM, typeLayoutEntry,
                                                   genericSig)) {
             return addFunction(
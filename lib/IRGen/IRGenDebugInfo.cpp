@@ -1054,6 +1054,17 @@ private:
     Ty = Ty->replaceSubstitutedSILFunctionTypesWithUnsubstituted(
         IGM.getSILModule());
 
+    // The resulting names only depend on the type and the signature, which
+    // are shared between all IGMs of this invocation, so the mangling and
+    // its expensive round-trip verification are only done once per type.
+    auto CacheKey = std::make_pair(Ty.getPointer(),
+                                   (const void *)Sig.getPointer());
+    auto &NameCache = IGM.IRGen.DebugTypeMangledNameCache;
+    auto Cached = NameCache.find(CacheKey);
+    if (Cached != NameCache.end())
+      return {BumpAllocatedString(Cached->second.first),
+              BumpAllocatedString(Cached->second.second)};
+
     Mangle::ASTMangler Mangler(IGM.Context);
     std::string SugaredName, CanonicalName;
     SugaredName = Mangler.mangleTypeForDebugger(Ty, Sig);
@@ -1110,6 +1121,8 @@ private:
     // one.
     if (CanonicalName.empty())
       std::swap(SugaredName, CanonicalName);
+
+    NameCache[CacheKey] = std::make_pair(SugaredName, CanonicalName);
     return {BumpAllocatedString(SugaredName),
             BumpAllocatedString(CanonicalName)};
   }
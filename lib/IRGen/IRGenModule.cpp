@@ -55,6 +55,7 @@
 #include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MD5.h"
 #include "llvm/Support/ModRef.h"
@@ -2293,6 +2294,21 @@ IRGenModule *IRGenerator::getGenModule(DeclContext *ctxt) {
   return IGM;
 }
 
+llvm::cl::opt<bool> IRGenBalancedPartitioning(
+    "irgen-balanced-partitioning", llvm::cl::init(false),
+    llvm::cl::desc("In multi-threaded compilation, distribute SIL functions "
+                   "across the LLVM modules by estimated code size instead "
+                   "of by source file"));
+
+/// A rough emission cost estimate for partitioning: the number of SIL
+/// instructions of the function.
+static uint64_t estimatedEmissionCost(SILFunction *f) {
+  uint64_t cost = 0;
+  for (SILBasicBlock &bb : *f)
+    cost += std::distance(bb.begin(), bb.end());
+  return cost;
+}
+
 IRGenModule *IRGenerator::getGenModule(SILFunction *f) {
   if (GenModules.size() == 1) {
     return getPrimaryIGM();
@@ -2302,6 +2318,28 @@ IRGenModule *IRGenerator::getGenModule(SILFunction *f) {
   if (found != DefaultIGMForFunction.end())
     return found->second;
 
+  // With balanced partitioning, the source-file association is ignored and
+  // the function goes to the LLVM module with the lowest accumulated cost
+  // estimate, so that one oversized source file does not serialize the
+  // parallel build. Functions which require a specific IGM - e.g. witnesses
+  // of resilient conformances, which are referenced with direct relative
+  // pointers - are already in DefaultIGMForFunction at this point and are
+  // not affected. The choice is memoized so that all later queries agree on
+  // where the function is defined. Note that the Queue (and not GenModules)
+  // is iterated to keep the assignment deterministic.
+  if (IRGenBalancedPartitioning && f->isDefinition()) {
+    IRGenModule *leastLoaded = nullptr;
+    for (IRGenModule *IGM : Queue) {
+      if (!leastLoaded ||
+          AssignedIGMCosts[IGM] < AssignedIGMCosts[leastLoaded]) {
+        leastLoaded = IGM;
+      }
+    }
+    AssignedIGMCosts[leastLoaded] += estimatedEmissionCost(f);
+    DefaultIGMForFunction[f] = leastLoaded;
+    return leastLoaded;
+  }
+
   if (auto *dc = f->getDeclContext())
     return getGenModule(dc);
 
@@ -221,6 +221,15 @@ public:
 
   SILModule &SIL;
 
+  /// The mangled names of types in the debug info, keyed by the type and the
+  /// generic signature used for mangling. The same stdlib and SDK types occur
+  /// in every IGM of an invocation and mangling them - including the
+  /// round-trip verification of the mangled names - is expensive, so the
+  /// names are shared across all IGMs.
+  llvm::DenseMap<std::pair<TypeBase *, const void *>,
+                 std::pair<std::string, std::string>>
+      DebugTypeMangledNameCache;
+
 private:
   llvm::DenseMap<SourceFile *, IRGenModule *> GenModules;
   
@@ -228,6 +237,10 @@ private:
   // It is used if a function has no source-file association.
   llvm::DenseMap<SILFunction *, IRGenModule *> DefaultIGMForFunction;
 
+  // The accumulated emission cost estimate of the functions assigned to each
+  // IGM so far. Only used with -irgen-balanced-partitioning.
+  llvm::DenseMap<IRGenModule *, uint64_t> AssignedIGMCosts;
+
   // Stores the IGM from which a global variable is referenced the first time.
   // It is used if a global variable has no source-file association.
   llvm::DenseMap<SILGlobalVariable *, IRGenModule *> DefaultIGMForGlobalVariable;
@@ -1336,6 +1349,15 @@ private:
   llvm::StringMap<llvm::Constant*> GlobalUTF16Strings;
   llvm::StringMap<std::pair<llvm::GlobalVariable*, llvm::Constant*>>
     StringsForTypeRef;
+
+  /// Cached mangled type refs, keyed by canonical type, generic signature,
+  /// and mangling role. The same canonical type is mangled anew for every
+  /// field record, capture descriptor, and associated type witness that
+  /// mentions it; caching the result avoids re-running the mangler each time.
+  llvm::DenseMap<
+      std::pair<std::pair<CanType, const GenericSignatureImpl *>, unsigned>,
+      std::pair<llvm::Constant *, unsigned>>
+    TypeRefs;
   llvm::StringMap<std::pair<llvm::GlobalVariable*, llvm::Constant*>> FieldNames;
   llvm::StringMap<llvm::Constant*> ObjCSelectorRefs;
   llvm::StringMap<llvm::Constant*> ObjCMethodNames;
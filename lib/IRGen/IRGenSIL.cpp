@@ -35,6 +35,7 @@
 #include "swift/Basic/ExternalUnion.h"
 #include "swift/Basic/Range.h"
 #include "swift/Basic/STLExtras.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/IRGen/GenericRequirement.h"
 #include "swift/IRGen/Linking.h"
 #include "swift/SIL/ApplySite.h"
@@ -2544,6 +2545,10 @@ void IRGenModule::emitSILFunction(SILFunction *f) {
     noteUseOfMetadataByCXXInterop(IRGen, f, TypeExpansionContext(*f));
 
   PrettyStackTraceSILFunction stackTrace("emitting IR", f);
+  // With -trace-stats-events the tracer attributes the wall time and the
+  // frontend counter deltas (e.g. NumIRInstsEmitted) of this emission to
+  // the individual SIL function.
+  FrontendStatsTracer tracer(Context.Stats, "emit-SIL-function", f);
   IRGenSILFunction(*this, f).emitSILFunction();
 }
 
@@ -2730,6 +2735,14 @@ void IRGenSILFunction::emitSILFunction() {
     if (!workQueue.isVisited(&bb))
       LoweredBBs[&bb].bb->eraseFromParent();
 
+  // Unlike NumIRInsts, which is counted on the finished module, this counts
+  // instructions as each function body is emitted so that per-event stats
+  // traces can attribute code size to SIL functions.
+  if (auto *Stats = IGM.Context.Stats) {
+    auto &C = Stats->getFrontendCounters();
+    for (auto const &BB : *CurFn)
+      C.NumIRInstsEmitted += BB.size();
+  }
 }
 
 void IRGenSILFunction::estimateStackSize() {
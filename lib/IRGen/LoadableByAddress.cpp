@@ -2423,6 +2423,36 @@ static bool rewriteFunctionReturn(StructLoweringState &pass) {
   return false;
 }
 
+/// Returns true if \p F might contain anything the pass rewrites: a
+/// signature, a value or a function type that lowers differently under the
+/// large-loadable mapping.
+static bool mayNeedRewrite(SILFunction *F, LargeSILTypeMapper &Mapper,
+                           irgen::IRGenModule &Mod) {
+  GenericEnvironment *genEnv = getSubstGenericEnvironment(F);
+  if (Mapper.shouldTransformFunctionType(genEnv, F->getLoweredFunctionType(),
+                                         Mod))
+    return true;
+
+  auto typeNeedsRewrite = [&](SILType ty) {
+    return Mapper.getNewSILType(genEnv, ty, Mod) != ty;
+  };
+
+  for (SILBasicBlock &BB : *F) {
+    for (SILArgument *arg : BB.getArguments())
+      if (typeNeedsRewrite(arg->getType()))
+        return true;
+    for (SILInstruction &I : BB) {
+      for (Operand &op : I.getAllOperands())
+        if (typeNeedsRewrite(op.get()->getType()))
+          return true;
+      for (SILValue result : I.getResults())
+        if (typeNeedsRewrite(result->getType()))
+          return true;
+    }
+  }
+  return false;
+}
+
 void LoadableByAddress::runOnFunction(SILFunction *F) {
   CanSILFunctionType funcType = F->getLoweredFunctionType();
   IRGenModule *currIRMod = getIRGenModule()->IRGen.getGenModule(F);
@@ -2443,7 +2473,14 @@ void LoadableByAddress::runOnFunction(SILFunction *F) {
     }
     return;
   }
-  
+
+  // Most functions contain neither large loadable values nor function types
+  // that lower differently; skip building the rewrite state for them. The
+  // type queries are memoized in MapperCache, so the pre-scan costs one
+  // cached lookup per distinct type.
+  if (!mayNeedRewrite(F, MapperCache, *currIRMod))
+    return;
+
   StructLoweringState pass(F, *currIRMod, MapperCache);
 
   // Rewrite function args and insert allocs.
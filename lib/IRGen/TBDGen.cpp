@@ -653,20 +653,30 @@ TBDFile GenerateTBDRequest::evaluate(Evaluator &evaluator,
 std::vector<std::string>
 PublicSymbolsRequest::evaluate(Evaluator &evaluator,
                                TBDGenDescriptor desc) const {
+  // The TBD interface file for the same descriptor describes exactly the
+  // same symbol surface. Derive the symbol list from it instead of walking
+  // the module's declarations again, so that a build which both emits a TBD
+  // and validates the symbols against the IR pays for one walk; the
+  // evaluator caches the file.
+  auto file = evaluateOrFatal(evaluator, GenerateTBDRequest{desc});
+
   std::vector<std::string> symbols;
-  auto addSymbol = [&](StringRef symbol, EncodeKind kind, SymbolSource source,
-                       Decl *decl, SymbolFlags flags) {
-    if (kind == EncodeKind::GlobalSymbol)
-      symbols.push_back(symbol.str());
+  for (const auto *symbol : file.symbols()) {
+    switch (symbol->getKind()) {
+    case EncodeKind::GlobalSymbol:
+      symbols.push_back(symbol->getName().str());
+      break;
     // TextAPI ObjC Class Kinds represents two symbols.
-    else if (kind == EncodeKind::ObjectiveCClass) {
-      symbols.push_back((llvm::MachO::ObjC2ClassNamePrefix + symbol).str());
-      symbols.push_back((llvm::MachO::ObjC2MetaClassNamePrefix + symbol).str());
+    case EncodeKind::ObjectiveCClass:
+      symbols.push_back(
+          (llvm::MachO::ObjC2ClassNamePrefix + symbol->getName()).str());
+      symbols.push_back(
+          (llvm::MachO::ObjC2MetaClassNamePrefix + symbol->getName()).str());
+      break;
+    default:
+      break;
     }
-  };
-  SimpleAPIRecorder recorder(addSymbol);
-  TBDGenVisitor visitor(desc, recorder);
-  visitor.visit(desc);
+  }
   return symbols;
 }
 
@@ -414,8 +414,6 @@ int swift::RunImmediatelyFromAST(CompilerInstance &CI) {
   if (autolinkImportedModules(swiftModule, IRGenOpts))
     return -1;
 
-  auto &Target = swiftModule->getASTContext().LangOpts.Target;
-  assert(Target.isMacOSX());
   auto JIT = SwiftJIT::Create(CI);
   if (auto Err = JIT.takeError()) {
     logError(std::move(Err));
@@ -432,6 +430,12 @@ int swift::RunImmediatelyFromAST(CompilerInstance &CI) {
   }
 
   auto Result = (*JIT)->runMain(CmdLine);
+
+  // It is not safe to unmap memory that has been registered with the swift or
+  // objc runtime. Currently the best way to avoid that is to leak the JIT.
+  // FIXME: Replace with "detach" llvm/llvm-project#56714.
+  (void)JIT->release();
+
   if (!Result) {
     logError(Result.takeError());
     return -1;
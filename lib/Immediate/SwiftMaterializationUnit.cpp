@@ -39,6 +39,7 @@
 #include "swift/AST/SILGenRequests.h"
 #include "swift/AST/TBDGenRequests.h"
 #include "swift/Basic/Assertions.h"
+#include "swift/Basic/LLVMInitialize.h"
 #include "swift/Frontend/Frontend.h"
 #include "swift/Immediate/SwiftMaterializationUnit.h"
 #include "swift/SIL/SILModule.h"
@@ -144,6 +145,10 @@ llvm::orc::ObjectTransformLayer &SwiftJIT::getObjTransformLayer() {
 
 llvm::Expected<std::unique_ptr<llvm::orc::LLJIT>>
 SwiftJIT::CreateLLJIT(CompilerInstance &CI) {
+  // The JIT consults the target registry when it builds its TargetMachine,
+  // and target registration is deferred out of frontend startup.
+  initializeLLVMTargetsOnce();
+
   llvm::TargetOptions TargetOpt;
   std::string CPU;
   std::string Triple;
@@ -507,6 +507,12 @@ static bool performLocalRetainMotion(CallInst &Retain, BasicBlock &BB,
           isa<MemIntrinsic>(CurInst))
         break;
 
+      // Calls to functions that don't write to memory can't do a release
+      // either.  With full LTO this covers calls into other modules whose
+      // callees LLVM proved read-only.
+      if (isCallThatCannotRelease(CurInst))
+        break;
+
       // CurInst->dump(); BBI->dump();
       // Otherwise, we get to something unknown/unhandled.  Bail out for now.
       goto OutOfLoop;
@@ -908,8 +914,10 @@ static void performRedundantCheckUnownedRemoval(BasicBlock &BB) {
       }
         
       case RT_Unknown:
-        // Loads cannot affect the retain.
-        if (isa<LoadInst>(I) || isa<StoreInst>(I) || isa<MemIntrinsic>(I))
+        // Loads, stores and calls which don't write to memory cannot
+        // decrement reference counts.
+        if (isa<LoadInst>(I) || isa<StoreInst>(I) || isa<MemIntrinsic>(I) ||
+            isCallThatCannotRelease(I))
           continue;
         break;
         
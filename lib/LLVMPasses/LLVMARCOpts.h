@@ -75,5 +75,21 @@ inline RT_Kind classifyInstruction(const llvm::Instruction &I) {
     .Default(RT_Unknown);
 }
 
+/// Take a look at the specified instruction and return true if it is a call
+/// that provably cannot release any object: releasing a reference requires
+/// writing to its reference count, so a call whose callee is known not to
+/// write to memory cannot perform one.
+///
+/// The memory attributes consulted here are computed interprocedurally by
+/// LLVM, so under full LTO this lets the optimization cross module
+/// boundaries the SIL optimizer never saw: a call into another Swift module
+/// whose callee was proven read-only no longer blocks retain motion.
+inline bool isCallThatCannotRelease(const llvm::Instruction &I) {
+  auto *CI = dyn_cast<llvm::CallInst>(&I);
+  if (CI == nullptr)
+    return false;
+  return CI->onlyReadsMemory();
+}
+
 } // end namespace swift
 #endif
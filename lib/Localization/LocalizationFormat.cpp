@@ -18,6 +18,7 @@
 #include "swift/Basic/Assertions.h"
 #include "swift/Basic/Range.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Bitstream/BitstreamReader.h"
 #include "llvm/Support/CommandLine.h"
@@ -25,7 +26,6 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include <cstdint>
-#include <map>
 #include <optional>
 #include <string>
 #include <system_error>
@@ -101,11 +101,32 @@ SerializedLocalizationProducer::SerializedLocalizationProducer(
     std::unique_ptr<llvm::MemoryBuffer> buffer)
     : LocalizationProducer(), Buffer(std::move(buffer)) {}
 
+SerializedLocalizationProducer::SerializedLocalizationProducer(
+    llvm::StringRef filePath)
+    : LocalizationProducer(), filePath(filePath) {}
+
 bool SerializedLocalizationProducer::initializeImpl() {
+  if (!Buffer) {
+    // The table is read in place, so the file can be mapped read-only and
+    // doesn't need a null terminator.
+    auto file = llvm::MemoryBuffer::getFile(filePath, /*IsText=*/false,
+                                            /*RequiresNullTerminator=*/false);
+    if (!file)
+      return false;
+    Buffer = std::move(file.get());
+  }
+
+  // Reject files too small to contain the table offset, and table offsets
+  // pointing outside of the file, rather than reading out of bounds; a
+  // failed initialization falls back to the default messages.
+  if (Buffer->getBufferSize() < sizeof(offset_type))
+    return false;
   auto base =
       reinterpret_cast<const unsigned char *>(Buffer.get()->getBufferStart());
   auto tableOffset =
       llvm::support::endian::read<offset_type>(base, llvm::endianness::little);
+  if (tableOffset >= Buffer->getBufferSize())
+    return false;
   SerializedTable.reset(SerializedLocalizationTable::Create(
       base + tableOffset, base + sizeof(offset_type), base));
   return true;
@@ -127,12 +148,11 @@ LocalizationProducer::producerFor(llvm::StringRef locale,
   llvm::sys::path::replace_extension(filePath, ".db");
 
   // If the serialized diagnostics file not available,
-  // fallback to the `.strings` file.
+  // fallback to the `.strings` file. Either way the file is only opened and
+  // read once a localized message is actually requested.
   if (llvm::sys::fs::exists(filePath)) {
-    if (auto file = llvm::MemoryBuffer::getFile(filePath)) {
-      return std::make_unique<diag::SerializedLocalizationProducer>(
-          std::move(file.get()));
-    }
+    return std::make_unique<diag::SerializedLocalizationProducer>(
+        filePath.str());
   } else {
     llvm::sys::path::replace_extension(filePath, ".strings");
     if (llvm::sys::fs::exists(filePath)) {
@@ -193,7 +213,7 @@ void StringsLocalizationProducer::forEachAvailable(
 
 void StringsLocalizationProducer::readStringsFile(
     llvm::MemoryBuffer *in, std::vector<std::string> &diagnostics) {
-  std::map<std::string, unsigned> diagLocs;
+  llvm::StringMap<unsigned> diagLocs;
 #define DIAG(KIND, ID, Group, Options, Text, Signature)                        \
   diagLocs[#ID] = static_cast<unsigned>(LocalDiagID::ID);
 #include "swift/AST/DiagnosticsAll.def"
@@ -227,7 +247,7 @@ void StringsLocalizationProducer::readStringsFile(
     auto idSize = buffer.find_first_of('\"');
     assert(idSize != std::string::npos);
 
-    std::string id(buffer.data(), idSize);
+    llvm::StringRef id(buffer.data(), idSize);
 
     // consume id and `" = "`. There could be a variable number of
     // spaces on each side of `=`.
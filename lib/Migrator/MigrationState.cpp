@@ -24,12 +24,12 @@ using namespace swift::migrator;
 
 #pragma mark - MigrationState
 
-std::string MigrationState::getInputText() const {
-  return SrcMgr.getEntireTextForBuffer(InputBufferID).str();
+StringRef MigrationState::getInputText() const {
+  return SrcMgr.getEntireTextForBuffer(InputBufferID);
 }
 
-std::string MigrationState::getOutputText() const {
-  return SrcMgr.getEntireTextForBuffer(OutputBufferID).str();
+StringRef MigrationState::getOutputText() const {
+  return SrcMgr.getEntireTextForBuffer(OutputBufferID);
 }
 
 static bool quickDumpText(StringRef OutFilename, StringRef Text) {
@@ -166,16 +166,13 @@ Migrator::performAFixItMigration(version::Version SwiftLanguageVersion) {
 
   Instance->performSema();
 
-  StringRef ResultText = InputText;
   unsigned ResultBufferID = InputState->getOutputBufferID();
 
   if (FixitApplyConsumer.getNumFixitsApplied() > 0) {
     SmallString<4096> Scratch;
     llvm::raw_svector_ostream OS(Scratch);
     FixitApplyConsumer.printResult(OS);
-    auto ResultBuffer = llvm::MemoryBuffer::getMemBufferCopy(OS.str());
-    ResultText = ResultBuffer->getBuffer();
-    ResultBufferID = SrcMgr.addNewSourceBuffer(std::move(ResultBuffer));
+    ResultBufferID = SrcMgr.addMemBufferCopy(OS.str(), getInputFilename());
   }
 
   States.push_back(MigrationState::make(MigrationKind::CompilerFixits,
@@ -219,7 +216,7 @@ bool Migrator::performSyntacticPasses(SyntacticPassOptions Opts) {
     ClangSourceManager,
     Editor.getClangFileIDForSwiftBufferID(
       StartInstance->getPrimarySourceFile()->getBufferID()),
-    InputState->getOutputText()
+    InputText
   };
 
   Edits.applyRewrites(Rewriter);
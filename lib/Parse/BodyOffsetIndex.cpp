@@ -0,0 +1,168 @@
+//===--- BodyOffsetIndex.cpp - Function body offset side table ------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2026 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Parse/BodyOffsetIndex.h"
+#include "swift/AST/ASTContext.h"
+#include "swift/AST/ASTWalker.h"
+#include "swift/AST/Decl.h"
+#include "swift/AST/SourceFile.h"
+#include "swift/Basic/Assertions.h"
+#include "swift/Basic/SourceManager.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+
+using namespace swift;
+
+/// Magic number identifying serialized body offset indexes: "SWBI".
+static const uint32_t BodyOffsetIndexMagic = 0x49425753;
+static const uint32_t BodyOffsetIndexVersion = 1;
+
+void BodyOffsetIndex::addEntry(const Entry &entry) {
+  assert((Entries.empty() ||
+          Entries.back().DeclStartOffset < entry.DeclStartOffset) &&
+         "entries must be added in increasing declaration offset order");
+  assert(entry.BodyStartOffset <= entry.BodyEndOffset && "invalid body range");
+  Entries.push_back(entry);
+}
+
+const BodyOffsetIndex::Entry *
+BodyOffsetIndex::lookup(unsigned DeclStartOffset) const {
+  auto it = std::lower_bound(Entries.begin(), Entries.end(), DeclStartOffset,
+                             [](const Entry &entry, unsigned offset) {
+                               return entry.DeclStartOffset < offset;
+                             });
+  if (it == Entries.end() || it->DeclStartOffset != DeclStartOffset)
+    return nullptr;
+  return &*it;
+}
+
+BodyOffsetIndex BodyOffsetIndex::harvest(SourceFile &SF) {
+  class BodyCollector : public ASTWalker {
+    SourceManager &SM;
+    unsigned BufferID;
+
+  public:
+    std::vector<Entry> Entries;
+
+    BodyCollector(SourceManager &SM, unsigned BufferID)
+        : SM(SM), BufferID(BufferID) {}
+
+    MacroWalking getMacroWalkingBehavior() const override {
+      return MacroWalking::None;
+    }
+
+    PreWalkAction walkToDeclPre(Decl *D) override {
+      auto *AFD = dyn_cast<AbstractFunctionDecl>(D);
+      if (!AFD)
+        return Action::Continue();
+
+      auto bodyRange = AFD->getBodySourceRange();
+      if (bodyRange.isInvalid())
+        return Action::Continue();
+
+      auto bufferRange = SM.getRangeForBuffer(BufferID);
+      if (!bufferRange.contains(bodyRange.Start) ||
+          !bufferRange.contains(bodyRange.End))
+        return Action::Continue();
+
+      Entries.push_back(
+          {SM.getLocOffsetInBuffer(AFD->getStartLoc(), BufferID),
+           SM.getLocOffsetInBuffer(bodyRange.Start, BufferID),
+           SM.getLocOffsetInBuffer(bodyRange.End, BufferID),
+           AFD->getBodyFingerprint().value_or(Fingerprint::ZERO())});
+      return Action::Continue();
+    }
+  };
+
+  BodyCollector collector(SF.getASTContext().SourceMgr, SF.getBufferID());
+  SF.walk(collector);
+
+  // Walk order is not strictly source order in the presence of attached
+  // attributes, so sort before building the index.
+  std::sort(collector.Entries.begin(), collector.Entries.end(),
+            [](const Entry &lhs, const Entry &rhs) {
+              return lhs.DeclStartOffset < rhs.DeclStartOffset;
+            });
+
+  BodyOffsetIndex index;
+  for (auto &entry : collector.Entries) {
+    // Duplicate starts can occur for synthesized pairs; keep the first.
+    if (!index.Entries.empty() &&
+        index.Entries.back().DeclStartOffset == entry.DeclStartOffset)
+      continue;
+    index.addEntry(entry);
+  }
+  return index;
+}
+
+void BodyOffsetIndex::serialize(llvm::raw_ostream &OS) const {
+  llvm::support::endian::Writer writer(OS, llvm::endianness::little);
+  writer.write<uint32_t>(BodyOffsetIndexMagic);
+  writer.write<uint32_t>(BodyOffsetIndexVersion);
+  writer.write<uint32_t>(Entries.size());
+  for (auto &entry : Entries) {
+    writer.write<uint32_t>(entry.DeclStartOffset);
+    writer.write<uint32_t>(entry.BodyStartOffset);
+    writer.write<uint32_t>(entry.BodyEndOffset);
+    auto raw = entry.BodyHash.getRawValue();
+    assert(raw.size() == Fingerprint::DIGEST_LENGTH);
+    OS.write(raw.data(), raw.size());
+  }
+}
+
+std::optional<BodyOffsetIndex>
+BodyOffsetIndex::deserialize(llvm::StringRef Data) {
+  const size_t headerSize = 3 * sizeof(uint32_t);
+  const size_t entrySize = 3 * sizeof(uint32_t) + Fingerprint::DIGEST_LENGTH;
+  if (Data.size() < headerSize)
+    return std::nullopt;
+
+  auto *cursor = reinterpret_cast<const uint8_t *>(Data.data());
+  auto readUInt32 = [&cursor] {
+    auto value = llvm::support::endian::read32le(cursor);
+    cursor += sizeof(uint32_t);
+    return value;
+  };
+
+  if (readUInt32() != BodyOffsetIndexMagic)
+    return std::nullopt;
+  if (readUInt32() != BodyOffsetIndexVersion)
+    return std::nullopt;
+
+  uint32_t count = readUInt32();
+  if (Data.size() != headerSize + count * entrySize)
+    return std::nullopt;
+
+  BodyOffsetIndex index;
+  for (uint32_t i = 0; i != count; ++i) {
+    unsigned declStart = readUInt32();
+    unsigned bodyStart = readUInt32();
+    unsigned bodyEnd = readUInt32();
+    auto hash = Fingerprint::fromString(
+        llvm::StringRef(reinterpret_cast<const char *>(cursor),
+                        Fingerprint::DIGEST_LENGTH));
+    cursor += Fingerprint::DIGEST_LENGTH;
+    if (!hash)
+      return std::nullopt;
+    Entry entry{declStart, bodyStart, bodyEnd, *hash};
+
+    if (entry.BodyStartOffset > entry.BodyEndOffset)
+      return std::nullopt;
+    if (!index.Entries.empty() &&
+        index.Entries.back().DeclStartOffset >= entry.DeclStartOffset)
+      return std::nullopt;
+    index.addEntry(entry);
+  }
+  return index;
+}
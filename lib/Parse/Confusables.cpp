@@ -12,24 +12,84 @@
 
 #include "swift/Parse/Confusables.h"
 
-char swift::confusable::tryConvertConfusableCharacterToASCII(uint32_t codepoint) {
-  switch (codepoint) {
+#include <algorithm>
+
+namespace {
+
+struct ConfusableEntry {
+  uint32_t Codepoint;
+  char Base;
+  const char *Name;
+  const char *BaseName;
+};
+
+const ConfusableEntry ConfusableEntries[] = {
 #define CONFUSABLE(CONFUSABLE_POINT, CONFUSABLE_NAME, BASE_POINT, BASE_NAME)   \
-  case CONFUSABLE_POINT:                                                       \
-    return BASE_POINT;
+  {CONFUSABLE_POINT, BASE_POINT, CONFUSABLE_NAME, BASE_NAME},
 #include "swift/Parse/Confusables.def"
-  default: return 0;
+};
+
+/// An open-addressed hash table over \c ConfusableEntries, so the lookup
+/// performed for every non-ASCII scalar during diagnostics is a couple of
+/// loads instead of a branchy switch. Built once on first use; at more than
+/// four times the entry count, the load factor keeps probe sequences short.
+class ConfusableTable {
+  static const unsigned Size = 512;
+  static_assert(Size >= 2 * (sizeof(ConfusableEntries) /
+                             sizeof(ConfusableEntries[0])),
+                "table too dense");
+
+  /// Entry index plus one; zero marks an empty slot.
+  uint16_t Slots[Size];
+
+  static unsigned hash(uint32_t codepoint) {
+    // Fibonacci hashing; the entries are spread across many Unicode blocks,
+    // so a single multiplicative mix suffices.
+    return (codepoint * 0x9E3779B9u) >> 20;
   }
+
+public:
+  ConfusableTable() {
+    std::fill(Slots, Slots + Size, 0);
+    uint16_t index = 0;
+    for (const auto &entry : ConfusableEntries) {
+      unsigned slot = hash(entry.Codepoint) & (Size - 1);
+      while (Slots[slot] != 0)
+        slot = (slot + 1) & (Size - 1);
+      Slots[slot] = ++index;
+    }
+  }
+
+  const ConfusableEntry *lookup(uint32_t codepoint) const {
+    for (unsigned slot = hash(codepoint) & (Size - 1);;
+         slot = (slot + 1) & (Size - 1)) {
+      uint16_t index = Slots[slot];
+      if (index == 0)
+        return nullptr;
+      const auto &entry = ConfusableEntries[index - 1];
+      if (entry.Codepoint == codepoint)
+        return &entry;
+    }
+  }
+};
+
+const ConfusableTable &getConfusableTable() {
+  static const ConfusableTable table;
+  return table;
+}
+
+} // end anonymous namespace
+
+char swift::confusable::tryConvertConfusableCharacterToASCII(uint32_t codepoint) {
+  if (const auto *entry = getConfusableTable().lookup(codepoint))
+    return entry->Base;
+  return 0;
 }
 
 std::pair<llvm::StringRef, llvm::StringRef>
 swift::confusable::getConfusableAndBaseCodepointNames(uint32_t codepoint) {
-  switch (codepoint) {
-#define CONFUSABLE(CONFUSABLE_POINT, CONFUSABLE_NAME, BASE_POINT, BASE_NAME)   \
-  case CONFUSABLE_POINT:                                                       \
-    return std::make_pair(CONFUSABLE_NAME, BASE_NAME);
-#include "swift/Parse/Confusables.def"
-  default:
-    return std::make_pair("", "");
-  }
+  if (const auto *entry = getConfusableTable().lookup(codepoint))
+    return std::make_pair(llvm::StringRef(entry->Name),
+                          llvm::StringRef(entry->BaseName));
+  return std::make_pair(llvm::StringRef(), llvm::StringRef());
 }
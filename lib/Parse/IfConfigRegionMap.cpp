@@ -0,0 +1,114 @@
+//===--- IfConfigRegionMap.cpp - Cached #if region maps -------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2026 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Parse/IfConfigRegionMap.h"
+#include "swift/Basic/Assertions.h"
+#include "swift/Basic/Feature.h"
+#include "swift/Basic/LangOptions.h"
+#include "swift/Basic/SourceManager.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
+
+#include <deque>
+#include <mutex>
+
+using namespace swift;
+
+void IfConfigRegionMap::materialize(
+    const SourceManager &SM, unsigned BufferID,
+    std::vector<IfConfigClauseRangeInfo> &Ranges) const {
+  SourceLoc bufferStart = SM.getLocForBufferStart(BufferID);
+  Ranges.reserve(Ranges.size() + Regions.size());
+  for (const auto &region : Regions) {
+    Ranges.emplace_back(bufferStart.getAdvancedLoc(region.DirectiveOffset),
+                        bufferStart.getAdvancedLoc(region.BodyOffset),
+                        bufferStart.getAdvancedLoc(region.EndOffset),
+                        region.Kind);
+  }
+}
+
+/// Hash every input that can change how conditional-compilation conditions
+/// evaluate: the target, the language version, platform condition values,
+/// custom -D flags, and the set of enabled language features.
+static llvm::hash_code hashConfiguration(const LangOptions &langOpts) {
+  llvm::hash_code hash = llvm::hash_value(llvm::StringRef(langOpts.Target.str()));
+  for (size_t i = 0, e = langOpts.EffectiveLanguageVersion.size(); i != e; ++i)
+    hash = llvm::hash_combine(hash, langOpts.EffectiveLanguageVersion[i]);
+  for (const auto &entry : langOpts.getPlatformConditionValues())
+    hash = llvm::hash_combine(hash, unsigned(entry.first),
+                              llvm::StringRef(entry.second));
+  for (const auto &flag : langOpts.getCustomConditionalCompilationFlags())
+    hash = llvm::hash_combine(hash, llvm::StringRef(flag));
+#define LANGUAGE_FEATURE(FeatureName, SENumber, Description)                   \
+  hash = llvm::hash_combine(hash, langOpts.hasFeature(Feature::FeatureName));
+#include "swift/Basic/Features.def"
+  return hash;
+}
+
+namespace {
+
+/// The cache key: a hash of the buffer contents (with its size folded in)
+/// and a hash of the conditional-compilation configuration.
+using CacheKey = std::pair<uint64_t, uint64_t>;
+
+struct RegionCacheStorage {
+  std::mutex Mutex;
+  llvm::DenseMap<CacheKey, std::shared_ptr<const IfConfigRegionMap>> Entries;
+  /// Insertion order, for FIFO eviction.
+  std::deque<CacheKey> Order;
+
+  /// The number of buffers worth of regions to retain; enough for an IDE
+  /// session's working set without holding entire projects.
+  static const size_t MaxEntries = 64;
+};
+
+RegionCacheStorage &getCacheStorage() {
+  static RegionCacheStorage storage;
+  return storage;
+}
+
+CacheKey makeKey(llvm::StringRef bufferText, const LangOptions &langOpts) {
+  return {llvm::hash_combine(bufferText.size(),
+                             llvm::hash_value(bufferText)),
+          uint64_t(hashConfiguration(langOpts))};
+}
+
+} // end anonymous namespace
+
+std::shared_ptr<const IfConfigRegionMap>
+IfConfigRegionCache::lookup(llvm::StringRef bufferText,
+                            const LangOptions &langOpts) {
+  auto &storage = getCacheStorage();
+  std::lock_guard<std::mutex> lock(storage.Mutex);
+  auto it = storage.Entries.find(makeKey(bufferText, langOpts));
+  if (it == storage.Entries.end())
+    return nullptr;
+  return it->second;
+}
+
+void IfConfigRegionCache::insert(llvm::StringRef bufferText,
+                                 const LangOptions &langOpts,
+                                 std::shared_ptr<const IfConfigRegionMap> map) {
+  assert(map && "caching a null region map");
+  auto &storage = getCacheStorage();
+  std::lock_guard<std::mutex> lock(storage.Mutex);
+  auto key = makeKey(bufferText, langOpts);
+  auto inserted = storage.Entries.insert({key, std::move(map)});
+  if (!inserted.second)
+    return;
+
+  storage.Order.push_back(key);
+  if (storage.Order.size() > RegionCacheStorage::MaxEntries) {
+    storage.Entries.erase(storage.Order.front());
+    storage.Order.pop_front();
+  }
+}
@@ -34,6 +34,15 @@
 
 #include <limits>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWIFT_LEXER_USE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define SWIFT_LEXER_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
 using namespace swift;
 
 // clang::isAsciiIdentifierStart and clang::isAsciiIdentifierContinue are
@@ -161,6 +170,159 @@ uint32_t swift::validateUTF8CharacterAndAdvance(const char *&Ptr,
   return EncodedBytes == 4 ? CharValue : ~0U;
 }
 
+//===----------------------------------------------------------------------===//
+// Vectorized ASCII fast-path scanning
+//===----------------------------------------------------------------------===//
+//
+// The hottest lexer loops (identifier continuations, comment bodies, and
+// horizontal whitespace) overwhelmingly consume long runs of plain ASCII.
+// These helpers classify 16 bytes at a time and bail out to the existing
+// byte-at-a-time paths for token boundaries, NUL characters, and anything
+// with the high bit set, which keeps all Unicode validation and diagnostics
+// on the slow path.
+
+#if SWIFT_LEXER_USE_SSE2
+
+/// Return the index of the first zero bit in the low 16 bits of \p Mask, or
+/// 16 if all are set.
+static unsigned firstNonMatchingByte(unsigned Mask) {
+  return llvm::countr_one(Mask & 0xFFFFu);
+}
+
+/// Advance \p Ptr over a run of ASCII identifier-continuation bytes
+/// ([A-Za-z0-9_$]), stopping at the first byte that needs the slow path.
+static const char *skipAsciiIdentifierRun(const char *Ptr, const char *End) {
+  while (End - Ptr >= 16) {
+    __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+    auto InRange = [&](char Lo, char Hi) {
+      return _mm_and_si128(_mm_cmpgt_epi8(Chunk, _mm_set1_epi8(Lo - 1)),
+                           _mm_cmpgt_epi8(_mm_set1_epi8(Hi + 1), Chunk));
+    };
+    __m128i IsIdent = _mm_or_si128(
+        _mm_or_si128(InRange('a', 'z'), InRange('A', 'Z')),
+        _mm_or_si128(InRange('0', '9'),
+                     _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('_')),
+                                  _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('$')))));
+    unsigned Mask = _mm_movemask_epi8(IsIdent);
+    if (Mask != 0xFFFFu)
+      return Ptr + firstNonMatchingByte(Mask);
+    Ptr += 16;
+  }
+  return Ptr;
+}
+
+/// Advance \p Ptr over comment-body bytes, stopping at newlines, NUL,
+/// comment delimiter characters ('*' and '/'), or any non-ASCII byte.
+static const char *skipPlainCommentBodyRun(const char *Ptr, const char *End) {
+  while (End - Ptr >= 16) {
+    __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+    __m128i IsStop = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\n')),
+                     _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\r'))),
+        _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8(0)),
+                     _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('*')),
+                                  _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('/')))));
+    // The sign bit of each byte flags non-ASCII input.
+    unsigned Mask = _mm_movemask_epi8(IsStop) | _mm_movemask_epi8(Chunk);
+    if (Mask != 0)
+      return Ptr + llvm::countr_zero(Mask);
+    Ptr += 16;
+  }
+  return Ptr;
+}
+
+/// Advance \p Ptr over a run of spaces and tabs.
+static const char *skipHorizontalWhitespaceRun(const char *Ptr,
+                                               const char *End) {
+  while (End - Ptr >= 16) {
+    __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+    __m128i IsWS = _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8(' ')),
+                                _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\t')));
+    unsigned Mask = _mm_movemask_epi8(IsWS);
+    if (Mask != 0xFFFFu)
+      return Ptr + firstNonMatchingByte(Mask);
+    Ptr += 16;
+  }
+  return Ptr;
+}
+
+#elif SWIFT_LEXER_USE_NEON
+
+/// Return the index of the first zero lane in a lane-wise 0x00/0xFF match
+/// vector, or 16 if every lane matched.
+static unsigned firstNonMatchingByte(uint8x16_t Match) {
+  // Narrow each 16-bit pair to 8 bits so every input lane contributes a
+  // nibble to a 64-bit mask.
+  uint8x8_t Narrowed = vshrn_n_u16(vreinterpretq_u16_u8(Match), 4);
+  uint64_t Mask = vget_lane_u64(vreinterpret_u64_u8(Narrowed), 0);
+  return llvm::countr_one(Mask) / 4;
+}
+
+static const char *skipAsciiIdentifierRun(const char *Ptr, const char *End) {
+  while (End - Ptr >= 16) {
+    uint8x16_t Chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(Ptr));
+    auto InRange = [&](uint8_t Lo, uint8_t Hi) {
+      return vandq_u8(vcgeq_u8(Chunk, vdupq_n_u8(Lo)),
+                      vcleq_u8(Chunk, vdupq_n_u8(Hi)));
+    };
+    uint8x16_t IsIdent = vorrq_u8(
+        vorrq_u8(InRange('a', 'z'), InRange('A', 'Z')),
+        vorrq_u8(InRange('0', '9'),
+                 vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8('_')),
+                          vceqq_u8(Chunk, vdupq_n_u8('$')))));
+    if (vminvq_u8(IsIdent) != 0xFF)
+      return Ptr + firstNonMatchingByte(IsIdent);
+    Ptr += 16;
+  }
+  return Ptr;
+}
+
+static const char *skipPlainCommentBodyRun(const char *Ptr, const char *End) {
+  while (End - Ptr >= 16) {
+    uint8x16_t Chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(Ptr));
+    uint8x16_t IsStop = vorrq_u8(
+        vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8('\n')),
+                 vceqq_u8(Chunk, vdupq_n_u8('\r'))),
+        vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8(0)),
+                 vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8('*')),
+                          vceqq_u8(Chunk, vdupq_n_u8('/')))));
+    // Any byte with the high bit set also needs the slow path.
+    uint8x16_t IsPlain = vbicq_u8(vcltq_u8(Chunk, vdupq_n_u8(0x80)), IsStop);
+    if (vminvq_u8(IsPlain) != 0xFF)
+      return Ptr + firstNonMatchingByte(IsPlain);
+    Ptr += 16;
+  }
+  return Ptr;
+}
+
+static const char *skipHorizontalWhitespaceRun(const char *Ptr,
+                                               const char *End) {
+  while (End - Ptr >= 16) {
+    uint8x16_t Chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(Ptr));
+    uint8x16_t IsWS = vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8(' ')),
+                               vceqq_u8(Chunk, vdupq_n_u8('\t')));
+    if (vminvq_u8(IsWS) != 0xFF)
+      return Ptr + firstNonMatchingByte(IsWS);
+    Ptr += 16;
+  }
+  return Ptr;
+}
+
+#else
+
+// No vector unit available; the callers' scalar loops handle everything.
+static const char *skipAsciiIdentifierRun(const char *Ptr, const char *) {
+  return Ptr;
+}
+static const char *skipPlainCommentBodyRun(const char *Ptr, const char *) {
+  return Ptr;
+}
+static const char *skipHorizontalWhitespaceRun(const char *Ptr, const char *) {
+  return Ptr;
+}
+
+#endif
+
 //===----------------------------------------------------------------------===//
 // Setup and Helper Methods
 //===----------------------------------------------------------------------===//
@@ -197,6 +359,10 @@ void Lexer::initialize(unsigned Offset, unsigned EndOffset) {
   // editing with libSyntax.
   ContentStart = BufferStart + BOMLength;
 
+  // If the buffer validated as well-formed UTF-8 in one pass, comment
+  // skipping doesn't need to re-validate each non-ASCII scalar it crosses.
+  BufferIsKnownWellFormedUTF8 = SourceMgr.isBufferWellFormedUTF8(BufferID);
+
   // Initialize code completion.
   if (BufferID == SourceMgr.getIDEInspectionTargetBufferID()) {
     const char *Ptr = BufferStart + SourceMgr.getIDEInspectionTargetOffset();
@@ -257,6 +423,22 @@ Lexer::Lexer(const Lexer &Parent, State BeginState, State EndState,
   initialize(Offset, EndOffset);
 }
 
+CharSourceRange TriviaArena::materializeRange(const SourceManager &SM,
+                                              unsigned BufferID,
+                                              size_t Index) const {
+  const CommentRecord &Record = Records[Index];
+  return CharSourceRange(SM.getLocForOffset(BufferID, Record.Offset),
+                         Record.Length);
+}
+
+StringRef TriviaArena::materializeText(const SourceManager &SM,
+                                       unsigned BufferID,
+                                       size_t Index) const {
+  const CommentRecord &Record = Records[Index];
+  return SM.getEntireTextForBuffer(BufferID).substr(Record.Offset,
+                                                    Record.Length);
+}
+
 InFlightDiagnostic Lexer::diagnose(const char *Loc, Diagnostic Diag) {
   if (auto *Diags = getTokenDiags())
     return Diags->diagnose(getSourceLoc(Loc), Diag);
@@ -370,10 +552,14 @@ static void diagnoseEmbeddedNul(DiagnosticEngine *Diags, const char *Ptr) {
 
 /// Advance \p CurPtr to the end of line or the end of file. Returns \c true
 /// if it stopped at the end of line, \c false if it stopped at the end of file.
+/// If \p ValidateUTF8 is false, the buffer is already known to be well-formed
+/// UTF-8 and non-ASCII scalars are skipped without re-validation.
 static bool advanceToEndOfLine(const char *&CurPtr, const char *BufferEnd,
                                const char *CodeCompletionPtr = nullptr,
-                               DiagnosticEngine *Diags = nullptr) {
+                               DiagnosticEngine *Diags = nullptr,
+                               bool ValidateUTF8 = true) {
   while (1) {
+    CurPtr = skipPlainCommentBodyRun(CurPtr, BufferEnd);
     switch (*CurPtr++) {
     case '\n':
     case '\r':
@@ -381,7 +567,7 @@ static bool advanceToEndOfLine(const char *&CurPtr, const char *BufferEnd,
       return true; // If we found the end of the line, return.
     default:
       // If this is a "high" UTF-8 character, validate it.
-      if (Diags && (signed char)(CurPtr[-1]) < 0) {
+      if (Diags && ValidateUTF8 && (signed char)(CurPtr[-1]) < 0) {
         --CurPtr;
         const char *CharStart = CurPtr;
         if (validateUTF8CharacterAndAdvance(CurPtr, BufferEnd) == ~0U)
@@ -407,7 +593,8 @@ static bool advanceToEndOfLine(const char *&CurPtr, const char *BufferEnd,
 
 void Lexer::skipToEndOfLine(bool EatNewline) {
   bool isEOL =
-      advanceToEndOfLine(CurPtr, BufferEnd, CodeCompletionPtr, getTokenDiags());
+      advanceToEndOfLine(CurPtr, BufferEnd, CodeCompletionPtr, getTokenDiags(),
+                         !BufferIsKnownWellFormedUTF8);
   if (EatNewline && isEOL) {
     ++CurPtr;
     NextToken.setAtStartOfLine(true);
@@ -428,7 +615,8 @@ void Lexer::skipHashbang(bool EatNewline) {
 static bool skipToEndOfSlashStarComment(const char *&CurPtr,
                                         const char *BufferEnd,
                                         const char *CodeCompletionPtr = nullptr,
-                                        DiagnosticEngine *Diags = nullptr) {
+                                        DiagnosticEngine *Diags = nullptr,
+                                        bool ValidateUTF8 = true) {
   const char *StartPtr = CurPtr-1;
   assert(CurPtr[-1] == '/' && CurPtr[0] == '*' && "Not a /* comment");
   // Make sure to advance over the * so that we don't incorrectly handle /*/ as
@@ -440,6 +628,7 @@ static bool skipToEndOfSlashStarComment(const char *&CurPtr,
   bool isMultiline = false;
 
   while (1) {
+    CurPtr = skipPlainCommentBodyRun(CurPtr, BufferEnd);
     switch (*CurPtr++) {
     case '*':
       // Check for a '*/'
@@ -464,7 +653,7 @@ static bool skipToEndOfSlashStarComment(const char *&CurPtr,
 
     default:
       // If this is a "high" UTF-8 character, validate it.
-      if (Diags && (signed char)(CurPtr[-1]) < 0) {
+      if (Diags && ValidateUTF8 && (signed char)(CurPtr[-1]) < 0) {
         --CurPtr;
         const char *CharStart = CurPtr;
         if (validateUTF8CharacterAndAdvance(CurPtr, BufferEnd) == ~0U)
@@ -506,7 +695,8 @@ static bool skipToEndOfSlashStarComment(const char *&CurPtr,
 /// Note that (unlike in C) block comments can be nested.
 void Lexer::skipSlashStarComment() {
   bool isMultiline = skipToEndOfSlashStarComment(
-      CurPtr, BufferEnd, CodeCompletionPtr, getTokenDiags());
+      CurPtr, BufferEnd, CodeCompletionPtr, getTokenDiags(),
+      !BufferIsKnownWellFormedUTF8);
   if (isMultiline)
     NextToken.setAtStartOfLine(true);
 }
@@ -740,7 +930,9 @@ void Lexer::lexIdentifier() {
   (void) didStart;
 
   // Lex [a-zA-Z_$0-9[[:XID_Continue:]]]*
-  while (advanceIfValidContinuationOfIdentifier(CurPtr, BufferEnd));
+  do {
+    CurPtr = skipAsciiIdentifierRun(CurPtr, BufferEnd);
+  } while (advanceIfValidContinuationOfIdentifier(CurPtr, BufferEnd));
 
   tok Kind = kindOfIdentifier(StringRef(TokStart, CurPtr-TokStart),
                               LexMode == LexerMode::SIL);
@@ -2912,6 +3104,8 @@ Restart:
     goto Restart;
   case ' ':
   case '\t':
+    CurPtr = skipHorizontalWhitespaceRun(CurPtr, BufferEnd);
+    goto Restart;
   case '\v':
   case '\f':
     goto Restart;
@@ -2925,6 +3119,9 @@ Restart:
       }
       // '// ...' comment.
       skipSlashSlashComment(/*EatNewline=*/false);
+      if (CommentTriviaArena)
+        CommentTriviaArena->record(TriviaStart - BufferStart,
+                                   CurPtr - TriviaStart);
       goto Restart;
     } else if (*CurPtr == '*') {
       if (CommentStart == nullptr) {
@@ -2932,6 +3129,9 @@ Restart:
       }
       // '/* ... */' comment.
       skipSlashStarComment();
+      if (CommentTriviaArena)
+        CommentTriviaArena->record(TriviaStart - BufferStart,
+                                   CurPtr - TriviaStart);
       goto Restart;
     }
     break;
@@ -528,6 +528,22 @@ SourceFileParsingResult parseSourceFile(SourceFile &SF) {
     parser.parseTopLevelItems(items);
   }
 
+  // Record the extents of the top-level items so a later reparse of an
+  // edited buffer can bound its damage to the items overlapping the edit.
+  if (state) {
+    auto bufferRange = ctx.SourceMgr.getRangeForBuffer(bufferID);
+    state->clearTopLevelItemRanges();
+    for (auto &item : items) {
+      auto range = item.getSourceRange();
+      if (range.isInvalid() || !bufferRange.contains(range.Start) ||
+          !bufferRange.contains(range.End))
+        continue;
+      state->recordTopLevelItemRange(
+          ctx.SourceMgr.getLocOffsetInBuffer(range.Start, bufferID),
+          ctx.SourceMgr.getLocOffsetInBuffer(range.End, bufferID));
+    }
+  }
+
   std::optional<ArrayRef<Token>> tokensRef;
   if (auto tokens = parser.takeTokenReceiver()->finalize())
     tokensRef = ctx.AllocateCopy(*tokens);
@@ -18,6 +18,7 @@
 #include "swift/AST/ASTWalker.h"
 #include "swift/AST/DiagnosticsParse.h"
 #include "swift/AST/Module.h"
+#include "swift/AST/NameLookup.h"
 #include "swift/AST/ParseRequests.h"
 #include "swift/AST/PrettyStackTrace.h"
 #include "swift/AST/SourceFile.h"
@@ -159,8 +160,12 @@ void Parser::performIDEInspectionSecondPassImpl(
   // discriminators.
   Context.evaluator.clearCachedOutput(LocalDiscriminatorsRequest{DC});
 
-  // Clear any ASTScopes that were expanded.
-  SF.clearScope();
+  // Clear any ASTScopes that were expanded. When the delayed state is a
+  // function body, only that body's scopes are stale, so keep the rest of
+  // the tree.
+  if (info.Kind != IDEInspectionDelayedDeclKind::FunctionBody ||
+      !ASTScope::unexpandFunctionBody(dyn_cast<AbstractFunctionDecl>(DC)))
+    SF.clearScope();
 
   // FIXME: We shouldn't be mutating the AST after-the-fact like this.
   switch (info.Kind) {
@@ -48,3 +48,55 @@ void PersistentParserState::restoreIDEInspectionDelayedDeclState(
       other.Kind, other.ParentContext, other.StartOffset, other.EndOffset,
       other.PrevOffset));
 }
+
+void PersistentParserState::recordTopLevelItemRange(unsigned StartOffset,
+                                                    unsigned EndOffset) {
+  assert(StartOffset <= EndOffset && "invalid item range");
+  assert((TopLevelItemRanges.empty() ||
+          TopLevelItemRanges.back().first <= StartOffset) &&
+         "item ranges must be recorded in source order");
+  TopLevelItemRanges.emplace_back(StartOffset, EndOffset);
+}
+
+std::optional<std::pair<unsigned, unsigned>>
+PersistentParserState::computeDamagedRegion(const SourceFileEdit &Edit) const {
+  if (TopLevelItemRanges.empty())
+    return std::nullopt;
+
+  // Extend the edited region by one byte on each side; an insertion directly
+  // adjacent to an item can change how that item parses (e.g. appending to an
+  // identifier), so adjacent items count as damaged too.
+  unsigned DamageStart = Edit.Offset == 0 ? 0 : Edit.Offset - 1;
+  unsigned DamageEnd = Edit.Offset + Edit.OldLength + 1;
+
+  // Grow the damage outward to the boundaries of any overlapping items.
+  for (auto &Range : TopLevelItemRanges) {
+    if (Range.second < DamageStart || Range.first > DamageEnd)
+      continue;
+    DamageStart = std::min(DamageStart, Range.first);
+    DamageEnd = std::max(DamageEnd, Range.second);
+  }
+  return std::make_pair(DamageStart, DamageEnd);
+}
+
+void PersistentParserState::applyEdit(const SourceFileEdit &Edit) {
+  auto Damage = computeDamagedRegion(Edit);
+  if (!Damage)
+    return;
+
+  int Delta = (int)Edit.NewLength - (int)Edit.OldLength;
+  std::vector<std::pair<unsigned, unsigned>> Survivors;
+  Survivors.reserve(TopLevelItemRanges.size());
+  for (auto &Range : TopLevelItemRanges) {
+    // Drop items overlapping the damaged region.
+    if (Range.second >= Damage->first && Range.first <= Damage->second)
+      continue;
+    // Shift items behind the edit by the length delta.
+    if (Range.first > Damage->second) {
+      Survivors.emplace_back(Range.first + Delta, Range.second + Delta);
+    } else {
+      Survivors.push_back(Range);
+    }
+  }
+  TopLevelItemRanges = std::move(Survivors);
+}
@@ -39,6 +39,8 @@
 #include "clang/AST/DeclObjC.h"
 #include "clang/Basic/Module.h"
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/raw_ostream.h"
 
 using namespace swift;
@@ -147,15 +149,27 @@ static std::string getLocString(const Decl *afd) {
   return std::move(os.str());
 }
 
-static std::string getMangledNameString(const Decl *D) {
+/// Memoizes the mangled names computed by the sort below. A decl's mangled
+/// name is otherwise recomputed for every comparison it participates in,
+/// which dominates sorting time for modules with many same-named overloads.
+using MangledNameCache = llvm::DenseMap<const Decl *, std::string>;
+
+static StringRef getMangledNameString(const Decl *D,
+                                      MangledNameCache &cache) {
+  auto known = cache.find(D);
+  if (known != cache.end())
+    return known->second;
+
   auto VD = dyn_cast<ValueDecl>(D);
   if (!VD && isa<ExtensionDecl>(D))
     VD = cast<ExtensionDecl>(D)->getExtendedNominal();
-  if (!VD)
-    return std::string();
-  Mangle::ASTMangler mangler(VD->getASTContext());
-  return mangler.mangleAnyDecl(VD, /*prefix=*/true,
-                               /*respectOriginallyDefinedIn=*/true);
+  std::string mangled;
+  if (VD) {
+    Mangle::ASTMangler mangler(VD->getASTContext());
+    mangled = mangler.mangleAnyDecl(VD, /*prefix=*/true,
+                                    /*respectOriginallyDefinedIn=*/true);
+  }
+  return cache.try_emplace(D, std::move(mangled)).first->second;
 }
 
 static std::string getTypeString(const ValueDecl *VD) {
@@ -246,12 +260,14 @@ static int lastDitchSort(Decl *lhs, Decl *rhs, bool suppressDiagnostic) {
 
 } // end namespace compare_detail
 
-/// Comparator for use with \c llvm::array_pod_sort() . This sorts decls into
-/// reverse order since they will be pushed onto a stack.
-static int reverseCompareDecls(Decl * const *lhs, Decl * const *rhs) {
+/// Three-way comparator for the top-level decl sort. This sorts decls into
+/// reverse order since they will be pushed onto a stack. \p mangledNames
+/// memoizes the mangled-name tiebreakers across comparisons of one sort.
+static int reverseCompareDecls(Decl *const lhs, Decl *const rhs,
+                               compare_detail::MangledNameCache &mangledNames) {
   using namespace compare_detail;
 
-  assert(*lhs != *rhs && "duplicate top-level decl");
+  assert(lhs != rhs && "duplicate top-level decl");
 
   /// Run the LHS and RHS expressions through an appropriate overload of
   /// `compare_detail::reverseCompare()`, returning if they are unequal or
@@ -266,56 +282,54 @@ static int reverseCompareDecls(Decl * const *lhs, Decl * const *rhs) {
   // implementation of structs/enums to get the opaque pointers. To avoid
   // referencing these methods before we see the definition for the generated
   // classes, we want to visit function definitions last.
-  COMPARE((areTypes<NominalTypeDecl, AbstractFunctionDecl>(*lhs)),
-          (areTypes<NominalTypeDecl, AbstractFunctionDecl>(*rhs)));
+  COMPARE((areTypes<NominalTypeDecl, AbstractFunctionDecl>(lhs)),
+          (areTypes<NominalTypeDecl, AbstractFunctionDecl>(rhs)));
 
   // Sort by names.
-  COMPARE(getNameString(*lhs), getNameString(*rhs));
+  COMPARE(getNameString(lhs), getNameString(rhs));
 
   // Two overloaded functions can have the same name when emitting C++.
-  if (isa<AbstractFunctionDecl>(*rhs) && isa<AbstractFunctionDecl>(*lhs)) {
+  if (isa<AbstractFunctionDecl>(rhs) && isa<AbstractFunctionDecl>(lhs)) {
     // Sort top level functions with the same C++ name by their location to
     // have stable sorting that depends on users source but not on the
     // compiler invocation.
     // FIXME: This is pretty suspect; PrintAsClang sometimes operates on
     //        serialized modules which don't have SourceLocs, so this sort
     //        rule may be applied in some steps of a build but not others.
-    if ((*rhs)->getLoc().isValid() && (*lhs)->getLoc().isValid()) {
-      COMPARE(getLocString(*lhs), getLocString(*rhs));
+    if ((rhs)->getLoc().isValid() && (lhs)->getLoc().isValid()) {
+      COMPARE(getLocString(lhs), getLocString(rhs));
     }
   }
 
   // A function and a global variable can have the same name in C++,
   // even when the variable might not actually be emitted by the emitter.
   // In that case, order the function before the variable.
-  COMPARE((areTypes<AbstractFunctionDecl, VarDecl>(*lhs)),
-          (areTypes<AbstractFunctionDecl, VarDecl>(*rhs)));
+  COMPARE((areTypes<AbstractFunctionDecl, VarDecl>(lhs)),
+          (areTypes<AbstractFunctionDecl, VarDecl>(rhs)));
 
   // Prefer value decls to extensions.
-  COMPARE(isType<ValueDecl>(*lhs), isType<ValueDecl>(*rhs));
+  COMPARE(isType<ValueDecl>(lhs), isType<ValueDecl>(rhs));
 
   // Last-ditch ValueDecl tiebreaker: Compare mangled names. This captures
   // *tons* of context and detail missed by the previous checks, but the
   // resulting sort makes little sense to humans.
-  // FIXME: It'd be nice to share the mangler or even memoize mangled names,
-  //        but we'd have to stop using `llvm::array_pod_sort()` so that we
-  //        could capture some outside state.
-  COMPARE(getMangledNameString(*lhs), getMangledNameString(*rhs));
+  COMPARE(getMangledNameString(lhs, mangledNames),
+          getMangledNameString(rhs, mangledNames));
 
   // Mangled names ought to distinguish all value decls, leaving only
   // extensions of the same nominal type beyond this point.
-  if (!isa<ExtensionDecl>(*lhs) || !isa<ExtensionDecl>(*rhs))
-    return lastDitchSort(*lhs, *rhs, /*suppressDiagnostic=*/false);
+  if (!isa<ExtensionDecl>(lhs) || !isa<ExtensionDecl>(rhs))
+    return lastDitchSort(lhs, rhs, /*suppressDiagnostic=*/false);
 
   // Break ties in extensions by putting smaller extensions last (in reverse
   // order).
-  auto lhsMembers = cast<ExtensionDecl>(*lhs)->getAllMembers();
-  auto rhsMembers = cast<ExtensionDecl>(*rhs)->getAllMembers();
+  auto lhsMembers = cast<ExtensionDecl>(lhs)->getAllMembers();
+  auto rhsMembers = cast<ExtensionDecl>(rhs)->getAllMembers();
   COMPARE(lhsMembers.size(), rhsMembers.size());
 
   // Or the extension with fewer protocols.
-  auto lhsProtos = cast<ExtensionDecl>(*lhs)->getLocalProtocols();
-  auto rhsProtos = cast<ExtensionDecl>(*rhs)->getLocalProtocols();
+  auto lhsProtos = cast<ExtensionDecl>(lhs)->getLocalProtocols();
+  auto rhsProtos = cast<ExtensionDecl>(rhs)->getLocalProtocols();
   COMPARE(lhsProtos.size(), rhsProtos.size());
 
   // If that fails, arbitrarily pick the extension whose protocols are
@@ -358,17 +372,18 @@ static int reverseCompareDecls(Decl * const *lhs, Decl * const *rhs) {
       COMPARE(getTypeString(lhsMember), getTypeString(rhsMember));
       COMPARE(getGenericSignatureString(lhsMember),
               getGenericSignatureString(rhsMember));
-      COMPARE(getMangledNameString(lhsMember), getMangledNameString(rhsMember));
+      COMPARE(getMangledNameString(lhsMember, mangledNames),
+              getMangledNameString(rhsMember, mangledNames));
     }
   }
 
   // Tough customer. Maybe they have different generic signatures?
-  COMPARE(getGenericSignatureString(*lhs), getGenericSignatureString(*rhs));
+  COMPARE(getGenericSignatureString(lhs), getGenericSignatureString(rhs));
 
   // Nothing, sadly.
   bool bothEmpty = lhsMembers.empty() && rhsMembers.empty()
                       && lhsProtos.empty() && rhsProtos.empty();
-  return lastDitchSort(*lhs, *rhs, /*suppressDiagnostic=*/bothEmpty);
+  return lastDitchSort(lhs, rhs, /*suppressDiagnostic=*/bothEmpty);
 
 #undef COMPARE
 }
@@ -973,7 +988,10 @@ public:
     }
 
     // REVERSE sort the decls, since we are going to copy them onto a stack.
-    llvm::array_pod_sort(decls.begin(), decls.end(), &reverseCompareDecls);
+    compare_detail::MangledNameCache mangledNames;
+    llvm::sort(decls, [&mangledNames](Decl *lhs, Decl *rhs) {
+      return reverseCompareDecls(lhs, rhs, mangledNames) < 0;
+    });
 
     assert(declsToWrite.empty());
     declsToWrite.assign(decls.begin(), decls.end());
@@ -42,6 +42,17 @@ SILBasicBlock::SILBasicBlock() :
 SILBasicBlock::SILBasicBlock(SILFunction *parent) :
   SwiftObjectHeader(registeredMetatype), Parent(parent) {}
 
+void *SILBasicBlock::operator new(size_t Bytes, SILModule &M) {
+  return M.allocateBlock(Bytes, alignof(SILBasicBlock));
+}
+
+void SILBasicBlock::deleteBlock(SILBasicBlock *BB) {
+  assert(BB->getParent() && "only parented blocks are heap allocated");
+  SILModule &M = BB->getModule();
+  BB->~SILBasicBlock();
+  M.deallocateBlock(BB);
+}
+
 SILBasicBlock::~SILBasicBlock() {
   if (!getParent()) {
     assert(ArgumentList.empty() &&
@@ -19,6 +19,7 @@
 #include "swift/AST/GenericEnvironment.h"
 #include "swift/AST/ProtocolConformance.h"
 #include "swift/Basic/Assertions.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/ClangImporter/ClangModule.h"
 #include "swift/SIL/FormalLinkage.h"
 #include "swift/SIL/Notifications.h"
@@ -129,9 +130,18 @@ SILModule::SILModule(llvm::PointerUnion<FileUnit *, ModuleDecl *> context,
   std::unique_ptr<DeserializationNotificationHandler> callback(
       new SILModule::SerializationCallback());
   deserializationNotificationHandlers.add(std::move(callback));
+
+  // Let the stats reporter attribute our arena's growth to SIL phases.
+  // Cleared again in ~SILModule, since the reporter outlives us.
+  if (auto *stats = getASTContext().Stats)
+    stats->setSILArenaBytesCallback(
+        [this] { return (int64_t)BPA.getBytesAllocated(); });
 }
 
 SILModule::~SILModule() {
+  if (auto *stats = getASTContext().Stats)
+    stats->setSILArenaBytesCallback(nullptr);
+
 #ifndef NDEBUG
   NumSlabsAllocated += numAllocatedSlabs;
   assert(numAllocatedSlabs == freeSlabs.size() && "leaking slabs in SILModule");
@@ -212,6 +222,14 @@ void *SILModule::allocateInst(unsigned Size, unsigned Align) const {
   return AlignedAlloc(Size, Align);
 }
 
+void *SILModule::allocateBlock(unsigned Size, unsigned Align) const {
+  return AlignedAlloc(Size, Align);
+}
+
+void SILModule::deallocateBlock(SILBasicBlock *BB) {
+  scheduledBlockMemory.push_back(BB);
+}
+
 void SILModule::willDeleteInstruction(SILInstruction *I) {
   // Update RootLocalArchetypeDefs.
   I->forEachDefinedLocalEnvironment([&](GenericEnvironment *genericEnv,
@@ -236,6 +254,10 @@ void SILModule::flushDeletedInsts() {
     AlignedFree(instToDelete);
   }
   scheduledForDeletion.clear();
+
+  for (void *blockMemory : scheduledBlockMemory)
+    AlignedFree(blockMemory);
+  scheduledBlockMemory.clear();
 }
 
 SILWitnessTable *
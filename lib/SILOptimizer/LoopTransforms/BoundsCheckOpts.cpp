@@ -1286,13 +1286,6 @@ bool BoundsCheckOpts::optimizeArrayBoundsCheckInLoop(SILLoop *loop) {
       llvm::dbgs() << "Attempting to remove redundant array bounds checks in "
                    << *loop);
 
-  // Collect safe arrays. Arrays are safe if there is no function call that
-  // could mutate their size in the loop.
-  ABCAnalysis ABC(true, releaseSafeArrays, RCIA);
-  for (auto *BB : loop->getBlocks()) {
-    ABC.analyzeBlock(BB);
-  }
-
   bool changed = false;
   auto result = findAndOptimizeInductionVariables(loop);
   changed |= result.first;
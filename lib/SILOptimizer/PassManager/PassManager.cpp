@@ -30,12 +30,16 @@
 #include "swift/SILOptimizer/Utils/SILOptFunctionBuilder.h"
 #include "swift/SILOptimizer/Utils/SILSSAUpdater.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/GraphWriter.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/Casting.h"
 #include <fstream>
 
@@ -57,6 +61,17 @@ llvm::cl::opt<unsigned> SILMinPassTime(
     "sil-min-pass-time", llvm::cl::init(0),
     llvm::cl::desc("The minimum number of milliseconds for which a pass is printed with -sil-print-pass-time"));
 
+llvm::cl::opt<std::string> SILPassTraceFile(
+    "sil-pass-trace-file", llvm::cl::init(""),
+    llvm::cl::desc("Append a chrome://tracing compatible JSON trace of all "
+                   "pass runs, including instruction count deltas, to the "
+                   "given file"));
+
+llvm::cl::opt<std::string> SILPassTimesJSONFile(
+    "sil-pass-times-json", llvm::cl::init(""),
+    llvm::cl::desc("Append the aggregated runtime of each pass as a JSON "
+                   "record to the given file"));
+
 llvm::cl::opt<bool> SILPrintLast(
     "sil-print-last", llvm::cl::init(false),
     llvm::cl::desc("Print the last optimized function before and after the last pass"));
@@ -627,6 +642,67 @@ bool SILPassManager::disablePassesForFunction(SILFunction *function) {
                    function->getName()) != SILDisablePassOnlyFun.end();
 }
 
+/// Returns the number of instructions in \p F.
+static int64_t countInstructions(SILFunction *F) {
+  int64_t numInsts = 0;
+  for (SILBasicBlock &BB : *F)
+    numInsts += std::distance(BB.begin(), BB.end());
+  return numInsts;
+}
+
+/// Returns the number of instructions in all function bodies of \p M.
+static int64_t countInstructions(SILModule *M) {
+  int64_t numInsts = 0;
+  for (SILFunction &F : *M)
+    numInsts += countInstructions(&F);
+  return numInsts;
+}
+
+/// Appends a complete-event record for one pass run to the trace file given
+/// by -sil-pass-trace-file.
+///
+/// The stream stays open for the lifetime of the process and the JSON array
+/// is left unterminated, which chrome://tracing accepts. This way the events
+/// of all pass manager instances end up in one consistent trace, and the
+/// traces of several processes can simply be concatenated.
+static void appendPassTraceEvent(StringRef passName, StringRef functionName,
+                                 llvm::sys::TimePoint<> startTime,
+                                 std::chrono::nanoseconds duration,
+                                 int64_t instsBefore, int64_t instsAfter) {
+  static std::unique_ptr<llvm::raw_fd_ostream> traceStream;
+  static bool streamInitialized = false;
+  if (!streamInitialized) {
+    streamInitialized = true;
+    std::error_code error;
+    traceStream = std::make_unique<llvm::raw_fd_ostream>(
+        SILPassTraceFile, error,
+        llvm::sys::fs::OF_Append | llvm::sys::fs::OF_Text);
+    if (error) {
+      llvm::errs() << "cannot open -sil-pass-trace-file "
+                   << SILPassTraceFile << ": " << error.message() << '\n';
+      traceStream.reset();
+    } else if (traceStream->tell() == 0) {
+      *traceStream << "[\n";
+    }
+  }
+  if (!traceStream)
+    return;
+
+  using namespace std::chrono;
+  llvm::json::Object event{
+      {"name", passName},
+      {"cat", "sil"},
+      {"ph", "X"},
+      {"ts", duration_cast<microseconds>(startTime.time_since_epoch()).count()},
+      {"dur", duration_cast<microseconds>(duration).count()},
+      {"pid", int64_t(llvm::sys::Process::getProcessId())},
+      {"tid", 0},
+      {"args", llvm::json::Object{{"function", functionName},
+                                  {"instructions-before", instsBefore},
+                                  {"instructions-after", instsAfter}}}};
+  *traceStream << llvm::json::Value(std::move(event)) << ",\n";
+}
+
 void SILPassManager::runPassOnFunction(unsigned TransIdx, SILFunction *F) {
 
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
@@ -700,6 +776,13 @@ void SILPassManager::runPassOnFunction(unsigned TransIdx, SILFunction *F) {
   llvm::sys::TimePoint<> startTime = std::chrono::system_clock::now();
   std::chrono::nanoseconds duration(0);
 
+  // The start of the pass run; `startTime` is reset when pausing the time
+  // measurement below.
+  llvm::sys::TimePoint<> traceStartTime = startTime;
+  int64_t traceInstsBefore = 0;
+  if (!SILPassTraceFile.empty())
+    traceInstsBefore = countInstructions(F);
+
   enum {
     // In future we might want to make snapshots with positive number (e.g.
     // corresponding to pass indices). Therefore use -1 here to avoid collisions.
@@ -748,6 +831,16 @@ void SILPassManager::runPassOnFunction(unsigned TransIdx, SILFunction *F) {
                    << " #" << NumPassesRun << " @" << F->getName() << "\n";
     }
   }
+  if (!SILPassTraceFile.empty()) {
+    appendPassTraceEvent(SFT->getTag(), F->getName(), traceStartTime, duration,
+                         traceInstsBefore, countInstructions(F));
+  }
+  if (!SILPassTimesJSONFile.empty()) {
+    auto &entry = passRuntimes[SFT->getTag()];
+    entry.first += duration;
+    entry.second += 1;
+    lastRunPassTag = SFT->getTag();
+  }
 
   if (numRepeats > 1)
     F->deleteSnapshot(SnapshotID);
@@ -803,9 +896,17 @@ runFunctionPasses(unsigned FromTransIdx, unsigned ToTransIdx) {
   if (ToTransIdx <= FromTransIdx)
     return;
 
-  BasicCalleeAnalysis *BCA = getAnalysis<BasicCalleeAnalysis>();
-  BottomUpFunctionOrder BottomUpOrder(*Mod, BCA);
-  auto BottomUpFunctions = BottomUpOrder.getFunctions();
+  // Computing the bottom-up order walks the whole call graph; reuse the
+  // order from the previous segment unless something invalidated it.
+  if (!BottomUpFunctionOrderIsValid) {
+    BasicCalleeAnalysis *BCA = getAnalysis<BasicCalleeAnalysis>();
+    BottomUpFunctionOrder BottomUpOrder(*Mod, BCA);
+    auto BottomUpFunctions = BottomUpOrder.getFunctions();
+    CachedBottomUpFunctionOrder.assign(BottomUpFunctions.begin(),
+                                       BottomUpFunctions.end());
+    BottomUpFunctionOrderIsValid = true;
+  }
+  auto &BottomUpFunctions = CachedBottomUpFunctionOrder;
 
   assert(FunctionWorklist.empty() && "Expected empty function worklist!");
 
@@ -877,6 +978,8 @@ void SILPassManager::runModulePass(unsigned TransIdx) {
   updateSILModuleStatsBeforeTransform(*Mod, SMT, *this, NumPassesRun);
 
   CurrentPassHasInvalidated = false;
+  FunctionsInvalidatedByCurrentPass.clear();
+  CurrentPassInvalidatedWholeModule = false;
   numSubpassesRun = 0;
 
   if (SILPrintPassName)
@@ -903,6 +1006,10 @@ void SILPassManager::runModulePass(unsigned TransIdx) {
 
   swiftPassInvocation.startModulePassRun(SMT);
 
+  int64_t traceInstsBefore = 0;
+  if (!SILPassTraceFile.empty())
+    traceInstsBefore = countInstructions(Mod);
+
   llvm::sys::TimePoint<> StartTime = std::chrono::system_clock::now();
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
   SMT->run();
@@ -926,6 +1033,16 @@ void SILPassManager::runModulePass(unsigned TransIdx) {
                    << " #" << NumPassesRun << "\n";
     }
   }
+  if (!SILPassTraceFile.empty()) {
+    appendPassTraceEvent(SMT->getTag(), "<module>", StartTime, duration,
+                         traceInstsBefore, countInstructions(Mod));
+  }
+  if (!SILPassTimesJSONFile.empty()) {
+    auto &entry = passRuntimes[SMT->getTag()];
+    entry.first += duration;
+    entry.second += 1;
+    lastRunPassTag = SMT->getTag();
+  }
 
   // If this pass invalidated anything, print and verify.
   if (doPrintAfter(SMT, nullptr, CurrentPassHasInvalidated)) {
@@ -936,10 +1053,23 @@ void SILPassManager::runModulePass(unsigned TransIdx) {
   updateSILModuleStatsAfterTransform(*Mod, SMT, *this, NumPassesRun, duration.count());
 
   if (Options.VerifyAll &&
-      (CurrentPassHasInvalidated || !SILVerifyWithoutInvalidation)) {
-    Mod->verify(getAnalysis<BasicCalleeAnalysis>()->getCalleeCache());
-    verifyAnalyses();
-    runSwiftModuleVerification();
+      (CurrentPassHasInvalidated || SILVerifyWithoutInvalidation)) {
+    // Only verify the functions for which the pass reported an invalidation.
+    // A module-wide invalidation - e.g. a change of witness- or vtables -
+    // still verifies the whole module, as does
+    // -sil-verify-without-invalidation.
+    if (CurrentPassInvalidatedWholeModule || SILVerifyWithoutInvalidation) {
+      Mod->verify(getAnalysis<BasicCalleeAnalysis>()->getCalleeCache());
+      verifyAnalyses();
+      runSwiftModuleVerification();
+    } else {
+      auto *calleeCache = getAnalysis<BasicCalleeAnalysis>()->getCalleeCache();
+      for (SILFunction *F : FunctionsInvalidatedByCurrentPass) {
+        F->verify(calleeCache);
+        verifyAnalyses(F);
+        runSwiftFunctionVerification(F);
+      }
+    }
   } else {
     if ((SILVerifyAfterPass.end() != std::find_if(SILVerifyAfterPass.begin(),
                                                   SILVerifyAfterPass.end(),
@@ -1045,9 +1175,54 @@ irgen::IRGenModule *SILPassManager::getIRGenModule() {
   return IRMod;
 }
 
+/// Appends one JSON record summarizing the pass runtimes of this pass
+/// manager to the file given by -sil-pass-times-json.
+///
+/// Each pass manager instance appends one line, so the records of all
+/// pipelines (and of several processes) can simply be concatenated and
+/// summed. The record carries the aggregated time per pass tag, the total,
+/// the number of pass runs and the tag of the last executed pass; the
+/// latter lets a driver combine this with -sil-opt-pass-count to identify
+/// the pass at a pipeline prefix boundary (see utils/sil-opt-bisect).
+void SILPassManager::appendPassTimesJSON() {
+  std::error_code error;
+  llvm::raw_fd_ostream stream(SILPassTimesJSONFile, error,
+                              llvm::sys::fs::OF_Append |
+                                  llvm::sys::fs::OF_Text);
+  if (error) {
+    llvm::errs() << "cannot open -sil-pass-times-json "
+                 << SILPassTimesJSONFile << ": " << error.message() << '\n';
+    return;
+  }
+
+  using namespace std::chrono;
+  llvm::json::Array passes;
+  std::vector<decltype(passRuntimes)::const_iterator> sorted;
+  for (auto it = passRuntimes.begin(); it != passRuntimes.end(); ++it)
+    sorted.push_back(it);
+  llvm::sort(sorted, [](const auto &a, const auto &b) {
+    return a->second.first > b->second.first;
+  });
+  for (const auto &it : sorted) {
+    passes.push_back(llvm::json::Object{
+        {"pass", it->first()},
+        {"ms", (double)it->second.first.count() / 1000000.},
+        {"runs", int64_t(it->second.second)}});
+  }
+  llvm::json::Object record{
+      {"total_ms", (double)totalPassRuntime.count() / 1000000.},
+      {"passes_run", int64_t(NumPassesRun)},
+      {"last_pass", lastRunPassTag},
+      {"passes", std::move(passes)}};
+  stream << llvm::json::Value(std::move(record)) << '\n';
+}
+
 /// D'tor.
 SILPassManager::~SILPassManager() {
 
+  if (!SILPassTimesJSONFile.empty() && !passRuntimes.empty())
+    appendPassTimesJSON();
+
   if (SILOptProfileRepeat > 1) {
     double milliSecs = (double)totalPassRuntime.count() / 1000000.;
     llvm::dbgs() << llvm::format("%9.3f", milliSecs) << " ms: total runtime of all passes\n";
@@ -1151,6 +1326,9 @@ void SILPassManager::addFunctionToWorklist(SILFunction *F,
 
   StoredLevel = NewLevel;
   FunctionWorklist.push_back(F);
+
+  // The new function is not part of the cached bottom-up function order.
+  invalidateBottomUpFunctionOrder();
 }
 
 void SILPassManager::restartWithCurrentFunction(SILTransform *T) {
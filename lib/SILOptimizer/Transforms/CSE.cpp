@@ -64,7 +64,11 @@ namespace {
 struct SimpleValue {
   SILInstruction *Inst;
 
-  SimpleValue(SILInstruction *I) : Inst(I) { }
+  /// The instruction's hash, computed once at construction so that probing,
+  /// inserting and growing the hash table do not re-walk the operands.
+  unsigned Hash;
+
+  SimpleValue(SILInstruction *I);
 
   bool isSentinel() const {
     return Inst == llvm::DenseMapInfo<SILInstruction *>::getEmptyKey() ||
@@ -525,8 +529,11 @@ public:
 };
 } // end anonymous namespace
 
+SimpleValue::SimpleValue(SILInstruction *I)
+    : Inst(I), Hash(isSentinel() ? 0 : unsigned(HashVisitor().visit(I))) {}
+
 unsigned llvm::DenseMapInfo<SimpleValue>::getHashValue(SimpleValue Val) {
-  return HashVisitor().visit(Val.Inst);
+  return Val.Hash;
 }
 
 bool llvm::DenseMapInfo<SimpleValue>::isEqual(SimpleValue LHS,
@@ -1057,9 +1064,12 @@ bool CSE::processNode(DominanceInfoNode *Node) {
     assert(llvm::DenseMapInfo<SimpleValue>::isEqual(Inst, Inst) &&
            "Inst must match itself for map to work");
 
+    // Hash the instruction only once for both the lookup and the insertion.
+    SimpleValue InstValue(Inst);
+
     // Now that we know we have an instruction we understand see if the
     // instruction has an available value.  If so, use it.
-    if (SILInstruction *AvailInst = AvailableValues->lookup(Inst)) {
+    if (SILInstruction *AvailInst = AvailableValues->lookup(InstValue)) {
       LLVM_DEBUG(llvm::dbgs() << "SILCSE CSE: " << *Inst << "  to: "
                               << *AvailInst << '\n');
 
@@ -1112,7 +1122,7 @@ bool CSE::processNode(DominanceInfoNode *Node) {
     }
 
     // Otherwise, just remember that this value is available.
-    AvailableValues->insert(Inst, Inst);
+    AvailableValues->insert(InstValue, Inst);
     LLVM_DEBUG(llvm::dbgs() << "SILCSE Adding to value table: " << *Inst
                             << " -> " << *Inst << "\n");
   }
@@ -268,8 +268,13 @@ class SILPerformanceInliner {
   void visitColdBlocks(SmallVectorImpl<FullApplySite> &AppliesToInline,
                        SILBasicBlock *root, DominanceInfo *DT, int numCallerBlocks);
 
-  void collectAppliesToInline(SILFunction *Caller,
-                              SmallVectorImpl<FullApplySite> &Applies);
+  void collectAppliesToInline(
+      SILFunction *Caller, SmallVectorImpl<FullApplySite> &Applies,
+      llvm::DenseMap<FullApplySite, uint64_t> &CallSiteProfileCounts);
+
+  static void updateCalleeProfile(
+      FullApplySite AI, SILFunction *Callee,
+      const llvm::DenseMap<FullApplySite, uint64_t> &CallSiteProfileCounts);
 
 public:
   SILPerformanceInliner(StringRef PassName, SILOptFunctionBuilder &FuncBuilder,
@@ -1168,7 +1173,8 @@ calculateBBWeights(SILFunction *Caller, DominanceInfo *DT,
 }
 
 void SILPerformanceInliner::collectAppliesToInline(
-    SILFunction *Caller, SmallVectorImpl<FullApplySite> &Applies) {
+    SILFunction *Caller, SmallVectorImpl<FullApplySite> &Applies,
+    llvm::DenseMap<FullApplySite, uint64_t> &CallSiteProfileCounts) {
   DominanceInfo *DT = DA->get(Caller);
   SILLoopInfo *LI = LA->get(Caller);
 
@@ -1217,6 +1223,14 @@ void SILPerformanceInliner::collectAppliesToInline(
   llvm::DenseMap<SILBasicBlock *, uint64_t> BBToWeightMap;
   calculateBBWeights(Caller, DT, BBToWeightMap);
 
+  // Remembers the profiled execution count of a candidate call site, so that
+  // the callee's entry count can be updated when the call site is inlined.
+  auto recordCallSiteProfileCount = [&](FullApplySite AI) {
+    auto bbIt = BBToWeightMap.find(AI.getParent());
+    if (bbIt != BBToWeightMap.end())
+      CallSiteProfileCounts[AI] = bbIt->getSecond();
+  };
+
   // Go through all instructions and find candidates for inlining.
   // We do this in dominance order for the constTracker.
   SmallVector<FullApplySite, 8> InitialCandidates;
@@ -1240,6 +1254,7 @@ void SILPerformanceInliner::collectAppliesToInline(
         // just add it to our final Applies list and continue.
         if (isInlineAlwaysCallSite(Callee, NumCallerBlocks)) {
           NumCallerBlocks += Callee->size();
+          recordCallSiteProfileCount(AI);
           Applies.push_back(AI);
           continue;
         }
@@ -1296,11 +1311,36 @@ void SILPerformanceInliner::collectAppliesToInline(
 
     const unsigned CallsToCalleeThreshold = 1024;
     if (CalleeCount[Callee] <= CallsToCalleeThreshold) {
+      recordCallSiteProfileCount(AI);
       Applies.push_back(AI);
     }
   }
 }
 
+/// Update the callee's entry count after inlining the call site \p AI, so
+/// that profile based decisions for the callee's remaining call sites are
+/// based on the residual hotness.
+///
+/// Without this, after the hottest call site of a callee has been inlined,
+/// the ratio of a remaining call site's count to the callee's entry count
+/// under-estimates the importance of that call site, because the entry count
+/// still includes calls which no longer exist.
+void SILPerformanceInliner::updateCalleeProfile(
+    FullApplySite AI, SILFunction *Callee,
+    const llvm::DenseMap<FullApplySite, uint64_t> &CallSiteProfileCounts) {
+  auto entryCount = Callee->getEntryCount();
+  if (!entryCount)
+    return;
+  auto csIt = CallSiteProfileCounts.find(AI);
+  if (csIt == CallSiteProfileCounts.end())
+    return;
+  uint64_t callSiteCount = csIt->getSecond();
+  uint64_t entryCountVal = entryCount.getValue();
+  uint64_t residualCount =
+      entryCountVal > callSiteCount ? entryCountVal - callSiteCount : 0;
+  Callee->setEntryCount(ProfileCounter(residualCount));
+}
+
 /// Attempt to inline all calls smaller than our threshold.
 /// returns True if a function was inlined.
 bool SILPerformanceInliner::inlineCallsIntoFunction(SILFunction *Caller) {
@@ -1314,7 +1354,8 @@ bool SILPerformanceInliner::inlineCallsIntoFunction(SILFunction *Caller) {
   // don't change anything yet so that the dominator information
   // remains valid.
   SmallVector<FullApplySite, 8> AppliesToInline;
-  collectAppliesToInline(Caller, AppliesToInline);
+  llvm::DenseMap<FullApplySite, uint64_t> CallSiteProfileCounts;
+  collectAppliesToInline(Caller, AppliesToInline, CallSiteProfileCounts);
   bool invalidatedStackNesting = false;
 
   if (AppliesToInline.empty())
@@ -1351,6 +1392,8 @@ bool SILPerformanceInliner::inlineCallsIntoFunction(SILFunction *Caller) {
     // will be deleted after inlining.
     invalidatedStackNesting |= SILInliner::invalidatesStackNesting(AI);
 
+    updateCalleeProfile(AI, Callee, CallSiteProfileCounts);
+
     if (SILPrintInliningCallee) {
       printInliningDetailsCallee(PassName, Caller, Callee);
     }
@@ -1869,6 +1869,14 @@ static bool isAsyncIteratorProtocolNext(ValueDecl *req) {
 InferredAssociatedTypes
 AssociatedTypeInference::inferTypeWitnessesViaValueWitnesses(
   const llvm::SetVector<AssociatedTypeDecl *> &assocTypes) {
+  // The requirements that can structurally drive inference are the same for
+  // every conformance to this protocol; the set is memoized per protocol.
+  auto candidates = evaluateOrDefault(ctx.evaluator,
+                                      InferenceCandidateRequirementsRequest{proto},
+                                      TinyPtrVector<ValueDecl *>());
+  llvm::SmallPtrSet<ValueDecl *, 8> candidateSet(candidates.begin(),
+                                                 candidates.end());
+
   InferredAssociatedTypes result;
   for (auto member : proto->getMembers()) {
     auto req = dyn_cast<ValueDecl>(member);
@@ -1889,14 +1897,11 @@ AssociatedTypeInference::inferTypeWitnessesViaValueWitnesses(
       continue;
     }
 
-    // Skip operator requirements, because they match globally and
-    // therefore tend to cause deduction mismatches.
-    // FIXME: If we had some basic soundness checking of Self, we might be able to
-    // use these.
-    if (auto func = dyn_cast<FuncDecl>(req)) {
-      if (func->isOperator() || isa<AccessorDecl>(func))
-        continue;
-    }
+    // Skip requirements that cannot drive inference for any conformance of
+    // this protocol: operators, accessors, and requirements that don't
+    // reference any associated type.
+    if (!candidateSet.count(req))
+      continue;
 
     // Validate the requirement.
     if (req->isInvalid())
@@ -4682,3 +4687,39 @@ ReferencedAssociatedTypesRequest::evaluate(Evaluator &eval,
 
   return assocTypes;
 }
+
+TinyPtrVector<ValueDecl *>
+InferenceCandidateRequirementsRequest::evaluate(Evaluator &eval,
+                                                ProtocolDecl *proto) const {
+  TinyPtrVector<ValueDecl *> candidates;
+  for (auto member : proto->getMembers()) {
+    auto *req = dyn_cast<ValueDecl>(member);
+    if (!req || !req->isProtocolRequirement())
+      continue;
+
+    if (isa<AssociatedTypeDecl>(req))
+      continue;
+
+    // Skip operator requirements, because they match globally and
+    // therefore tend to cause deduction mismatches.
+    // FIXME: If we had some basic soundness checking of Self, we might be
+    // able to use these.
+    if (auto *func = dyn_cast<FuncDecl>(req)) {
+      if (func->isOperator() || isa<AccessorDecl>(func))
+        continue;
+    }
+
+    // A requirement that references no associated type cannot bind one,
+    // except for AsyncIteratorProtocol.next() which is special-cased by
+    // inference.
+    auto referenced = evaluateOrDefault(eval,
+                                        ReferencedAssociatedTypesRequest{req},
+                                        TinyPtrVector<AssociatedTypeDecl *>());
+    if (referenced.empty() && !isAsyncIteratorProtocolNext(req))
+      continue;
+
+    candidates.push_back(req);
+  }
+
+  return candidates;
+}
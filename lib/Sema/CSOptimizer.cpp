@@ -264,6 +264,45 @@ static bool isArithmeticOperator(ValueDecl *decl) {
   return decl->isOperator() && decl->getBaseIdentifier().isArithmeticOperator();
 }
 
+/// A precomputed preference for the closed set of standard-library operator
+/// overloads.
+///
+/// When the context provides no signal at all, explore operator disjunctions
+/// in the order operator expressions actually resolve in practice: the
+/// homogeneous overloads over the common concrete types first, with `Int`
+/// ahead of `Double` ahead of the rest. The ranks are deliberately tiny so
+/// that any genuine contextual score dominates them.
+static double getPrecomputedOperatorRank(ValueDecl *decl,
+                                         FunctionType *overloadType) {
+  if (!decl->isOperator())
+    return 0;
+
+  auto name = decl->getBaseIdentifier();
+  if (!(name.isArithmeticOperator() || name.isStandardComparisonOperator() ||
+        name.isBitwiseOperator()))
+    return 0;
+
+  if (decl->getAttrs().hasAttribute<DisfavoredOverloadAttr>())
+    return 0;
+
+  if (overloadType->getNumParams() != 2)
+    return 0;
+
+  auto lhsTy = overloadType->getParams()[0].getPlainType();
+  auto rhsTy = overloadType->getParams()[1].getPlainType();
+  if (lhsTy->hasTypeParameter() || lhsTy->hasTypeVariable() ||
+      !lhsTy->isEqual(rhsTy))
+    return 0;
+
+  if (lhsTy->isInt())
+    return 0.03;
+  if (lhsTy->isDouble())
+    return 0.02;
+  if (lhsTy->isFloat() || lhsTy->isString())
+    return 0.01;
+  return 0;
+}
+
 /// Generic choices are supported only if they are not complex enough
 /// that would they'd require solving to figure out whether they are a
 /// potential match or not.
@@ -1759,6 +1798,24 @@ static void determineBestChoicesInContext(
                          (!canUseContextualResultTypes ||
                           !anyNonSpeculativeResultTypes(resultTypes));
 
+    // If the context gave us nothing to go on, consult the precomputed
+    // ranking for standard-library operators; it only reorders exploration,
+    // so it's always treated as speculative.
+    if (favoredChoices.empty() && isOperator && !hasArgumentCandidates) {
+      forEachDisjunctionChoice(
+          cs, disjunction,
+          [&](Constraint *choice, ValueDecl *decl,
+              FunctionType *overloadType) {
+            auto rank = getPrecomputedOperatorRank(decl, overloadType);
+            if (rank > 0) {
+              favoredChoices.push_back({choice, rank});
+              bestScore = std::max(bestScore, rank);
+            }
+          });
+      if (!favoredChoices.empty())
+        isSpeculative = true;
+    }
+
     DisjunctionInfoBuilder info(/*score=*/bestScore);
 
     info.setSpeculative(isSpeculative);
@@ -29,6 +29,8 @@
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Compiler.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/SaveAndRestore.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -1550,6 +1552,64 @@ ConstraintSystem::solveImpl(SyntacticElementTarget &target,
   }
 }
 
+/// Append one complete event in Chrome trace format for the constraint
+/// system that was just solved, so a slow file can be opened as a flamegraph
+/// in chrome://tracing and the guilty expression located by source range.
+///
+/// Events are appended as one JSON object per line; the trace event format
+/// tolerates a missing closing bracket, so the file stays well-formed even
+/// if the frontend is killed mid-run.
+static void recordSolverTraceEvent(ConstraintSystem &cs) {
+  // Without a timer there is neither an anchor nor a start time to
+  // attribute the event to.
+  if (!cs.Timer)
+    return;
+
+  auto &ctx = cs.getASTContext();
+
+  std::error_code EC;
+  llvm::raw_fd_ostream OS(ctx.TypeCheckerOpts.SolverTracePath, EC,
+                          llvm::sys::fs::OF_Append | llvm::sys::fs::OF_Text);
+  if (EC)
+    return;
+
+  if (OS.tell() == 0)
+    OS << "[\n";
+
+  SmallString<128> range;
+  {
+    llvm::raw_svector_ostream rangeOS(range);
+    auto R = cs.Timer->getAffectedRange();
+    if (R.isValid()) {
+      R.print(rangeOS, ctx.SourceMgr, /*PrintText=*/false);
+    } else {
+      rangeOS << "<invalid range>";
+    }
+  }
+
+  auto startTime = cs.Timer->startedAt().getWallTime();
+  auto endTime =
+      llvm::TimeRecord::getCurrentTime(/*Start=*/false).getWallTime();
+
+  OS << llvm::json::Value(llvm::json::Object{
+            {"name", range.str()},
+            {"cat", "solve"},
+            {"ph", "X"},
+            {"pid", int64_t(llvm::sys::Process::getProcessId())},
+            {"tid", int64_t(0)},
+            {"ts", int64_t(startTime * 1e6)},
+            {"dur", int64_t((endTime - startTime) * 1e6)},
+            {"args",
+             llvm::json::Object{
+                 {"scopes", int64_t(cs.solverState->NumSolverScopes)},
+                 {"trail steps", int64_t(cs.solverState->NumTrailSteps)},
+                 {"max depth", int64_t(cs.solverState->maxDepth)},
+                 {"memory", int64_t(ctx.getSolverMemory())},
+             }},
+        })
+     << ",\n";
+}
+
 bool ConstraintSystem::solve(SmallVectorImpl<Solution> &solutions,
                              FreeTypeVariableBinding allowFreeTypeVariables) {
   // Set up solver state.
@@ -1576,6 +1636,9 @@ bool ConstraintSystem::solve(SmallVectorImpl<Solution> &solutions,
   // by constraint system options.
   filterSolutions(solutions);
 
+  if (!getASTContext().TypeCheckerOpts.SolverTracePath.empty())
+    recordSolverTraceEvent(*this);
+
   // We fail if there is no solution or the expression was too complex.
   return solutions.empty() || isTooComplex(solutions);
 }
@@ -27,6 +27,8 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <algorithm>
+
 using namespace llvm;
 using namespace swift;
 using namespace constraints;
@@ -130,8 +132,23 @@ void SplitterStep::computeFollowupSteps(
   PartialSolutions = std::unique_ptr<SmallVector<Solution, 4>[]>(
       new SmallVector<Solution, 4>[numComponents]);
 
-  // Add components.
-  for (unsigned i : indices(components)) {
+  // Add components. Since the components are independent and the split fails
+  // as soon as any one of them is unsatisfiable, attempt the components with
+  // the fewest disjunctions first; that bounds the work wasted on a doomed
+  // split before a cheap component gets a chance to fail. Partial solutions
+  // are recorded by `solutionIndex`, so the merge is unaffected by the order
+  // in which components are solved. The work list executes the most recently
+  // added step first, so steps are added in order of decreasing cost.
+  SmallVector<unsigned, 4> componentOrder;
+  for (unsigned i : indices(components))
+    componentOrder.push_back(i);
+  std::stable_sort(componentOrder.begin(), componentOrder.end(),
+                   [&](unsigned lhs, unsigned rhs) {
+                     return components[lhs].getNumDisjunctions() >
+                            components[rhs].getNumDisjunctions();
+                   });
+
+  for (unsigned i : componentOrder) {
     unsigned solutionIndex = components[i].solutionIndex;
 
     steps.push_back(std::make_unique<ComponentStep>(
@@ -23,8 +23,10 @@
 #include "swift/Basic/Assertions.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/LEB128.h"
 #include "llvm/Support/SaveAndRestore.h"
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <numeric>
 
@@ -45,7 +47,7 @@ SolverTrail::~SolverTrail() {
   // possible that constraint graph is corrupted as well
   // so let's not attempt to check change log.
   if (!CS.inInvalidState())
-    ASSERT(Changes.empty() && "Trail corrupted");
+    ASSERT(NumChanges == 0 && "Trail corrupted");
 }
 
 #define LOCATOR_CHANGE(Name, _) \
@@ -368,6 +370,353 @@ SolverTrail::Change::getSyntacticElementTargetKey() const {
   }
 }
 
+namespace {
+
+/// Reinterpret a trivially-copyable field of a change as its raw bits for
+/// encoding.
+template <typename T>
+uint64_t rawBits(const T &value) {
+  static_assert(sizeof(T) <= sizeof(uint64_t),
+                "field does not fit in an encoded word");
+  uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(T));
+  return bits;
+}
+
+/// Reconstitute a field of a change from its raw bits.
+template <typename T>
+void setRawBits(T &value, uint64_t bits) {
+  static_assert(sizeof(T) <= sizeof(uint64_t),
+                "field does not fit in an encoded word");
+  std::memcpy(&value, &bits, sizeof(T));
+}
+
+} // end anonymous namespace
+
+unsigned SolverTrail::Change::encode(char *buffer) const {
+  static_assert(unsigned(ChangeKind::Last) < 0x100,
+                "change kind must fit in one byte");
+
+  uint8_t *ptr = reinterpret_cast<uint8_t *>(buffer);
+  *ptr++ = uint8_t(Kind);
+
+  auto push = [&](uint64_t value) {
+    ptr += llvm::encodeULEB128(value, ptr);
+  };
+
+  switch (Kind) {
+#define LOCATOR_CHANGE(Name, _) case ChangeKind::Name:
+#include "swift/Sema/CSTrail.def"
+    push(rawBits(TheLocator));
+    break;
+
+#define EXPR_CHANGE(Name) case ChangeKind::Name:
+#include "swift/Sema/CSTrail.def"
+    push(rawBits(TheExpr));
+    break;
+
+#define CLOSURE_CHANGE(Name) case ChangeKind::Name:
+#include "swift/Sema/CSTrail.def"
+    push(rawBits(TheClosure));
+    break;
+
+#define CONSTRAINT_CHANGE(Name) case ChangeKind::Name:
+#include "swift/Sema/CSTrail.def"
+    push(rawBits(TheConstraint.Constraint));
+    break;
+
+#define GRAPH_NODE_CHANGE(Name) case ChangeKind::Name:
+#include "swift/Sema/CSTrail.def"
+    push(rawBits(TheConstraint.TypeVar));
+    push(rawBits(TheConstraint.Constraint));
+    break;
+
+#define BINDING_RELATION_CHANGE(Name) case ChangeKind::Name:
+#include "swift/Sema/CSTrail.def"
+    push(rawBits(BindingRelation.TypeVar));
+    push(rawBits(BindingRelation.OtherTypeVar));
+    push(rawBits(BindingRelation.Constraint));
+    break;
+
+#define SCORE_CHANGE(Name) case ChangeKind::Name:
+#include "swift/Sema/CSTrail.def"
+    push(Options);
+    break;
+
+  case ChangeKind::AddedTypeVariable:
+    push(rawBits(TypeVar));
+    break;
+
+  case ChangeKind::ExtendedEquivalenceClass:
+    push(rawBits(EquivClass.TypeVar));
+    push(EquivClass.PrevSize);
+    break;
+
+  case ChangeKind::RelatedTypeVariables:
+    push(rawBits(Relation.TypeVar));
+    push(rawBits(Relation.OtherTypeVar));
+    break;
+
+  case ChangeKind::UpdatedTypeVariable:
+    push(Options);
+    push(rawBits(Update.TypeVar));
+    push(rawBits(Update.ParentOrFixed));
+    break;
+
+  case ChangeKind::AddedConversionRestriction:
+    push(rawBits(Restriction.SrcType));
+    push(rawBits(Restriction.DstType));
+    break;
+
+  case ChangeKind::AddedFix:
+    push(rawBits(TheFix));
+    break;
+
+  case ChangeKind::AddedFixedRequirement:
+    push(Options);
+    push(rawBits(FixedRequirement.GP));
+    push(rawBits(FixedRequirement.ReqTy));
+    break;
+
+  case ChangeKind::RecordedOpenedPackExpansionType:
+    push(rawBits(TheExpansion));
+    break;
+
+  case ChangeKind::RecordedPackElementExpansion:
+    push(rawBits(TheElement));
+    break;
+
+  case ChangeKind::RecordedPackExpansionEnvironment:
+    push(rawBits(TheExpansionExpr));
+    break;
+
+  case ChangeKind::RecordedNodeType:
+    push(rawBits(Node.Node));
+    push(rawBits(Node.OldType));
+    break;
+
+  case ChangeKind::RecordedKeyPathComponentType:
+    push(Options);
+    push(rawBits(KeyPath.Expr));
+    push(rawBits(KeyPath.OldType));
+    break;
+
+  case ChangeKind::RecordedResultBuilderTransform:
+    push(rawBits(TheRef));
+    break;
+
+  case ChangeKind::RecordedContextualInfo:
+    push(rawBits(Node.Node));
+    break;
+
+  case ChangeKind::RecordedTarget:
+    // Every storage arm of a target key is a single pointer; encode the
+    // raw word without caring which arm is active.
+    push(Options);
+    push(rawBits(TheExpr));
+    break;
+
+  case ChangeKind::RecordedCaseLabelItemInfo:
+    push(rawBits(TheItem));
+    break;
+
+  case ChangeKind::RecordedPotentialThrowSite:
+    push(rawBits(TheCatchNode));
+    break;
+
+  case ChangeKind::RecordedIsolatedParam:
+    push(rawBits(TheParam));
+    break;
+
+  case ChangeKind::RecordedKeyPath:
+    push(rawBits(KeyPath.Expr));
+    break;
+
+  case ChangeKind::RetiredConstraint:
+    push(rawBits(Retiree.Where));
+    push(rawBits(Retiree.Constraint));
+    break;
+
+  case ChangeKind::RetractedBinding:
+    push(Options);
+    push(rawBits(Binding.TypeVar));
+    push(rawBits(Binding.BindingType));
+    push(rawBits(Binding.BindingSource));
+    break;
+  }
+
+  unsigned length = ptr - reinterpret_cast<uint8_t *>(buffer);
+  ASSERT(length + 1 <= MaxEncodedSize && "encoded change record too large");
+  *ptr = uint8_t(length);
+  return length + 1;
+}
+
+SolverTrail::Change SolverTrail::Change::decode(const char *&bytes) {
+  const uint8_t *ptr = reinterpret_cast<const uint8_t *>(bytes);
+
+  Change result;
+  result.Kind = ChangeKind(*ptr++);
+
+  auto next = [&]() -> uint64_t {
+    unsigned numRead;
+    uint64_t value = llvm::decodeULEB128(ptr, &numRead);
+    ptr += numRead;
+    return value;
+  };
+
+  switch (result.Kind) {
+#define LOCATOR_CHANGE(Name, _) case ChangeKind::Name:
+#include "swift/Sema/CSTrail.def"
+    setRawBits(result.TheLocator, next());
+    break;
+
+#define EXPR_CHANGE(Name) case ChangeKind::Name:
+#include "swift/Sema/CSTrail.def"
+    setRawBits(result.TheExpr, next());
+    break;
+
+#define CLOSURE_CHANGE(Name) case ChangeKind::Name:
+#include "swift/Sema/CSTrail.def"
+    setRawBits(result.TheClosure, next());
+    break;
+
+#define CONSTRAINT_CHANGE(Name) case ChangeKind::Name:
+#include "swift/Sema/CSTrail.def"
+    setRawBits(result.TheConstraint.Constraint, next());
+    break;
+
+#define GRAPH_NODE_CHANGE(Name) case ChangeKind::Name:
+#include "swift/Sema/CSTrail.def"
+    setRawBits(result.TheConstraint.TypeVar, next());
+    setRawBits(result.TheConstraint.Constraint, next());
+    break;
+
+#define BINDING_RELATION_CHANGE(Name) case ChangeKind::Name:
+#include "swift/Sema/CSTrail.def"
+    setRawBits(result.BindingRelation.TypeVar, next());
+    setRawBits(result.BindingRelation.OtherTypeVar, next());
+    setRawBits(result.BindingRelation.Constraint, next());
+    break;
+
+#define SCORE_CHANGE(Name) case ChangeKind::Name:
+#include "swift/Sema/CSTrail.def"
+    result.Options = unsigned(next());
+    break;
+
+  case ChangeKind::AddedTypeVariable:
+    setRawBits(result.TypeVar, next());
+    break;
+
+  case ChangeKind::ExtendedEquivalenceClass:
+    setRawBits(result.EquivClass.TypeVar, next());
+    result.EquivClass.PrevSize = unsigned(next());
+    break;
+
+  case ChangeKind::RelatedTypeVariables:
+    setRawBits(result.Relation.TypeVar, next());
+    setRawBits(result.Relation.OtherTypeVar, next());
+    break;
+
+  case ChangeKind::UpdatedTypeVariable:
+    result.Options = unsigned(next());
+    setRawBits(result.Update.TypeVar, next());
+    setRawBits(result.Update.ParentOrFixed, next());
+    break;
+
+  case ChangeKind::AddedConversionRestriction:
+    setRawBits(result.Restriction.SrcType, next());
+    setRawBits(result.Restriction.DstType, next());
+    break;
+
+  case ChangeKind::AddedFix:
+    setRawBits(result.TheFix, next());
+    break;
+
+  case ChangeKind::AddedFixedRequirement:
+    result.Options = unsigned(next());
+    setRawBits(result.FixedRequirement.GP, next());
+    setRawBits(result.FixedRequirement.ReqTy, next());
+    break;
+
+  case ChangeKind::RecordedOpenedPackExpansionType:
+    setRawBits(result.TheExpansion, next());
+    break;
+
+  case ChangeKind::RecordedPackElementExpansion:
+    setRawBits(result.TheElement, next());
+    break;
+
+  case ChangeKind::RecordedPackExpansionEnvironment:
+    setRawBits(result.TheExpansionExpr, next());
+    break;
+
+  case ChangeKind::RecordedNodeType:
+    setRawBits(result.Node.Node, next());
+    setRawBits(result.Node.OldType, next());
+    break;
+
+  case ChangeKind::RecordedKeyPathComponentType:
+    result.Options = unsigned(next());
+    setRawBits(result.KeyPath.Expr, next());
+    setRawBits(result.KeyPath.OldType, next());
+    break;
+
+  case ChangeKind::RecordedResultBuilderTransform:
+    setRawBits(result.TheRef, next());
+    break;
+
+  case ChangeKind::RecordedContextualInfo:
+    setRawBits(result.Node.Node, next());
+    break;
+
+  case ChangeKind::RecordedTarget:
+    result.Options = unsigned(next());
+    setRawBits(result.TheExpr, next());
+    break;
+
+  case ChangeKind::RecordedCaseLabelItemInfo:
+    setRawBits(result.TheItem, next());
+    break;
+
+  case ChangeKind::RecordedPotentialThrowSite:
+    setRawBits(result.TheCatchNode, next());
+    break;
+
+  case ChangeKind::RecordedIsolatedParam:
+    setRawBits(result.TheParam, next());
+    break;
+
+  case ChangeKind::RecordedKeyPath:
+    setRawBits(result.KeyPath.Expr, next());
+    break;
+
+  case ChangeKind::RetiredConstraint:
+    setRawBits(result.Retiree.Where, next());
+    setRawBits(result.Retiree.Constraint, next());
+    break;
+
+  case ChangeKind::RetractedBinding:
+    result.Options = unsigned(next());
+    setRawBits(result.Binding.TypeVar, next());
+    setRawBits(result.Binding.BindingType, next());
+    setRawBits(result.Binding.BindingSource, next());
+    break;
+  }
+
+  // Skip over the trailing length byte.
+  bytes = reinterpret_cast<const char *>(ptr) + 1;
+  return result;
+}
+
+std::pair<SolverTrail::Change, unsigned>
+SolverTrail::Change::decodeLast(const char *end) {
+  unsigned length = uint8_t(end[-1]);
+  const char *start = end - length - 1;
+  Change result = decode(start);
+  ASSERT(start == end && "Trail corrupted");
+  return {result, length + 1};
+}
+
 void SolverTrail::Change::undo(ConstraintSystem &cs) const {
   auto &cg = cs.getConstraintGraph();
 
@@ -803,12 +1152,19 @@ void SolverTrail::recordChange(Change change) {
   LLVM_DEBUG(llvm::dbgs() << "+ "; change.dump(llvm::dbgs(), CS, 0););
   ASSERT(!UndoActive);
 
-  Changes.push_back(change);
+  if (Slabs.empty() || Slabs.back().Used + Change::MaxEncodedSize > SlabSize) {
+    Slabs.emplace_back();
+    Slabs.back().Bytes = std::make_unique<char[]>(SlabSize);
+  }
+
+  auto &slab = Slabs.back();
+  slab.Used += change.encode(slab.Bytes.get() + slab.Used);
+  ++NumChanges;
 
   ++Profile[unsigned(change.Kind)];
   ++Total;
-  if (Changes.size() > Max)
-    Max = Changes.size();
+  if (NumChanges > Max)
+    Max = NumChanges;
 }
 
 void SolverTrail::undo(unsigned toIndex) {
@@ -824,30 +1180,54 @@ void SolverTrail::undo(unsigned toIndex) {
 #include "swift/Sema/CSTrail.def"
   };
 
-  LLVM_DEBUG(llvm::dbgs() << "decisions " << Changes.size()
+  LLVM_DEBUG(llvm::dbgs() << "decisions " << NumChanges
                           << " max " << Max
                           << " total " << Total << "\n";
              dumpHistogram();
              llvm::dbgs() << "\n");
 
-  ASSERT(Changes.size() >= toIndex && "Trail corrupted");
+  ASSERT(NumChanges >= toIndex && "Trail corrupted");
   ASSERT(!UndoActive);
   UndoActive = true;
 
-  for (unsigned i = Changes.size(); i > toIndex; i--) {
-    auto change = Changes[i - 1];
+  while (NumChanges > toIndex) {
+    auto &slab = Slabs.back();
+    ASSERT(slab.Used > 0 && "Trail corrupted");
+
+    auto [change, recordSize] = Change::decodeLast(slab.Bytes.get() + slab.Used);
     LLVM_DEBUG(llvm::dbgs() << "- "; change.dump(llvm::dbgs(), CS, 0));
     change.undo(CS);
+
+    slab.Used -= recordSize;
+    --NumChanges;
+
+    // Give the memory for a fully-undone slab back eagerly; deep scopes
+    // are torn down long before the trail itself is destroyed.
+    if (slab.Used == 0)
+      Slabs.pop_back();
   }
 
-  Changes.resize(toIndex);
   UndoActive = false;
 }
 
+void SolverTrail::forEachChangeFrom(
+    unsigned fromIndex, llvm::function_ref<void(const Change &)> body) const {
+  unsigned index = 0;
+  for (const auto &slab : Slabs) {
+    const char *bytes = slab.Bytes.get();
+    const char *end = bytes + slab.Used;
+    while (bytes != end) {
+      auto change = Change::decode(bytes);
+      if (index++ >= fromIndex)
+        body(change);
+    }
+  }
+}
+
 void SolverTrail::dumpActiveScopeChanges(llvm::raw_ostream &out,
                                          unsigned fromIndex,
                                          unsigned indent) const {
-  if (Changes.empty())
+  if (NumChanges == 0)
     return;
 
   // Collect Changes for printing.
@@ -855,8 +1235,7 @@ void SolverTrail::dumpActiveScopeChanges(llvm::raw_ostream &out,
   std::set<TypeVariableType *> updatedTypeVars;
   std::set<Constraint *> addedConstraints;
   std::set<Constraint *> removedConstraints;
-  for (unsigned int i = fromIndex; i < Changes.size(); i++) {
-    auto change = Changes[i];
+  forEachChangeFrom(fromIndex, [&](const Change &change) {
     switch (change.Kind) {
     case ChangeKind::AddedTypeVariable:
       addedTypeVars.push_back(change.TypeVar);
@@ -874,7 +1253,7 @@ void SolverTrail::dumpActiveScopeChanges(llvm::raw_ostream &out,
       // Don't consider changes that don't affect the graph.
       break;
     }
-  }
+  });
 
   // If there are any constraints that were both added and removed in this set
   // of Changes, remove them from both.
@@ -988,6 +1367,7 @@ void SolverTrail::dump() const { dump(llvm::errs()); }
 
 void SolverTrail::dump(raw_ostream &OS, unsigned fromIndex,
                        unsigned indent) const {
-  for (unsigned i = fromIndex; i < Changes.size(); ++i)
-    Changes[i].dump(OS, CS, indent);
+  forEachChangeFrom(fromIndex, [&](const Change &change) {
+    change.dump(OS, CS, indent);
+  });
 }
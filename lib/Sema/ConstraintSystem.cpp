@@ -118,6 +118,7 @@ ConstraintSystem::ConstraintSystem(DeclContext *dc,
                                    DiagnosticTransaction *diagnosticTransaction)
   : Context(dc->getASTContext()), DC(dc), Options(options),
     diagnosticTransaction(diagnosticTransaction),
+    Allocator(dc->getASTContext()),
     Arena(dc->getASTContext(), Allocator),
     CG(*this)
 {
@@ -132,6 +133,13 @@ ConstraintSystem::ConstraintSystem(DeclContext *dc,
     Options |= ConstraintSystemFlags::UseClangFunctionTypes;
 }
 
+ConstraintSystem::RecyclingAllocator::RecyclingAllocator(ASTContext &ctx)
+    : Context(ctx), Allocator(ctx.takeConstraintSolverMemory()) {}
+
+ConstraintSystem::RecyclingAllocator::~RecyclingAllocator() {
+  Context.recycleConstraintSolverMemory(std::move(Allocator));
+}
+
 ConstraintSystem::~ConstraintSystem() {
   for (unsigned i = 0, n = TypeVariables.size(); i != n; ++i) {
     auto &impl = TypeVariables[i]->getImpl();
@@ -146,11 +154,12 @@ void ConstraintSystem::startExpressionTimer(ExpressionTimer::AnchorType anchor)
   const auto &opts = getASTContext().TypeCheckerOpts;
   unsigned timeout = opts.ExpressionTimeoutThreshold;
 
-  // If either the timeout is set, or we're asked to emit warnings,
-  // start the timer. Otherwise, don't start the timer, it's needless
-  // overhead.
+  // If the timeout is set, we're asked to emit warnings, or we're
+  // recording a solver trace, start the timer. Otherwise, don't start
+  // the timer, it's needless overhead.
   if (timeout == 0) {
-    if (opts.WarnLongExpressionTypeChecking == 0)
+    if (opts.WarnLongExpressionTypeChecking == 0 &&
+        opts.SolverTracePath.empty())
       return;
 
     timeout = ExpressionTimer::NoLimit;
@@ -5806,13 +5806,29 @@ static void diagnoseDeprecatedWritableKeyPath(const Expr *E,
   const_cast<Expr *>(E)->walk(Walker);
 }
 
-static void maybeDiagnoseCallToKeyValueObserveMethod(const Expr *E,
-                                                     const DeclContext *DC) {
-  class KVOObserveCallWalker : public BaseDiagnosticWalker {
+/// Diagnose the syntactic restrictions that only need to inspect one node at
+/// a time: calls to key-value observation methods with key paths to
+/// properties that are not ObjC-dynamic, explicit uses of a 'lazy' variable's
+/// backing storage, and comparisons against '.nan'.
+///
+/// These checks share a single traversal rather than each walking the
+/// expression separately. Each check still skips the same subtrees it would
+/// have skipped as a standalone walker; a check that asks to skip a node is
+/// paused until the walk leaves that node's subtree, without affecting the
+/// other checks.
+static void diagnoseNodeLocalRestrictions(const Expr *E,
+                                          const DeclContext *DC) {
+  class NodeLocalDiagnosticWalker : public BaseDiagnosticWalker {
     const ASTContext &C;
 
+    /// For each check, the root of a subtree the check asked to skip, if the
+    /// walk is currently inside one.
+    Expr *KVOObserveCallSkipRoot = nullptr;
+    Expr *LazyStorageAccessSkipRoot = nullptr;
+    Expr *NaNComparisonSkipRoot = nullptr;
+
   public:
-    KVOObserveCallWalker(ASTContext &ctx) : C(ctx) {}
+    NodeLocalDiagnosticWalker(ASTContext &ctx) : C(ctx) {}
 
     void maybeDiagnoseCallExpr(CallExpr *expr) {
       auto fn = expr->getCalledValue(/*skipFunctionConversions=*/true);
@@ -5866,32 +5882,6 @@ static void maybeDiagnoseCallToKeyValueObserveMethod(const Expr *E,
       }
     }
 
-    PreWalkResult<Expr *> walkToExprPre(Expr *E) override {
-      if (!E || isa<ErrorExpr>(E) || !E->getType())
-        return Action::SkipNode(E);
-
-      if (auto *CE = dyn_cast<CallExpr>(E)) {
-        maybeDiagnoseCallExpr(CE);
-        return Action::SkipNode(E);
-      }
-
-      return Action::Continue(E);
-    }
-  };
-
-  KVOObserveCallWalker Walker(DC->getASTContext());
-  const_cast<Expr *>(E)->walk(Walker);
-}
-
-static void diagnoseExplicitUseOfLazyVariableStorage(const Expr *E,
-                                                     const DeclContext *DC) {
-
-  class ExplicitLazyVarStorageAccessFinder : public BaseDiagnosticWalker {
-    const ASTContext &C;
-
-  public:
-    ExplicitLazyVarStorageAccessFinder(ASTContext &ctx) : C(ctx) {}
-
     void tryDiagnoseExplicitLazyStorageVariableUse(MemberRefExpr *MRE) {
       if (MRE->isImplicit()) {
         return;
@@ -5913,31 +5903,6 @@ static void diagnoseExplicitUseOfLazyVariableStorage(const Expr *E,
       }
     }
 
-    PreWalkResult<Expr *> walkToExprPre(Expr *E) override {
-      if (!E || isa<ErrorExpr>(E) || !E->getType())
-        return Action::SkipNode(E);
-
-      if (auto *MRE = dyn_cast<MemberRefExpr>(E)) {
-        tryDiagnoseExplicitLazyStorageVariableUse(MRE);
-        return Action::SkipNode(E);
-      }
-
-      return Action::Continue(E);
-    }
-  };
-
-  ExplicitLazyVarStorageAccessFinder Walker(DC->getASTContext());
-  const_cast<Expr *>(E)->walk(Walker);
-}
-
-static void diagnoseComparisonWithNaN(const Expr *E, const DeclContext *DC) {
-  class ComparisonWithNaNFinder : public BaseDiagnosticWalker {
-    const ASTContext &C;
-
-  public:
-    ComparisonWithNaNFinder(const DeclContext *dc)
-        : C(dc->getASTContext()) {}
-
     void tryDiagnoseComparisonWithNaN(BinaryExpr *BE) {
       ValueDecl *comparisonDecl = nullptr;
 
@@ -6044,16 +6009,42 @@ static void diagnoseComparisonWithNaN(const Expr *E, const DeclContext *DC) {
       if (!E || isa<ErrorExpr>(E) || !E->getType())
         return Action::SkipNode(E);
 
-      if (auto *BE = dyn_cast<BinaryExpr>(E)) {
-        tryDiagnoseComparisonWithNaN(BE);
-        return Action::SkipNode(E);
+      if (!KVOObserveCallSkipRoot) {
+        if (auto *CE = dyn_cast<CallExpr>(E)) {
+          maybeDiagnoseCallExpr(CE);
+          KVOObserveCallSkipRoot = E;
+        }
+      }
+
+      if (!LazyStorageAccessSkipRoot) {
+        if (auto *MRE = dyn_cast<MemberRefExpr>(E)) {
+          tryDiagnoseExplicitLazyStorageVariableUse(MRE);
+          LazyStorageAccessSkipRoot = E;
+        }
       }
 
+      if (!NaNComparisonSkipRoot) {
+        if (auto *BE = dyn_cast<BinaryExpr>(E)) {
+          tryDiagnoseComparisonWithNaN(BE);
+          NaNComparisonSkipRoot = E;
+        }
+      }
+
+      return Action::Continue(E);
+    }
+
+    PostWalkResult<Expr *> walkToExprPost(Expr *E) override {
+      if (E == KVOObserveCallSkipRoot)
+        KVOObserveCallSkipRoot = nullptr;
+      if (E == LazyStorageAccessSkipRoot)
+        LazyStorageAccessSkipRoot = nullptr;
+      if (E == NaNComparisonSkipRoot)
+        NaNComparisonSkipRoot = nullptr;
       return Action::Continue(E);
     }
   };
 
-  ComparisonWithNaNFinder Walker(DC);
+  NodeLocalDiagnosticWalker Walker(DC->getASTContext());
   const_cast<Expr *>(E)->walk(Walker);
 }
 
@@ -6488,9 +6479,7 @@ void swift::performSyntacticExprDiagnostics(const Expr *E,
   diagRecursivePropertyAccess(E, DC);
   diagnoseImplicitSelfUseInClosure(E, DC);
   diagnoseUnintendedOptionalBehavior(E, DC);
-  maybeDiagnoseCallToKeyValueObserveMethod(E, DC);
-  diagnoseExplicitUseOfLazyVariableStorage(E, DC);
-  diagnoseComparisonWithNaN(E, DC);
+  diagnoseNodeLocalRestrictions(E, DC);
   if (!ctx.isSwiftVersionAtLeast(5))
     diagnoseDeprecatedWritableKeyPath(E, DC);
   if (!ctx.LangOpts.DisableAvailabilityChecking)
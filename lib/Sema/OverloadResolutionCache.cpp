@@ -0,0 +1,122 @@
+//===--- OverloadResolutionCache.cpp - Solver outcome memoization ---------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2025 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Sema/OverloadResolutionCache.h"
+
+#include "swift/Basic/LangOptions.h"
+#include "swift/Basic/StableHasher.h"
+#include "llvm/Support/EndianStream.h"
+
+#include <atomic>
+#include <mutex>
+
+using namespace swift;
+using namespace swift::constraints;
+
+/// Magic number identifying a serialized cache: "SWOC".
+static const uint32_t CacheMagic = 0x434F5753;
+static const uint32_t CacheVersion = 1;
+
+Fingerprint OverloadResolutionCache::fingerprintExpression(
+    llvm::StringRef ExprText, llvm::StringRef ModuleName,
+    const LangOptions &LangOpts, llvm::StringRef BufferIdentifier,
+    unsigned Offset, llvm::StringRef ContextualTypeText,
+    llvm::StringRef ExtraDependencies) {
+  auto hasher = StableHasher::defaultHasher();
+  hasher.combine(ExprText);
+  hasher.combine(ModuleName);
+  hasher.combine(BufferIdentifier);
+  hasher.combine(uint64_t(Offset));
+  hasher.combine(ContextualTypeText);
+  hasher.combine(llvm::StringRef(LangOpts.Target.str()));
+  for (unsigned i = 0, e = LangOpts.EffectiveLanguageVersion.size(); i != e;
+       ++i)
+    hasher.combine(uint64_t(LangOpts.EffectiveLanguageVersion[i]));
+  hasher.combine(ExtraDependencies);
+  return Fingerprint(std::move(hasher));
+}
+
+namespace {
+/// The process-wide shared cache and its lock. Contention is negligible: the
+/// cache is consulted once per expression typecheck and written only when an
+/// expression exceeds the solver's limits.
+struct SharedCacheState {
+  std::mutex Lock;
+  OverloadResolutionCache Cache;
+  std::atomic<bool> Empty{true};
+};
+} // end anonymous namespace
+
+static SharedCacheState &getSharedCacheState() {
+  static SharedCacheState State;
+  return State;
+}
+
+bool OverloadResolutionCache::lookupSharedTooComplex(const Fingerprint &FP) {
+  auto &State = getSharedCacheState();
+  std::lock_guard<std::mutex> Guard(State.Lock);
+  return State.Cache.isKnownTooComplex(FP);
+}
+
+void OverloadResolutionCache::recordSharedTooComplex(const Fingerprint &FP) {
+  auto &State = getSharedCacheState();
+  std::lock_guard<std::mutex> Guard(State.Lock);
+  State.Cache.recordTooComplex(FP);
+  State.Empty.store(false, std::memory_order_release);
+}
+
+bool OverloadResolutionCache::sharedCacheIsEmpty() {
+  return getSharedCacheState().Empty.load(std::memory_order_acquire);
+}
+
+void OverloadResolutionCache::writeToStream(llvm::raw_ostream &OS) const {
+  llvm::support::endian::Writer Writer(OS, llvm::endianness::little);
+  Writer.write<uint32_t>(CacheMagic);
+  Writer.write<uint32_t>(CacheVersion);
+  Writer.write<uint32_t>(TooComplexExprs.size());
+  for (const auto &FP : TooComplexExprs)
+    OS << FP.getRawValue();
+}
+
+std::optional<OverloadResolutionCache>
+OverloadResolutionCache::readFromBuffer(llvm::StringRef Buffer) {
+  const size_t HeaderSize = 3 * sizeof(uint32_t);
+  if (Buffer.size() < HeaderSize)
+    return std::nullopt;
+
+  const char *Ptr = Buffer.data();
+  auto readUInt32 = [&Ptr]() -> uint32_t {
+    uint32_t Value = llvm::support::endian::read32le(Ptr);
+    Ptr += sizeof(uint32_t);
+    return Value;
+  };
+
+  if (readUInt32() != CacheMagic)
+    return std::nullopt;
+  if (readUInt32() != CacheVersion)
+    return std::nullopt;
+
+  uint32_t NumEntries = readUInt32();
+  if (Buffer.size() != HeaderSize + NumEntries * Fingerprint::DIGEST_LENGTH)
+    return std::nullopt;
+
+  OverloadResolutionCache Cache;
+  for (uint32_t i = 0; i != NumEntries; ++i) {
+    auto FP = Fingerprint::fromString(
+        llvm::StringRef(Ptr, Fingerprint::DIGEST_LENGTH));
+    if (!FP)
+      return std::nullopt;
+    Cache.TooComplexExprs.insert(*FP);
+    Ptr += Fingerprint::DIGEST_LENGTH;
+  }
+  return Cache;
+}
@@ -32,7 +32,9 @@
 #include "swift/Basic/Assertions.h"
 #include "swift/Basic/Statistic.h"
 #include "swift/IDE/TypeCheckCompletionCallback.h"
+#include "swift/Parse/Lexer.h"
 #include "swift/Sema/ConstraintSystem.h"
+#include "swift/Sema/OverloadResolutionCache.h"
 #include "swift/Sema/SolutionResult.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallPtrSet.h"
@@ -455,6 +457,48 @@ TypeChecker::typeCheckTarget(SyntacticElementTarget &target,
     return std::nullopt;
   }
 
+  // Compute the fingerprint under which this expression's solver outcome is
+  // memoized. Computed lazily so that the common path pays only for a branch;
+  // the fingerprint is needed up front only when the cache already has
+  // entries to consult.
+  std::optional<Fingerprint> exprFingerprint;
+  auto fingerprintTarget = [&]() -> std::optional<Fingerprint> {
+    auto *expr = target.getAsExpr();
+    if (!expr)
+      return std::nullopt;
+    auto range = expr->getSourceRange();
+    if (range.isInvalid())
+      return std::nullopt;
+    auto &SM = Context.SourceMgr;
+    auto charRange = Lexer::getCharSourceRangeFromSourceRange(SM, range);
+    // Key on the expression's position and contextual type as well as its
+    // text: a textually identical expression in another scope or against
+    // another contextual type may well be tractable, and must not inherit
+    // this one's verdict.
+    unsigned bufferID = SM.findBufferContainingLoc(range.Start);
+    std::string contextualTypeText;
+    if (auto contextualType = target.getExprContextualType())
+      contextualTypeText = contextualType->getString();
+    return OverloadResolutionCache::fingerprintExpression(
+        SM.extractText(charRange), dc->getParentModule()->getName().str(),
+        Context.LangOpts, SM.getIdentifierForBuffer(bufferID),
+        SM.getLocOffsetInBuffer(range.Start, bufferID), contextualTypeText);
+  };
+
+  // If a previous solve proved this exact expression too complex under the
+  // same configuration, fail fast instead of re-running the solver to
+  // rediscover the verdict.
+  if (!OverloadResolutionCache::sharedCacheIsEmpty()) {
+    exprFingerprint = fingerprintTarget();
+    if (exprFingerprint &&
+        OverloadResolutionCache::lookupSharedTooComplex(*exprFingerprint)) {
+      auto range = target.getSourceRange();
+      Context.Diags.diagnose(range.Start, diag::expression_too_complex)
+          .highlight(range);
+      return errorResult();
+    }
+  }
+
   // Construct a constraint system from this expression.
   ConstraintSystemOptions csOptions = ConstraintSystemFlags::AllowFixes;
 
@@ -491,8 +535,17 @@ TypeChecker::typeCheckTarget(SyntacticElementTarget &target,
 
   // Attempt to solve the constraint system.
   auto viable = cs.solve(target, allowFreeTypeVariables);
-  if (!viable)
+  if (!viable) {
+    // Remember expressions that exceeded the solver's limits; identical
+    // re-solves (incremental rebuilds, IDE reparses) fail fast above.
+    if (cs.isAlreadyTooComplex.first) {
+      if (!exprFingerprint)
+        exprFingerprint = fingerprintTarget();
+      if (exprFingerprint)
+        OverloadResolutionCache::recordSharedTooComplex(*exprFingerprint);
+    }
     return errorResult();
+  }
 
   // Apply this solution to the constraint system.
   // FIXME: This shouldn't be necessary.
@@ -56,6 +56,7 @@
 #include "swift/Basic/Defer.h"
 #include "swift/Bridging/ASTGen.h"
 #include "swift/ClangImporter/ClangModule.h"
+#include "swift/Parse/IfConfigRegionMap.h"
 #include "swift/Sema/IDETypeChecking.h"
 #include "swift/Serialization/SerializedModuleLoader.h"
 #include "swift/Strings.h"
@@ -3125,8 +3126,25 @@ LifetimeDependenceInfoRequest::evaluate(Evaluator &evaluator,
 }
 
 ArrayRef<IfConfigClauseRangeInfo> SourceFile::getIfConfigClauseRanges() const {
+  if (IfConfigClauseRanges.IsSorted)
+    return IfConfigClauseRanges.Ranges;
+
+  // Consult the process-wide snapshot cache before recomputing: IDE clients
+  // issue repeated syntactic requests that rebuild ASTContexts over unchanged
+  // buffers, and region computation requires a parse.
+  {
+    auto &SM = getASTContext().SourceMgr;
+    if (auto cached = IfConfigRegionCache::lookup(
+            SM.getEntireTextForBuffer(BufferID), getASTContext().LangOpts)) {
+      IfConfigClauseRanges.Ranges.clear();
+      cached->materialize(SM, BufferID, IfConfigClauseRanges.Ranges);
+      IfConfigClauseRanges.IsSorted = true;
+      return IfConfigClauseRanges.Ranges;
+    }
+  }
+
 #if SWIFT_BUILD_SWIFT_SYNTAX
-  if (!IfConfigClauseRanges.IsSorted) {
+  {
     IfConfigClauseRanges.Ranges.clear();
 
     BridgedIfConfigClauseRangeInfo *regions;
@@ -3139,8 +3157,28 @@ ArrayRef<IfConfigClauseRangeInfo> SourceFile::getIfConfigClauseRanges() const {
 
     IfConfigClauseRanges.IsSorted = true;
   }
+
+  // Publish an offset-based snapshot so other ASTContexts holding the same
+  // buffer text can skip the parse. The legacy path below only knows about
+  // regions recorded by an in-progress parse, so its results are not
+  // necessarily complete and are not shared.
+  {
+    auto &SM = getASTContext().SourceMgr;
+    auto map = std::make_shared<IfConfigRegionMap>();
+    map->Regions.reserve(IfConfigClauseRanges.Ranges.size());
+    for (const auto &range : IfConfigClauseRanges.Ranges) {
+      auto bodyRange = range.getBodyRange(SM);
+      map->Regions.push_back(
+          {SM.getLocOffsetInBuffer(range.getStartLoc(), BufferID),
+           SM.getLocOffsetInBuffer(bodyRange.getStart(), BufferID),
+           SM.getLocOffsetInBuffer(bodyRange.getEnd(), BufferID),
+           range.getKind()});
+    }
+    IfConfigRegionCache::insert(SM.getEntireTextForBuffer(BufferID),
+                                getASTContext().LangOpts, std::move(map));
+  }
 #else
-  if (!IfConfigClauseRanges.IsSorted) {
+  {
     auto &SM = getASTContext().SourceMgr;
     // Sort the ranges if we need to.
     llvm::sort(
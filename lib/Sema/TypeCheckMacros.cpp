@@ -50,7 +50,12 @@
 #include "swift/Sema/ConstraintSystem.h"
 #include "swift/Sema/IDETypeChecking.h"
 #include "swift/Subsystems.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Config/config.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA256.h"
 
 #define DEBUG_TYPE "macros"
 
@@ -1007,6 +1012,111 @@ static CharSourceRange getExpansionInsertionRange(MacroRole role,
   llvm_unreachable("unhandled MacroRole");
 }
 
+#if SWIFT_BUILD_SWIFT_SYNTAX
+/// Compute a fingerprint for the plugin that provides the macro module
+/// \p moduleName, from the path, size and modification time of the library
+/// and executable backing it.
+///
+/// Returns \c std::nullopt if the plugin cannot be identified, in which case
+/// the expansion must not be cached.
+static std::optional<std::string>
+getMacroPluginFingerprint(ASTContext &ctx, Identifier moduleName) {
+  auto &entry = ctx.getPluginLoader().lookupPluginByModuleName(moduleName);
+  if (entry.libraryPath.empty() && entry.executablePath.empty())
+    return std::nullopt;
+
+  std::string fingerprint;
+  llvm::raw_string_ostream OS(fingerprint);
+  auto fs = ctx.SourceMgr.getFileSystem();
+  for (StringRef path : {entry.libraryPath, entry.executablePath}) {
+    if (path.empty())
+      continue;
+
+    // A 'unix://' server path names a connection, not a binary; the macro
+    // implementation itself is the library path, which is fingerprinted
+    // above.
+    if (path.starts_with("unix://"))
+      continue;
+
+    auto status = fs->status(path);
+    if (!status)
+      return std::nullopt;
+    OS << path << ':' << status->getSize() << ':'
+       << status->getLastModificationTime().time_since_epoch().count() << ';';
+  }
+  if (fingerprint.empty())
+    return std::nullopt;
+  return fingerprint;
+}
+
+/// Hash the inputs that determine the result of an external macro expansion
+/// into a stable on-disk cache key.
+static std::string getMacroExpansionCacheHash(ArrayRef<std::string> parts) {
+  llvm::SHA256 hasher;
+  for (const std::string &part : parts) {
+    // Length-prefix each part so adjacent parts cannot alias.
+    uint64_t size = part.size();
+    hasher.update(
+        StringRef(reinterpret_cast<const char *>(&size), sizeof(size)));
+    hasher.update(part);
+  }
+  return llvm::toHex(hasher.final(), /*LowerCase=*/true);
+}
+
+/// Compute the file that caches the expansion with the given key hash.
+static void getMacroExpansionCacheFile(ASTContext &ctx, StringRef hash,
+                                       SmallVectorImpl<char> &path) {
+  StringRef cacheDir = ctx.SearchPathOpts.MacroExpansionCachePath;
+  path.assign(cacheDir.begin(), cacheDir.end());
+  llvm::sys::path::append(path, hash + ".swift");
+}
+
+/// Try to replay a cached expansion result, returning a buffer named
+/// \p bufferName on a hit.
+static std::unique_ptr<llvm::MemoryBuffer>
+loadCachedMacroExpansion(ASTContext &ctx, StringRef hash,
+                         StringRef bufferName) {
+  SmallString<256> path;
+  getMacroExpansionCacheFile(ctx, hash, path);
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer)
+    return nullptr;
+
+  // The cache key covers the discriminator, so the buffer name is identical
+  // to the one the plugin-produced buffer would have gotten.
+  return llvm::MemoryBuffer::getMemBufferCopy((*buffer)->getBuffer(),
+                                              bufferName);
+}
+
+/// Record an expansion result on disk. Best-effort: a failure only loses the
+/// cache hit, so it is not diagnosed.
+static void cacheMacroExpansion(ASTContext &ctx, StringRef hash,
+                                StringRef expansion) {
+  if (llvm::sys::fs::create_directories(
+          ctx.SearchPathOpts.MacroExpansionCachePath))
+    return;
+
+  SmallString<256> path;
+  getMacroExpansionCacheFile(ctx, hash, path);
+
+  // Write to a temporary file and rename it into place so concurrent
+  // frontend jobs never observe a partially-written entry.
+  auto temp = llvm::sys::fs::TempFile::create(path + "-%%%%%%");
+  if (!temp) {
+    llvm::consumeError(temp.takeError());
+    return;
+  }
+  {
+    llvm::raw_fd_ostream OS(temp->FD, /*shouldClose=*/false);
+    OS << expansion;
+  }
+  if (auto error = temp->keep(path)) {
+    llvm::consumeError(std::move(error));
+    llvm::consumeError(temp->discard());
+  }
+}
+#endif // SWIFT_BUILD_SWIFT_SYNTAX
+
 static SourceFile *
 createMacroSourceFile(std::unique_ptr<llvm::MemoryBuffer> buffer,
                       MacroRole role, ASTNode target, DeclContext *dc,
@@ -1217,19 +1327,46 @@ evaluateFreestandingMacro(FreestandingMacroExpansion *expansion,
     if (!astGenSourceFile)
       return nullptr;
 
-    BridgedStringRef evaluatedSourceOut{nullptr, 0};
-    assert(!externalDef.isError());
-    swift_Macros_expandFreestandingMacro(
-        &ctx.Diags, externalDef.get(), discriminator->c_str(),
-        getRawMacroRole(macroRole), astGenSourceFile,
-        expansion->getSourceRange().Start.getOpaquePointerValue(),
-        &evaluatedSourceOut);
-    if (!evaluatedSourceOut.unbridged().data())
-      return nullptr;
-    evaluatedSource = llvm::MemoryBuffer::getMemBufferCopy(
-        evaluatedSourceOut.unbridged(),
-        adjustMacroExpansionBufferName(*discriminator));
-    swift_ASTGen_freeBridgedString(evaluatedSourceOut);
+    // If expansion caching is enabled, replay a previous expansion of the
+    // same inputs instead of round-tripping to the plugin.
+    std::optional<std::string> cacheHash;
+    if (!ctx.SearchPathOpts.MacroExpansionCachePath.empty()) {
+      if (auto fingerprint =
+              getMacroPluginFingerprint(ctx, external.moduleName)) {
+        auto inputRange = Lexer::getCharSourceRangeFromSourceRange(
+            ctx.SourceMgr, expansion->getSourceRange());
+        cacheHash = getMacroExpansionCacheHash(
+            {*fingerprint, external.moduleName.str().str(),
+             external.macroTypeName.str().str(), *discriminator,
+             std::to_string(getRawMacroRole(macroRole)),
+             ctx.SourceMgr.extractText(inputRange).str()});
+        evaluatedSource = loadCachedMacroExpansion(
+            ctx, *cacheHash, adjustMacroExpansionBufferName(*discriminator));
+      }
+    }
+
+    if (!evaluatedSource) {
+      const bool hadErrorBefore = ctx.Diags.hadAnyError();
+
+      BridgedStringRef evaluatedSourceOut{nullptr, 0};
+      assert(!externalDef.isError());
+      swift_Macros_expandFreestandingMacro(
+          &ctx.Diags, externalDef.get(), discriminator->c_str(),
+          getRawMacroRole(macroRole), astGenSourceFile,
+          expansion->getSourceRange().Start.getOpaquePointerValue(),
+          &evaluatedSourceOut);
+      if (!evaluatedSourceOut.unbridged().data())
+        return nullptr;
+      evaluatedSource = llvm::MemoryBuffer::getMemBufferCopy(
+          evaluatedSourceOut.unbridged(),
+          adjustMacroExpansionBufferName(*discriminator));
+      swift_ASTGen_freeBridgedString(evaluatedSourceOut);
+
+      // Only cache diagnostic-free expansions; replaying from the cache
+      // skips plugin IPC entirely, so plugin diagnostics would be lost.
+      if (cacheHash && (hadErrorBefore || !ctx.Diags.hadAnyError()))
+        cacheMacroExpansion(ctx, *cacheHash, evaluatedSource->getBuffer());
+    }
     break;
 #else
     ctx.Diags.diagnose(loc, diag::macro_unsupported);
@@ -1574,20 +1711,60 @@ static SourceFile *evaluateAttachedMacro(MacroDecl *macro, Decl *attachedTo,
       startLoc = attachedToLoc;
     }
 
-    BridgedStringRef evaluatedSourceOut{nullptr, 0};
-    assert(!externalDef.isError());
-    swift_Macros_expandAttachedMacro(
-        &ctx.Diags, externalDef.get(), discriminator->c_str(),
-        extendedType.c_str(), conformanceList.c_str(), getRawMacroRole(role),
-        astGenAttrSourceFile, attr->AtLoc.getOpaquePointerValue(),
-        astGenDeclSourceFile, startLoc.getOpaquePointerValue(),
-        astGenParentDeclSourceFile, parentDeclLoc, &evaluatedSourceOut);
-    if (!evaluatedSourceOut.unbridged().data())
-      return nullptr;
-    evaluatedSource = llvm::MemoryBuffer::getMemBufferCopy(
-        evaluatedSourceOut.unbridged(),
-        adjustMacroExpansionBufferName(*discriminator));
-    swift_ASTGen_freeBridgedString(evaluatedSourceOut);
+    // If expansion caching is enabled, replay a previous expansion of the
+    // same inputs instead of round-tripping to the plugin. Pretty-printed
+    // Clang declarations are skipped: their source text is synthesized and
+    // not a stable key.
+    std::optional<std::string> cacheHash;
+    if (!ctx.SearchPathOpts.MacroExpansionCachePath.empty() &&
+        !isPrettyPrintedDecl) {
+      if (auto fingerprint =
+              getMacroPluginFingerprint(ctx, external.moduleName)) {
+        auto &SM = ctx.SourceMgr;
+        auto attrRange = Lexer::getCharSourceRangeFromSourceRange(
+            SM, attr->getRangeWithAt());
+        auto declRange = Lexer::getCharSourceRangeFromSourceRange(
+            SM, searchDecl->getSourceRange());
+        std::string parentDeclText;
+        if (parentDecl) {
+          parentDeclText = SM.extractText(
+              Lexer::getCharSourceRangeFromSourceRange(
+                  SM, parentDecl->getSourceRange())).str();
+        }
+        cacheHash = getMacroExpansionCacheHash(
+            {*fingerprint, external.moduleName.str().str(),
+             external.macroTypeName.str().str(), *discriminator,
+             std::to_string(getRawMacroRole(role)), extendedType,
+             conformanceList, SM.extractText(attrRange).str(),
+             SM.extractText(declRange).str(), parentDeclText});
+        evaluatedSource = loadCachedMacroExpansion(
+            ctx, *cacheHash, adjustMacroExpansionBufferName(*discriminator));
+      }
+    }
+
+    if (!evaluatedSource) {
+      const bool hadErrorBefore = ctx.Diags.hadAnyError();
+
+      BridgedStringRef evaluatedSourceOut{nullptr, 0};
+      assert(!externalDef.isError());
+      swift_Macros_expandAttachedMacro(
+          &ctx.Diags, externalDef.get(), discriminator->c_str(),
+          extendedType.c_str(), conformanceList.c_str(), getRawMacroRole(role),
+          astGenAttrSourceFile, attr->AtLoc.getOpaquePointerValue(),
+          astGenDeclSourceFile, startLoc.getOpaquePointerValue(),
+          astGenParentDeclSourceFile, parentDeclLoc, &evaluatedSourceOut);
+      if (!evaluatedSourceOut.unbridged().data())
+        return nullptr;
+      evaluatedSource = llvm::MemoryBuffer::getMemBufferCopy(
+          evaluatedSourceOut.unbridged(),
+          adjustMacroExpansionBufferName(*discriminator));
+      swift_ASTGen_freeBridgedString(evaluatedSourceOut);
+
+      // Only cache diagnostic-free expansions; replaying from the cache
+      // skips plugin IPC entirely, so plugin diagnostics would be lost.
+      if (cacheHash && (hadErrorBefore || !ctx.Diags.hadAnyError()))
+        cacheMacroExpansion(ctx, *cacheHash, evaluatedSource->getBuffer());
+    }
     break;
 #else
     attachedTo->diagnose(diag::macro_unsupported);
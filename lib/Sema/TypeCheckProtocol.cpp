@@ -1444,6 +1444,35 @@ static bool contextMayExpandOperator(
   return potentialExpansions.shouldExpandForName(operatorName);
 }
 
+/// Quickly determine whether a candidate found by base name alone could
+/// possibly witness the given requirement, based only on parameter-list
+/// arity.
+///
+/// Base-name lookup returns every overload sharing the base name, which for
+/// imported C++ types can be a very large set; this prunes candidates that
+/// cannot match before any per-pair matching work is done.
+static bool witnessArityMayMatch(ValueDecl *req, ValueDecl *witness) {
+  auto *reqParams = req->getParameterList();
+  auto *witnessParams = witness->getParameterList();
+  if (!reqParams || !witnessParams)
+    return true;
+
+  if (reqParams->size() == witnessParams->size())
+    return true;
+
+  // Be conservative about anything that can absorb or drop arguments.
+  for (auto *param : *witnessParams) {
+    if (param->isVariadic() || param->isDefaultArgument())
+      return true;
+  }
+  for (auto *param : *reqParams) {
+    if (param->isVariadic())
+      return true;
+  }
+
+  return false;
+}
+
 SmallVector<ValueDecl *, 4>
 swift::lookupValueWitnesses(DeclContext *DC, ValueDecl *req, bool *ignoringNames) {
   assert(!isa<AssociatedTypeDecl>(req) && "Not for lookup for type witnesses*");
@@ -1475,6 +1504,7 @@ swift::lookupValueWitnesses(DeclContext *DC, ValueDecl *req, bool *ignoringNames
     for (auto candidate : lookup) {
       auto decl = candidate.getValueDecl();
       if (!isa<ProtocolDecl>(decl->getDeclContext()) &&
+          witnessArityMayMatch(req, decl) &&
           swift::isMemberOperator(cast<FuncDecl>(decl), DC->getSelfInterfaceType())) {
         witnesses.push_back(decl);
       }
@@ -1521,7 +1551,8 @@ swift::lookupValueWitnesses(DeclContext *DC, ValueDecl *req, bool *ignoringNames
       DC->lookupQualified(nominal, reqBaseName, nominal->getLoc(),
                           options, lookupResults);
       for (auto *decl : lookupResults) {
-        if (!isa<ProtocolDecl>(decl->getDeclContext())) {
+        if (!isa<ProtocolDecl>(decl->getDeclContext()) &&
+            witnessArityMayMatch(req, decl)) {
           witnesses.push_back(decl);
         }
       }
@@ -2115,22 +2115,44 @@ ModuleFile::resolveCrossReference(ModuleID MID, uint32_t pathLen) {
   assert(baseModule && "missing dependency");
   PrettyXRefTrace pathTrace(*baseModule);
 
-  llvm::BitstreamEntry entry =
-      fatalIfUnexpected(DeclTypeCursor.advance(AF_DontPopBlockAtEnd));
-  if (entry.Kind != llvm::BitstreamEntry::Record)
-    return diagnoseFatal();
-
   SmallVector<ValueDecl *, 8> values;
   SmallVector<uint64_t, 8> scratch;
   StringRef blobData;
 
+  // Decode the whole cross-reference path up front. The path pieces are laid
+  // out back-to-back in the bitstream, so one sequential pass streams them all
+  // in together; the lookups below recursively deserialize other decls and
+  // seek the cursor all over the file, and interleaving the piece reads with
+  // them turns each piece into a separate scattered read.
+  struct PathPiece {
+    unsigned RecordID;
+    SmallVector<uint64_t, 8> Scratch;
+    StringRef BlobData;
+  };
+  SmallVector<PathPiece, 8> pathPieces;
+  pathPieces.resize(pathLen);
+  for (auto &piece : pathPieces) {
+    llvm::BitstreamEntry entry =
+        fatalIfUnexpected(DeclTypeCursor.advance(AF_DontPopBlockAtEnd));
+    if (entry.Kind != llvm::BitstreamEntry::Record)
+      return diagnoseFatal();
+    piece.RecordID = fatalIfUnexpected(
+        DeclTypeCursor.readRecord(entry.ID, piece.Scratch, &piece.BlobData));
+  }
+
+  unsigned pieceIndex = 0;
+  auto readNextPathPiece = [&]() -> unsigned {
+    const PathPiece &piece = pathPieces[pieceIndex++];
+    scratch.assign(piece.Scratch.begin(), piece.Scratch.end());
+    blobData = piece.BlobData;
+    return piece.RecordID;
+  };
+
   // Read the first path piece. This one is special because lookup is performed
   // against the base module, rather than against the previous link in the path.
   // In particular, operator path pieces represent actual operators here, but
   // filters on operator functions when they appear later on.
-  scratch.clear();
-  unsigned recordID = fatalIfUnexpected(
-      DeclTypeCursor.readRecord(entry.ID, scratch, &blobData));
+  unsigned recordID = readNextPathPiece();
   switch (recordID) {
   case XREF_TYPE_PATH_PIECE:
   case XREF_VALUE_PATH_PIECE: {
@@ -2269,29 +2291,21 @@ ModuleFile::resolveCrossReference(ModuleID MID, uint32_t pathLen) {
   }
 
   auto getXRefDeclNameForError = [&]() -> DeclName {
-    BCOffsetRAII restoreOffset(DeclTypeCursor);
     DeclName result = pathTrace.getLastName();
-    uint32_t namePathLen = pathLen;
-    while (--namePathLen) {
-      llvm::BitstreamEntry entry =
-          fatalIfUnexpected(DeclTypeCursor.advance(AF_DontPopBlockAtEnd));
-      if (entry.Kind != llvm::BitstreamEntry::Record)
-        return Identifier();
-
-      scratch.clear();
-      unsigned recordID = fatalIfUnexpected(
-          DeclTypeCursor.readRecord(entry.ID, scratch, &blobData));
-      switch (recordID) {
+    for (unsigned restIndex = pieceIndex, endIndex = pathPieces.size();
+         restIndex != endIndex; ++restIndex) {
+      const PathPiece &piece = pathPieces[restIndex];
+      switch (piece.RecordID) {
       case XREF_TYPE_PATH_PIECE: {
         IdentifierID IID;
-        XRefTypePathPieceLayout::readRecord(scratch, IID, std::nullopt,
+        XRefTypePathPieceLayout::readRecord(piece.Scratch, IID, std::nullopt,
                                             std::nullopt, std::nullopt);
         result = getIdentifier(IID);
         break;
       }
       case XREF_VALUE_PATH_PIECE: {
         IdentifierID IID;
-        XRefValuePathPieceLayout::readRecord(scratch, std::nullopt, IID,
+        XRefValuePathPieceLayout::readRecord(piece.Scratch, std::nullopt, IID,
                                              std::nullopt, std::nullopt,
                                              std::nullopt);
         result = getIdentifier(IID);
@@ -2299,7 +2313,7 @@ ModuleFile::resolveCrossReference(ModuleID MID, uint32_t pathLen) {
       }
       case XREF_OPAQUE_RETURN_TYPE_PATH_PIECE: {
         IdentifierID IID;
-        XRefOpaqueReturnTypePathPieceLayout::readRecord(scratch, IID);
+        XRefOpaqueReturnTypePathPieceLayout::readRecord(piece.Scratch, IID);
         auto mangledName = getIdentifier(IID);
         
         SmallString<64> buf;
@@ -2458,14 +2472,7 @@ ModuleFile::resolveCrossReference(ModuleID MID, uint32_t pathLen) {
 
   // For remaining path pieces, filter or drill down into the results we have.
   while (--pathLen) {
-    llvm::BitstreamEntry entry =
-        fatalIfUnexpected(DeclTypeCursor.advance(AF_DontPopBlockAtEnd));
-    if (entry.Kind != llvm::BitstreamEntry::Record)
-      return diagnoseFatal();
-
-    scratch.clear();
-    unsigned recordID = fatalIfUnexpected(
-        DeclTypeCursor.readRecord(entry.ID, scratch, &blobData));
+    unsigned recordID = readNextPathPiece();
     switch (recordID) {
     case XREF_TYPE_PATH_PIECE: {
       if (values.size() == 1 && isa<NominalTypeDecl>(values.front())) {
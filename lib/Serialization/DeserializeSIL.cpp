@@ -538,6 +538,18 @@ SILDeserializer::getSILDifferentiabilityWitnessForReference(
 }
 
 /// Helper function to find a SILFunction, given its name and type.
+DeclID SILDeserializer::probeFuncTable(StringRef name) {
+  if (!FuncTable)
+    return 0;
+  auto known = FuncTableProbes.find(name);
+  if (known != FuncTableProbes.end())
+    return known->second;
+  auto iter = FuncTable->find(name);
+  DeclID FID = (iter == FuncTable->end()) ? 0 : *iter;
+  FuncTableProbes[name] = FID;
+  return FID;
+}
+
 SILFunction *SILDeserializer::getFuncForReference(StringRef name,
                                                   SILType type,
                                                   TypeExpansionContext context) {
@@ -545,9 +557,8 @@ SILFunction *SILDeserializer::getFuncForReference(StringRef name,
   SILFunction *fn = SILMod.lookUpFunction(name);
   if (!fn) {
     // Otherwise, look for a function with this name in the module.
-    auto iter = FuncTable->find(name);
-    if (iter != FuncTable->end()) {
-      auto maybeFn = readSILFunctionChecked(*iter, nullptr, name,
+    if (auto FID = probeFuncTable(name)) {
+      auto maybeFn = readSILFunctionChecked(FID, nullptr, name,
                                             /*declarationOnly*/ true);
       if (maybeFn) {
         fn = maybeFn.get();
@@ -605,13 +616,12 @@ SILFunction *SILDeserializer::getFuncForReference(StringRef name,
     return fn;
 
   // Otherwise, look for a function with this name in the module.
-  auto iter = FuncTable->find(name);
-
-  if (iter == FuncTable->end())
+  auto FID = probeFuncTable(name);
+  if (!FID)
     return nullptr;
 
   auto maybeFn =
-      readSILFunctionChecked(*iter, nullptr, name,
+      readSILFunctionChecked(FID, nullptr, name,
                              /*declarationOnly*/ true, true, forDebugScope);
   if (!maybeFn) {
     // Ignore the failure and just pretend the function doesn't exist
@@ -3884,14 +3894,12 @@ bool SILDeserializer::readSILInstruction(SILFunction *Fn,
 SILFunction *SILDeserializer::lookupSILFunction(SILFunction *InFunc,
                                                 bool onlyUpdateLinkage) {
   StringRef name = InFunc->getName();
-  if (!FuncTable)
-    return nullptr;
-  auto iter = FuncTable->find(name);
-  if (iter == FuncTable->end())
+  auto FID = probeFuncTable(name);
+  if (!FID)
     return nullptr;
 
   // Re-reading the function as declaration will update the linkage.
-  auto maybeFunc = readSILFunctionChecked(*iter, InFunc, name,
+  auto maybeFunc = readSILFunctionChecked(FID, InFunc, name,
                                         /*declarationOnly*/ onlyUpdateLinkage);
   if (!maybeFunc) {
     // Ignore the error; treat it as if we didn't have a definition.
@@ -3914,15 +3922,12 @@ SILFunction *SILDeserializer::lookupSILFunction(SILFunction *InFunc,
 /// create a SILFunction object.
 bool SILDeserializer::hasSILFunction(StringRef Name,
                                      std::optional<SILLinkage> Linkage) {
-  if (!FuncTable)
-    return false;
-  auto iter = FuncTable->find(Name);
-  if (iter == FuncTable->end())
+  auto FID = probeFuncTable(Name);
+  if (!FID)
     return false;
 
   // There is a function with the required name.
   // Find out which linkage it has.
-  auto FID = *iter;
   auto &cacheEntry = Funcs[FID-1];
   if (cacheEntry.isFullyDeserialized() ||
       (cacheEntry.isDeserialized()))
@@ -4003,13 +4008,11 @@ bool SILDeserializer::hasSILFunction(StringRef Name,
 
 SILFunction *SILDeserializer::lookupSILFunction(StringRef name,
                                                 bool declarationOnly) {
-  if (!FuncTable)
-    return nullptr;
-  auto iter = FuncTable->find(name);
-  if (iter == FuncTable->end())
+  auto FID = probeFuncTable(name);
+  if (!FID)
     return nullptr;
 
-  auto maybeFunc = readSILFunctionChecked(*iter, nullptr, name,
+  auto maybeFunc = readSILFunctionChecked(FID, nullptr, name,
                                           declarationOnly);
 
   if (!maybeFunc) {
@@ -18,6 +18,7 @@
 #include "swift/Serialization/SerializedSILLoader.h"
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/SaveAndRestore.h"
 
 namespace llvm {
@@ -89,6 +90,19 @@ namespace swift {
     // Before adding a new cache here, please read the comment at the
     // beginning of the deserialization cache section.
 
+    /// Memoized probes of the on-disk function table, including misses.
+    ///
+    /// The table is immutable, so a probe result never changes and does not
+    /// have to be invalidated. A value of 0 records that the name is not in
+    /// the table (function IDs are 1-based). Misses are the common case:
+    /// before a shared specialization is created, its mangled name is looked
+    /// up in every deserializer, mostly unsuccessfully.
+    llvm::StringMap<serialization::DeclID> FuncTableProbes;
+
+    /// Looks up \p name in the on-disk function table, memoizing the result.
+    /// Returns 0 if the table does not contain the name.
+    serialization::DeclID probeFuncTable(StringRef name);
+
     /// A declaration will only
     llvm::DenseMap<NormalProtocolConformance *, SILWitnessTable *>
     ConformanceToWitnessTableMap;
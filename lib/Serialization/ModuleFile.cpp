@@ -352,21 +352,33 @@ void ModuleFile::lookupValue(DeclName name,
     // FIXME: As a bit of a hack, do lookup by the simple name, then filter
     // compound decls, to avoid having to completely redo how modules are
     // serialized.
-    auto iter = Core->TopLevelDecls->find(name.getBaseName());
-    if (iter != Core->TopLevelDecls->end()) {
-      for (auto item : *iter) {
-        Expected<Decl *> declOrError = getDeclChecked(item.second);
-        if (!declOrError) {
-          if (!getContext().LangOpts.EnableDeserializationRecovery)
-            fatal(declOrError.takeError());
-          diagnoseAndConsumeError(declOrError.takeError());
-          continue;
-        }
-        auto VD = cast<ValueDecl>(declOrError.get());
-        if (name.isSimpleName() || VD->getName().matchesRef(name))
-          if (ABIRoleInfo(VD).matchesOptions(flags))
-            results.push_back(VD);
+    //
+    // Use the memoized decl IDs if this base name has been probed before;
+    // misses in particular recur once per file that mentions the name.
+    SmallVector<DeclID, 2> declIDs;
+    auto known = TopLevelDeclIDs.find(name.getBaseName());
+    if (known != TopLevelDeclIDs.end()) {
+      declIDs.append(known->second.begin(), known->second.end());
+    } else {
+      auto iter = Core->TopLevelDecls->find(name.getBaseName());
+      if (iter != Core->TopLevelDecls->end())
+        for (auto item : *iter)
+          declIDs.push_back(item.second);
+      TopLevelDeclIDs.try_emplace(name.getBaseName(), declIDs);
+    }
+
+    for (auto declID : declIDs) {
+      Expected<Decl *> declOrError = getDeclChecked(declID);
+      if (!declOrError) {
+        if (!getContext().LangOpts.EnableDeserializationRecovery)
+          fatal(declOrError.takeError());
+        diagnoseAndConsumeError(declOrError.takeError());
+        continue;
       }
+      auto VD = cast<ValueDecl>(declOrError.get());
+      if (name.isSimpleName() || VD->getName().matchesRef(name))
+        if (ABIRoleInfo(VD).matchesOptions(flags))
+          results.push_back(VD);
     }
   }
 
@@ -1116,6 +1128,7 @@ std::optional<CommentInfo> ModuleFile::getCommentForDecl(const Decl *D) const {
   assert(D->getDeclContext()->getModuleScopeContext() == FileContext &&
          "Decl is from a different serialized file");
 
+  Core->ensureModuleDocParsed();
   if (!Core->DeclCommentTable)
     return std::nullopt;
   if (D->isImplicit())
@@ -1130,6 +1143,7 @@ std::optional<CommentInfo> ModuleFile::getCommentForDecl(const Decl *D) const {
 }
 
 bool ModuleFile::hasLoadedSwiftDoc() const {
+  Core->ensureModuleDocParsed();
   return Core->DeclCommentTable != nullptr;
 }
 
@@ -1142,6 +1156,7 @@ void ModuleFile::collectSerializedSearchPath(
 
 void ModuleFile::collectBasicSourceFileInfo(
     llvm::function_ref<void(const BasicSourceFileInfo &)> callback) const {
+  Core->ensureModuleSourceInfoParsed();
   if (Core->SourceFileListData.empty())
     return;
   assert(!Core->SourceLocsTextData.empty());
@@ -1225,6 +1240,7 @@ ModuleFile::getExternalRawLocsForDecl(const Decl *D) const {
   assert(D->getDeclContext()->getModuleScopeContext() == FileContext &&
          "Decl is from a different serialized file");
 
+  Core->ensureModuleSourceInfoParsed();
   if (!Core->DeclUSRsTable)
     return std::nullopt;
   // Future compilers may not provide BasicDeclLocsData anymore.
@@ -1280,6 +1296,7 @@ ModuleFile::getExternalRawLocsForDecl(const Decl *D) const {
 const static StringRef Separator = "/";
 
 std::optional<StringRef> ModuleFile::getGroupNameById(unsigned Id) const {
+  Core->ensureModuleDocParsed();
   if (!Core->GroupNamesMap)
     return std::nullopt;
   const auto &GroupNamesMap = *Core->GroupNamesMap;
@@ -1295,6 +1312,7 @@ std::optional<StringRef> ModuleFile::getGroupNameById(unsigned Id) const {
 }
 
 std::optional<StringRef> ModuleFile::getSourceFileNameById(unsigned Id) const {
+  Core->ensureModuleDocParsed();
   if (!Core->GroupNamesMap)
     return std::nullopt;
   const auto &GroupNamesMap = *Core->GroupNamesMap;
@@ -1337,6 +1355,7 @@ std::optional<unsigned> ModuleFile::getSourceOrderForDecl(const Decl *D) const {
 }
 
 void ModuleFile::collectAllGroups(SmallVectorImpl<StringRef> &Names) const {
+  Core->ensureModuleDocParsed();
   if (!Core->GroupNamesMap)
     return;
   for (auto It = Core->GroupNamesMap->begin(); It != Core->GroupNamesMap->end();
@@ -1356,6 +1375,7 @@ void ModuleFile::collectAllGroups(SmallVectorImpl<StringRef> &Names) const {
 
 std::optional<CommentInfo>
 ModuleFile::getCommentForDeclByUSR(StringRef USR) const {
+  Core->ensureModuleDocParsed();
   if (!Core->DeclCommentTable)
     return std::nullopt;
 
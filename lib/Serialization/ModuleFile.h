@@ -314,6 +314,13 @@ private:
   llvm::DenseMap<const Decl *, Identifier> PrivateDiscriminatorsByValue;
   llvm::DenseMap<const Decl *, StringRef> FilenamesForPrivateValues;
 
+  /// Memoized probes of the on-disk top-level decl table, including misses.
+  /// Every file that names an identifier probes each of its imported modules
+  /// for it, and the serialized table never changes, so the first probe's
+  /// decl IDs are definitive.
+  llvm::DenseMap<DeclBaseName, llvm::SmallVector<serialization::DeclID, 2>>
+      TopLevelDeclIDs;
+
   TinyPtrVector<Decl *> ImportDecls;
 
   /// Maps USRs to their deserialized comment object.
@@ -23,6 +23,7 @@
 #include "swift/Parse/ParseVersion.h"
 #include "swift/Serialization/SerializedModuleLoader.h"
 #include "swift/Strings.h"
+#include "llvm/Support/Endian.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/OnDiskHashTable.h"
 #include "llvm/Support/PrettyStackTrace.h"
@@ -856,6 +857,21 @@ ModuleFileSharedCore::readDerivativeFunctionConfigTable(
       base + tableOffset, base + sizeof(uint32_t), base));
 }
 
+void ModuleFileSharedCore::allocateOffsetBuffer(ArrayRef<RawBitOffset> &buffer,
+                                                StringRef rawData) {
+  assert(buffer.empty() && "reallocating deserialized buffer");
+  assert(rawData.size() % sizeof(uint32_t) == 0 && "malformed offsets record");
+  size_t count = rawData.size() / sizeof(uint32_t);
+  if (count == 0)
+    return;
+
+  auto *result = Allocator.Allocate<RawBitOffset>(count);
+  const char *data = rawData.data();
+  for (size_t i = 0; i != count; ++i)
+    result[i] = llvm::support::endian::read32le(data + i * sizeof(uint32_t));
+  buffer = llvm::ArrayRef(result, count);
+}
+
 bool ModuleFileSharedCore::readIndexBlock(llvm::BitstreamCursor &cursor) {
   if (llvm::Error Err = cursor.EnterSubBlock(INDEX_BLOCK_ID)) {
     // FIXME this drops the error on the floor.
@@ -925,20 +941,16 @@ bool ModuleFileSharedCore::readIndexBlock(llvm::BitstreamCursor &cursor) {
 
       switch (kind) {
       case index_block::DECL_OFFSETS:
-        assert(blobData.empty());
-        allocateBuffer(Decls, scratch);
+        allocateOffsetBuffer(Decls, blobData);
         break;
       case index_block::TYPE_OFFSETS:
-        assert(blobData.empty());
-        allocateBuffer(Types, scratch);
+        allocateOffsetBuffer(Types, blobData);
         break;
       case index_block::CLANG_TYPE_OFFSETS:
-        assert(blobData.empty());
-        allocateBuffer(ClangTypes, scratch);
+        allocateOffsetBuffer(ClangTypes, blobData);
         break;
       case index_block::IDENTIFIER_OFFSETS:
-        assert(blobData.empty());
-        allocateBuffer(Identifiers, scratch);
+        allocateOffsetBuffer(Identifiers, blobData);
         break;
       case index_block::TOP_LEVEL_DECLS:
         TopLevelDecls = readDeclTable(scratch, blobData);
@@ -991,36 +1003,28 @@ bool ModuleFileSharedCore::readIndexBlock(llvm::BitstreamCursor &cursor) {
         DeclFingerprints = readDeclFingerprintsTable(scratch, blobData);
         break;
       case index_block::LOCAL_DECL_CONTEXT_OFFSETS:
-        assert(blobData.empty());
-        allocateBuffer(LocalDeclContexts, scratch);
+        allocateOffsetBuffer(LocalDeclContexts, blobData);
         break;
       case index_block::GENERIC_SIGNATURE_OFFSETS:
-        assert(blobData.empty());
-        allocateBuffer(GenericSignatures, scratch);
+        allocateOffsetBuffer(GenericSignatures, blobData);
         break;
       case index_block::GENERIC_ENVIRONMENT_OFFSETS:
-        assert(blobData.empty());
-        allocateBuffer(GenericEnvironments, scratch);
+        allocateOffsetBuffer(GenericEnvironments, blobData);
         break;
       case index_block::SUBSTITUTION_MAP_OFFSETS:
-        assert(blobData.empty());
-        allocateBuffer(SubstitutionMaps, scratch);
+        allocateOffsetBuffer(SubstitutionMaps, blobData);
         break;
       case index_block::PROTOCOL_CONFORMANCE_OFFSETS:
-        assert(blobData.empty());
-        allocateBuffer(Conformances, scratch);
+        allocateOffsetBuffer(Conformances, blobData);
         break;
       case index_block::ABSTRACT_CONFORMANCE_OFFSETS:
-        assert(blobData.empty());
-        allocateBuffer(AbstractConformances, scratch);
+        allocateOffsetBuffer(AbstractConformances, blobData);
         break;
       case index_block::PACK_CONFORMANCE_OFFSETS:
-        assert(blobData.empty());
-        allocateBuffer(PackConformances, scratch);
+        allocateOffsetBuffer(PackConformances, blobData);
         break;
       case index_block::SIL_LAYOUT_OFFSETS:
-        assert(blobData.empty());
-        allocateBuffer(SILLayouts, scratch);
+        allocateOffsetBuffer(SILLayouts, blobData);
         break;
 
       default:
@@ -1062,7 +1066,7 @@ ModuleFileSharedCore::readGroupTable(ArrayRef<uint64_t> Fields,
   return std::unique_ptr<ModuleFileSharedCore::GroupNameTable>(pMap.release());
 }
 
-bool ModuleFileSharedCore::readCommentBlock(llvm::BitstreamCursor &cursor) {
+bool ModuleFileSharedCore::readCommentBlock(llvm::BitstreamCursor &cursor) const {
   if (llvm::Error Err = cursor.EnterSubBlock(COMMENT_BLOCK_ID)) {
     // FIXME this drops the error on the floor.
     consumeError(std::move(Err));
@@ -1175,7 +1179,7 @@ getActualMacroAccess(unsigned rawValue) {
   }
 }
 
-bool ModuleFileSharedCore::readModuleDocIfPresent(PathObfuscator &pathRecoverer) {
+bool ModuleFileSharedCore::readModuleDocIfPresent() const {
   if (!this->ModuleDocInputBuffer)
     return true;
 
@@ -1216,7 +1220,7 @@ bool ModuleFileSharedCore::readModuleDocIfPresent(PathObfuscator &pathRecoverer)
           RequiresOSSAModules,
           /*requiresRevisionMatch*/false,
           /*requiredSDK*/StringRef(), /*target*/std::nullopt,
-          /*extendedInfo*/nullptr, pathRecoverer);
+          /*extendedInfo*/nullptr, SideFilePathRecoverer);
       if (info.status != Status::Valid)
         return false;
       // Check that the swiftdoc is actually for this module.
@@ -1259,7 +1263,7 @@ ModuleFileSharedCore::readDeclUSRsTable(ArrayRef<uint64_t> fields,
                                    base));
 }
 
-bool ModuleFileSharedCore::readDeclLocsBlock(llvm::BitstreamCursor &cursor) {
+bool ModuleFileSharedCore::readDeclLocsBlock(llvm::BitstreamCursor &cursor) const {
   if (llvm::Error Err = cursor.EnterSubBlock(CONTROL_BLOCK_ID)) {
     consumeError(std::move(Err));
     return false;
@@ -1322,7 +1326,7 @@ bool ModuleFileSharedCore::readDeclLocsBlock(llvm::BitstreamCursor &cursor) {
   return false;
 }
 
-bool ModuleFileSharedCore::readModuleSourceInfoIfPresent(PathObfuscator &pathRecoverer) {
+bool ModuleFileSharedCore::readModuleSourceInfoIfPresent() const {
   if (!this->ModuleSourceInfoInputBuffer)
     return true;
 
@@ -1362,7 +1366,7 @@ bool ModuleFileSharedCore::readModuleSourceInfoIfPresent(PathObfuscator &pathRec
           RequiresOSSAModules,
           /*requiresRevisionMatch*/false,
           /*requiredSDK*/StringRef(), /*target*/std::nullopt,
-          /*extendedInfo*/nullptr, pathRecoverer);
+          /*extendedInfo*/nullptr, SideFilePathRecoverer);
       if (info.status != Status::Valid)
         return false;
       // Check that the swiftsourceinfo is actually for this module.
@@ -1869,15 +1873,26 @@ ModuleFileSharedCore::ModuleFileSharedCore(
     info.status = error(Status::Malformed);
     return;
   }
-  // Read source info file.
-  readModuleSourceInfoIfPresent(pathRecoverer);
-  if (!readModuleDocIfPresent(pathRecoverer)) {
-    info.status = error(Status::MalformedDocumentation);
-    return;
-  }
+  // The .swiftdoc and .swiftsourceinfo buffers are deliberately not parsed
+  // here; that is deferred to the first documentation or source-location
+  // query so compile-only clients never pay for it. Keep a copy of the path
+  // obfuscator for when that parse eventually happens. A side file that
+  // turns out to be malformed is treated as if it were absent.
+  SideFilePathRecoverer = pathRecoverer;
+}
+
+void ModuleFileSharedCore::ensureModuleDocParsed() const {
+  std::call_once(ModuleDocParsedFlag,
+                 [this] { (void)readModuleDocIfPresent(); });
+}
+
+void ModuleFileSharedCore::ensureModuleSourceInfoParsed() const {
+  std::call_once(ModuleSourceInfoParsedFlag,
+                 [this] { (void)readModuleSourceInfoIfPresent(); });
 }
 
 bool ModuleFileSharedCore::hasSourceInfo() const {
+  ensureModuleSourceInfoParsed();
   return !!DeclUSRsTable;
 }
 
@@ -16,10 +16,13 @@
 #include "ModuleFormat.h"
 #include "swift/AST/LinkLibrary.h"
 #include "swift/AST/Module.h"
+#include "swift/Basic/PathRemapper.h"
 #include "swift/Serialization/Validation.h"
 #include "llvm/ADT/bit.h"
 #include "llvm/Bitstream/BitstreamReader.h"
 
+#include <mutex>
+
 namespace llvm {
   template <typename Info> class OnDiskIterableChainedHashTable;
 }
@@ -233,6 +236,10 @@ private:
     buffer = result;
   }
 
+  /// Decodes an offsets record, which is stored as a blob of fixed-width
+  /// little-endian 32-bit entries, into a buffer allocated from #Allocator.
+  void allocateOffsetBuffer(ArrayRef<RawBitOffset> &buffer, StringRef rawData);
+
   /// Decls referenced by this module.
   ArrayRef<RawBitOffset> Decls;
 
@@ -329,13 +336,18 @@ private:
 
   using GroupNameTable = const llvm::DenseMap<unsigned, StringRef>;
 
-  std::unique_ptr<GroupNameTable> GroupNamesMap;
-  std::unique_ptr<SerializedDeclCommentTable> DeclCommentTable;
+  /// The tables and blobs below that come out of the swiftdoc and
+  /// swiftsourceinfo side files are parsed lazily, on the first documentation
+  /// or source-location query, so compile-only clients never pay for them.
+  /// They must only be accessed after the corresponding
+  /// \c ensureModuleDocParsed() / \c ensureModuleSourceInfoParsed() call.
+  mutable std::unique_ptr<GroupNameTable> GroupNamesMap;
+  mutable std::unique_ptr<SerializedDeclCommentTable> DeclCommentTable;
 
   class DeclUSRTableInfo;
   using SerializedDeclUSRTable =
       llvm::OnDiskIterableChainedHashTable<DeclUSRTableInfo>;
-  std::unique_ptr<SerializedDeclUSRTable> DeclUSRsTable;
+  mutable std::unique_ptr<SerializedDeclUSRTable> DeclUSRsTable;
 
   class DerivativeFunctionConfigTableInfo;
   using SerializedDerivativeFunctionConfigTable =
@@ -344,18 +356,28 @@ private:
       DerivativeFunctionConfigurations;
 
   /// A blob of 0 terminated string segments referenced in \c SourceLocsTextData
-  StringRef SourceLocsTextData;
+  mutable StringRef SourceLocsTextData;
 
   /// A blob of source file list.
-  StringRef SourceFileListData;
+  mutable StringRef SourceFileListData;
 
   /// An array of fixed size source location data for each USR appearing in
   /// \c DeclUSRsTable.
-  StringRef BasicDeclLocsData;
+  mutable StringRef BasicDeclLocsData;
 
   /// An array of fixed-size location data for each `SingleRawComment` piece
   /// of declaration's documentation `RawComment`s.
-  StringRef DocRangesData;
+  mutable StringRef DocRangesData;
+
+  /// Guard the one-time lazy parse of #ModuleDocInputBuffer and
+  /// #ModuleSourceInfoInputBuffer respectively.
+  mutable std::once_flag ModuleDocParsedFlag;
+  mutable std::once_flag ModuleSourceInfoParsedFlag;
+
+  /// A copy of the path obfuscator the module was loaded with, retained so
+  /// that the lazy side-file parse can recover serialized paths. Mutable only
+  /// because the validation helpers take it by non-const reference.
+  mutable PathObfuscator SideFilePathRecoverer;
 
   struct ModuleBits {
     /// The decl ID of the main class in this module file, if it has one.
@@ -533,22 +555,22 @@ private:
   /// Reads the comment block, which contains USR to comment mappings.
   ///
   /// Returns false if there was an error.
-  bool readCommentBlock(llvm::BitstreamCursor &cursor);
+  bool readCommentBlock(llvm::BitstreamCursor &cursor) const;
 
   /// Loads data from #ModuleDocInputBuffer.
   ///
   /// Returns false if there was an error.
-  bool readModuleDocIfPresent(PathObfuscator &pathRecoverer);
+  bool readModuleDocIfPresent() const;
 
   /// Reads the source loc block, which contains USR to decl location mapping.
   ///
   /// Returns false if there was an error.
-  bool readDeclLocsBlock(llvm::BitstreamCursor &cursor);
+  bool readDeclLocsBlock(llvm::BitstreamCursor &cursor) const;
 
   /// Loads data from #ModuleSourceInfoInputBuffer.
   ///
   /// Returns false if there was an error.
-  bool readModuleSourceInfoIfPresent(PathObfuscator &pathRecoverer);
+  bool readModuleSourceInfoIfPresent() const;
 
   /// Read an on-disk decl hash table stored in
   /// \c sourceinfo_block::DeclUSRSLayout format.
@@ -692,9 +714,19 @@ public:
   bool hasSourceInfoFile() const { return !!ModuleSourceInfoInputBuffer; }
 
   /// Returns \c true if a corresponding .swiftsourceinfo has been found *and
-  /// read*.
+  /// read*. Triggers the lazy parse of the .swiftsourceinfo buffer.
   bool hasSourceInfo() const;
 
+  /// Parses the .swiftdoc buffer, if one was provided, the first time this is
+  /// called. Must be called before accessing #DeclCommentTable or
+  /// #GroupNamesMap. Thread-safe.
+  void ensureModuleDocParsed() const;
+
+  /// Parses the .swiftsourceinfo buffer, if one was provided, the first time
+  /// this is called. Must be called before accessing #DeclUSRsTable or the
+  /// location data blobs. Thread-safe.
+  void ensureModuleSourceInfoParsed() const;
+
   bool isConcurrencyChecked() const { return Bits.IsConcurrencyChecked; }
 
   bool strictMemorySafety() const { return Bits.StrictMemorySafety; }
@@ -58,7 +58,7 @@ const uint16_t SWIFTMODULE_VERSION_MAJOR = 0;
 /// describe what change you made. The content of this comment isn't important;
 /// it just ensures a conflict if two people change the module format.
 /// Don't worry about adhering to the 80-column limit for this line.
-const uint16_t SWIFTMODULE_VERSION_MINOR = 961; // borrow/mutate accessors
+const uint16_t SWIFTMODULE_VERSION_MINOR = 962; // fixed-width offset table blobs
 
 /// A standard hash seed used for all string hashes in a serialized module.
 ///
@@ -2721,7 +2721,7 @@ namespace index_block {
 
   using OffsetsLayout = BCGenericRecordLayout<
     RecordIDField, // record ID
-    BCArray<BitOffsetField>
+    BCBlob // array of fixed-width little-endian 32-bit offsets
   >;
 
   using DeclListLayout = BCGenericRecordLayout<
@@ -6540,11 +6540,28 @@ std::vector<CharOffset> Serializer::writeAllIdentifiers() {
   return identifierOffsets;
 }
 
+/// Emits an offsets record as a blob of fixed-width little-endian entries,
+/// which the reader can decode without scanning the whole record.
+template <typename Range>
+static void emitOffsetsRecord(const index_block::OffsetsLayout &Offsets,
+                              SmallVectorImpl<uint64_t> &scratch,
+                              unsigned recordCode, const Range &offsets) {
+  SmallString<2048> blob;
+  {
+    llvm::raw_svector_ostream out(blob);
+    endian::Writer writer(out, llvm::endianness::little);
+    for (unsigned offset : offsets)
+      writer.write<uint32_t>(offset);
+  }
+  Offsets.emit(scratch, recordCode, blob.str());
+}
+
 template <typename SpecificASTBlockRecordKeeper>
 void Serializer::writeOffsets(const index_block::OffsetsLayout &Offsets,
                               const SpecificASTBlockRecordKeeper &entities) {
-  Offsets.emit(ScratchRecord, SpecificASTBlockRecordKeeper::RecordCode,
-               entities.getOffsets());
+  emitOffsetsRecord(Offsets, ScratchRecord,
+                    SpecificASTBlockRecordKeeper::RecordCode,
+                    entities.getOffsets());
 }
 
 /// Writes an in-memory decl table to an on-disk representation, using the
@@ -7131,8 +7148,8 @@ void Serializer::writeAST(ModuleOrSourceFile DC) {
     writeOffsets(Offsets, PackConformancesToSerialize);
     writeOffsets(Offsets, SILLayoutsToSerialize);
 
-    Offsets.emit(ScratchRecord, index_block::IDENTIFIER_OFFSETS,
-                 identifierOffsets);
+    emitOffsetsRecord(Offsets, ScratchRecord, index_block::IDENTIFIER_OFFSETS,
+                      identifierOffsets);
 
     index_block::DeclListLayout DeclList(Out);
     writeDeclTable(DeclList, index_block::TOP_LEVEL_DECLS, topLevelDecls);
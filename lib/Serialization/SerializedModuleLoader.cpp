@@ -284,8 +284,11 @@ std::error_code SerializedModuleLoaderBase::openModuleDocFileIfPresent(
   SmallString<256>
   ModuleDocPath{BaseName.getName(file_types::TY_SwiftModuleDocFile)};
 
+  // Like the module file itself, this is bitstream; not requiring a null
+  // terminator keeps the buffer mmap-able and shared across processes.
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> ModuleDocOrErr =
-    FS.getBufferForFile(ModuleDocPath);
+    FS.getBufferForFile(ModuleDocPath, /*FileSize=*/-1,
+                        /*RequiresNullTerminator=*/false);
   if (ModuleDocOrErr) {
     *ModuleDocBuffer = std::move(*ModuleDocOrErr);
   } else if (ModuleDocOrErr.getError() !=
@@ -403,13 +406,19 @@ SerializedModuleLoaderBase::openModuleSourceInfoFileIfPresent(
   llvm::sys::path::append(PathWithProjectDir, FileName);
 
   // Try to open the module source info file from the "Project" directory.
+  // This is bitstream as well; not requiring a null terminator keeps the
+  // buffer mmap-able and shared across processes.
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
-  ModuleSourceInfoOrErr = FS.getBufferForFile(PathWithProjectDir);
+  ModuleSourceInfoOrErr = FS.getBufferForFile(PathWithProjectDir,
+                                              /*FileSize=*/-1,
+                                              /*RequiresNullTerminator=*/false);
 
   // If it does not exist, try to open the module source info file adjacent to
   // the .swiftmodule file.
   if (ModuleSourceInfoOrErr.getError() == std::errc::no_such_file_or_directory)
-    ModuleSourceInfoOrErr = FS.getBufferForFile(PathWithoutProjectDir);
+    ModuleSourceInfoOrErr =
+        FS.getBufferForFile(PathWithoutProjectDir, /*FileSize=*/-1,
+                            /*RequiresNullTerminator=*/false);
 
   // If we ended up with a different file system error, return it.
   if (ModuleSourceInfoOrErr)
@@ -461,11 +470,17 @@ std::error_code SerializedModuleLoaderBase::openModuleFile(
   // the surface look like memory corruption.
   //
   // rdar://63755989
+  // A swiftmodule is bitstream and is never scanned as a C string, so don't
+  // require a null terminator either: requiring one forces MemoryBuffer to
+  // abandon mmap and read a private copy whenever the file size is an exact
+  // multiple of the page size. With a plain read-only mmap, all concurrent
+  // frontend processes loading the same stdlib/SDK module share one set of
+  // physical pages through the page cache.
   bool enableVolatileModules = Ctx.LangOpts.EnableVolatileModules;
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> ModuleOrErr =
       FS.getBufferForFile(ModulePath,
                           /*FileSize=*/-1,
-                          /*RequiresNullTerminator=*/true,
+                          /*RequiresNullTerminator=*/false,
                           /*IsVolatile=*/enableVolatileModules);
   if (!ModuleOrErr)
     return ModuleOrErr.getError();
@@ -756,6 +771,22 @@ bool SerializedModuleLoaderBase::findModule(
   auto findTargetSpecificModuleFiles = [&](bool IsFramework) -> SearchResult {
     std::optional<SerializedModuleBaseName> firstAbsoluteBaseName;
 
+    // Most target-specific candidates are absent; probing each of them costs
+    // several failed filesystem accesses per candidate, which adds up on
+    // network filesystems. List the .swiftmodule directory once and only probe
+    // candidates that some file in it actually matches. If the listing fails,
+    // conservatively probe every candidate as before.
+    SmallString<256> moduleDirPath{currPath};
+    llvm::sys::path::append(moduleDirPath, genericModuleFileName);
+    SmallVector<SmallString<32>, 8> presentFileNames;
+    std::error_code listingError;
+    auto dirIt = fs.dir_begin(moduleDirPath, listingError);
+    bool haveListing = !listingError;
+    while (!listingError && dirIt != llvm::vfs::directory_iterator()) {
+      presentFileNames.emplace_back(llvm::sys::path::filename(dirIt->path()));
+      dirIt.increment(listingError);
+    }
+
     for (const auto &targetSpecificBaseName : targetSpecificBaseNames) {
       SerializedModuleBaseName absoluteBaseName{currPath,
                                                 targetSpecificBaseName};
@@ -763,6 +794,16 @@ bool SerializedModuleLoaderBase::findModule(
       if (!firstAbsoluteBaseName.has_value())
         firstAbsoluteBaseName.emplace(absoluteBaseName);
 
+      if (haveListing) {
+        SmallString<32> targetPrefix{
+            llvm::sys::path::filename(targetSpecificBaseName.baseName)};
+        targetPrefix += '.';
+        if (llvm::none_of(presentFileNames, [&](StringRef fileName) {
+              return fileName.starts_with(targetPrefix);
+            }))
+          continue;
+      }
+
       auto result = findModuleFilesInDirectory(
           moduleID, absoluteBaseName, moduleInterfacePath,
           moduleInterfaceSourcePath, moduleBuffer, moduleDocBuffer,
@@ -922,10 +963,6 @@ LoadedFile *SerializedModuleLoaderBase::loadAST(
   StringRef moduleDocBufferID;
   if (moduleDocInputBuffer)
     moduleDocBufferID = moduleDocInputBuffer->getBufferIdentifier();
-  StringRef moduleSourceInfoID;
-  if (moduleSourceInfoInputBuffer)
-    moduleSourceInfoID = moduleSourceInfoInputBuffer->getBufferIdentifier();
-
   if (moduleInputBuffer->getBufferSize() % 4 != 0) {
     if (diagLoc)
       Ctx.Diags.diagnose(*diagLoc, diag::serialization_malformed_module,
@@ -1009,11 +1046,9 @@ LoadedFile *SerializedModuleLoaderBase::loadAST(
         (Ctx.LangOpts.AllowModuleWithCompilerErrors &&
          (loadInfo.status == serialization::Status::TargetTooNew ||
           loadInfo.status == serialization::Status::TargetIncompatible))) {
-      if (loadedModuleFile->hasSourceInfoFile() &&
-          !loadedModuleFile->hasSourceInfo())
-        Ctx.Diags.diagnose(diagLocOrInvalid,
-                           diag::serialization_malformed_sourceinfo,
-                           moduleSourceInfoID);
+      // Note: the .swiftsourceinfo buffer is parsed lazily on the first
+      // source-location query, so a malformed one is no longer diagnosed
+      // here; it is simply treated as absent when it is eventually read.
 
       Ctx.bumpGeneration();
       LoadedModuleFiles.emplace_back(std::move(loadedModuleFile),
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "swift/StaticMirror/ObjectFileContext.h"
+#include "swift/StaticMirror/OnDiskTypeRefCache.h"
 #include "swift/Basic/Assertions.h"
 #include "swift/Basic/Unreachable.h"
 #include "swift/Demangling/Demangler.h"
@@ -576,12 +577,16 @@ uint64_t ObjectMemoryReader::getPtrauthMask() {
 
 template <typename Runtime>
 std::unique_ptr<ReflectionContextHolder> makeReflectionContextForMetadataReader(
-    std::shared_ptr<ObjectMemoryReader> reader, uint8_t pointerSize) {
+    std::shared_ptr<ObjectMemoryReader> reader, uint8_t pointerSize,
+    OnDiskTypeRefCache *typeRefCache) {
   using ReflectionContext = reflection::ReflectionContext<Runtime>;
-  auto context = new ReflectionContext(reader);
+  auto context = new ReflectionContext(reader, typeRefCache);
   auto &builder = context->getBuilder();
   for (unsigned i = 0, e = reader->getImages().size(); i < e; ++i) {
-    context->addImage(reader->getImageStartAddress(i));
+    auto infoID = context->addImage(reader->getImageStartAddress(i));
+    if (typeRefCache && infoID)
+      typeRefCache->registerImage(
+          *infoID, reader->getImages()[i].TheImage.getObjectFile());
   }
 
   ReflectionContextHolder *holder = new ReflectionContextHolder{
@@ -592,7 +597,8 @@ std::unique_ptr<ReflectionContextHolder> makeReflectionContextForMetadataReader(
 }
 
 std::unique_ptr<ReflectionContextHolder> makeReflectionContextForObjectFiles(
-  const std::vector<const ObjectFile *> &objectFiles, bool ObjCInterop) {
+  const std::vector<const ObjectFile *> &objectFiles, bool ObjCInterop,
+  OnDiskTypeRefCache *typeRefCache) {
   auto Reader = std::make_shared<ObjectMemoryReader>(objectFiles);
 
   auto pointerSize = Reader->getPointerSize();
@@ -605,8 +611,8 @@ std::unique_ptr<ReflectionContextHolder> makeReflectionContextForObjectFiles(
   case 4:
 #define MAKE_CONTEXT(INTEROP, PTRSIZE)                                         \
   makeReflectionContextForMetadataReader<                                      \
-      External<INTEROP<RuntimeTarget<PTRSIZE>>>>(std::move(Reader),            \
-                                                 pointerSize.value())
+      External<INTEROP<RuntimeTarget<PTRSIZE>>>>(                              \
+      std::move(Reader), pointerSize.value(), typeRefCache)
 #if SWIFT_OBJC_INTEROP
     if (ObjCInterop)
       return MAKE_CONTEXT(WithObjCInterop, 4);
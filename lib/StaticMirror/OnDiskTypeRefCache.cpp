@@ -0,0 +1,193 @@
+//===--- OnDiskTypeRefCache.cpp - Persistent typeref cache ----------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2025 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/StaticMirror/OnDiskTypeRefCache.h"
+#include "swift/RemoteInspection/TypeRefBuilder.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Object/BuildID.h"
+#include "llvm/Object/MachO.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <cstring>
+
+using namespace llvm;
+using namespace llvm::object;
+using namespace swift;
+using namespace swift::static_mirror;
+
+/// Cache file layout, all fields host-endian:
+///
+///   char     Magic[4]   "SFDC"
+///   uint32_t Version
+///   uint64_t NumEntries
+///   NumEntries of:
+///     uint64_t Offset
+///     uint32_t NameLen
+///     char     Name[NameLen]
+static const char CacheMagic[4] = {'S', 'F', 'D', 'C'};
+static const uint32_t CacheVersion = 1;
+
+/// Returns the image's build UUID as lower-case hex, or an empty string if it
+/// has none.
+static std::string getImageUUID(const ObjectFile *O) {
+  if (auto *MachO = dyn_cast<MachOObjectFile>(O)) {
+    ArrayRef<uint8_t> UUID = MachO->getUuid();
+    if (!UUID.empty())
+      return toHex(UUID, /*LowerCase=*/true);
+    return "";
+  }
+  BuildIDRef BuildID = getBuildID(O);
+  if (!BuildID.empty())
+    return toHex(BuildID, /*LowerCase=*/true);
+  return "";
+}
+
+OnDiskTypeRefCache::~OnDiskTypeRefCache() {
+  for (const auto &Entry : Images)
+    if (Entry.NeedsWrite)
+      writeImage(Entry);
+}
+
+void OnDiskTypeRefCache::registerImage(uint64_t InfoID, const ObjectFile *O) {
+  if (InfoID >= Images.size())
+    Images.resize(InfoID + 1);
+  auto &Entry = Images[InfoID];
+  Entry.UUID = getImageUUID(O);
+  if (!Entry.UUID.empty())
+    Entry.LoadedFromDisk = loadImage(Entry);
+}
+
+bool OnDiskTypeRefCache::loadImage(ImageEntry &Entry) {
+  SmallString<128> Path(CacheDir);
+  sys::path::append(Path, Entry.UUID + ".typerefs");
+
+  auto BufferOrErr = MemoryBuffer::getFile(Path);
+  if (!BufferOrErr)
+    return false;
+  auto Buffer = std::move(*BufferOrErr);
+
+  StringRef Data = Buffer->getBuffer();
+  if (Data.size() < sizeof(CacheMagic) + sizeof(uint32_t) + sizeof(uint64_t) ||
+      memcmp(Data.data(), CacheMagic, sizeof(CacheMagic)) != 0)
+    return false;
+  size_t Pos = sizeof(CacheMagic);
+
+  uint32_t Version;
+  memcpy(&Version, Data.data() + Pos, sizeof(Version));
+  Pos += sizeof(Version);
+  if (Version != CacheVersion)
+    return false;
+
+  uint64_t NumEntries;
+  memcpy(&NumEntries, Data.data() + Pos, sizeof(NumEntries));
+  Pos += sizeof(NumEntries);
+
+  llvm::StringMap<uint64_t> Locators;
+  for (uint64_t i = 0; i < NumEntries; ++i) {
+    if (Data.size() - Pos < sizeof(uint64_t) + sizeof(uint32_t))
+      return false;
+    uint64_t Offset;
+    memcpy(&Offset, Data.data() + Pos, sizeof(Offset));
+    Pos += sizeof(Offset);
+    uint32_t NameLen;
+    memcpy(&NameLen, Data.data() + Pos, sizeof(NameLen));
+    Pos += sizeof(NameLen);
+    if (Data.size() - Pos < NameLen)
+      return false;
+    Locators[Data.substr(Pos, NameLen)] = Offset;
+    Pos += NameLen;
+  }
+
+  Entry.Locators = std::move(Locators);
+  return true;
+}
+
+void OnDiskTypeRefCache::writeImage(const ImageEntry &Entry) {
+  if (sys::fs::create_directories(CacheDir))
+    return;
+
+  SmallString<128> Path(CacheDir);
+  sys::path::append(Path, Entry.UUID + ".typerefs");
+
+  // Write to a unique temporary and rename it into place so that a concurrent
+  // session never sees a half-written file.
+  SmallString<128> TempPath;
+  int TempFD;
+  if (sys::fs::createUniqueFile(Path + ".tmp%%%%%%", TempFD, TempPath))
+    return;
+
+  {
+    raw_fd_ostream OS(TempFD, /*shouldClose=*/true);
+    OS.write(CacheMagic, sizeof(CacheMagic));
+    OS.write(reinterpret_cast<const char *>(&CacheVersion),
+             sizeof(CacheVersion));
+    uint64_t NumEntries = Entry.Locators.size();
+    OS.write(reinterpret_cast<const char *>(&NumEntries), sizeof(NumEntries));
+    for (const auto &Locator : Entry.Locators) {
+      uint64_t Offset = Locator.second;
+      OS.write(reinterpret_cast<const char *>(&Offset), sizeof(Offset));
+      uint32_t NameLen = Locator.first().size();
+      OS.write(reinterpret_cast<const char *>(&NameLen), sizeof(NameLen));
+      OS.write(Locator.first().data(), NameLen);
+    }
+    if (OS.has_error()) {
+      OS.clear_error();
+      sys::fs::remove(TempPath);
+      return;
+    }
+  }
+
+  if (sys::fs::rename(TempPath, Path))
+    sys::fs::remove(TempPath);
+}
+
+void OnDiskTypeRefCache::cacheFieldDescriptors(
+    uint64_t InfoID, const reflection::FieldSection &FieldDescriptors,
+    llvm::ArrayRef<std::string> MangledNames) {
+  auto *Entry = getImage(InfoID);
+  if (!Entry || Entry->LoadedFromDisk || Entry->UUID.empty())
+    return;
+
+  auto Begin = FieldDescriptors.startAddress().getRemoteAddress();
+  size_t NameIndex = 0;
+  for (auto FD : FieldDescriptors) {
+    if (NameIndex >= MangledNames.size())
+      break;
+    const std::string &Name = MangledNames[NameIndex++];
+    if (!Name.empty())
+      Entry->Locators[Name] = FD.getRemoteAddress() - Begin;
+  }
+  Entry->NeedsWrite = true;
+}
+
+std::optional<remote::FieldDescriptorLocator>
+OnDiskTypeRefCache::getFieldDescriptorLocator(const std::string &Name) {
+  // Only images loaded from disk are consulted; the tables of images scanned
+  // this session are already in TypeRefBuilder's in-memory cache.
+  for (uint64_t InfoID = 0; InfoID < Images.size(); ++InfoID) {
+    auto &Entry = Images[InfoID];
+    if (!Entry.LoadedFromDisk)
+      continue;
+    auto It = Entry.Locators.find(Name);
+    if (It != Entry.Locators.end())
+      return remote::FieldDescriptorLocator{InfoID, It->second};
+  }
+  return std::nullopt;
+}
+
+bool OnDiskTypeRefCache::isReflectionInfoCached(uint64_t InfoID) {
+  auto *Entry = getImage(InfoID);
+  return Entry && Entry->LoadedFromDisk;
+}
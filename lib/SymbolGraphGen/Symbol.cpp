@@ -872,11 +872,22 @@ void Symbol::printPath(llvm::raw_ostream &OS) const {
 
 void Symbol::getUSR(SmallVectorImpl<char> &USR) const {
   llvm::raw_svector_ostream OS(USR);
+
+  auto &Cache = Graph->Walker.USRCache;
+  auto Key = std::make_pair(D, SynthesizedBaseTypeDecl);
+  auto Found = Cache.find(Key);
+  if (Found != Cache.end()) {
+    OS << Found->second;
+    return;
+  }
+
+  auto StartSize = USR.size();
   ide::printDeclUSR(D, OS, /*distinguishSynthesizedDecls*/ true);
   if (SynthesizedBaseTypeDecl) {
     OS << "::SYNTHESIZED::";
     ide::printDeclUSR(SynthesizedBaseTypeDecl, OS);
   }
+  Cache.try_emplace(Key, USR.data() + StartSize, USR.size() - StartSize);
 }
 
 bool Symbol::supportsKind(DeclKind Kind) {
@@ -71,6 +71,12 @@ struct SymbolGraphASTWalker : public SourceEntityWalker {
   /// Maps any internal symbol with a public type alias of that symbol.
   llvm::DenseMap<const ValueDecl *, const ValueDecl *> PublicPrivateTypeAliases;
 
+  /// Caches USRs already mangled during serialization. A symbol's USR is
+  /// serialized once for its node and once per relationship it appears in, so
+  /// large graphs re-mangle the same declarations many times without this.
+  llvm::DenseMap<std::pair<const Decl *, const ValueDecl *>, std::string>
+      USRCache;
+
   // MARK: - Initialization
 
   SymbolGraphASTWalker(
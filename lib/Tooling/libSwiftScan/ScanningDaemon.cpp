@@ -0,0 +1,590 @@
+//===------------ ScanningDaemon.cpp - Swift Compiler --------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2025 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Implementation of the dependency scanner daemon: a long-lived service
+// holding the in-memory dependency scanning cache across build-system
+// invocations, accessed over a Unix-domain socket.
+//
+// The wire protocol matches the compiler's plugin-server transport: each
+// message is a little-endian 'uint64_t' payload size followed by the payload.
+// Requests are JSON objects of the form
+//
+//   {"command": "scan", "working_directory": <path>, "argv": [<args>]}
+//   {"command": "reset"}
+//   {"command": "shutdown"}
+//
+// A successful scan reply is the same JSON dependency graph document that
+// 'swift-frontend -scan-dependencies' emits; other replies are either
+// {"status": "ok"} or {"error": <message>}.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift-c/DependencyScan/DependencyScan.h"
+#include "swift/Basic/Defer.h"
+#include "swift/Basic/InitializeSwiftModules.h"
+#include "swift/Basic/LLVMInitialize.h"
+#include "swift/DependencyScan/DependencyScanImpl.h"
+#include "swift/DependencyScan/DependencyScanJSON.h"
+#include "swift/DependencyScan/DependencyScanningTool.h"
+#include "swift/DependencyScan/StringUtils.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/CBindingWrapping.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/Mutex.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <mutex>
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace swift;
+using namespace swift::dependencies;
+
+#if !defined(_WIN32)
+
+//=== Message Framing -----------------------------------------------------===//
+
+static ssize_t readAll(int fd, void *buf, size_t nbyte) {
+  ssize_t bytesToRead = nbyte;
+  void *ptr = buf;
+
+#if defined(SIGPIPE)
+  /// Ignore SIGPIPE while reading.
+  auto *old_handler = signal(SIGPIPE, SIG_IGN);
+  SWIFT_DEFER { signal(SIGPIPE, old_handler); };
+#endif
+
+  while (bytesToRead > 0) {
+    ssize_t readingSize = std::min(ssize_t(INT32_MAX), bytesToRead);
+    ssize_t readSize = ::read(fd, ptr, readingSize);
+    if (readSize <= 0) {
+      // 0: EOF (the peer closed the connection), -1: error.
+      break;
+    }
+    ptr = static_cast<char *>(ptr) + readSize;
+    bytesToRead -= readSize;
+  }
+
+  return nbyte - bytesToRead;
+}
+
+static ssize_t writeAll(int fd, const void *buf, size_t nbyte) {
+  ssize_t bytesToWrite = nbyte;
+  const void *ptr = buf;
+
+#if defined(SIGPIPE)
+  /// Ignore SIGPIPE while writing.
+  auto *old_handler = signal(SIGPIPE, SIG_IGN);
+  SWIFT_DEFER { signal(SIGPIPE, old_handler); };
+#endif
+
+  while (bytesToWrite > 0) {
+    ssize_t writingSize = std::min(ssize_t(INT32_MAX), bytesToWrite);
+    ssize_t writtenSize = ::write(fd, ptr, writingSize);
+    if (writtenSize <= 0) {
+      break;
+    }
+    ptr = static_cast<const char *>(ptr) + writtenSize;
+    bytesToWrite -= writtenSize;
+  }
+  return nbyte - bytesToWrite;
+}
+
+static llvm::Error sendMessage(int fd, llvm::StringRef message) {
+  // Write header (message size).
+  uint64_t header = llvm::support::endian::byte_swap(
+      uint64_t(message.size()), llvm::endianness::little);
+  if (writeAll(fd, &header, sizeof(header)) != sizeof(header))
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "failed to write scanner message header");
+
+  // Write message.
+  if (writeAll(fd, message.data(), message.size()) != ssize_t(message.size()))
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "failed to write scanner message data");
+
+  return llvm::Error::success();
+}
+
+/// The largest framed message either side will accept. Requests are small
+/// command objects and replies are dependency-graph JSON, which tops out in
+/// the tens of megabytes even for very large projects; anything bigger is a
+/// corrupt or hostile header, and honoring it would let any local client make
+/// the daemon allocate arbitrary memory.
+static const uint64_t MaxMessageSize = 256ull << 20;
+
+/// Reads the next framed message, or \c std::nullopt on a clean EOF before
+/// the message header.
+static llvm::Expected<std::optional<std::string>> readMessage(int fd) {
+  // Read header (message size).
+  uint64_t header;
+  ssize_t readSize = readAll(fd, &header, sizeof(header));
+  if (readSize == 0)
+    return std::nullopt;
+  if (readSize != sizeof(header))
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "failed to read scanner message header");
+
+  uint64_t size =
+      llvm::support::endian::read<uint64_t>(&header, llvm::endianness::little);
+  if (size > MaxMessageSize)
+    return llvm::createStringError(
+        llvm::inconvertibleErrorCode(),
+        "scanner message header declares %llu bytes, exceeding the %llu byte "
+        "limit",
+        (unsigned long long)size, (unsigned long long)MaxMessageSize);
+
+  // Read message.
+  std::string message;
+  message.reserve(size);
+  auto sizeToRead = size;
+  while (sizeToRead > 0) {
+    char buffer[4096];
+    readSize =
+        readAll(fd, buffer, std::min(uint64_t(sizeof(buffer)), sizeToRead));
+    if (readSize == 0)
+      return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                     "failed to read scanner message data");
+    sizeToRead -= readSize;
+    message.append(buffer, readSize);
+  }
+
+  return message;
+}
+
+//=== Cache Invalidation --------------------------------------------------===//
+
+namespace {
+/// A snapshot of the modification time and size of a file the cached
+/// dependency information was computed from. Missing files are recorded too,
+/// so that a file appearing later (e.g. a module map materializing in a
+/// search path) also invalidates the cache.
+struct FileSnapshot {
+  uint64_t Size = 0;
+  int64_t ModTimeNanos = -1;
+  bool Exists = false;
+
+  friend bool operator!=(const FileSnapshot &LHS, const FileSnapshot &RHS) {
+    return LHS.Size != RHS.Size || LHS.ModTimeNanos != RHS.ModTimeNanos ||
+           LHS.Exists != RHS.Exists;
+  }
+};
+} // namespace
+
+static FileSnapshot takeFileSnapshot(llvm::StringRef path) {
+  FileSnapshot snapshot;
+  llvm::sys::fs::file_status status;
+  if (llvm::sys::fs::status(path, status))
+    return snapshot;
+  snapshot.Size = status.getSize();
+  snapshot.ModTimeNanos =
+      status.getLastModificationTime().time_since_epoch().count();
+  snapshot.Exists = true;
+  return snapshot;
+}
+
+static void trackFile(swiftscan_string_ref_t path,
+                      llvm::StringMap<FileSnapshot> &trackedFiles) {
+  llvm::StringRef pathRef(c_string_utils::get_C_string(path));
+  if (pathRef.empty())
+    return;
+  if (trackedFiles.contains(pathRef))
+    return;
+  trackedFiles[pathRef] = takeFileSnapshot(pathRef);
+}
+
+/// Record the files each cached dependency was computed from: source files,
+/// interfaces, module maps, and binary modules. These are the inputs whose
+/// change must invalidate the daemon's in-memory cache.
+static void trackGraphFiles(swiftscan_dependency_graph_t graph,
+                            llvm::StringMap<FileSnapshot> &trackedFiles) {
+  for (size_t i = 0; i < graph->dependencies->count; ++i) {
+    auto module = graph->dependencies->modules[i];
+    trackFile(module->module_path, trackedFiles);
+    for (size_t j = 0; j < module->source_files->count; ++j)
+      trackFile(module->source_files->strings[j], trackedFiles);
+
+    auto details = module->details;
+    switch (details->kind) {
+    case SWIFTSCAN_DEPENDENCY_INFO_SWIFT_TEXTUAL:
+      trackFile(details->swift_textual_details.module_interface_path,
+                trackedFiles);
+      trackFile(details->swift_textual_details.bridging_header_path,
+                trackedFiles);
+      break;
+    case SWIFTSCAN_DEPENDENCY_INFO_SWIFT_BINARY:
+      trackFile(details->swift_binary_details.compiled_module_path,
+                trackedFiles);
+      trackFile(details->swift_binary_details.header_dependency, trackedFiles);
+      break;
+    case SWIFTSCAN_DEPENDENCY_INFO_CLANG:
+      trackFile(details->clang_details.module_map_path, trackedFiles);
+      break;
+    }
+  }
+}
+
+static bool anyTrackedFileChanged(
+    const llvm::StringMap<FileSnapshot> &trackedFiles) {
+  for (const auto &entry : trackedFiles)
+    if (takeFileSnapshot(entry.getKey()) != entry.getValue())
+      return true;
+  return false;
+}
+
+//=== Daemon Service ------------------------------------------------------===//
+
+static std::string makeErrorReply(llvm::StringRef message) {
+  llvm::json::Object reply;
+  reply["error"] = message.str();
+  std::string buffer;
+  llvm::raw_string_ostream OS(buffer);
+  OS << llvm::json::Value(std::move(reply));
+  return buffer;
+}
+
+static std::string makeStatusOKReply() {
+  return std::string("{\"status\": \"ok\"}");
+}
+
+namespace {
+/// The daemon-side scanner state: the scanning tool holding the shared
+/// in-memory cache, and the snapshot of files that cache was computed from.
+struct ScannerDaemonState {
+  std::unique_ptr<DependencyScanningTool> Tool =
+      std::make_unique<DependencyScanningTool>();
+  llvm::StringMap<FileSnapshot> TrackedFiles;
+
+  void reset() {
+    Tool = std::make_unique<DependencyScanningTool>();
+    TrackedFiles.clear();
+  }
+};
+} // namespace
+
+static std::string handleScanRequest(ScannerDaemonState &state,
+                                     const llvm::json::Object &request) {
+  const auto *argv = request.getArray("argv");
+  if (!argv)
+    return makeErrorReply("malformed scan request: missing 'argv'");
+  std::string workingDirectory =
+      request.getString("working_directory").value_or("").str();
+
+  std::vector<std::string> argStorage;
+  std::vector<const char *> args;
+  argStorage.reserve(argv->size());
+  for (const auto &arg : *argv) {
+    auto argString = arg.getAsString();
+    if (!argString)
+      return makeErrorReply("malformed scan request: non-string argument");
+    argStorage.push_back(argString->str());
+    args.push_back(argStorage.back().c_str());
+  }
+
+  // If any file the cached state was computed from changed on disk, start
+  // over with a fresh cache rather than serving stale dependencies.
+  if (anyTrackedFileChanged(state.TrackedFiles))
+    state.reset();
+
+  auto scanResult = state.Tool->getDependencies(args, workingDirectory);
+  if (scanResult.getError())
+    return makeErrorReply("dependency scan failed");
+  auto graph = std::move(*scanResult);
+  SWIFT_DEFER { swiftscan_dependency_graph_dispose(graph); };
+  trackGraphFiles(graph, state.TrackedFiles);
+
+  std::string reply;
+  llvm::raw_string_ostream OS(reply);
+  writeJSON(OS, graph);
+  return reply;
+}
+
+/// Serve framed requests on \p connection until the client disconnects or
+/// requests a shutdown. Returns true if a shutdown was requested.
+static bool serveConnection(int connection, ScannerDaemonState &state) {
+  while (true) {
+    auto message = readMessage(connection);
+    if (!message) {
+      llvm::consumeError(message.takeError());
+      return false;
+    }
+    if (!*message)
+      return false;
+
+    std::string reply;
+    bool shutdown = false;
+    auto request = llvm::json::parse(**message);
+    const llvm::json::Object *requestObject =
+        request ? request->getAsObject() : nullptr;
+    if (!requestObject) {
+      llvm::consumeError(request.takeError());
+      reply = makeErrorReply("malformed scanner daemon request");
+    } else {
+      auto command = requestObject->getString("command").value_or("");
+      if (command == "scan") {
+        reply = handleScanRequest(state, *requestObject);
+      } else if (command == "reset") {
+        state.reset();
+        reply = makeStatusOKReply();
+      } else if (command == "shutdown") {
+        reply = makeStatusOKReply();
+        shutdown = true;
+      } else {
+        reply = makeErrorReply("unknown scanner daemon command");
+      }
+    }
+
+    if (auto error = sendMessage(connection, reply)) {
+      llvm::consumeError(std::move(error));
+      return false;
+    }
+    if (shutdown)
+      return true;
+  }
+}
+#endif // !defined(_WIN32)
+
+int swiftscan_scanner_daemon_run(const char *socket_path,
+                                 swiftscan_string_ref_t *error) {
+#if defined(_WIN32)
+  if (error)
+    *error = c_string_utils::create_clone(
+        "the dependency scanner daemon is not supported on this platform");
+  return 1;
+#else
+  {
+    static std::mutex initializationMutex;
+    std::lock_guard<std::mutex> lock(initializationMutex);
+    INITIALIZE_LLVM();
+    if (!swiftModulesInitialized())
+      initializeSwiftModules();
+  }
+
+  llvm::StringRef socketPath(socket_path);
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (socketPath.size() >= sizeof(addr.sun_path)) {
+    if (error)
+      *error = c_string_utils::create_clone(
+          "scanner daemon socket path is too long");
+    return 1;
+  }
+  memcpy(addr.sun_path, socketPath.data(), socketPath.size());
+
+  // Remove a socket left behind by a previous daemon instance.
+  ::unlink(socket_path);
+
+  int listenFD = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listenFD < 0 ||
+      ::bind(listenFD, reinterpret_cast<struct sockaddr *>(&addr),
+             sizeof(addr)) < 0 ||
+      ::listen(listenFD, /*backlog=*/16) < 0) {
+    if (error)
+      *error = c_string_utils::create_clone(
+          std::error_code(errno, std::generic_category()).message().c_str());
+    if (listenFD >= 0)
+      close(listenFD);
+    return 1;
+  }
+
+  ScannerDaemonState state;
+  bool shutdown = false;
+  while (!shutdown) {
+    int connection = ::accept(listenFD, nullptr, nullptr);
+    if (connection < 0)
+      break;
+    shutdown = serveConnection(connection, state);
+    close(connection);
+  }
+
+  close(listenFD);
+  ::unlink(socket_path);
+  return 0;
+#endif
+}
+
+//=== Daemon Client -------------------------------------------------------===//
+
+namespace {
+/// Client connection to a running scanner daemon. A request and its reply
+/// are exchanged under a lock, so a connection may be shared by multiple
+/// scan worker threads.
+class ScanningDaemonConnection {
+  std::string SocketPath;
+  int FD = -1;
+  llvm::sys::SmartMutex<true> ConnectionLock;
+
+public:
+  ScanningDaemonConnection(llvm::StringRef socketPath)
+      : SocketPath(socketPath) {}
+  ~ScanningDaemonConnection() { disconnect(); }
+
+  llvm::Error connect();
+  llvm::Expected<std::string> performRequest(llvm::StringRef request);
+
+private:
+  void disconnect() {
+#if !defined(_WIN32)
+    if (FD >= 0) {
+      close(FD);
+      FD = -1;
+    }
+#endif
+  }
+};
+} // namespace
+
+llvm::Error ScanningDaemonConnection::connect() {
+#if defined(_WIN32)
+  return llvm::createStringError(
+      llvm::inconvertibleErrorCode(),
+      "the dependency scanner daemon is not supported on this platform");
+#else
+  if (FD >= 0)
+    return llvm::Error::success();
+
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (SocketPath.size() >= sizeof(addr.sun_path))
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "scanner daemon socket path is too long: %s",
+                                   SocketPath.c_str());
+  memcpy(addr.sun_path, SocketPath.data(), SocketPath.size());
+
+  int sock = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (sock < 0)
+    return llvm::errorCodeToError(
+        std::error_code(errno, std::generic_category()));
+  if (::connect(sock, reinterpret_cast<struct sockaddr *>(&addr),
+                sizeof(addr)) < 0) {
+    std::error_code ec(errno, std::generic_category());
+    close(sock);
+    return llvm::createStringError(
+        ec, "failed to connect to scanner daemon socket '%s'",
+        SocketPath.c_str());
+  }
+  FD = sock;
+  return llvm::Error::success();
+#endif
+}
+
+llvm::Expected<std::string>
+ScanningDaemonConnection::performRequest(llvm::StringRef request) {
+#if defined(_WIN32)
+  return llvm::createStringError(
+      llvm::inconvertibleErrorCode(),
+      "the dependency scanner daemon is not supported on this platform");
+#else
+  llvm::sys::SmartScopedLock<true> lock(ConnectionLock);
+  if (auto error = connect())
+    return std::move(error);
+
+  if (auto error = sendMessage(FD, request)) {
+    disconnect();
+    return std::move(error);
+  }
+  auto reply = readMessage(FD);
+  if (!reply) {
+    disconnect();
+    return reply.takeError();
+  }
+  if (!*reply) {
+    disconnect();
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "scanner daemon closed the connection");
+  }
+  return std::move(**reply);
+#endif
+}
+
+DEFINE_SIMPLE_CONVERSION_FUNCTIONS(ScanningDaemonConnection,
+                                   swiftscan_scan_daemon_t)
+
+swiftscan_scan_daemon_t swiftscan_scan_daemon_connect(
+    const char *socket_path, swiftscan_string_ref_t *error) {
+  auto connection = std::make_unique<ScanningDaemonConnection>(socket_path);
+  if (auto connectError = connection->connect()) {
+    if (error)
+      *error = c_string_utils::create_clone(
+          llvm::toString(std::move(connectError)).c_str());
+    else
+      llvm::consumeError(std::move(connectError));
+    return nullptr;
+  }
+  return wrap(connection.release());
+}
+
+swiftscan_string_ref_t
+swiftscan_scan_daemon_scan_json(swiftscan_scan_daemon_t daemon,
+                                swiftscan_scan_invocation_t invocation,
+                                swiftscan_string_ref_t *error) {
+  llvm::json::Array argv;
+  for (size_t i = 0; i < invocation->argv->count; ++i)
+    argv.push_back(
+        c_string_utils::get_C_string(invocation->argv->strings[i]));
+  llvm::json::Object request;
+  request["command"] = "scan";
+  request["working_directory"] =
+      c_string_utils::get_C_string(invocation->working_directory);
+  request["argv"] = std::move(argv);
+  std::string requestBuffer;
+  llvm::raw_string_ostream requestOS(requestBuffer);
+  requestOS << llvm::json::Value(std::move(request));
+
+  auto reply = unwrap(daemon)->performRequest(requestBuffer);
+  if (!reply) {
+    if (error)
+      *error = c_string_utils::create_clone(
+          llvm::toString(reply.takeError()).c_str());
+    else
+      llvm::consumeError(reply.takeError());
+    return c_string_utils::create_null();
+  }
+
+  // An error reply is a JSON object carrying a single "error" message.
+  if (auto errorReply = llvm::json::parse(*reply)) {
+    if (const auto *replyObject = errorReply->getAsObject()) {
+      if (auto errorMessage = replyObject->getString("error")) {
+        if (error)
+          *error = c_string_utils::create_clone(errorMessage->str().c_str());
+        return c_string_utils::create_null();
+      }
+    }
+  } else {
+    llvm::consumeError(errorReply.takeError());
+    if (error)
+      *error = c_string_utils::create_clone(
+          "malformed reply from the scanner daemon");
+    return c_string_utils::create_null();
+  }
+
+  return c_string_utils::create_clone(reply->c_str());
+}
+
+void swiftscan_scan_daemon_cache_reset(swiftscan_scan_daemon_t daemon) {
+  auto reply = unwrap(daemon)->performRequest("{\"command\": \"reset\"}");
+  if (!reply)
+    llvm::consumeError(reply.takeError());
+}
+
+void swiftscan_scan_daemon_dispose(swiftscan_scan_daemon_t daemon) {
+  delete unwrap(daemon);
+}
@@ -20,6 +20,10 @@
 #include "TaskPrivate.h"
 #include "swift/ABI/Task.h"
 #include "swift/Runtime/Concurrency.h"
+#if !SWIFT_CONCURRENCY_EMBEDDED
+#include "swift/Threading/Once.h"
+#include "swift/Threading/ThreadLocalStorage.h"
+#endif
 
 #include <stdlib.h>
 
@@ -36,6 +40,124 @@ struct GlobalAllocator {
 
 } // end anonymous namespace
 
+#if SWIFT_CONCURRENCY_EMBEDDED
+
+void *swift::_swift_task_slabAllocate(size_t size) { return malloc(size); }
+
+void swift::_swift_task_slabDeallocate(void *ptr, size_t size) { free(ptr); }
+
+#else
+
+// Most tasks allocate exactly one default-capacity slab and retire it on
+// completion, so under heavy task churn the allocator degenerates into one
+// malloc/free pair per task. Keep a handful of retired default-size slabs
+// per thread and satisfy new slab requests from that cache first. Oversized
+// slabs are rare and go straight to malloc/free.
+namespace {
+
+/// A retired slab in the per-thread cache, linked through its own memory.
+/// Each entry records the length of the list it heads, which bounds the
+/// cache without a separate counter.
+struct CachedSlab {
+  CachedSlab *next;
+  size_t depth;
+};
+
+/// The allocation size of a default-capacity slab, including the slab
+/// header. Only slabs of exactly this size are cached.
+constexpr size_t defaultSlabAllocationSize =
+    TaskAllocator::slabHeaderSize() + SlabCapacity;
+
+static_assert(defaultSlabAllocationSize >= sizeof(CachedSlab),
+              "a cached slab must be able to hold its own list entry");
+
+/// The maximum number of slabs cached per thread; bounds the idle memory
+/// kept by each thread to a few malloc quanta.
+constexpr size_t maxCachedSlabsPerThread = 8;
+
+void freeCachedSlabs(void *head) {
+  auto *slab = static_cast<CachedSlab *>(head);
+  while (slab) {
+    CachedSlab *next = slab->next;
+    free(slab);
+    slab = next;
+  }
+}
+
+#if SWIFT_THREADING_USE_RESERVED_TLS_KEYS
+
+CachedSlab *getSlabCache() {
+  return static_cast<CachedSlab *>(
+      swift::tls_get(swift::tls_key::concurrency_slab_cache));
+}
+
+void setSlabCache(CachedSlab *head) {
+  static swift::once_t token;
+  swift::tls_init_once(token, swift::tls_key::concurrency_slab_cache,
+                       freeCachedSlabs);
+  swift::tls_set(swift::tls_key::concurrency_slab_cache, head);
+}
+
+#elif defined(SWIFT_THREAD_LOCAL)
+
+struct SlabCache {
+  CachedSlab *head = nullptr;
+  ~SlabCache() { freeCachedSlabs(head); }
+};
+
+static SWIFT_THREAD_LOCAL SlabCache slabCache;
+
+CachedSlab *getSlabCache() { return slabCache.head; }
+
+void setSlabCache(CachedSlab *head) { slabCache.head = head; }
+
+#else
+
+tls_key_t getSlabCacheKey() {
+  static swift::tls_key_t key;
+  static swift::once_t token;
+  swift::tls_alloc_once(token, key, freeCachedSlabs);
+  return key;
+}
+
+CachedSlab *getSlabCache() {
+  return static_cast<CachedSlab *>(swift::tls_get(getSlabCacheKey()));
+}
+
+void setSlabCache(CachedSlab *head) {
+  swift::tls_set(getSlabCacheKey(), head);
+}
+
+#endif
+
+} // end anonymous namespace
+
+void *swift::_swift_task_slabAllocate(size_t size) {
+  if (size == defaultSlabAllocationSize) {
+    if (CachedSlab *cached = getSlabCache()) {
+      setSlabCache(cached->next);
+      return cached;
+    }
+  }
+  return malloc(size);
+}
+
+void swift::_swift_task_slabDeallocate(void *ptr, size_t size) {
+  if (size == defaultSlabAllocationSize) {
+    CachedSlab *head = getSlabCache();
+    if (!head || head->depth < maxCachedSlabsPerThread) {
+      auto *cached = static_cast<CachedSlab *>(ptr);
+      cached->next = head;
+      cached->depth = head ? head->depth + 1 : 1;
+      setSlabCache(cached);
+      return;
+    }
+  }
+  free(ptr);
+}
+
+#endif // !SWIFT_CONCURRENCY_EMBEDDED
+
 static TaskAllocator &allocator(AsyncTask *task) {
   if (task)
     return task->Private.get().Allocator;
@@ -35,7 +35,21 @@
 #include <atomic>
 #include <new>
 
+namespace swift {
+/// Obtain backing memory for a task allocator slab of \p size bytes
+/// (including the slab header), preferring the per-thread slab cache over
+/// malloc. Defined in TaskAlloc.cpp.
+void *_swift_task_slabAllocate(size_t size);
+/// Return slab memory obtained from _swift_task_slabAllocate, either to the
+/// per-thread slab cache or to malloc.
+void _swift_task_slabDeallocate(void *ptr, size_t size);
+}
+
 #define SWIFT_FATAL_ERROR swift_Concurrency_fatalError
+#define SWIFT_STACK_ALLOCATOR_SLAB_MALLOC(size)                                \
+  ::swift::_swift_task_slabAllocate(size)
+#define SWIFT_STACK_ALLOCATOR_SLAB_FREE(ptr, size)                             \
+  ::swift::_swift_task_slabDeallocate(ptr, size)
 #include "../runtime/StackAllocator.h"
 
 namespace swift {
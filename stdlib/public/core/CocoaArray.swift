@@ -90,10 +90,10 @@ internal struct _CocoaArrayWrapper: RandomAccessCollection {
     
     let base = unsafe UnsafeMutableRawPointer(result.firstElementAddress)
       .assumingMemoryBound(to: AnyObject.self)
-      
-    for idx in 0..<boundsCount {
-      unsafe (base + idx).initialize(to: core.objectAt(idx + bounds.lowerBound))
-    }
+
+    // Fetch the references in bulk with getObjects(_:range:) rather than one
+    // objectAt(_:) message (and autoreleased return) per element.
+    _ = unsafe _copyContents(subRange: bounds, initializing: base)
 
     return _SliceBuffer(_buffer: result, shiftedToStartIndex: bounds.lowerBound)
   }
@@ -115,14 +115,20 @@ internal func validateUTF8(_ buf: UnsafeBufferPointer<UInt8>) -> UTF8ValidationR
     return .success(UTF8ExtraInfo(isASCII: true))
   }
 
-  var iter = unsafe buf.makeIterator()
+  var index = buf.startIndex
   var lastValidIndex = buf.startIndex
 
+  @inline(__always) func next() -> UInt8? {
+    guard index < buf.endIndex else { return nil }
+    defer { index &+= 1 }
+    return unsafe buf[index]
+  }
+
   @inline(__always) func guarantee(
     _ f: (UInt8) -> Bool,
     _ err: _UTF8EncodingErrorKind
   ) throws(_UTF8EncodingErrorKind) {
-    guard let cu = unsafe iter.next() else {
+    guard let cu = next() else {
       throw .truncatedScalar
     }
     guard f(cu) else {
@@ -213,9 +219,25 @@ internal func validateUTF8(_ buf: UnsafeBufferPointer<UInt8>) -> UTF8ValidationR
 
      "Contin" is any continuation byte, i.e. 80..BF or 10xxxxxx
      */
+    let asciiMask = UInt(truncatingIfNeeded: 0x8080_8080_8080_8080 as UInt64)
     var isASCII = true
-    while let cu = unsafe iter.next() {
-      if UTF8.isASCII(cu) { lastValidIndex &+= 1; continue }
+    while let cu = next() {
+      if UTF8.isASCII(cu) {
+        lastValidIndex &+= 1
+        // Skip ahead over the rest of an ASCII run a word at a time. A single
+        // non-ASCII byte anywhere in the buffer defeats the _allASCII fast
+        // path above, and mixed content (markup, JSON) would otherwise pay
+        // for its long ASCII stretches byte by byte.
+        while index &+ MemoryLayout<UInt>.size <= buf.endIndex {
+          let word = unsafe UnsafeRawPointer(
+            buf.baseAddress.unsafelyUnwrapped
+          ).loadUnaligned(fromByteOffset: index, as: UInt.self)
+          guard word & asciiMask == 0 else { break }
+          index &+= MemoryLayout<UInt>.size
+          lastValidIndex &+= MemoryLayout<UInt>.size
+        }
+        continue
+      }
       isASCII = false
       if _slowPath(!_isUTF8MultiByteLeading(cu)) {
         throw _diagnoseInvalidUTF8MultiByteLeading(cu)
@@ -19,6 +19,7 @@
 #include "swift/Basic/Unreachable.h"
 #include "swift/Demangling/Demangle.h"
 #include "swift/Runtime/Casting.h"
+#include "swift/Runtime/Concurrent.h"
 #include "swift/Runtime/Config.h"
 #include "swift/Runtime/Debug.h"
 #include "swift/Runtime/Enum.h"
@@ -397,10 +398,75 @@ missing_reflection_metadata_warning(const char *fmt, ...) {
   warningv(0, fmt, args);
 }
 
+namespace {
+
+struct FieldCacheKey {
+  const Metadata *type;
+  unsigned index;
+
+  friend llvm::hash_code hash_value(const FieldCacheKey &key) {
+    return llvm::hash_combine(key.type, key.index);
+  }
+};
+
+/// A resolved field name and type for a (type metadata, field index) pair.
+/// Resolving a field means demangling its mangled type name and running a
+/// metadata lookup, and mirroring the same type repeatedly would otherwise
+/// redo that for every field on every Mirror. The name points into the
+/// image's reflection strings and the field's metadata is process-lifetime
+/// stable, so entries are never invalidated.
+struct FieldCacheEntry {
+  const Metadata *type;
+  unsigned index;
+
+  StringRef name;
+  FieldType fieldInfo;
+
+  FieldCacheEntry(FieldCacheKey key, StringRef name, FieldType fieldInfo)
+      : type(key.type), index(key.index), name(name), fieldInfo(fieldInfo) {}
+
+  bool matchesKey(const FieldCacheKey &key) {
+    return type == key.type && index == key.index;
+  }
+
+  friend llvm::hash_code hash_value(const FieldCacheEntry &value) {
+    return hash_value(FieldCacheKey{value.type, value.index});
+  }
+
+  static size_t getExtraAllocationSize(FieldCacheKey key, StringRef name,
+                                       FieldType fieldInfo) {
+    return 0;
+  }
+
+  size_t getExtraAllocationSize() const { return 0; }
+};
+
+} // end anonymous namespace
+
+static ConcurrentReadableHashMap<FieldCacheEntry> FieldCache;
+
+static void cacheFieldAt(const Metadata *base, unsigned index, StringRef name,
+                         FieldType fieldInfo) {
+  FieldCacheKey key{base, index};
+  FieldCache.getOrInsert(key, [&](FieldCacheEntry *entry, bool created) {
+    if (created)
+      ::new (entry) FieldCacheEntry(key, name, fieldInfo);
+    return true; // Keep the new entry.
+  });
+}
+
 static std::pair<StringRef /*name*/, FieldType /*fieldInfo*/>
 getFieldAt(const Metadata *base, unsigned index) {
   using namespace reflection;
-  
+
+  // Check the cache first.
+  {
+    auto snapshot = FieldCache.snapshot();
+    if (const FieldCacheEntry *entry =
+            snapshot.find(FieldCacheKey{base, index}))
+      return {entry->name, entry->fieldInfo};
+  }
+
   // If we failed to find the field descriptor metadata for the type, fall
   // back to returning an empty tuple as a standin.
   auto failedToFindMetadata = [&]() -> std::pair<StringRef, FieldType> {
@@ -426,8 +492,11 @@ getFieldAt(const Metadata *base, unsigned index) {
   auto name = field.getFieldName();
 
   // Enum cases don't always have types.
-  if (!field.hasMangledTypeName())
-    return {name, FieldType::untypedEnumCase(field.isIndirectCase())};
+  if (!field.hasMangledTypeName()) {
+    auto fieldInfo = FieldType::untypedEnumCase(field.isIndirectCase());
+    cacheFieldAt(base, index, name, fieldInfo);
+    return {name, fieldInfo};
+  }
 
   auto typeName = field.getMangledTypeName();
 
@@ -465,6 +534,10 @@ getFieldAt(const Metadata *base, unsigned index) {
   fieldType.setIndirect(field.isIndirectCase());
   fieldType.setReferenceOwnership(typeInfo.getReferenceOwnership());
   fieldType.setIsVar(field.isVar());
+  // Don't cache failed demanglings, so that the field stays visible to
+  // reflection metadata registered later (and keeps warning until then).
+  if (!result.isError())
+    cacheFieldAt(base, index, name, fieldType);
   return {name, fieldType};
 }
 
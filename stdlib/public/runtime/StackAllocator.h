@@ -33,6 +33,15 @@
 #define SWIFT_FATAL_ERROR swift::fatalError
 #endif
 
+// Slab memory is obtained from and returned to these hooks, which a client
+// can override before including this file (like SWIFT_FATAL_ERROR above).
+// The task allocator overrides them to recycle slabs through a per-thread
+// cache. Both receive the full slab size, including the slab header.
+#ifndef SWIFT_STACK_ALLOCATOR_SLAB_MALLOC
+#define SWIFT_STACK_ALLOCATOR_SLAB_MALLOC(size) malloc(size)
+#define SWIFT_STACK_ALLOCATOR_SLAB_FREE(ptr, size) free(ptr)
+#endif
+
 namespace swift {
 
 /// A bump-pointer allocator that obeys a stack discipline.
@@ -251,7 +260,8 @@ private:
     }
     size_t capacity = std::max(SlabCapacity,
                                Allocation::includingHeader(size));
-    void *slabBuffer = malloc(Slab::includingHeader(capacity));
+    void *slabBuffer =
+        SWIFT_STACK_ALLOCATOR_SLAB_MALLOC(Slab::includingHeader(capacity));
     Slab *newSlab = ::new (slabBuffer) Slab(capacity);
     if (slab)
       slab->next = newSlab;
@@ -270,7 +280,8 @@ private:
       Slab *next = slab->next;
       freedCapacity += slab->capacity;
       slab->clearMetadata();
-      free(slab);
+      SWIFT_STACK_ALLOCATOR_SLAB_FREE(slab,
+                                      Slab::includingHeader(slab->capacity));
       numAllocatedSlabs--;
       slab = next;
     }
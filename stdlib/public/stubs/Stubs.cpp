@@ -394,6 +394,131 @@ static inline void _swift_set_errno(int to) {
 #endif
 }
 
+namespace {
+
+// Limits within which a decimal form m * 10^e converts to a binary float
+// with a single exactly-rounded operation (Clinger's fast path): both m and
+// 10^|e| must be exactly representable, so one multiply or divide yields the
+// correctly rounded result under round-to-nearest.
+template <typename T> struct ExactFloatParseTraits;
+
+template <> struct ExactFloatParseTraits<double> {
+  static constexpr uint64_t maxExactMantissa = uint64_t(1) << 53;
+  static constexpr int maxExactExponent = 22;
+  static const double powersOfTen[maxExactExponent + 1];
+};
+const double ExactFloatParseTraits<double>::powersOfTen[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+template <> struct ExactFloatParseTraits<float> {
+  static constexpr uint64_t maxExactMantissa = uint64_t(1) << 24;
+  static constexpr int maxExactExponent = 10;
+  static const float powersOfTen[maxExactExponent + 1];
+};
+const float ExactFloatParseTraits<float>::powersOfTen[] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+// Parse the longest valid plain decimal prefix of \p nptr, matching strtod's
+// prefix rules. Returns false — leaving the conversion to the libc fallback —
+// for anything outside the exactly-representable envelope above or any form
+// the scan doesn't recognize (whitespace, hex, infinity/NaN, long digit
+// strings, out-of-range exponents).
+template <typename T>
+bool _swift_parseDecimalFloatExact(const char *nptr, T *outResult,
+                                   const char **outEnd) {
+  using Traits = ExactFloatParseTraits<T>;
+  const char *p = nptr;
+
+  bool negative = (*p == '-');
+  if (*p == '-' || *p == '+')
+    ++p;
+
+  // Leave hexadecimal forms to the fallback.
+  if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+    return false;
+
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int fractionDigits = 0;
+  bool sawDigit = false;
+
+  while (*p >= '0' && *p <= '9') {
+    sawDigit = true;
+    if (digits == 19)
+      return false;
+    mantissa = mantissa * 10 + uint64_t(*p - '0');
+    if (mantissa != 0)
+      ++digits;
+    ++p;
+  }
+
+  if (*p == '.') {
+    const char *fraction = p + 1;
+    while (*fraction >= '0' && *fraction <= '9') {
+      sawDigit = true;
+      if (digits == 19)
+        return false;
+      mantissa = mantissa * 10 + uint64_t(*fraction - '0');
+      if (mantissa != 0)
+        ++digits;
+      ++fractionDigits;
+      ++fraction;
+    }
+    // strtod consumes a trailing radix point ("1." parses as 1), but a lone
+    // "." is not a number.
+    if (sawDigit)
+      p = fraction;
+  }
+
+  if (!sawDigit)
+    return false;
+
+  int exponent = 0;
+  if (*p == 'e' || *p == 'E') {
+    const char *exponentDigits = p + 1;
+    bool exponentNegative = (*exponentDigits == '-');
+    if (*exponentDigits == '-' || *exponentDigits == '+')
+      ++exponentDigits;
+    if (*exponentDigits >= '0' && *exponentDigits <= '9') {
+      int value = 0;
+      while (*exponentDigits >= '0' && *exponentDigits <= '9') {
+        if (value < 10000)
+          value = value * 10 + (*exponentDigits - '0');
+        ++exponentDigits;
+      }
+      exponent = exponentNegative ? -value : value;
+      p = exponentDigits;
+    }
+    // An 'e' not followed by digits is not part of the number; the number
+    // ends just before it.
+  }
+
+  int e10 = exponent - fractionDigits;
+  if (mantissa > Traits::maxExactMantissa)
+    return false;
+  if (e10 < -Traits::maxExactExponent || e10 > Traits::maxExactExponent)
+    return false;
+
+  T value = static_cast<T>(mantissa);
+  if (e10 < 0)
+    value /= Traits::powersOfTen[-e10];
+  else
+    value *= Traits::powersOfTen[e10];
+  *outResult = negative ? -value : value;
+  *outEnd = p;
+  return true;
+}
+
+// long double and __fp16 have no fast path; __fp16 converts via float and
+// picks it up there.
+bool _swift_parseDecimalFloatExact(const char *nptr, long double *outResult,
+                                   const char **outEnd) {
+  return false;
+}
+
+} // end anonymous namespace
+
 // We can't return Float80, but we can receive a pointer to one, so
 // switch the return type and the out parameter on strtold.
 template <typename T>
@@ -414,6 +539,13 @@ static const char *_swift_stdlib_strtoX_impl(
     return nptr + std::strlen(nptr);
   }
 
+  // Common decimal forms convert with one exactly-rounded operation; only
+  // hard cases (long digit strings, extreme exponents, hex, inf/NaN) pay for
+  // the libc conversion below.
+  const char *FastEndPtr;
+  if (_swift_parseDecimalFloatExact(nptr, outResult, &FastEndPtr))
+    return FastEndPtr;
+
   char *EndPtr;
   _swift_set_errno(0);
 #if SWIFT_STDLIB_HAS_LOCALE
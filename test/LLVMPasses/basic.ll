@@ -25,6 +25,7 @@ declare ptr @swift_retainUnowned(ptr returned)
 declare void @user(ptr) nounwind
 declare void @user_objc(ptr) nounwind
 declare void @unknown_func()
+declare void @readonly_func(ptr) readonly nounwind
 
 define private void @__swift_fixLifetime(ptr) noinline nounwind {
 entry:
@@ -95,6 +96,37 @@ define void @retain_motion1(ptr %A) {
   ret void
 }
 
+; retain_motion_readonly_call - A call to a function that doesn't write to
+; memory can't release, so a retain can move across it.  With LTO, the
+; readonly attribute may come from inference across module boundaries.
+
+; CHECK-LABEL: @retain_motion_readonly_call(
+; CHECK-NEXT: call void @readonly_func
+; CHECK-NEXT: ret void
+
+define void @retain_motion_readonly_call(ptr %A) {
+  tail call ptr @swift_retain(ptr %A)
+  call void @readonly_func(ptr %A)
+  tail call void @swift_release(ptr %A) nounwind
+  ret void
+}
+
+; no_retain_motion_unknown_call - A call without memory attributes might
+; release the object, so the retain cannot move over it.
+
+; CHECK-LABEL: @no_retain_motion_unknown_call(
+; CHECK: call ptr @swift_retain
+; CHECK-NEXT: call void @unknown_func
+; CHECK-NEXT: call void @swift_release
+; CHECK-NEXT: ret void
+
+define void @no_retain_motion_unknown_call(ptr %A) {
+  tail call ptr @swift_retain(ptr %A)
+  call void @unknown_func()
+  tail call void @swift_release(ptr %A) nounwind
+  ret void
+}
+
 ; rdar://11583269 - Optimize out objc_retain/release(null)
 
 ; CHECK-LABEL: @objc_retain_release_null(
@@ -297,6 +329,26 @@ define void @remove_redundant_check_unowned(ptr %A, ptr %B, ptr %C) {
   ret void
 }
 
+; CHECK-LABEL: @remove_check_unowned_across_readonly_call
+; CHECK-NEXT: load
+; CHECK-NEXT: call void @swift_checkUnowned
+; CHECK-NEXT: call void @readonly_func
+; CHECK-NEXT: load
+; CHECK-NEXT: ret
+define void @remove_check_unowned_across_readonly_call(ptr %A, ptr %C) {
+  tail call ptr @swift_retainUnowned(ptr %A)
+  %L1 = load i64, ptr %A, align 8
+  tail call void @swift_release(ptr %A)
+
+  ; Cannot write to memory, so cannot do a release.
+  call void @readonly_func(ptr %C)
+
+  tail call ptr @swift_retainUnowned(ptr %A)
+  %L3 = load i64, ptr %A, align 8
+  tail call void @swift_release(ptr %A)
+  ret void
+}
+
 ; CHECK-LABEL: @dont_remove_redundant_check_unowned
 ; CHECK-NEXT: load
 ; CHECK-NEXT: call void @swift_checkUnowned
@@ -37,6 +37,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include <deque>
 
 using namespace SourceKit;
 using namespace swift;
@@ -424,8 +425,13 @@ public:
     return Cost;
   }
 
-  /// Schedule building this AST on the given \p Queue.
-  void schedule(WorkQueue Queue);
+  /// Schedule building this AST at the given \p Priority on the manager's
+  /// AST build queue.
+  void schedule(ASTBuildPriority Priority);
+
+  /// Build the AST and inform all attached consumers of the result. Must be
+  /// executed on the manager's serial AST build queue.
+  void execute();
 
   /// Inform the given \p Consumer when the AST has been built. If the build
   /// operation has already built the AST, the consumer is directly informed.
@@ -513,10 +519,11 @@ public:
 
   /// Schedules the given \p Consumer to the latest suitable build operation.
   /// Independently of what happens, the consumer will receive either a \c
-  /// cancelled, \c failed or \c handlePrimaryAST callback.
+  /// cancelled, \c failed or \c handlePrimaryAST callback. If no suitable
+  /// build operation exists, a new one is scheduled at \p Priority.
   void enqueueConsumer(SwiftASTConsumerRef Consumer,
                        IntrusiveRefCntPtr<llvm::vfs::FileSystem> FileSystem,
-                       SwiftASTManagerRef Mgr);
+                       SwiftASTManagerRef Mgr, ASTBuildPriority Priority);
 
   /// Cancel all currently running build operations.
   void cancelAllBuilds();
@@ -611,10 +618,33 @@ struct SwiftASTManager::Implementation {
   std::vector<ScheduledConsumer> ScheduledConsumers;
 
   /// Queue guaranteeing that only one \c ASTBuildOperation builds an AST at a
-  /// time.
+  /// time. Jobs on this queue don't execute a fixed operation; they pick the
+  /// highest-priority entry from the pending deques below, so an interactive
+  /// build can overtake background builds scheduled before it.
   WorkQueue ASTBuildQueue{ WorkQueue::Dequeuing::Serial,
                            "sourcekit.swift.ASTBuilding" };
 
+  /// Build operations that have been scheduled but have not started building
+  /// yet, bucketed by \c ASTBuildPriority, oldest first. Guarded by \c
+  /// PendingASTBuildsMtx. Every entry has exactly one matching drain job on
+  /// \c ASTBuildQueue, so the two deques are never both empty when a drain
+  /// job runs.
+  llvm::sys::Mutex PendingASTBuildsMtx;
+  std::deque<ASTBuildOperationRef> PendingInteractiveASTBuilds;
+  std::deque<ASTBuildOperationRef> PendingBackgroundASTBuilds;
+
+  /// If \p BuildOp is still waiting to start at \c Background priority,
+  /// requeue it at \c Interactive priority. Called when an interactive
+  /// consumer attaches to a build that was scheduled by a batch request.
+  void promoteASTBuildToInteractive(const ASTBuildOperationRef &BuildOp) {
+    llvm::sys::ScopedLock L(PendingASTBuildsMtx);
+    auto It = llvm::find(PendingBackgroundASTBuilds, BuildOp);
+    if (It == PendingBackgroundASTBuilds.end())
+      return;
+    PendingBackgroundASTBuilds.erase(It);
+    PendingInteractiveASTBuilds.push_back(BuildOp);
+  }
+
   /// Queue on which consumers may be notified about results and cancellation.
   /// This is essentially just a background queue to which we can jump to inform
   /// consumers while making sure that no locks are currently claimed.
@@ -788,7 +818,8 @@ SwiftInvocationRef SwiftASTManager::getTypecheckInvocation(
 void SwiftASTManager::processASTAsync(
     SwiftInvocationRef InvokRef, SwiftASTConsumerRef ASTConsumer,
     const void *OncePerASTToken, SourceKitCancellationToken CancellationToken,
-    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem) {
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem,
+    ASTBuildPriority Priority) {
   assert(fileSystem);
   ASTProducerRef Producer = Impl.getOrCreateASTProducer(InvokRef);
 
@@ -810,7 +841,8 @@ void SwiftASTManager::processASTAsync(
     Impl.ScheduledConsumers.push_back({ASTConsumer, OncePerASTToken});
   }
 
-  Producer->enqueueConsumer(ASTConsumer, fileSystem, shared_from_this());
+  Producer->enqueueConsumer(ASTConsumer, fileSystem, shared_from_this(),
+                            Priority);
 
   auto WeakConsumer = SwiftASTConsumerWeakRef(ASTConsumer);
   auto WeakThis = std::weak_ptr<SwiftASTManager>(shared_from_this());
@@ -1227,57 +1259,87 @@ ASTUnitRef ASTBuildOperation::buildASTUnit(std::string &Error) {
   return ASTRef;
 }
 
-void ASTBuildOperation::schedule(WorkQueue Queue) {
+void ASTBuildOperation::schedule(ASTBuildPriority Priority) {
   transitionToState(State::Queued, /*ExpectedOldState=*/State::Created);
-  auto SharedThis = shared_from_this();
-  // Capture `SharedThis` in the dispatched lambda to keep `this` alive.
-  // Capture `this` for a more convenient access of members.
-  Queue.dispatch(
-      [this, SharedThis] {
-        transitionToState(State::Running, /*ExpectedOldState=*/State::Queued);
-
-        SWIFT_DEFER {
-          transitionToState(State::Finished,
-                            /*ExpectedOldState=*/State::Running);
-        };
-
-        SmallVector<SwiftASTConsumerRef, 4> ConsumersToCancel;
+  auto &MgrImpl = ASTManager->Impl;
+  {
+    llvm::sys::ScopedLock L(MgrImpl.PendingASTBuildsMtx);
+    auto &Pending = (Priority == ASTBuildPriority::Interactive)
+                        ? MgrImpl.PendingInteractiveASTBuilds
+                        : MgrImpl.PendingBackgroundASTBuilds;
+    Pending.push_back(shared_from_this());
+  }
+  // One drain job is dispatched per scheduled operation, so whenever a drain
+  // job runs there is at least one pending operation to pick up. The drain
+  // job always takes the oldest interactive build first, which lets
+  // interactive builds overtake background builds scheduled before them. The
+  // job is not tied to the operation that scheduled it; the shared pointer
+  // popped from the pending deques keeps whichever operation it executes
+  // alive.
+  MgrImpl.ASTBuildQueue.dispatch(
+      [Mgr = ASTManager] {
+        ASTBuildOperationRef Next;
         {
-          llvm::sys::ScopedLock L(ConsumersAndResultMtx);
-          if (Consumers.empty()) {
-            // There are no consumers - no point creating the AST anymore.
-            Result.emplace(/*AST=*/nullptr, /*Error=*/"", /*Cancelled=*/true);
-            return;
-          }
-          if (CancellationFlag->load(std::memory_order_relaxed)) {
-            assert(false && "We should only set the cancellation flag if there "
-                            "are no more consumers");
-            ConsumersToCancel = Consumers;
+          llvm::sys::ScopedLock L(Mgr->Impl.PendingASTBuildsMtx);
+          if (!Mgr->Impl.PendingInteractiveASTBuilds.empty()) {
+            Next = Mgr->Impl.PendingInteractiveASTBuilds.front();
+            Mgr->Impl.PendingInteractiveASTBuilds.pop_front();
+          } else {
+            assert(!Mgr->Impl.PendingBackgroundASTBuilds.empty() &&
+                   "Drain jobs and pending builds must be in 1:1 "
+                   "correspondence");
+            Next = Mgr->Impl.PendingBackgroundASTBuilds.front();
+            Mgr->Impl.PendingBackgroundASTBuilds.pop_front();
           }
         }
-        for (auto &Consumer : ConsumersToCancel) {
-          Consumer->cancelled();
-        }
-
-        std::string Error;
-        assert(!Result && "We should only be producing a result once");
-        ASTUnitRef AST = buildASTUnit(Error);
-        SmallVector<SwiftASTConsumerRef, 4> ConsumersToInform;
-        {
-          llvm::sys::ScopedLock L(ConsumersAndResultMtx);
-          bool WasCancelled = CancellationFlag->load(std::memory_order_relaxed);
-          Result.emplace(AST, Error, WasCancelled);
-          ConsumersToInform = Consumers;
-          Consumers = {};
-        }
-        for (auto &Consumer : ConsumersToInform) {
-          informConsumer(Consumer);
-        }
-        DidFinishCallback();
+        Next->execute();
       },
       /*isStackDeep=*/true);
 }
 
+void ASTBuildOperation::execute() {
+  transitionToState(State::Running, /*ExpectedOldState=*/State::Queued);
+
+  SWIFT_DEFER {
+    transitionToState(State::Finished,
+                      /*ExpectedOldState=*/State::Running);
+  };
+
+  SmallVector<SwiftASTConsumerRef, 4> ConsumersToCancel;
+  {
+    llvm::sys::ScopedLock L(ConsumersAndResultMtx);
+    if (Consumers.empty()) {
+      // There are no consumers - no point creating the AST anymore.
+      Result.emplace(/*AST=*/nullptr, /*Error=*/"", /*Cancelled=*/true);
+      return;
+    }
+    if (CancellationFlag->load(std::memory_order_relaxed)) {
+      assert(false && "We should only set the cancellation flag if there "
+                      "are no more consumers");
+      ConsumersToCancel = Consumers;
+    }
+  }
+  for (auto &Consumer : ConsumersToCancel) {
+    Consumer->cancelled();
+  }
+
+  std::string Error;
+  assert(!Result && "We should only be producing a result once");
+  ASTUnitRef AST = buildASTUnit(Error);
+  SmallVector<SwiftASTConsumerRef, 4> ConsumersToInform;
+  {
+    llvm::sys::ScopedLock L(ConsumersAndResultMtx);
+    bool WasCancelled = CancellationFlag->load(std::memory_order_relaxed);
+    Result.emplace(AST, Error, WasCancelled);
+    ConsumersToInform = Consumers;
+    Consumers = {};
+  }
+  for (auto &Consumer : ConsumersToInform) {
+    informConsumer(Consumer);
+  }
+  DidFinishCallback();
+}
+
 bool ASTBuildOperation::addConsumer(SwiftASTConsumerRef Consumer) {
   {
     llvm::sys::ScopedLock L(ConsumersAndResultMtx);
@@ -1370,12 +1432,12 @@ void ASTProducer::cancelAllBuilds() {
 void ASTProducer::enqueueConsumer(
     SwiftASTConsumerRef Consumer,
     IntrusiveRefCntPtr<llvm::vfs::FileSystem> FileSystem,
-    SwiftASTManagerRef Mgr) {
+    SwiftASTManagerRef Mgr, ASTBuildPriority Priority) {
   // Enqueue the consumer in the background because getBuildOperationForConsumer
   // consults the file system and might be slow. Also, there's no need to do
   // this synchronously since all results will be delivered async anyway.
   auto This = shared_from_this();
-  BuildOperationsQueue.dispatch([Consumer, FileSystem, Mgr, This]() {
+  BuildOperationsQueue.dispatch([Consumer, FileSystem, Mgr, This, Priority]() {
     // The passed in filesystem does not have overlays resolved. Make sure to
     // do so before performing any file operations.
     llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS = FileSystem;
@@ -1397,7 +1459,12 @@ void ASTProducer::enqueueConsumer(
         // getBuildOperationForConsumer but before the consumer could be
         // added. This should be an absolute edge case. Let's just try
         // again.
-        This->enqueueConsumer(Consumer, FS, Mgr);
+        This->enqueueConsumer(Consumer, FS, Mgr, Priority);
+      } else if (Priority == ASTBuildPriority::Interactive) {
+        // An interactive consumer shouldn't have to wait for batch builds
+        // just because the build it joined was originally scheduled by a
+        // batch request.
+        Mgr->Impl.promoteASTBuildToInteractive(BuildOp);
       }
     } else {
       auto WeakThis = std::weak_ptr<ASTProducer>(This);
@@ -1418,7 +1485,7 @@ void ASTProducer::enqueueConsumer(
       assert(WasAdded && "Consumer wasn't added to a new build operation "
                          "that can't have been cancelled yet?");
       (void)WasAdded;
-      NewBuildOp->schedule(Mgr->Impl.ASTBuildQueue);
+      NewBuildOp->schedule(Priority);
     }
   });
 }
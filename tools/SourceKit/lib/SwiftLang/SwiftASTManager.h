@@ -251,6 +251,22 @@ public:
 typedef std::shared_ptr<SwiftASTConsumer> SwiftASTConsumerRef;
 typedef std::weak_ptr<SwiftASTConsumer> SwiftASTConsumerWeakRef;
 
+/// The scheduling class of an AST build.
+///
+/// Only one AST is built at a time, so a long build scheduled by a batch
+/// request (e.g. indexing) would otherwise delay every build scheduled after
+/// it. Builds requested at \c Interactive priority are picked before any
+/// waiting \c Background build, independently of the order in which they were
+/// scheduled. The priority only affects the order in which waiting builds are
+/// started; it does not preempt a build that is already running (a running
+/// build can still be cancelled cooperatively if all its consumers go away).
+enum class ASTBuildPriority {
+  /// The user is waiting on the result (cursor info, diagnostics, ...).
+  Interactive,
+  /// A batch operation that tolerates latency, like background indexing.
+  Background
+};
+
 class SwiftASTManager : public std::enable_shared_from_this<SwiftASTManager> {
 public:
   explicit SwiftASTManager(std::shared_ptr<SwiftEditorDocumentFileMap>,
@@ -278,11 +294,16 @@ public:
   /// \param OncePerASTToken if non-null, a previous query with the same value
   /// token, that is enqueued waiting to be executed on the same AST, will be
   /// cancelled.
+  /// \param Priority determines whether a new AST build may overtake builds
+  /// scheduled earlier by batch requests. If an interactive consumer attaches
+  /// to a build that is still waiting at \c Background priority, the build is
+  /// promoted to \c Interactive.
   void
   processASTAsync(SwiftInvocationRef Invok, SwiftASTConsumerRef ASTConsumer,
                   const void *OncePerASTToken,
                   SourceKitCancellationToken CancellationToken,
-                  llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem);
+                  llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem,
+                  ASTBuildPriority Priority = ASTBuildPriority::Interactive);
 
   std::unique_ptr<llvm::MemoryBuffer>
   getMemoryBuffer(StringRef Filename,
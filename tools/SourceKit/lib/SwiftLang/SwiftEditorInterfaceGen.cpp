@@ -25,6 +25,8 @@
 #include "swift/Parse/ParseVersion.h"
 #include "swift/Strings.h"
 
+#include "llvm/Support/Chrono.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/ConvertUTF.h"
 
@@ -79,6 +81,15 @@ public:
   bool IsModule = false;
   std::string ModuleOrHeaderName;
   CompilerInvocation Invocation;
+  // The options the interface text was generated with and a stamp of the
+  // module file it was generated from, used to decide whether this context
+  // can be replayed for a later interface-open request without regenerating
+  // the whole interface (see canReuseEditorInfo()).
+  std::optional<std::string> GroupName;
+  bool SynthesizedExtensions = false;
+  std::optional<std::string> InterestedUSR;
+  std::string ModuleFilePath;
+  llvm::sys::TimePoint<> ModuleFileMTime;
   PrintingDiagnosticConsumer DiagConsumer;
   CompilerInstance Instance;
   ModuleDecl *Mod = nullptr;
@@ -489,6 +500,23 @@ SwiftInterfaceGenContextRef SwiftInterfaceGenContext::create(
     if (getModuleInterfaceInfo(Ctx, ModuleOrHeaderName, Group, IFaceGenCtx->Impl,
                                ErrMsg, SynthesizedExtensions, InterestedUSR))
       return nullptr;
+    // Record what the text was generated from so that a later interface-open
+    // request for the same module can replay this context instead of
+    // regenerating the interface.
+    if (Group)
+      IFaceGenCtx->Impl.GroupName = Group->str();
+    IFaceGenCtx->Impl.SynthesizedExtensions = SynthesizedExtensions;
+    if (InterestedUSR)
+      IFaceGenCtx->Impl.InterestedUSR = InterestedUSR->str();
+    if (ModuleDecl *Mod = IFaceGenCtx->Impl.Mod) {
+      StringRef ModuleFile = Mod->getModuleFilename();
+      llvm::sys::fs::file_status Status;
+      if (!ModuleFile.empty() &&
+          !llvm::sys::fs::status(ModuleFile, Status)) {
+        IFaceGenCtx->Impl.ModuleFilePath = ModuleFile.str();
+        IFaceGenCtx->Impl.ModuleFileMTime = Status.getLastModificationTime();
+      }
+    }
   } else {
     auto &FEOpts = Invocation.getFrontendOptions();
     if (FEOpts.ImplicitObjCHeaderPath.empty()) {
@@ -619,6 +647,33 @@ bool SwiftInterfaceGenContext::matches(StringRef ModuleName,
   return true;
 }
 
+bool SwiftInterfaceGenContext::canReuseEditorInfo(
+    std::optional<StringRef> Group, bool SynthesizedExtensions,
+    std::optional<StringRef> InterestedUSR) const {
+  auto asOptString =
+      [](std::optional<StringRef> Val) -> std::optional<std::string> {
+    if (!Val)
+      return std::nullopt;
+    return Val->str();
+  };
+  if (asOptString(Group) != Impl.GroupName)
+    return false;
+  if (SynthesizedExtensions != Impl.SynthesizedExtensions)
+    return false;
+  if (asOptString(InterestedUSR) != Impl.InterestedUSR)
+    return false;
+  // If the module file this interface was generated from changed on disk,
+  // the text is stale and needs to be regenerated.
+  if (!Impl.ModuleFilePath.empty()) {
+    llvm::sys::fs::file_status Status;
+    if (llvm::sys::fs::status(Impl.ModuleFilePath, Status))
+      return false;
+    if (Status.getLastModificationTime() != Impl.ModuleFileMTime)
+      return false;
+  }
+  return true;
+}
+
 void SwiftInterfaceGenContext::reportEditorInfo(EditorConsumer &Consumer) const {
   Consumer.handleSourceText(Impl.Info.Text);
   reportSyntacticAnnotations(Impl.TextCI, Consumer);
@@ -780,6 +835,26 @@ void SwiftLangSupport::editorOpenInterface(
 
   Invocation.getClangImporterOptions().ImportForwardDeclarations = true;
 
+  // If the interface of this module has already been generated with an
+  // equivalent invocation and the module hasn't changed since, replay the
+  // cached text instead of rebuilding it; regenerating the interface of a
+  // large SDK module can take many seconds.
+  if (auto Existing = IFaceGenContexts.find(ModuleName, Invocation)) {
+    if (Existing->canReuseEditorInfo(Group, SynthesizedExtensions,
+                                     InterestedUSR)) {
+      // Replay on the context's queue since reporting requires exclusive
+      // access to the underlying AST.
+      Semaphore SemaDone(0);
+      Existing->accessASTAsync([&] {
+        Existing->reportEditorInfo(Consumer);
+        SemaDone.signal();
+      });
+      SemaDone.wait();
+      IFaceGenContexts.set(Name, Existing);
+      return;
+    }
+  }
+
   std::string ErrMsg;
   auto IFaceGenRef = SwiftInterfaceGenContext::create(Name,
                                                       /*IsModule=*/true,
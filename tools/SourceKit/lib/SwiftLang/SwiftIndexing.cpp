@@ -449,8 +449,11 @@ void SwiftLangSupport::indexToStore(
   };
 
   auto ASTConsumer = std::make_shared<IndexStoreASTConsumer>(std::move(Receiver), std::move(Opts));
+  // Indexing tolerates latency; don't let its AST builds delay interactive
+  // requests.
   getASTManager()->processASTAsync(Invok, ASTConsumer,
                                    /*OncePerASTToken=*/nullptr,
                                    CancellationToken,
-                                   llvm::vfs::getRealFileSystem());
+                                   llvm::vfs::getRealFileSystem(),
+                                   ASTBuildPriority::Background);
 }
@@ -60,6 +60,15 @@ public:
 
   bool matches(StringRef ModuleName, const swift::CompilerInvocation &Invok);
 
+  /// Whether the generated text of this context (which already passed \c
+  /// matches for the requested module and invocation) can be replayed for a
+  /// new interface-open request with the given printing parameters, i.e. the
+  /// parameters are the same as the ones the text was generated with and the
+  /// module file it was generated from has not changed on disk.
+  bool canReuseEditorInfo(std::optional<StringRef> Group,
+                          bool SynthesizedExtensions,
+                          std::optional<StringRef> InterestedUSR) const;
+
   /// Note: requires exclusive access to the underlying AST.
   void reportEditorInfo(EditorConsumer &Consumer) const;
 
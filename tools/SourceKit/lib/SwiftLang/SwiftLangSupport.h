@@ -31,6 +31,7 @@
 #include "swift/IDETool/IDEInspectionInstance.h"
 #include "swift/Index/IndexSymbol.h"
 #include "swift/Refactoring/Refactoring.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Mutex.h"
@@ -158,6 +159,43 @@ public:
   SwiftEditorDocumentRef remove(StringRef FilePath);
 };
 
+/// A small thread-safe MRU cache of cursor-info responses, keyed by the
+/// request parameters and the editor snapshot they were computed against.
+/// Hover and quick-help repeatedly fire identical requests at the same
+/// location; replaying the stored response avoids re-resolving the cursor
+/// while the document is unchanged. Entries computed against older snapshots
+/// can no longer match any key and age out of the MRU list.
+class CursorInfoResponseCache {
+public:
+  struct Key {
+    std::string FilePath;
+    uint64_t SnapshotStamp;
+    unsigned Offset;
+    unsigned Length;
+    bool Actionables;
+    bool SymbolGraph;
+    llvm::hash_code ArgsHash;
+
+    friend bool operator==(const Key &LHS, const Key &RHS) {
+      return LHS.SnapshotStamp == RHS.SnapshotStamp &&
+             LHS.Offset == RHS.Offset && LHS.Length == RHS.Length &&
+             LHS.Actionables == RHS.Actionables &&
+             LHS.SymbolGraph == RHS.SymbolGraph &&
+             LHS.ArgsHash == RHS.ArgsHash && LHS.FilePath == RHS.FilePath;
+    }
+  };
+
+private:
+  static const size_t MaxEntries = 8;
+  /// Entries in LRU order, most recently used last.
+  std::vector<std::pair<Key, std::shared_ptr<const CursorInfoData>>> Entries;
+  llvm::sys::Mutex Mtx;
+
+public:
+  std::shared_ptr<const CursorInfoData> get(const Key &K);
+  void set(Key K, std::shared_ptr<const CursorInfoData> Value);
+};
+
 namespace CodeCompletion {
 
 /// Provides a thread-safe cache for code completion results that remain valid
@@ -344,6 +382,7 @@ class SwiftLangSupport : public LangSupport {
   ThreadSafeRefCntPtr<SwiftCompletionCache> CCCache;
   ThreadSafeRefCntPtr<SwiftPopularAPI> PopularAPI;
   CodeCompletion::SessionCacheMap CCSessions;
+  CursorInfoResponseCache CursorInfoCache;
   ThreadSafeRefCntPtr<SwiftCustomCompletions> CustomCompletions;
   std::shared_ptr<SwiftStatistics> Stats;
   llvm::StringMap<std::unique_ptr<FileSystemProvider>> FileSystemProviders;
@@ -571,6 +571,127 @@ static void walkRelatedDecls(const ValueDecl *VD, const FnTy &Fn) {
 // SwiftLangSupport::getCursorInfo
 //===----------------------------------------------------------------------===//
 
+std::shared_ptr<const CursorInfoData>
+CursorInfoResponseCache::get(const Key &K) {
+  llvm::sys::ScopedLock L(Mtx);
+  for (auto I = Entries.begin(); I != Entries.end(); ++I) {
+    if (I->first == K) {
+      auto Value = I->second;
+      // Move the hit to the most-recently-used position.
+      std::rotate(I, I + 1, Entries.end());
+      return Value;
+    }
+  }
+  return nullptr;
+}
+
+void CursorInfoResponseCache::set(Key K,
+                                  std::shared_ptr<const CursorInfoData> Value) {
+  llvm::sys::ScopedLock L(Mtx);
+  if (Entries.size() >= MaxEntries)
+    Entries.erase(Entries.begin());
+  Entries.emplace_back(std::move(K), std::move(Value));
+}
+
+static StringRef copyString(llvm::BumpPtrAllocator &Allocator, StringRef Str) {
+  if (Str.empty())
+    return StringRef();
+  char *Mem = Allocator.Allocate<char>(Str.size());
+  memcpy(Mem, Str.data(), Str.size());
+  return StringRef(Mem, Str.size());
+}
+
+static ArrayRef<StringRef> copyStringArray(llvm::BumpPtrAllocator &Allocator,
+                                           ArrayRef<StringRef> Strs) {
+  if (Strs.empty())
+    return {};
+  auto *Mem = Allocator.Allocate<StringRef>(Strs.size());
+  for (size_t I = 0, E = Strs.size(); I != E; ++I)
+    Mem[I] = copyString(Allocator, Strs[I]);
+  return llvm::ArrayRef(Mem, Strs.size());
+}
+
+static ArrayRef<ParentInfo> copyParentInfoArray(llvm::BumpPtrAllocator &Allocator,
+                                                ArrayRef<ParentInfo> Parents) {
+  if (Parents.empty())
+    return {};
+  auto *Mem = Allocator.Allocate<ParentInfo>(Parents.size());
+  for (size_t I = 0, E = Parents.size(); I != E; ++I)
+    ::new (Mem + I) ParentInfo(copyString(Allocator, Parents[I].Title),
+                               copyString(Allocator, Parents[I].KindName),
+                               copyString(Allocator, Parents[I].USR));
+  return llvm::ArrayRef(Mem, Parents.size());
+}
+
+static ArrayRef<ReferencedDeclInfo>
+copyReferencedDeclArray(llvm::BumpPtrAllocator &Allocator,
+                        ArrayRef<ReferencedDeclInfo> Refs) {
+  if (Refs.empty())
+    return {};
+  auto *Mem = Allocator.Allocate<ReferencedDeclInfo>(Refs.size());
+  for (size_t I = 0, E = Refs.size(); I != E; ++I) {
+    const ReferencedDeclInfo &Ref = Refs[I];
+    ::new (Mem + I) ReferencedDeclInfo(
+        copyString(Allocator, Ref.USR), Ref.DeclarationLang,
+        copyString(Allocator, Ref.AccessLevel),
+        copyString(Allocator, Ref.FilePath),
+        copyString(Allocator, Ref.ModuleName), Ref.IsSystem, Ref.IsSPI,
+        copyParentInfoArray(Allocator, Ref.ParentContexts));
+  }
+  return llvm::ArrayRef(Mem, Refs.size());
+}
+
+/// Deep-copy \p Data into a self-contained CursorInfoData whose strings and
+/// arrays all live in the copy's own allocator, so the copy can be cached
+/// beyond the request that produced it. Keep this in sync with the fields of
+/// \c CursorInfoData and \c CursorSymbolInfo.
+static std::shared_ptr<const CursorInfoData>
+copyCursorInfoData(const CursorInfoData &Data) {
+  auto Copy = std::make_shared<CursorInfoData>();
+  auto &A = Copy->Allocator;
+  Copy->InternalDiagnostic = copyString(A, Data.InternalDiagnostic);
+  Copy->DidReuseAST = Data.DidReuseAST;
+  for (const CursorSymbolInfo &Sym : Data.Symbols) {
+    CursorSymbolInfo &NewSym = Copy->Symbols.emplace_back();
+    NewSym.Kind = Sym.Kind;
+    NewSym.DeclarationLang = Sym.DeclarationLang;
+    NewSym.Name = copyString(A, Sym.Name);
+    NewSym.USR = copyString(A, Sym.USR);
+    NewSym.TypeName = copyString(A, Sym.TypeName);
+    NewSym.TypeUSR = copyString(A, Sym.TypeUSR);
+    NewSym.ContainerTypeUSR = copyString(A, Sym.ContainerTypeUSR);
+    NewSym.DocComment = copyString(A, Sym.DocComment);
+    NewSym.DocCommentAsXML = copyString(A, Sym.DocCommentAsXML);
+    NewSym.GroupName = copyString(A, Sym.GroupName);
+    NewSym.LocalizationKey = copyString(A, Sym.LocalizationKey);
+    NewSym.AnnotatedDeclaration = copyString(A, Sym.AnnotatedDeclaration);
+    NewSym.FullyAnnotatedDeclaration =
+        copyString(A, Sym.FullyAnnotatedDeclaration);
+    NewSym.SymbolGraph = copyString(A, Sym.SymbolGraph);
+    NewSym.ModuleName = copyString(A, Sym.ModuleName);
+    NewSym.ModuleInterfaceName = copyString(A, Sym.ModuleInterfaceName);
+    NewSym.Location = Sym.Location;
+    NewSym.Location.Filename = copyString(A, Sym.Location.Filename);
+    NewSym.OverrideUSRs = copyStringArray(A, Sym.OverrideUSRs);
+    NewSym.AnnotatedRelatedDeclarations =
+        copyStringArray(A, Sym.AnnotatedRelatedDeclarations);
+    NewSym.ModuleGroupArray = copyStringArray(A, Sym.ModuleGroupArray);
+    NewSym.ParentContexts = copyParentInfoArray(A, Sym.ParentContexts);
+    NewSym.ReferencedSymbols =
+        copyReferencedDeclArray(A, Sym.ReferencedSymbols);
+    NewSym.ReceiverUSRs = copyStringArray(A, Sym.ReceiverUSRs);
+    NewSym.IsSystem = Sym.IsSystem;
+    NewSym.IsDynamic = Sym.IsDynamic;
+    NewSym.IsSynthesized = Sym.IsSynthesized;
+    NewSym.ParentNameOffset = Sym.ParentNameOffset;
+  }
+  for (const RefactoringInfo &Info : Data.AvailableActions)
+    Copy->AvailableActions.emplace_back(
+        Info.Kind, copyString(A, Info.KindName),
+        copyString(A, Info.UnavailableReason));
+  return Copy;
+}
+
 static StringRef getSourceToken(unsigned Offset,
                                 ImmutableTextSnapshotRef Snap) {
   auto MemBuf = Snap->getBuffer()->getInternalBuffer();
@@ -2176,6 +2297,43 @@ void SwiftLangSupport::getCursorInfo(
     return;
   }
 
+  // Cursor info for an unchanged snapshot is deterministic for a given set of
+  // arguments, and hover/quick-help repeat such requests frequently. Serve
+  // repeats from the response cache. Only requests against the primary buffer
+  // of an open editor document participate, since the snapshot stamp is what
+  // keys invalidation.
+  std::optional<CursorInfoResponseCache::Key> CacheKey;
+  if (InputBufferName.empty() && !vfsOptions) {
+    if (auto EditorDoc = EditorDocuments->findByPath(PrimaryFilePath)) {
+      if (auto Snap = EditorDoc->getLatestSnapshot()) {
+        llvm::hash_code ArgsHash = llvm::hash_value(Args.size());
+        for (const char *Arg : Args)
+          ArgsHash = llvm::hash_combine(ArgsHash, StringRef(Arg));
+        CacheKey = CursorInfoResponseCache::Key{PrimaryFilePath.str(),
+                                                Snap->getStamp(),
+                                                Offset,
+                                                Length,
+                                                Actionables,
+                                                SymbolGraph,
+                                                ArgsHash};
+        if (auto Cached = CursorInfoCache.get(*CacheKey)) {
+          Receiver(RequestResult<CursorInfoData>::fromResult(*Cached));
+          return;
+        }
+        // Store whatever response this request produces. Empty, errored, and
+        // cancelled responses are not cached; a later identical request might
+        // do better once the AST catches up.
+        auto DownstreamReceiver = std::move(Receiver);
+        Receiver = [this, Key = *CacheKey, DownstreamReceiver](
+                       const RequestResult<CursorInfoData> &Res) {
+          if (Res.isValue() && !Res.value().Symbols.empty())
+            CursorInfoCache.set(Key, copyCursorInfoData(Res.value()));
+          DownstreamReceiver(Res);
+        };
+      }
+    }
+  }
+
   std::string Error;
   SwiftInvocationRef Invok =
       ASTMgr->getTypecheckInvocation(Args, PrimaryFilePath, fileSystem, Error);
@@ -31,7 +31,12 @@
 #include <cstdlib>
 #endif
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace swift::Demangle;
 
@@ -108,6 +113,17 @@ static llvm::cl::opt<bool>
 /// \}
 
 
+static llvm::cl::opt<unsigned>
+NumThreads("j", llvm::cl::init(1),
+           llvm::cl::desc("Demangle standard input with N worker threads "
+                          "(reads all input up front; output order is "
+                          "preserved)"));
+
+static llvm::cl::opt<bool>
+NullSeparated("null",
+              llvm::cl::desc("Separate standard input and output records with "
+                             "NUL instead of newline"));
+
 static llvm::cl::list<std::string>
 InputNames(llvm::cl::Positional, llvm::cl::desc("[mangled name...]"),
                llvm::cl::ZeroOrMore);
@@ -384,20 +400,75 @@ static bool findMaybeMangled(llvm::StringRef input, llvm::StringRef &match) {
   return false;
 }
 
-static int demangleSTDIN(const swift::Demangle::DemangleOptions &options) {
+/// Demangle every maybe-mangled symbol in \p inputContents into \p os,
+/// echoing the surrounding text unchanged.
+static void demangleRecord(llvm::raw_ostream &os, llvm::StringRef inputContents,
+                           swift::Demangle::Context &DCtx,
+                           const swift::Demangle::DemangleOptions &options) {
+  llvm::StringRef match;
+
+  while (findMaybeMangled(inputContents, match)) {
+    os << substrBefore(inputContents, match);
+    demangle(os, match, DCtx, options);
+    inputContents = substrAfter(inputContents, match);
+  }
+
+  os << inputContents;
+}
+
+static int demangleSTDIN(const swift::Demangle::DemangleOptions &options,
+                         char separator) {
   swift::Demangle::Context DCtx;
-  for (std::string mangled; std::getline(std::cin, mangled);) {
-    llvm::StringRef inputContents(mangled);
-    llvm::StringRef match;
-
-    while (findMaybeMangled(inputContents, match)) {
-      llvm::outs() << substrBefore(inputContents, match);
-      demangle(llvm::outs(), match, DCtx, options);
-      inputContents = substrAfter(inputContents, match);
-    }
+  for (std::string mangled; std::getline(std::cin, mangled, separator);) {
+    demangleRecord(llvm::outs(), mangled, DCtx, options);
+    llvm::outs() << separator;
+  }
+
+  return EXIT_SUCCESS;
+}
 
-    llvm::outs() << inputContents << '\n';
+/// Parallel variant of demangleSTDIN for large batches (e.g. collections of
+/// crash logs). Reads all of stdin up front and splits the records into one
+/// contiguous shard per worker; each worker demangles its shard into a private
+/// buffer with its own context, and the buffers are written out in shard
+/// order. That preserves the input order without any cross-thread
+/// coordination, at the cost of holding the input and output in memory.
+static int
+demangleSTDINParallel(const swift::Demangle::DemangleOptions &options,
+                      unsigned numThreads, char separator) {
+  std::string input((std::istreambuf_iterator<char>(std::cin)),
+                    std::istreambuf_iterator<char>());
+  if (input.empty())
+    return EXIT_SUCCESS;
+
+  llvm::SmallVector<llvm::StringRef, 8> records;
+  llvm::StringRef(input).split(records, separator);
+  // Like std::getline, treat a trailing separator as terminating the last
+  // record rather than starting an empty one.
+  if (input.back() == separator)
+    records.pop_back();
+
+  numThreads = std::min<size_t>(numThreads, records.size());
+  std::vector<std::string> shardOutputs(numThreads);
+  std::vector<std::thread> workers;
+  size_t shardSize = (records.size() + numThreads - 1) / numThreads;
+  for (unsigned t = 0; t < numThreads; ++t) {
+    size_t begin = t * shardSize;
+    size_t end = std::min(begin + shardSize, records.size());
+    workers.emplace_back([&, begin, end, t] {
+      llvm::raw_string_ostream os(shardOutputs[t]);
+      swift::Demangle::Context DCtx;
+      for (size_t i = begin; i != end; ++i) {
+        demangleRecord(os, records[i], DCtx, options);
+        os << separator;
+      }
+    });
   }
+  for (auto &worker : workers)
+    worker.join();
+
+  for (const std::string &shardOutput : shardOutputs)
+    llvm::outs() << shardOutput;
 
   return EXIT_SUCCESS;
 }
@@ -428,7 +499,10 @@ int main(int argc, char **argv) {
       llvm::errs() << "The option -type cannot be used to demangle stdin.\n";
       return EXIT_FAILURE;
     }
-    return demangleSTDIN(options);
+    char separator = NullSeparated ? '\0' : '\n';
+    if (NumThreads > 1)
+      return demangleSTDINParallel(options, NumThreads, separator);
+    return demangleSTDIN(options, separator);
   } else {
     swift::Demangle::Context DCtx;
     for (llvm::StringRef name : InputNames) {
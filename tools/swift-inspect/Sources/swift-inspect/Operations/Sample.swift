@@ -0,0 +1,105 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2026 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import ArgumentParser
+import SwiftRemoteMirror
+import Foundation
+
+private struct SampleRecord: Encodable {
+  struct TagStats: Encodable {
+    var count: Int
+    var bytes: Int
+  }
+
+  var timestamp: Double
+  var allocationCount: Int
+  var allocationBytes: Int
+  var allocationsByTag: [String: TagStats]
+  var conformanceCacheEntries: Int
+}
+
+internal struct Sample: ParsableCommand {
+  static let configuration = CommandConfiguration(
+    abstract: "Periodically record the target's runtime cache statistics " +
+              "into a timeline file.",
+    discussion: """
+      Attaches once and then samples the target's metadata allocations and
+      protocol conformance cache at a fixed interval, appending one JSON
+      record per sample. The target only pauses for the duration of each
+      batched read, not for the whole session. Do not combine with
+      --fork-corpse: a corpse is a frozen snapshot and every sample would
+      be identical.
+      """)
+
+  @OptionGroup()
+  var options: UniversalOptions
+
+  @Option(help: "Seconds between samples")
+  var interval: Double = 1.0
+
+  @Option(help: "Total sampling duration in seconds (0 = until killed)")
+  var duration: Double = 60.0
+
+  @Option(help: "Output to a file")
+  var outputFile: String? = nil
+
+  func run() throws {
+    try inspect(options: options) { process in
+      var output = try Output(outputFile)
+      let encoder = JSONEncoder()
+      encoder.outputFormatting = [.sortedKeys]
+      let start = Date()
+      let deadline: Date =
+          duration > 0 ? start.addingTimeInterval(duration) : .distantFuture
+
+      while true {
+        let sampleBegin = Date()
+
+        var byTag: [String: SampleRecord.TagStats] = [:]
+        var allocationCount = 0
+        var allocationBytes = 0
+        try process.context.allocations.forEach { allocation in
+          let name = process.context.name(allocation: allocation.tag)
+              ?? "tag-\(allocation.tag)"
+          var stats = byTag[name, default: .init(count: 0, bytes: 0)]
+          stats.count += 1
+          stats.bytes += allocation.size
+          byTag[name] = stats
+          allocationCount += 1
+          allocationBytes += allocation.size
+        }
+
+        var conformanceCacheEntries = 0
+        try process.context.iterateConformanceCache { _, _ in
+          conformanceCacheEntries += 1
+        }
+
+        let record = SampleRecord(
+            timestamp: sampleBegin.timeIntervalSince1970,
+            allocationCount: allocationCount,
+            allocationBytes: allocationBytes,
+            allocationsByTag: byTag,
+            conformanceCacheEntries: conformanceCacheEntries)
+        let data = try encoder.encode(record)
+        print(String(data: data, encoding: .utf8)!, to: &output)
+
+        if Date() >= deadline {
+          break
+        }
+        let elapsed = Date().timeIntervalSince(sampleBegin)
+        if elapsed < interval {
+          Thread.sleep(forTimeInterval: interval - elapsed)
+        }
+      }
+    }
+  }
+}
@@ -132,6 +132,7 @@ internal struct SwiftInspect: ParsableCommand {
     DumpCacheNodes.self,
     DumpArrays.self,
     DumpConcurrency.self,
+    Sample.self,
   ]
 #elseif os(Windows) || os(Android)
   static let subcommands: [ParsableCommand.Type] = [
@@ -140,6 +141,7 @@ internal struct SwiftInspect: ParsableCommand {
     DumpGenericMetadata.self,
     DumpCacheNodes.self,
     DumpArrays.self,
+    Sample.self,
   ]
 #else
   static let subcommands: [ParsableCommand.Type] = [
@@ -147,6 +149,7 @@ internal struct SwiftInspect: ParsableCommand {
     DumpRawMetadata.self,
     DumpGenericMetadata.self,
     DumpCacheNodes.self,
+    Sample.self,
   ]
 #endif
 
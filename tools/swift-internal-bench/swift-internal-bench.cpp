@@ -0,0 +1,288 @@
+//===--- swift-internal-bench.cpp - Data structure microbenchmarks --------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2026 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Microbenchmarks for compiler-internal data structures, with pinned input
+// corpora so results are comparable across compiler versions. unittests/
+// covers correctness; this tool exists to watch the performance side of the
+// same components. Each benchmark auto-calibrates its iteration count, runs
+// several samples, and reports the fastest one; -json records results and
+// -baseline compares against an earlier recording, failing on regression,
+// which is the CI entry point.
+//
+// Lexer and parser throughput live in swift-parse-bench, which needs a file
+// corpus; everything here is self-contained.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/LLVMInitialize.h"
+#include "swift/Basic/PrefixMap.h"
+#include "swift/Demangling/Demangle.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <chrono>
+#include <vector>
+
+using namespace swift;
+
+namespace options {
+
+static llvm::cl::opt<std::string>
+Filter("filter", llvm::cl::desc("Only run benchmarks containing this string"),
+       llvm::cl::init(""));
+
+static llvm::cl::opt<unsigned>
+Samples("samples", llvm::cl::desc("Samples per benchmark; the fastest wins"),
+        llvm::cl::init(5));
+
+static llvm::cl::opt<std::string>
+JSONPath("json", llvm::cl::desc("Write results as JSON to this file"),
+         llvm::cl::init(""));
+
+static llvm::cl::opt<std::string>
+BaselinePath("baseline",
+             llvm::cl::desc("Compare against a -json recording and fail on "
+                            "regression"),
+             llvm::cl::init(""));
+
+static llvm::cl::opt<double>
+RegressionPct("regression-pct",
+              llvm::cl::desc("Slowdown vs. the baseline considered a "
+                             "regression"),
+              llvm::cl::init(5.0));
+
+} // end namespace options
+
+//===----------------------------------------------------------------------===//
+// Pinned corpora
+//===----------------------------------------------------------------------===//
+
+/// Mangled names of varying shapes: plain functions, nested generics,
+/// protocol witnesses, and specializations. Pinned so that demangler
+/// results stay comparable; do not edit existing entries, append instead.
+static const char *const MangledNames[] = {
+    "$ss5printyypd_SS9separatorSS10terminatortF",
+    "$sSa8capacitySivg",
+    "$sS2iSzsWP",
+    "$s4test3fooyS2iF",
+    "$sSD4keysSD4KeysVyxq__GvgSS_SitSgWOc",
+    "$s7example6WidgetV5label5countACSS_SitcfC",
+    "$sSlsE3mapySayqd__Gqd__7ElementQzKXEKlF",
+    "$sSTsE6reduceyqd__qd___qd__qd___7ElementQztKXEtKlF",
+    "$s4main9ContainerC4itemxvgAA8ProtocolA2aDP4itemxvgTW",
+    "$sS2ayxGSlsSl15withContiguousStorageIfAvailableyqd__Sgqd__SRyxGKXEKlFTW",
+    "$sSo8NSObjectCs8HashableSCsACP4hash4intoys6HasherVz_tFTW",
+    "$s4test3sumySiSaySiGFTfq4g_n",
+};
+
+/// Keys with heavy shared prefixes, the workload PrefixMap exists for:
+/// mangling-like paths where most of each key is common with its neighbors.
+static std::vector<std::string> makePrefixMapKeys() {
+  std::vector<std::string> keys;
+  static const char *const Modules[] = {"Swift", "Foundation", "MyApp"};
+  static const char *const Kinds[] = {"struct", "enum", "class", "protocol"};
+  for (const char *module : Modules)
+    for (const char *kind : Kinds)
+      for (unsigned i = 0; i != 64; ++i)
+        keys.push_back(std::string(module) + "." + kind + ".Member" +
+                       std::to_string(i));
+  return keys;
+}
+
+static ArrayRef<char> asArray(const std::string &str) {
+  return ArrayRef<char>(str.data(), str.size());
+}
+
+//===----------------------------------------------------------------------===//
+// Benchmark bodies
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+/// A registered benchmark: the body runs the measured operation \p Iters
+/// times and returns the number of individual operations performed, so
+/// results are reported per operation rather than per pass.
+struct Benchmark {
+  const char *Name;
+  uint64_t (*Body)(uint64_t Iters);
+};
+
+} // end anonymous namespace
+
+static uint64_t benchDemangleSymbols(uint64_t Iters) {
+  uint64_t Ops = 0;
+  Demangle::Context DCtx;
+  for (uint64_t I = 0; I != Iters; ++I) {
+    for (const char *Name : MangledNames) {
+      Demangle::NodePointer Node = DCtx.demangleSymbolAsNode(Name);
+      (void)Node;
+      DCtx.clear();
+      ++Ops;
+    }
+  }
+  return Ops;
+}
+
+static uint64_t benchDemangleSymbolsAsString(uint64_t Iters) {
+  uint64_t Ops = 0;
+  Demangle::Context DCtx;
+  for (uint64_t I = 0; I != Iters; ++I) {
+    for (const char *Name : MangledNames) {
+      std::string Demangled = DCtx.demangleSymbolAsString(StringRef(Name));
+      (void)Demangled;
+      DCtx.clear();
+      ++Ops;
+    }
+  }
+  return Ops;
+}
+
+static uint64_t benchPrefixMapInsert(uint64_t Iters) {
+  static const std::vector<std::string> Keys = makePrefixMapKeys();
+  uint64_t Ops = 0;
+  for (uint64_t I = 0; I != Iters; ++I) {
+    PrefixMap<char, unsigned> Map;
+    unsigned Value = 0;
+    for (const auto &Key : Keys) {
+      Map.insert(asArray(Key), Value++);
+      ++Ops;
+    }
+  }
+  return Ops;
+}
+
+static uint64_t benchPrefixMapFindPrefix(uint64_t Iters) {
+  static const std::vector<std::string> Keys = makePrefixMapKeys();
+  PrefixMap<char, unsigned> Map;
+  unsigned Value = 0;
+  for (const auto &Key : Keys)
+    Map.insert(asArray(Key), Value++);
+
+  uint64_t Ops = 0;
+  uint64_t Found = 0;
+  for (uint64_t I = 0; I != Iters; ++I) {
+    for (const auto &Key : Keys) {
+      if (Map.findPrefix(asArray(Key)).first)
+        ++Found;
+      ++Ops;
+    }
+  }
+  if (Found != Ops)
+    llvm::report_fatal_error("PrefixMap lookup corpus mismatch");
+  return Ops;
+}
+
+static const Benchmark Benchmarks[] = {
+    {"Demangler/symbolsAsNode", benchDemangleSymbols},
+    {"Demangler/symbolsAsString", benchDemangleSymbolsAsString},
+    {"PrefixMap/insert", benchPrefixMapInsert},
+    {"PrefixMap/findPrefix", benchPrefixMapFindPrefix},
+};
+
+//===----------------------------------------------------------------------===//
+// Runner
+//===----------------------------------------------------------------------===//
+
+/// Runs \p B once with \p Iters iterations and returns nanoseconds per
+/// operation.
+static double measure(const Benchmark &B, uint64_t Iters) {
+  auto Start = std::chrono::steady_clock::now();
+  uint64_t Ops = B.Body(Iters);
+  std::chrono::duration<double, std::nano> Elapsed =
+      std::chrono::steady_clock::now() - Start;
+  return Elapsed.count() / (double)Ops;
+}
+
+/// Doubles the iteration count until one sample takes long enough to trust
+/// the clock, aiming for roughly 100ms per sample.
+static uint64_t calibrate(const Benchmark &B) {
+  uint64_t Iters = 1;
+  while (true) {
+    auto Start = std::chrono::steady_clock::now();
+    (void)B.Body(Iters);
+    std::chrono::duration<double> Elapsed =
+        std::chrono::steady_clock::now() - Start;
+    if (Elapsed.count() >= 0.01)
+      return std::max<uint64_t>(
+          1, (uint64_t)((double)Iters * 0.1 / Elapsed.count()));
+    Iters *= 2;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  PROGRAM_START(argc, argv);
+  llvm::cl::ParseCommandLineOptions(
+      argc, argv, "Microbenchmarks for compiler-internal data structures\n");
+
+  llvm::StringMap<double> Baseline;
+  if (!options::BaselinePath.empty()) {
+    auto BufOrErr = llvm::MemoryBuffer::getFile(options::BaselinePath);
+    if (!BufOrErr) {
+      llvm::errs() << "error opening baseline '" << options::BaselinePath
+                   << "': " << BufOrErr.getError().message() << "\n";
+      return 1;
+    }
+    auto Parsed = llvm::json::parse(BufOrErr.get()->getBuffer());
+    if (!Parsed || !Parsed->getAsObject()) {
+      llvm::errs() << "error: baseline is not a JSON object\n";
+      return 1;
+    }
+    for (const auto &Entry : *Parsed->getAsObject())
+      if (auto NsPerOp = Entry.second.getAsNumber())
+        Baseline[Entry.first.str()] = *NsPerOp;
+  }
+
+  llvm::json::Object Results;
+  bool Regressed = false;
+  for (const Benchmark &B : Benchmarks) {
+    if (!options::Filter.empty() &&
+        !StringRef(B.Name).contains(options::Filter))
+      continue;
+
+    uint64_t Iters = calibrate(B);
+    double Best = measure(B, Iters);
+    for (unsigned I = 1; I < options::Samples; ++I)
+      Best = std::min(Best, measure(B, Iters));
+    Results[B.Name] = Best;
+
+    llvm::outs() << llvm::format("%-32s %12.2f ns/op", B.Name, Best);
+    auto It = Baseline.find(B.Name);
+    if (It != Baseline.end() && It->second > 0) {
+      double Pct = (Best / It->second - 1.0) * 100.0;
+      llvm::outs() << llvm::format("  %+7.1f%% vs baseline", Pct);
+      if (Pct > options::RegressionPct) {
+        llvm::outs() << "  REGRESSED";
+        Regressed = true;
+      }
+    }
+    llvm::outs() << "\n";
+  }
+
+  if (!options::JSONPath.empty()) {
+    std::error_code EC;
+    llvm::raw_fd_ostream OS(options::JSONPath, EC, llvm::sys::fs::OF_Text);
+    if (EC) {
+      llvm::errs() << "error opening '" << options::JSONPath
+                   << "': " << EC.message() << "\n";
+      return 1;
+    }
+    OS << llvm::json::Value(std::move(Results)) << "\n";
+  }
+
+  return Regressed ? 1 : 0;
+}
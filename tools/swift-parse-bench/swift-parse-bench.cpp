@@ -0,0 +1,177 @@
+//===--- swift-parse-bench.cpp - Lexer/parser throughput benchmark --------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2025 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures raw lexer and parser throughput over a corpus of Swift files so
+// that parsing regressions show up as numbers instead of bug reports. The
+// corpus is lexed and parsed repeatedly and the tool reports tokens/sec and
+// top-level decls/sec. test/Parse covers correctness only; this tool exists
+// to watch the performance side.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/LLVMInitialize.h"
+#include "swift/Basic/LangOptions.h"
+#include "swift/Basic/SourceManager.h"
+#include "swift/Parse/Lexer.h"
+#include "swift/Subsystems.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <chrono>
+
+using namespace swift;
+
+namespace options {
+
+static llvm::cl::list<std::string>
+InputPaths(llvm::cl::Positional, llvm::cl::desc("<files or directories>"),
+           llvm::cl::OneOrMore);
+
+static llvm::cl::opt<unsigned>
+Iterations("iterations", llvm::cl::desc("Number of passes over the corpus"),
+           llvm::cl::init(10));
+
+static llvm::cl::opt<bool>
+LexOnly("lex-only", llvm::cl::desc("Measure lexing only, skip parsing"),
+        llvm::cl::init(false));
+
+} // end namespace options
+
+/// Collect every .swift file under \p Path into \p Files, recursing into
+/// directories.
+static bool collectInputFiles(StringRef Path,
+                              std::vector<std::string> &Files) {
+  if (llvm::sys::fs::is_directory(Path)) {
+    std::error_code EC;
+    llvm::sys::fs::recursive_directory_iterator It(Path, EC), End;
+    for (; It != End && !EC; It.increment(EC)) {
+      StringRef Entry = It->path();
+      if (llvm::sys::path::extension(Entry) == ".swift")
+        Files.push_back(Entry.str());
+    }
+    if (EC) {
+      llvm::errs() << "error reading directory '" << Path
+                   << "': " << EC.message() << "\n";
+      return false;
+    }
+    return true;
+  }
+  if (llvm::sys::fs::exists(Path)) {
+    Files.push_back(Path.str());
+    return true;
+  }
+  llvm::errs() << "error: no such file or directory: '" << Path << "'\n";
+  return false;
+}
+
+namespace {
+
+/// One timed pass over the corpus: total work units (tokens or decls) and the
+/// wall time spent producing them.
+struct BenchResult {
+  uint64_t Units = 0;
+  std::chrono::duration<double> Elapsed{0};
+
+  double unitsPerSecond() const {
+    return Elapsed.count() > 0 ? Units / Elapsed.count() : 0;
+  }
+};
+
+} // end anonymous namespace
+
+static BenchResult benchLexing(SourceManager &SM, const LangOptions &LangOpts,
+                               ArrayRef<unsigned> BufferIDs,
+                               unsigned Iterations) {
+  BenchResult Result;
+  auto Start = std::chrono::steady_clock::now();
+  for (unsigned I = 0; I != Iterations; ++I) {
+    for (unsigned BufferID : BufferIDs) {
+      Lexer L(LangOpts, SM, BufferID, /*Diags=*/nullptr, LexerMode::Swift);
+      Token Tok;
+      do {
+        L.lex(Tok);
+        ++Result.Units;
+      } while (Tok.isNot(tok::eof));
+    }
+  }
+  Result.Elapsed = std::chrono::steady_clock::now() - Start;
+  return Result;
+}
+
+static BenchResult benchParsing(SourceManager &SM,
+                                ArrayRef<unsigned> BufferIDs,
+                                unsigned Iterations) {
+  BenchResult Result;
+  auto Start = std::chrono::steady_clock::now();
+  for (unsigned I = 0; I != Iterations; ++I) {
+    for (unsigned BufferID : BufferIDs) {
+      // A fresh ParserUnit per pass keeps each parse cold; its ASTContext and
+      // arenas are torn down before the next file.
+      ParserUnit Unit(SM, SourceFileKind::Main, BufferID);
+      Unit.parse();
+      Result.Units += Unit.getSourceFile().getTopLevelItems().size();
+    }
+  }
+  Result.Elapsed = std::chrono::steady_clock::now() - Start;
+  return Result;
+}
+
+int main(int argc, char *argv[]) {
+  PROGRAM_START(argc, argv);
+  llvm::cl::ParseCommandLineOptions(argc, argv,
+                                    "Swift parser throughput benchmark\n");
+
+  std::vector<std::string> Files;
+  for (const auto &Path : options::InputPaths)
+    if (!collectInputFiles(Path, Files))
+      return 1;
+  if (Files.empty()) {
+    llvm::errs() << "error: no .swift files in corpus\n";
+    return 1;
+  }
+
+  SourceManager SM;
+  std::vector<unsigned> BufferIDs;
+  uint64_t CorpusBytes = 0;
+  for (const auto &File : Files) {
+    auto FileBufOrErr = llvm::MemoryBuffer::getFile(File);
+    if (!FileBufOrErr) {
+      llvm::errs() << "error opening '" << File
+                   << "': " << FileBufOrErr.getError().message() << "\n";
+      return 1;
+    }
+    CorpusBytes += FileBufOrErr.get()->getBufferSize();
+    BufferIDs.push_back(SM.addNewSourceBuffer(std::move(FileBufOrErr.get())));
+  }
+
+  LangOptions LangOpts;
+  llvm::outs() << "corpus: " << Files.size() << " files, " << CorpusBytes
+               << " bytes, " << options::Iterations << " iterations\n";
+
+  BenchResult Lex =
+      benchLexing(SM, LangOpts, BufferIDs, options::Iterations);
+  llvm::outs() << llvm::format("lex:   %10llu tokens  %12.0f tokens/sec\n",
+                               (unsigned long long)Lex.Units,
+                               Lex.unitsPerSecond());
+
+  if (!options::LexOnly) {
+    BenchResult Parse = benchParsing(SM, BufferIDs, options::Iterations);
+    llvm::outs() << llvm::format("parse: %10llu decls   %12.0f decls/sec\n",
+                                 (unsigned long long)Parse.Units,
+                                 Parse.unitsPerSecond());
+  }
+  return 0;
+}
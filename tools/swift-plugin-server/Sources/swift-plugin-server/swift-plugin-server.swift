@@ -13,14 +13,119 @@
 @_spi(PluginMessage) import SwiftCompilerPluginMessageHandling
 @_spi(PluginMessage) import SwiftLibraryPluginProvider
 
+#if canImport(Darwin)
+import Darwin
+#elseif canImport(Glibc)
+import Glibc
+#elseif canImport(Android)
+import Android
+#elseif canImport(Musl)
+import Musl
+#endif
+
 @main
 final class SwiftPluginServer {
   static func main() throws {
-    let connection = try StandardIOMessageConnection()
-    let listener = CompilerPluginMessageListener(
-      connection: connection,
-      provider: LibraryPluginProvider.shared
-    )
-    try listener.main()
+    var socketPath: String? = nil
+    var args = CommandLine.arguments.dropFirst()[...]
+    while let arg = args.popFirst() {
+      switch arg {
+      case "--socket":
+        socketPath = args.popFirst()
+      default:
+        // Ignore unknown arguments for forward compatibility.
+        break
+      }
+    }
+
+    if let socketPath = socketPath {
+      try listenOnSocket(socketPath)
+    } else {
+      let connection = try StandardIOMessageConnection()
+      let listener = CompilerPluginMessageListener(
+        connection: connection,
+        provider: LibraryPluginProvider.shared
+      )
+      try listener.main()
+    }
+  }
+
+  /// Serve plugin connections on a Unix domain socket at 'socketPath'.
+  ///
+  /// The process stays alive across compiler invocations so plugin libraries
+  /// loaded by 'LibraryPluginProvider' stay warm between frontend jobs.
+  /// Connections are served one at a time; each connection carries the same
+  /// message stream as the stdio transport, so the per-connection handling
+  /// redirects the accepted socket onto stdin/stdout and reuses
+  /// 'StandardIOMessageConnection'.
+  static func listenOnSocket(_ socketPath: String) throws {
+#if os(Windows)
+    fatalError("'--socket' is not supported on this platform")
+#else
+#if canImport(Glibc) || canImport(Android) || canImport(Musl)
+    let sockStream = Int32(SOCK_STREAM.rawValue)
+#else
+    let sockStream = SOCK_STREAM
+#endif
+    let serverFD = socket(AF_UNIX, sockStream, 0)
+    guard serverFD >= 0 else {
+      fatalError("failed to create socket: \(String(cString: strerror(errno)))")
+    }
+
+    var addr = sockaddr_un()
+    addr.sun_family = sa_family_t(AF_UNIX)
+    let maxPathLength = MemoryLayout.size(ofValue: addr.sun_path) - 1
+    guard socketPath.utf8.count <= maxPathLength else {
+      fatalError("socket path is too long: \(socketPath)")
+    }
+    withUnsafeMutableBytes(of: &addr.sun_path) { sunPath in
+      socketPath.withCString { path in
+        _ = memcpy(sunPath.baseAddress!, path, socketPath.utf8.count)
+      }
+    }
+
+    // A stale socket file from a previous server blocks 'bind'.
+    unlink(socketPath)
+
+    let bound = withUnsafePointer(to: &addr) { addrPtr in
+      addrPtr.withMemoryRebound(to: sockaddr.self, capacity: 1) { sockaddrPtr in
+        bind(serverFD, sockaddrPtr, socklen_t(MemoryLayout<sockaddr_un>.size))
+      }
+    }
+    guard bound >= 0 else {
+      fatalError("failed to bind '\(socketPath)': " +
+                 String(cString: strerror(errno)))
+    }
+    guard listen(serverFD, 16) >= 0 else {
+      fatalError("failed to listen on '\(socketPath)': " +
+                 String(cString: strerror(errno)))
+    }
+
+    while true {
+      let connectionFD = accept(serverFD, nil, nil)
+      guard connectionFD >= 0 else {
+        if errno == EINTR {
+          continue
+        }
+        fatalError("failed to accept connection: " +
+                   String(cString: strerror(errno)))
+      }
+
+      dup2(connectionFD, 0)
+      dup2(connectionFD, 1)
+      close(connectionFD)
+
+      do {
+        let connection = try StandardIOMessageConnection()
+        let listener = CompilerPluginMessageListener(
+          connection: connection,
+          provider: LibraryPluginProvider.shared
+        )
+        try listener.main()
+      } catch {
+        // A broken connection only affects that client; keep serving.
+      }
+    }
+#endif
   }
 }
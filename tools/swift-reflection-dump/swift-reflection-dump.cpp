@@ -20,6 +20,7 @@
 #include "swift/RemoteInspection/TypeRef.h"
 #include "swift/RemoteInspection/TypeRefBuilder.h"
 #include "swift/StaticMirror/ObjectFileContext.h"
+#include "swift/StaticMirror/OnDiskTypeRefCache.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/Object/Archive.h"
 #include "llvm/Object/COFF.h"
@@ -41,8 +42,12 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <csignal>
+#include <future>
 #include <iostream>
+#include <sstream>
+#include <thread>
 
 using llvm::ArrayRef;
 using llvm::dyn_cast;
@@ -79,6 +84,16 @@ static llvm::cl::opt<std::string>
                  llvm::cl::desc("Architecture to inspect in the binary"),
                  llvm::cl::Required);
 
+static llvm::cl::opt<std::string> TypeRefCacheDir(
+    "typeref-cache-dir",
+    llvm::cl::desc("Directory holding a persistent cache of decoded field "
+                   "descriptor tables, keyed by image UUID"));
+
+static llvm::cl::opt<unsigned>
+    NumThreads("j", llvm::cl::init(1),
+               llvm::cl::desc("Dump reflection sections with N worker threads "
+                              "(output order is preserved)"));
+
 #if SWIFT_OBJC_INTEROP
 static llvm::cl::opt<bool> DisableObjCInterop(
     "no-objc-interop",
@@ -86,6 +101,37 @@ static llvm::cl::opt<bool> DisableObjCInterop(
 #endif
 } // end namespace options
 
+static void dumpSection(ReflectionContextHolder &context,
+                        TypeRefBuilder::DumpSection section, bool objCInterop,
+                        std::ostream &stream) {
+  auto &builder = context.Builder;
+  switch (context.PointerSize) {
+  case 4:
+#if SWIFT_OBJC_INTEROP
+    if (objCInterop)
+      builder.dumpSection<WithObjCInterop, 4>(section, stream);
+    else
+      builder.dumpSection<NoObjCInterop, 4>(section, stream);
+#else
+    builder.dumpSection<NoObjCInterop, 4>(section, stream);
+#endif
+    break;
+  case 8:
+#if SWIFT_OBJC_INTEROP
+    if (objCInterop)
+      builder.dumpSection<WithObjCInterop, 8>(section, stream);
+    else
+      builder.dumpSection<NoObjCInterop, 8>(section, stream);
+#else
+    builder.dumpSection<NoObjCInterop, 8>(section, stream);
+#endif
+    break;
+  default:
+    fputs("unsupported word size in object file\n", stderr);
+    abort();
+  }
+}
+
 static int doDumpReflectionSections(ArrayRef<std::string> BinaryFilenames,
                                     StringRef Arch, ActionType Action,
                                     std::ostream &stream) {
@@ -120,38 +166,63 @@ static int doDumpReflectionSections(ArrayRef<std::string> BinaryFilenames,
 #else
   bool ObjCInterop = false;
 #endif
-  auto context = makeReflectionContextForObjectFiles(ObjectFiles, ObjCInterop);
+  // Declared before the context so that the cache is written back after the
+  // context (and with it the last reader of the cached tables) is gone.
+  std::unique_ptr<OnDiskTypeRefCache> TypeRefCache;
+  if (!options::TypeRefCacheDir.empty())
+    TypeRefCache =
+        std::make_unique<OnDiskTypeRefCache>(options::TypeRefCacheDir);
+
+  auto context = makeReflectionContextForObjectFiles(ObjectFiles, ObjCInterop,
+                                                     TypeRefCache.get());
   auto &builder = context->Builder;
 
   switch (Action) {
-  case ActionType::DumpReflectionSections:
+  case ActionType::DumpReflectionSections: {
     // Dump everything
-    switch (context->PointerSize) {
-    case 4:
-#if SWIFT_OBJC_INTEROP
-      if (!options::DisableObjCInterop)
-        builder.dumpAllSections<WithObjCInterop, 4>(stream);
-      else
-        builder.dumpAllSections<NoObjCInterop, 4>(stream);
-#else
-      builder.dumpAllSections<NoObjCInterop, 4>(stream);
-#endif
-      break;
-    case 8:
-#if SWIFT_OBJC_INTEROP
-      if (!options::DisableObjCInterop)
-        builder.dumpAllSections<WithObjCInterop, 8>(stream);
-      else
-        builder.dumpAllSections<NoObjCInterop, 8>(stream);
-#else
-      builder.dumpAllSections<NoObjCInterop, 8>(stream);
-#endif
-      break;
-    default:
-      fputs("unsupported word size in object file\n", stderr);
-      abort();
+    constexpr TypeRefBuilder::DumpSection AllSections[] = {
+        TypeRefBuilder::DumpSection::FieldDescriptors,
+        TypeRefBuilder::DumpSection::AssociatedTypes,
+        TypeRefBuilder::DumpSection::BuiltinTypes,
+        TypeRefBuilder::DumpSection::CaptureDescriptors,
+        TypeRefBuilder::DumpSection::Conformances,
+        TypeRefBuilder::DumpSection::MultiPayloadEnums,
+    };
+    constexpr size_t NumSections = sizeof(AllSections) / sizeof(AllSections[0]);
+
+    if (options::NumThreads > 1) {
+      // Each worker builds its own reflection context over the shared
+      // memory-mapped object files and claims sections off a shared counter;
+      // the buffers are streamed out in section order as they complete.
+      unsigned NumWorkers =
+          std::min<unsigned>(options::NumThreads, NumSections);
+      std::atomic<size_t> NextSection{0};
+      std::promise<std::string> Promises[NumSections];
+      std::vector<std::thread> Workers;
+      for (unsigned w = 0; w < NumWorkers; ++w) {
+        Workers.emplace_back([&] {
+          auto WorkerContext =
+              makeReflectionContextForObjectFiles(ObjectFiles, ObjCInterop);
+          while (true) {
+            size_t i = NextSection.fetch_add(1);
+            if (i >= NumSections)
+              break;
+            std::ostringstream Buf;
+            dumpSection(*WorkerContext, AllSections[i], ObjCInterop, Buf);
+            Promises[i].set_value(Buf.str());
+          }
+        });
+      }
+      for (auto &Promise : Promises)
+        stream << Promise.get_future().get();
+      for (auto &Worker : Workers)
+        Worker.join();
+    } else {
+      for (auto Section : AllSections)
+        dumpSection(*context, Section, ObjCInterop, stream);
     }
     break;
+  }
   case ActionType::DumpTypeLowering: {
     for (std::string Line; std::getline(std::cin, Line);) {
       if (Line.empty())
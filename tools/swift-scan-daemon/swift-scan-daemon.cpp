@@ -0,0 +1,47 @@
+//===--- swift-scan-daemon.cpp - Dependency Scanner Daemon ----------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2025 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// A long-lived dependency scanner service. It keeps the in-memory dependency
+// scanning cache warm across build-system invocations, serving scan requests
+// over the Unix-domain socket specified by '--socket'. Clients connect using
+// the libSwiftScan 'swiftscan_scan_daemon_*' API.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift-c/DependencyScan/DependencyScan.h"
+#include "swift/Basic/LLVMInitialize.h"
+#include "llvm/Support/CommandLine.h"
+
+namespace {
+llvm::cl::OptionCategory Category("swift-scan-daemon Options");
+llvm::cl::opt<std::string>
+    SocketPath("socket", llvm::cl::desc("<Unix-domain socket path to serve>"),
+               llvm::cl::cat(Category), llvm::cl::Required);
+} // namespace
+
+int main(int argc, char *argv[]) {
+  PROGRAM_START(argc, argv);
+
+  llvm::cl::HideUnrelatedOptions(Category);
+  llvm::cl::ParseCommandLineOptions(
+      argc, argv, "Swift dependency scanner daemon\n");
+
+  swiftscan_string_ref_t err_msg;
+  if (swiftscan_scanner_daemon_run(SocketPath.c_str(), &err_msg)) {
+    llvm::errs() << llvm::StringRef((const char *)err_msg.data,
+                                    err_msg.length)
+                 << "\n";
+    swiftscan_string_dispose(err_msg);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
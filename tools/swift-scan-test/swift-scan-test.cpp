@@ -23,8 +23,12 @@
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/StringSaver.h"
 #include "llvm/Support/ThreadPool.h"
+#include <chrono>
 
 using namespace llvm;
 
@@ -36,6 +40,7 @@ enum Actions {
   replay_result,
   scan_dependency,
   get_chained_bridging_header,
+  benchmark_scan,
 };
 
 llvm::cl::OptionCategory Category("swift-scan-test Options");
@@ -59,8 +64,24 @@ llvm::cl::opt<Actions>
                             clEnumVal(replay_result, "replay result"),
                             clEnumVal(scan_dependency, "scan dependency"),
                             clEnumVal(get_chained_bridging_header,
-                                      "get cached bridging header")),
+                                      "get cached bridging header"),
+                            clEnumVal(benchmark_scan,
+                                      "measure scan throughput over a "
+                                      "generated synthetic module graph")),
            llvm::cl::cat(Category));
+llvm::cl::opt<unsigned> GraphWidth("graph-width",
+                                   llvm::cl::desc("<modules per level>"),
+                                   llvm::cl::cat(Category), cl::init(10));
+llvm::cl::opt<unsigned> GraphDepth("graph-depth",
+                                   llvm::cl::desc("<import levels>"),
+                                   llvm::cl::cat(Category), cl::init(5));
+llvm::cl::opt<unsigned>
+    InterfaceSize("interface-size",
+                  llvm::cl::desc("<declarations per interface>"),
+                  llvm::cl::cat(Category), cl::init(100));
+llvm::cl::opt<unsigned> Iterations("iterations",
+                                   llvm::cl::desc("<number of scans>"),
+                                   llvm::cl::cat(Category), cl::init(10));
 llvm::cl::list<std::string>
     SwiftCommands(llvm::cl::Positional, llvm::cl::desc("<swift-frontend args>"),
                   llvm::cl::cat(Category));
@@ -283,6 +304,124 @@ createArgs(ArrayRef<std::string> Cmd, StringSaver &Saver, Actions Action) {
   return Args;
 }
 
+static bool writeTextFile(StringRef path, StringRef contents) {
+  std::error_code EC;
+  llvm::raw_fd_ostream out(path, EC, llvm::sys::fs::OF_Text);
+  if (EC) {
+    llvm::errs() << "cannot write " << path << ": " << EC.message() << "\n";
+    return false;
+  }
+  out << contents;
+  return true;
+}
+
+/// Generates a layered graph of textual interfaces under \p graphDir: each
+/// of -graph-depth levels holds -graph-width modules, every module imports
+/// all modules of the next level, and each interface carries
+/// -interface-size filler declarations so interface I/O cost scales too.
+/// Returns the generated main source path, or an empty string on failure.
+static std::string generateModuleGraph(StringRef graphDir) {
+  for (unsigned level = 0; level < GraphDepth; ++level) {
+    for (unsigned mod = 0; mod < GraphWidth; ++mod) {
+      std::string name =
+          "Mod" + std::to_string(level) + "_" + std::to_string(mod);
+      std::string contents;
+      llvm::raw_string_ostream OS(contents);
+      OS << "// swift-interface-format-version: 1.0\n"
+         << "// swift-module-flags: -module-name " << name
+         << " -swift-version 5 -enable-library-evolution\n";
+      if (level + 1 < GraphDepth)
+        for (unsigned imported = 0; imported < GraphWidth; ++imported)
+          OS << "import Mod" << level + 1 << "_" << imported << "\n";
+      for (unsigned decl = 0; decl < InterfaceSize; ++decl)
+        OS << "public func " << name << "_f" << decl << "()\n";
+
+      SmallString<128> path(graphDir);
+      llvm::sys::path::append(path, name + ".swiftinterface");
+      if (!writeTextFile(path, contents))
+        return "";
+    }
+  }
+
+  std::string mainContents;
+  llvm::raw_string_ostream mainOS(mainContents);
+  for (unsigned mod = 0; mod < GraphWidth; ++mod)
+    mainOS << "import Mod0_" << mod << "\n";
+  SmallString<128> mainPath(graphDir);
+  llvm::sys::path::append(mainPath, "main.swift");
+  if (!writeTextFile(mainPath, mainContents))
+    return "";
+  return std::string(mainPath);
+}
+
+static int action_benchmark_scan(ArrayRef<std::string> Cmd,
+                                 StringRef WorkingDirectory) {
+  SmallString<128> graphDir;
+  if (auto EC = llvm::sys::fs::createUniqueDirectory("swift-scan-benchmark",
+                                                     graphDir)) {
+    llvm::errs() << "cannot create temporary directory: " << EC.message()
+                 << "\n";
+    return EXIT_FAILURE;
+  }
+  SWIFT_DEFER { llvm::sys::fs::remove_directories(graphDir); };
+
+  std::string mainPath = generateModuleGraph(graphDir);
+  if (mainPath.empty())
+    return EXIT_FAILURE;
+
+  // Positional arguments carry the environment setup (-sdk, -target,
+  // -resource-dir, ...); the generated graph supplies the rest.
+  std::vector<std::string> Commands(Cmd.begin(), Cmd.end());
+  Commands.insert(Commands.end(),
+                  {"-scan-dependencies", mainPath, "-I", graphDir.str().str(),
+                   "-module-name", "ScanBenchmark"});
+  llvm::BumpPtrAllocator Alloc;
+  llvm::StringSaver Saver(Alloc);
+  auto Args = createArgs(Commands, Saver, Actions::scan_dependency);
+
+  if (WorkingDirectory.empty())
+    WorkingDirectory = graphDir;
+
+  // Use a fresh scanner per iteration so every scan pays the full cost of
+  // walking the graph rather than hitting the scanning cache.
+  using namespace std::chrono;
+  nanoseconds total(0), fastest = nanoseconds::max();
+  for (unsigned i = 0; i < Iterations; ++i) {
+    auto scanner = swiftscan_scanner_create();
+    auto invocation = swiftscan_scan_invocation_create();
+    swiftscan_scan_invocation_set_working_directory(
+        invocation, WorkingDirectory.str().c_str());
+    swiftscan_scan_invocation_set_argv(invocation, Args.size(), Args.data());
+
+    auto start = steady_clock::now();
+    auto graph = swiftscan_dependency_graph_create(scanner, invocation);
+    nanoseconds duration = steady_clock::now() - start;
+
+    swiftscan_scan_invocation_dispose(invocation);
+    swiftscan_scanner_dispose(scanner);
+    if (!graph) {
+      llvm::errs() << "dependency scanning failed\n";
+      return EXIT_FAILURE;
+    }
+    swiftscan_dependency_graph_dispose(graph);
+    total += duration;
+    fastest = std::min(fastest, duration);
+  }
+
+  double avgMilliSecs =
+      (double)total.count() / (double)Iterations / 1000000.;
+  llvm::outs() << "graph: " << GraphWidth * GraphDepth << " modules ("
+               << GraphWidth << " wide x " << GraphDepth << " deep, "
+               << InterfaceSize << " decls per interface)\n"
+               << "scans: " << Iterations << "\n"
+               << llvm::format("avg: %10.3f ms\n", avgMilliSecs)
+               << llvm::format("min: %10.3f ms\n",
+                               (double)fastest.count() / 1000000.)
+               << llvm::format("throughput: %7.3f scans/sec\n",
+                               1000. / avgMilliSecs);
+  return EXIT_SUCCESS;
+}
+
 int main(int argc, char *argv[]) {
   PROGRAM_START(argc, argv);
 
@@ -290,6 +429,10 @@ int main(int argc, char *argv[]) {
   llvm::cl::ParseCommandLineOptions(argc, argv,
                                     "Test libSwiftScan interfaces\n");
 
+  // The benchmark needs no CAS and drives its own timing loop.
+  if (Action == benchmark_scan)
+    return action_benchmark_scan(SwiftCommands, WorkingDirectory);
+
   // Create CAS.
   auto option = swiftscan_cas_options_create();
   SWIFT_DEFER { swiftscan_cas_options_dispose(option); };
@@ -327,6 +470,9 @@ int main(int argc, char *argv[]) {
       case get_chained_bridging_header:
         Ret += action_scan_dependency(Args, WorkingDirectory,
                                       Action == get_chained_bridging_header);
+        break;
+      case benchmark_scan:
+        llvm_unreachable("handled before the thread pool is created");
       }
     });
   }
@@ -215,6 +215,38 @@ TEST(Cache, sameKeyValueIntrusiveRefCountPter) {
   EXPECT_TRUE(freed);
 }
 
+#if !USES_LIBCACHE
+// The default (non-libcache) implementation evicts least-recently-used
+// entries when trimAllCaches() is called; on Darwin eviction is up to the
+// system cache library, so there is nothing deterministic to test.
+TEST(Cache, trimAllCachesEvictsEverything) {
+  Counter c1, c2;
+  swift::sys::Cache<const char *, Counter> cache(__func__);
+  cache.set("a", c1);
+  cache.set("b", c2);
+  swift::sys::CacheImpl::trimAllCaches();
+  EXPECT_EQ(1, c1.exit);
+  EXPECT_EQ(1, c2.exit);
+  EXPECT_FALSE(cache.get("a").has_value());
+  EXPECT_FALSE(cache.get("b").has_value());
+}
+
+TEST(Cache, trimAllCachesEvictsLeastRecentlyUsedFirst) {
+  Counter c1, c2;
+  swift::sys::Cache<const char *, Counter> cache(__func__);
+  cache.set("a", c1);
+  cache.set("b", c2);
+  // Touch "a" so that "b" becomes the least recently used entry. Counters
+  // report no cost, so each entry is accounted with the minimum cost of 1.
+  EXPECT_TRUE(cache.get("a").has_value());
+  swift::sys::CacheImpl::trimAllCaches(/*MaxResidualCost=*/1);
+  EXPECT_EQ(0, c1.exit);
+  EXPECT_EQ(1, c2.exit);
+  EXPECT_TRUE(cache.get("a").has_value());
+  EXPECT_FALSE(cache.get("b").has_value());
+}
+#endif
+
 TEST(Cache, copyValue) {
   struct S {
     int ident, copy;
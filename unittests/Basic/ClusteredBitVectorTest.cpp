@@ -153,6 +153,57 @@ TEST(ClusteredBitVector, FlipAllSmall) {
   EXPECT_EQ(1u, vec.count());
 }
 
+TEST(ClusteredBitVector, AppendConstantBits) {
+  ClusteredBitVector vec;
+  vec.appendConstantBits(65, true);
+  vec.appendConstantBits(3, false);
+  EXPECT_EQ(68u, vec.size());
+  EXPECT_EQ(65u, vec.count());
+  EXPECT_EQ(true, vec[64]);
+  EXPECT_EQ(false, vec[65]);
+}
+
+TEST(ClusteredBitVector, FindNextSetBit) {
+  ClusteredBitVector vec;
+  vec.appendClearBits(163);
+  vec.setBit(3);
+  vec.setBit(66);
+  vec.setBit(162);
+  EXPECT_EQ(3u, vec.findNextSetBit());
+  EXPECT_EQ(3u, vec.findNextSetBit(3));
+  EXPECT_EQ(66u, vec.findNextSetBit(4));
+  EXPECT_EQ(162u, vec.findNextSetBit(67));
+  EXPECT_EQ(ClusteredBitVector::npos, vec.findNextSetBit(163));
+  EXPECT_EQ(ClusteredBitVector::npos, ClusteredBitVector().findNextSetBit());
+}
+
+TEST(ClusteredBitVector, FindNextClearBit) {
+  ClusteredBitVector vec;
+  vec.appendSetBits(163);
+  vec.clearBit(70);
+  vec.clearBit(162);
+  EXPECT_EQ(70u, vec.findNextClearBit());
+  EXPECT_EQ(162u, vec.findNextClearBit(71));
+
+  // The unused bits beyond the end of the vector don't count as clear.
+  ClusteredBitVector allSet;
+  allSet.appendSetBits(65);
+  EXPECT_EQ(ClusteredBitVector::npos, allSet.findNextClearBit());
+}
+
+TEST(ClusteredBitVector, FindPreviousSetBit) {
+  ClusteredBitVector vec;
+  vec.appendClearBits(163);
+  vec.setBit(3);
+  vec.setBit(66);
+  vec.setBit(162);
+  EXPECT_EQ(162u, vec.findPreviousSetBit(vec.size()));
+  EXPECT_EQ(66u, vec.findPreviousSetBit(162));
+  EXPECT_EQ(3u, vec.findPreviousSetBit(66));
+  EXPECT_EQ(ClusteredBitVector::npos, vec.findPreviousSetBit(3));
+  EXPECT_EQ(ClusteredBitVector::npos, vec.findPreviousSetBit(0));
+}
+
 TEST(ClusteredBitVector, FlipAllBig) {
   ClusteredBitVector vec;
   vec.appendClearBits(163);
@@ -97,3 +97,55 @@ TEST(SourceManager, RangeContains) {
   EXPECT_TRUE(SM.rangeContains(R_ad, R_bc));
 }
 
+
+TEST(SourceManager, LineStartOffsets) {
+  SourceManager SM;
+  // Lines of varying length; the second one is long enough to exercise the
+  // word-at-a-time newline scan.
+  unsigned ID = SM.addMemBufferCopy("ab\nthis is a longer line\n\nx");
+
+  auto Starts = SM.getLineStartOffsets(ID);
+  ASSERT_EQ(4u, Starts.size());
+  EXPECT_EQ(0u, Starts[0]);
+  EXPECT_EQ(3u, Starts[1]);
+  EXPECT_EQ(25u, Starts[2]);
+  EXPECT_EQ(26u, Starts[3]);
+}
+
+TEST(SourceManager, LineAndColumnInBuffer) {
+  SourceManager SM;
+  unsigned ID = SM.addMemBufferCopy("ab\nthis is a longer line\n\nx");
+  auto Start = SM.getLocForBufferStart(ID);
+
+  EXPECT_EQ(std::make_pair(1u, 1u), SM.getLineAndColumnInBuffer(Start, ID));
+  EXPECT_EQ(std::make_pair(1u, 3u),
+            SM.getLineAndColumnInBuffer(Start.getAdvancedLoc(2), ID));
+  EXPECT_EQ(std::make_pair(2u, 1u),
+            SM.getLineAndColumnInBuffer(Start.getAdvancedLoc(3), ID));
+  EXPECT_EQ(std::make_pair(2u, 10u),
+            SM.getLineAndColumnInBuffer(Start.getAdvancedLoc(12), ID));
+  EXPECT_EQ(std::make_pair(3u, 1u),
+            SM.getLineAndColumnInBuffer(Start.getAdvancedLoc(25), ID));
+  EXPECT_EQ(std::make_pair(4u, 1u),
+            SM.getLineAndColumnInBuffer(Start.getAdvancedLoc(26), ID));
+}
+
+TEST(SourceManager, ResolveFromLineCol) {
+  SourceManager SM;
+  unsigned ID = SM.addMemBufferCopy("ab\nthis is a longer line\n\nx");
+
+  EXPECT_EQ(0u, SM.resolveFromLineCol(ID, 1, 1).value());
+  EXPECT_EQ(3u, SM.resolveFromLineCol(ID, 2, 1).value());
+  EXPECT_EQ(12u, SM.resolveFromLineCol(ID, 2, 10).value());
+  // End-of-line resolution.
+  EXPECT_EQ(2u, SM.resolveFromLineCol(ID, 1, ~0u).value());
+  EXPECT_EQ(24u, SM.resolveFromLineCol(ID, 2, ~0u).value());
+  EXPECT_EQ(25u, SM.resolveFromLineCol(ID, 3, ~0u).value());
+  // The last line has no terminating newline.
+  EXPECT_EQ(27u, SM.resolveFromLineCol(ID, 4, ~0u).value());
+  // Nonexistent lines resolve to nothing.
+  EXPECT_FALSE(SM.resolveFromLineCol(ID, 0, 1).has_value());
+  EXPECT_FALSE(SM.resolveFromLineCol(ID, 5, 1).has_value());
+
+  EXPECT_EQ(21u, SM.getLineLength(ID, 2).value());
+}
@@ -25,3 +25,17 @@ TEST(IsSingleExtendedGraphemeCluster, Test1) {
   EXPECT_EQ(false, isSingleExtendedGraphemeCluster(""));
   EXPECT_EQ(true, isSingleExtendedGraphemeCluster("a"));
 }
+
+TEST(IsWellFormedUTF8, Test1) {
+  EXPECT_EQ(true, isWellFormedUTF8(""));
+  EXPECT_EQ(true, isWellFormedUTF8("plain ascii text"));
+  // Long enough to exercise the eight-byte ASCII fast path with a non-ASCII
+  // scalar at an unaligned tail position.
+  EXPECT_EQ(true, isWellFormedUTF8("let \xC3\xA9l\xC3\xA9phant = \"\xF0\x9F\x98\x80\""));
+  // Lone continuation byte.
+  EXPECT_EQ(false, isWellFormedUTF8("abcdefghij\x80xyz"));
+  // Truncated multi-byte sequence at the end of the string.
+  EXPECT_EQ(false, isWellFormedUTF8("abcdefghij\xE2\x82"));
+  // Overlong encoding of '/'.
+  EXPECT_EQ(false, isWellFormedUTF8("abcdefghij\xC0\xAF"));
+}
@@ -52,6 +52,59 @@ TEST_F(LocalizationTest, TestStringsSerialization) {
       });
 }
 
+TEST_F(LocalizationTest, TestSerializedProducerFromFilePath) {
+  StringsLocalizationProducer strings(DiagsPath);
+
+  auto dbFile = createTemporaryFile("en", "db");
+
+  {
+    SerializedLocalizationWriter writer;
+
+    strings.forEachAvailable(
+        [&writer](swift::DiagID id, llvm::StringRef translation) {
+          writer.insert(id, translation);
+        });
+
+    ASSERT_FALSE(writer.emit(dbFile));
+  }
+
+  // A file-path based producer defers opening the file until the first
+  // message is requested, and should serve the same translations as one
+  // constructed from a buffer.
+  SerializedLocalizationProducer db(llvm::StringRef(dbFile));
+  strings.forEachAvailable(
+      [&db](swift::DiagID id, llvm::StringRef translation) {
+        ASSERT_EQ(translation, db.getMessageOr(id, "<no-fallback>"));
+      });
+}
+
+TEST_F(LocalizationTest, TestMissingOrTruncatedSerializedFile) {
+  // A producer pointed at a nonexistent file should fall back to the
+  // default message rather than failing.
+  {
+    SerializedLocalizationProducer db(llvm::StringRef("/nonexistent/en.db"));
+    ASSERT_EQ("<<<default-fallback>>>",
+              db.getMessageOr(static_cast<swift::DiagID>(0),
+                              "<<<default-fallback>>>"));
+  }
+
+  // So should one pointed at a file too small to contain the table offset.
+  {
+    auto dbFile = createTemporaryFile("short", "db");
+    {
+      std::error_code error;
+      llvm::raw_fd_ostream OS(dbFile, error, llvm::sys::fs::OF_None);
+      ASSERT_FALSE(error);
+      OS << "!";
+    }
+
+    SerializedLocalizationProducer db(llvm::StringRef(dbFile));
+    ASSERT_EQ("<<<default-fallback>>>",
+              db.getMessageOr(static_cast<swift::DiagID>(0),
+                              "<<<default-fallback>>>"));
+  }
+}
+
 TEST_F(LocalizationTest, TestSerializationOfEmptyFile) {
   auto dbFile = createTemporaryFile("by", "db");
   SerializedLocalizationWriter writer;
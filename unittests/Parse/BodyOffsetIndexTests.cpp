@@ -0,0 +1,64 @@
+#include "swift/Parse/BodyOffsetIndex.h"
+#include "swift/Basic/StableHasher.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gtest/gtest.h"
+
+using namespace swift;
+
+namespace {
+
+Fingerprint fingerprintFor(llvm::StringRef text) {
+  auto hasher = StableHasher::defaultHasher();
+  hasher.combine(text);
+  return Fingerprint(std::move(hasher));
+}
+
+BodyOffsetIndex makeIndex() {
+  BodyOffsetIndex index;
+  index.addEntry({0, 12, 40, fingerprintFor("first")});
+  index.addEntry({45, 60, 100, fingerprintFor("second")});
+  index.addEntry({120, 130, 131, Fingerprint::ZERO()});
+  return index;
+}
+
+} // end anonymous namespace
+
+TEST(BodyOffsetIndex, Lookup) {
+  auto index = makeIndex();
+  ASSERT_NE(nullptr, index.lookup(45));
+  EXPECT_EQ(60u, index.lookup(45)->BodyStartOffset);
+  EXPECT_EQ(100u, index.lookup(45)->BodyEndOffset);
+  EXPECT_EQ(nullptr, index.lookup(44));
+  EXPECT_EQ(nullptr, index.lookup(1000));
+}
+
+TEST(BodyOffsetIndex, SerializationRoundTrip) {
+  auto index = makeIndex();
+
+  std::string buffer;
+  llvm::raw_string_ostream OS(buffer);
+  index.serialize(OS);
+
+  auto restored = BodyOffsetIndex::deserialize(buffer);
+  ASSERT_TRUE(restored.has_value());
+  ASSERT_EQ(index.getEntries().size(), restored->getEntries().size());
+  for (size_t i = 0; i != index.getEntries().size(); ++i)
+    EXPECT_EQ(index.getEntries()[i], restored->getEntries()[i]);
+}
+
+TEST(BodyOffsetIndex, RejectsMalformedData) {
+  auto index = makeIndex();
+  std::string buffer;
+  llvm::raw_string_ostream OS(buffer);
+  index.serialize(OS);
+
+  // Truncated payload.
+  EXPECT_FALSE(
+      BodyOffsetIndex::deserialize(llvm::StringRef(buffer).drop_back()).has_value());
+  // Wrong magic.
+  std::string corrupted = buffer;
+  corrupted[0] = 'X';
+  EXPECT_FALSE(BodyOffsetIndex::deserialize(corrupted).has_value());
+  // Empty input.
+  EXPECT_FALSE(BodyOffsetIndex::deserialize("").has_value());
+}
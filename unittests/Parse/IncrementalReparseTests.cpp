@@ -0,0 +1,79 @@
+#include "swift/Parse/PersistentParserState.h"
+#include "gtest/gtest.h"
+
+using namespace swift;
+
+namespace {
+
+/// Record three top-level items: [0,10], [20,30], [40,50].
+void recordItems(PersistentParserState &state) {
+  state.recordTopLevelItemRange(0, 10);
+  state.recordTopLevelItemRange(20, 30);
+  state.recordTopLevelItemRange(40, 50);
+}
+
+} // end anonymous namespace
+
+TEST(IncrementalReparse, NoRecordedRangesMeansFullReparse) {
+  PersistentParserState state;
+  EXPECT_FALSE(state.computeDamagedRegion({5, 1, 2}).has_value());
+}
+
+TEST(IncrementalReparse, EditInsideOneItemDamagesOnlyThatItem) {
+  PersistentParserState state;
+  recordItems(state);
+  auto damage = state.computeDamagedRegion({24, 2, 5});
+  ASSERT_TRUE(damage.has_value());
+  EXPECT_EQ(20u, damage->first);
+  EXPECT_EQ(30u, damage->second);
+}
+
+TEST(IncrementalReparse, EditBetweenItemsDamagesNeither) {
+  PersistentParserState state;
+  recordItems(state);
+  // Whitespace-only edit strictly between the first two items.
+  auto damage = state.computeDamagedRegion({14, 2, 2});
+  ASSERT_TRUE(damage.has_value());
+  EXPECT_EQ(13u, damage->first);
+  EXPECT_EQ(17u, damage->second);
+}
+
+TEST(IncrementalReparse, InsertionAdjacentToItemDamagesIt) {
+  PersistentParserState state;
+  recordItems(state);
+  // Inserting directly after the first item may extend its last token.
+  auto damage = state.computeDamagedRegion({11, 0, 3});
+  ASSERT_TRUE(damage.has_value());
+  EXPECT_EQ(0u, damage->first);
+}
+
+TEST(IncrementalReparse, EditSpanningItemsDamagesAll) {
+  PersistentParserState state;
+  recordItems(state);
+  auto damage = state.computeDamagedRegion({5, 40, 1});
+  ASSERT_TRUE(damage.has_value());
+  EXPECT_EQ(0u, damage->first);
+  EXPECT_EQ(50u, damage->second);
+}
+
+TEST(IncrementalReparse, ApplyEditDropsDamagedAndShiftsLaterItems) {
+  PersistentParserState state;
+  recordItems(state);
+  // Replace 2 bytes with 5 inside the middle item.
+  state.applyEdit({24, 2, 5});
+  auto ranges = state.getTopLevelItemRanges();
+  ASSERT_EQ(2u, ranges.size());
+  EXPECT_EQ(std::make_pair(0u, 10u), ranges[0]);
+  EXPECT_EQ(std::make_pair(43u, 53u), ranges[1]);
+}
+
+TEST(IncrementalReparse, ApplyDeletionShiftsBackward) {
+  PersistentParserState state;
+  recordItems(state);
+  // Delete 4 bytes inside the first item.
+  state.applyEdit({2, 4, 0});
+  auto ranges = state.getTopLevelItemRanges();
+  ASSERT_EQ(2u, ranges.size());
+  EXPECT_EQ(std::make_pair(16u, 26u), ranges[0]);
+  EXPECT_EQ(std::make_pair(36u, 46u), ranges[1]);
+}
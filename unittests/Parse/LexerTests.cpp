@@ -83,6 +83,33 @@ TEST_F(LexerTest, TokenizeWithComments) {
             Toks[0].getLoc().getAdvancedLoc(8));
 }
 
+TEST_F(LexerTest, CommentTriviaArena) {
+  // The comments follow the first token because the lexer primes its first
+  // token at construction, before an arena can be installed.
+  const char *Source =
+      "(/*yo*/)\n"
+      "// Blah\n"
+      ";";
+  unsigned BufID = SourceMgr.addMemBufferCopy(Source);
+
+  TriviaArena Arena;
+  Lexer L(LangOpts, SourceMgr, BufID, /*Diags=*/nullptr, LexerMode::Swift);
+  L.setCommentTriviaArena(&Arena);
+  Token Tok;
+  do {
+    L.lex(Tok);
+  } while (Tok.isNot(tok::eof));
+
+  ASSERT_EQ(2u, Arena.size());
+  EXPECT_EQ(1u, Arena.getRecords()[0].Offset);
+  EXPECT_EQ(6u, Arena.getRecords()[0].Length);
+  EXPECT_EQ(9u, Arena.getRecords()[1].Offset);
+  EXPECT_EQ(7u, Arena.getRecords()[1].Length);
+  EXPECT_EQ("/*yo*/", Arena.materializeText(SourceMgr, BufID, 0));
+  EXPECT_EQ("// Blah", Arena.materializeText(SourceMgr, BufID, 1));
+  EXPECT_EQ(7u, Arena.materializeRange(SourceMgr, BufID, 1).getByteLength());
+}
+
 TEST_F(LexerTest, EOFTokenLengthIsZero) {
   const char *Source = "meow";
   std::vector<tok> ExpectedTokens{ tok::identifier, tok::eof };
@@ -0,0 +1,77 @@
+//===--- OverloadResolutionCacheTests.cpp ---------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2025 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/LangOptions.h"
+#include "swift/Sema/OverloadResolutionCache.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gtest/gtest.h"
+
+using namespace swift;
+using namespace swift::constraints;
+
+TEST(OverloadResolutionCache, FingerprintSensitivity) {
+  LangOptions langOpts;
+  auto base = OverloadResolutionCache::fingerprintExpression(
+      "a + b + c", "MyModule", langOpts, "file.swift", 10, "Int");
+  EXPECT_EQ(base, OverloadResolutionCache::fingerprintExpression(
+                      "a + b + c", "MyModule", langOpts, "file.swift", 10,
+                      "Int"));
+  EXPECT_NE(base, OverloadResolutionCache::fingerprintExpression(
+                      "a + b + d", "MyModule", langOpts, "file.swift", 10,
+                      "Int"));
+  EXPECT_NE(base, OverloadResolutionCache::fingerprintExpression(
+                      "a + b + c", "OtherModule", langOpts, "file.swift", 10,
+                      "Int"));
+  // The same text in another file, at another position, or against another
+  // contextual type is a different expression.
+  EXPECT_NE(base, OverloadResolutionCache::fingerprintExpression(
+                      "a + b + c", "MyModule", langOpts, "other.swift", 10,
+                      "Int"));
+  EXPECT_NE(base, OverloadResolutionCache::fingerprintExpression(
+                      "a + b + c", "MyModule", langOpts, "file.swift", 42,
+                      "Int"));
+  EXPECT_NE(base, OverloadResolutionCache::fingerprintExpression(
+                      "a + b + c", "MyModule", langOpts, "file.swift", 10,
+                      "Double"));
+  EXPECT_NE(base, OverloadResolutionCache::fingerprintExpression(
+                      "a + b + c", "MyModule", langOpts, "file.swift", 10,
+                      "Int", "dep-fingerprint"));
+}
+
+TEST(OverloadResolutionCache, SerializationRoundTrip) {
+  LangOptions langOpts;
+  OverloadResolutionCache cache;
+  cache.recordTooComplex(OverloadResolutionCache::fingerprintExpression(
+      "x + y * z", "MyModule", langOpts, "file.swift", 10, ""));
+  cache.recordTooComplex(OverloadResolutionCache::fingerprintExpression(
+      "f(a, b, c)", "MyModule", langOpts, "file.swift", 30, ""));
+
+  llvm::SmallString<128> buffer;
+  llvm::raw_svector_ostream os(buffer);
+  cache.writeToStream(os);
+
+  auto restored = OverloadResolutionCache::readFromBuffer(buffer.str());
+  ASSERT_TRUE(restored.has_value());
+  EXPECT_EQ(2u, restored->size());
+  EXPECT_TRUE(
+      restored->isKnownTooComplex(OverloadResolutionCache::fingerprintExpression(
+          "x + y * z", "MyModule", langOpts, "file.swift", 10, "")));
+  EXPECT_FALSE(
+      restored->isKnownTooComplex(OverloadResolutionCache::fingerprintExpression(
+          "untouched", "MyModule", langOpts, "file.swift", 10, "")));
+
+  // Corrupted input is rejected rather than partially decoded.
+  EXPECT_FALSE(
+      OverloadResolutionCache::readFromBuffer(buffer.str().drop_back(1))
+          .has_value());
+}
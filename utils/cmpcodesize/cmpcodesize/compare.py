@@ -260,6 +260,91 @@ def compare_sizes_of_file(old_files, new_files, all_sections, all_segments,
                       csv=csv)
 
 
+def demangle_symbols(names):
+    """Demangle all names in one batched swift-demangle invocation and
+    return a name -> demangled dict. Names the demangler cannot handle (or
+    all names, if no demangler is available) map to themselves."""
+    demangler = os.environ.get('SWIFT_DEMANGLE', 'swift-demangle')
+    names = list(names)
+    try:
+        output = subprocess.check_output(
+            [demangler, '-compact'],
+            input='\n'.join(names).encode('utf-8')).decode('utf-8')
+    except (OSError, subprocess.CalledProcessError):
+        return dict(zip(names, names))
+    return dict(zip(names, output.split('\n')))
+
+
+def origin_of(demangled):
+    """Return the SIL-level origin of a demangled symbol: specializations
+    (generic, partial, function signature, or chains thereof) are attributed
+    to the function they were cloned from, everything else to itself."""
+    if demangled.startswith('merged '):
+        demangled = demangled[len('merged '):]
+    # Specialization chains read "... specialization <...> of f"; the last
+    # "> of " separates the innermost origin even when the specialization
+    # arguments themselves contain "of".
+    if ' specialization <' in demangled and '> of ' in demangled:
+        return demangled.rsplit('> of ', 1)[1]
+    return demangled
+
+
+def compare_origin_sizes(old_files, new_files, csv=None):
+    """Compare function sizes aggregated by SIL origin, so that size growth
+    from new or fatter specializations is attributed to the generic function
+    that spawned them."""
+    old_sizes = collections.defaultdict(int)
+    new_sizes = collections.defaultdict(int)
+    for name in old_files:
+        read_sizes(old_sizes, [], name, True, False)
+    for name in new_files:
+        read_sizes(new_sizes, [], name, True, False)
+
+    demangled = demangle_symbols(set(old_sizes) | set(new_sizes))
+
+    old_origins = collections.defaultdict(int)
+    new_origins = collections.defaultdict(int)
+    old_copies = collections.defaultdict(int)
+    new_copies = collections.defaultdict(int)
+    for func, size in old_sizes.items():
+        origin = origin_of(demangled[func])
+        old_origins[origin] += size
+        old_copies[origin] += 1
+    for func, size in new_sizes.items():
+        origin = origin_of(demangled[func])
+        new_origins[origin] += size
+        new_copies[origin] += 1
+
+    deltas = []
+    for origin in set(old_origins) | set(new_origins):
+        old_size = old_origins[origin]
+        new_size = new_origins[origin]
+        if old_size != new_size:
+            deltas.append((new_size - old_size, old_size, new_size,
+                           old_copies[origin], new_copies[origin], origin))
+    deltas.sort(key=itemgetter(0, 1))
+
+    header = ("diff", "old", "new", "#old", "#new")
+    if csv:
+        csv.writerow(list(header) + ["origin"])
+    else:
+        print("%8s %8s %8s %5s %5s" % header)
+    for (diff, old_size, new_size, n_old, n_new, origin) in deltas:
+        if csv:
+            csv.writerow([diff, old_size, new_size, n_old, n_new, origin])
+        else:
+            print("%8d %8d %8d %5d %5d %s" %
+                  (diff, old_size, new_size, n_old, n_new, origin))
+
+    total_diff = sum(d[0] for d in deltas)
+    if csv:
+        csv.writerow(["Total size change", total_diff, "", "", "", ""])
+    else:
+        print("Total size change attributed to origins: {}".format(
+            total_diff))
+    return total_diff
+
+
 def list_function_sizes(size_array):
     for pair in sorted(size_array, key=itemgetter(1)):
         name = pair[0]
@@ -17,8 +17,8 @@ import os
 import sys
 
 from cmpcodesize.compare import \
-    compare_function_sizes, compare_sizes_of_file, list_function_sizes, \
-    read_sizes
+    compare_function_sizes, compare_origin_sizes, compare_sizes_of_file, \
+    list_function_sizes, read_sizes
 
 
 SHORTCUTS = {
@@ -99,6 +99,23 @@ How to specify files:
                         action='store_true',
                         dest='list_functions',
                         default=False)
+    parser.add_argument('-g', '--group-by-origin',
+                        help='Attribute function size deltas to their SIL ' +
+                             'origin: specializations are charged to the ' +
+                             'generic function they were cloned from. ' +
+                             'Requires swift-demangle in PATH (or ' +
+                             '$SWIFT_DEMANGLE).',
+                        action='store_true',
+                        dest='group_by_origin',
+                        default=False)
+    parser.add_argument('-t', '--threshold',
+                        help='With --group-by-origin: exit with an error if ' +
+                             'the total attributed size grows by more than ' +
+                             'this many bytes. Intended for CI gating.',
+                        action='store',
+                        dest='threshold',
+                        type=int,
+                        default=None)
     parser.add_argument('-s', '--summarize',
                         help='Summarize the sizes of multiple files instead ' +
                              'of listing each file separately.',
@@ -204,7 +221,17 @@ How to specify files:
         if not os.path.isfile(file):
             sys.exit("file " + file + " not found")
 
-    if parsed_arguments.list_functions:
+    if parsed_arguments.group_by_origin:
+        assert old_files and new_files, \
+            'Incorrect usage: Must specify both old and new files when ' + \
+            'using --group-by-origin.'
+        total_diff = compare_origin_sizes(old_files, new_files, csv=csv_out)
+        if parsed_arguments.threshold is not None and \
+                total_diff > parsed_arguments.threshold:
+            sys.exit("total size grew by {} bytes, more than the threshold "
+                     "of {} bytes".format(total_diff,
+                                          parsed_arguments.threshold))
+    elif parsed_arguments.list_functions:
         if not new_files:
             sizes = collections.defaultdict(int)
             for file in old_files:
@@ -0,0 +1,48 @@
+# test_origin_of.py - origin_of unit tests -*- python -*-
+#
+# This source file is part of the Swift.org open source project
+#
+# Copyright (c) 2026 Apple Inc. and the Swift project authors
+# Licensed under Apache License v2.0 with Runtime Library Exception
+#
+# See https://swift.org/LICENSE.txt for license information
+# See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+
+import unittest
+
+from cmpcodesize.compare import origin_of
+
+
+class OriginOfTestCase(unittest.TestCase):
+
+    def test_plain_function_is_its_own_origin(self):
+        self.assertEqual(origin_of('Swift.print(Any...)'), 'Swift.print(Any...)')
+
+    def test_generic_specialization(self):
+        self.assertEqual(
+            origin_of('generic specialization <Swift.Int> of '
+                      'Swift.max<A>(A, A) -> A'),
+            'Swift.max<A>(A, A) -> A')
+
+    def test_function_signature_specialization_of_generic_specialization(self):
+        self.assertEqual(
+            origin_of('function signature specialization '
+                      '<Arg[0] = Dead> of generic specialization '
+                      '<Swift.Int> of Swift.max<A>(A, A) -> A'),
+            'Swift.max<A>(A, A) -> A')
+
+    def test_specialization_arguments_containing_of(self):
+        self.assertEqual(
+            origin_of('generic specialization <Swift.Array<Swift.Int>> of '
+                      'test.f<A>(A) -> ()'),
+            'test.f<A>(A) -> ()')
+
+    def test_merged_prefix_is_stripped(self):
+        self.assertEqual(
+            origin_of('merged generic specialization <Swift.Int> of '
+                      'test.f<A>(A) -> ()'),
+            'test.f<A>(A) -> ()')
+
+
+if __name__ == '__main__':
+    unittest.main()